@@ -0,0 +1,137 @@
+#include "bench.h"
+
+#include <cstdlib>
+#include <new>
+#include <fstream>
+#include <SDL.h>
+#include "errors.h"
+#include "misc.h"
+#include "datapackage.h"
+#include "geometry.h"
+#include "map.h"
+#include "mapobject.h"
+
+#define BENCH_MAP_TERRAINS 6 // le nombre de terrains du jeu de textures "lake"
+
+static unsigned long s_allocations = 0; // non protégé : les mesures comptent les allocations d'un seul thread
+
+void* operator new(size_t size) throw(bad_alloc)
+{
+	s_allocations++;
+	void* p_rtn = malloc((size > 0)?size:1);
+	if (p_rtn == 0)
+		throw bad_alloc();
+
+	return p_rtn;
+}
+
+void operator delete(void* p) throw()
+{
+	free(p);
+}
+
+double benchClock()
+{
+	return (double) SDL_GetPerformanceCounter() * 1000.0 / (double) SDL_GetPerformanceFrequency();
+}
+
+unsigned long benchAllocations()
+{
+	return s_allocations;
+}
+
+unsigned long benchReadCalls()
+{
+#ifdef _WIN32
+	return 0;
+#else
+	ifstream ifs("/proc/self/io");
+	string key;
+	unsigned long value;
+	while (ifs >> key >> value)
+	{
+		if (key == "syscr:")
+			return value;
+	}
+
+	return 0;
+#endif
+}
+
+void writeBenchMap(const string& fileName, unsigned int size, bool flat, unsigned int mobsCount)
+{
+	ofstream ofs(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!ofs.is_open())
+		throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
+
+	int tmp = PFGAME_VERSION;
+	ofs.write((char*) &tmp, sizeof(int));
+	tmp = STRING_FLAG;
+	ofs.write((char*) &tmp, sizeof(int));
+	writeString(ofs, "lacdorange");
+
+	// données lues par Map::Map(DataPackage&)
+	vector<int> heights_v(size*size, MAP_CELL_SQUARE_HEIGHT);
+	WRITE_ENUM(ofs, Map::SAVE_DIM);
+	WRITE_UINT(ofs, size);
+	WRITE_UINT(ofs, size);
+	WRITE_ENUM(ofs, Map::SAVE_SEED);
+	WRITE_UINT(ofs, 1);
+	WRITE_ENUM(ofs, Map::SAVE_TEXTURE);
+	WRITE_STRING(ofs, "lake");
+	WRITE_ENUM(ofs, Map::SAVE_CELLS);
+	for (unsigned int i=0;i<size;i++)
+	{
+		for (unsigned int j=0;j<size;j++)
+		{
+			if (!flat)
+				heights_v[i*size+j] = MAP_CELL_SQUARE_HEIGHT*(1+rand()%2);
+			WRITE_ENUM(ofs, Cell::SAVE_COORD);
+			WRITE_UINT(ofs, i+1);
+			WRITE_UINT(ofs, j+1);
+			WRITE_ENUM(ofs, Cell::SAVE_TERRAIN);
+			WRITE_UINT(ofs, (flat)?0:rand()%BENCH_MAP_TERRAINS);
+			WRITE_ENUM(ofs, Cell::SAVE_Z);
+			WRITE_INT(ofs, heights_v[i*size+j]);
+			WRITE_ENUM(ofs, Cell::SAVE_SLOPE);
+			WRITE_INT(ofs, PfOrientation::CARDINAL_E);
+			WRITE_INT(ofs, 0);
+			WRITE_INT(ofs, 0);
+			WRITE_ENUM(ofs, Cell::SAVE_END);
+		}
+	}
+	WRITE_ENUM(ofs, Map::SAVE_GROUNDTYPE);
+	WRITE_ENUM(ofs, Map::MAP_GROUND_FLOOR);
+	WRITE_ENUM(ofs, Map::SAVE_MAPLINKS);
+	WRITE_UINT(ofs, 0);
+	WRITE_ENUM(ofs, Map::SAVE_SCRIPT);
+	WRITE_UINT(ofs, 0);
+	WRITE_ENUM(ofs, Map::SAVE_END);
+	WRITE_END(ofs);
+
+	// données lues par MapModel : les mobs, puis l'absence d'arrière-plan
+	WRITE_UINT(ofs, mobsCount);
+	for (unsigned int i=0;i<mobsCount;i++)
+	{
+		unsigned int row = (i/(size/2))%size, col = 2*(i%(size/2)) + row%2;
+		WRITE_INT(ofs, NEW_SLOT_FLAG);
+		WRITE_INT(ofs, WAD_MOB);
+		// données lues par MapObject::loadData, l'ordonnée étant celle de la case au niveau du sol
+		WRITE_ENUM(ofs, MapObject::SAVE_ORIENTATION);
+		WRITE_INT(ofs, (int) ((i%2 == 0)?PfOrientation::EAST:PfOrientation::WEST));
+		WRITE_ENUM(ofs, MapObject::SAVE_COORD);
+		WRITE_FLOAT(ofs, col*MAP_CELL_SIZE);
+		WRITE_FLOAT(ofs, row*MAP_CELL_SIZE);
+		WRITE_ENUM(ofs, MapObject::SAVE_Z);
+		WRITE_INT(ofs, heights_v[row*size+col]);
+		WRITE_ENUM(ofs, MapObject::SAVE_SPEED);
+		WRITE_INT(ofs, 1);
+		WRITE_FLOAT(ofs, 0.0);
+		WRITE_ENUM(ofs, MapObject::SAVE_CODEOBJ);
+		WRITE_INT(ofs, 0);
+		WRITE_ENUM(ofs, MapObject::SAVE_END);
+	}
+	WRITE_CHAR(ofs, 0);
+	WRITE_END(ofs);
+	ofs.close();
+}
@@ -0,0 +1,125 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant les mesures de performance du moteur et leurs outils communs.
+* @date xx/xx/xxxx
+*
+* Chaque mesure est une fonction recevant les arguments de la ligne de commande qui suivent son nom,
+* et retournant le code de sortie du programme. La liste des mesures est tenue dans le fichier "main.cpp".
+*
+* Les mesures s'exécutent sans fenêtre ni contexte OpenGL (variable <em>g_glRecordOnly</em>, fichier "glfunc.h"),
+* depuis le répertoire du jeu dont elles lisent les ressources. Leurs résultats sont écrits sur la sortie standard.
+*/
+
+#ifndef BENCH_H_INCLUDED
+#define BENCH_H_INCLUDED
+
+#include "gen.h"
+
+#include <string>
+#include <vector>
+
+/**
+* @brief Retourne une date en millisecondes, à n'utiliser que par différence.
+* @return La date.
+*/
+double benchClock();
+/**
+* @brief Retourne le nombre d'allocations faites par l'opérateur <em>new</em> depuis le début du programme.
+* @return Le nombre d'allocations.
+*
+* Les opérateurs <em>new</em> et <em>delete</em> globaux sont remplacés dans ce programme afin de compter les allocations.
+*/
+unsigned long benchAllocations();
+/**
+* @brief Retourne le nombre d'appels système de lecture faits par le programme.
+* @return Le nombre d'appels, 0 si le système ne le fournit pas.
+*
+* Sous Linux, ce nombre est lu dans le fichier /proc/self/io. Les autres systèmes ne le fournissent pas.
+*/
+unsigned long benchReadCalls();
+/**
+* @brief Ecrit un fichier map de mesure, au format de MapEditorModel::saveMap, utilisant le wad "lacdorange" et le jeu de textures "lake".
+* @param fileName Le chemin du fichier.
+* @param size Le nombre de lignes et de colonnes de la map.
+* @param flat Indique si toutes les cases sont de terrain 0 et de même hauteur, sinon terrains et hauteurs sont tirés au hasard.
+* @param mobsCount Le nombre de mobs, au plus <em>size</em>*<em>size</em>/2.
+* @throw FileException si le fichier ne peut pas être ouvert.
+*
+* Les mobs occupent une case sur deux, le premier étant le mob contrôlé. Ils avancent vers l'est ou l'ouest jusqu'à leur première collision.
+* La map n'a pas d'arrière-plan.
+*/
+void writeBenchMap(const string& fileName, unsigned int size, bool flat, unsigned int mobsCount);
+
+/**
+* @brief Compte les rendus du terrain d'une map, de ses cases seules puis de leurs lots.
+* @param args_v Le nom du fichier map (répertoire MAPS_DIR), "Lac.map" par défaut.
+* @return Le code de sortie du programme.
+*
+* La map du fichier, puis une map de 100x100 cases aux terrains et hauteurs tirés au hasard, sont rendues une fois
+* avec un RecordingRenderBackend. Sont écrits le nombre de rendus d'une image par image de case, le nombre de rendus des lots,
+* et le nombre minimal de rendus, d'un rendu par texture et par plan de perspective.
+*/
+int terrainBatchBench(const vector<string>& args_v);
+/**
+* @brief Compare l'affichage d'une AbstractView depuis sa liste triée et l'affichage d'origine en une passe par plan.
+* @param args_v Les nombres de Viewable, 1000, 10000 et 100000 par défaut.
+* @return Le code de sortie du programme.
+*
+* Pour chaque nombre, des RectangleGLItem aux plans et textures tirés au hasard sont affichés par une vue sans rendu.
+* Sont écrits les temps d'affichage des deux méthodes et la comparaison de leurs ordres d'affichage, ainsi que les temps de mise à jour
+* de la liste triée à sa création et après le changement de plan d'un Viewable sur cent.
+*/
+int viewSortBench(const vector<string>& args_v);
+/**
+* @brief Mesure la construction et la destruction du Viewable d'une map de 100x100 cases.
+* @param args_v Le nombre de constructions, 10 par défaut.
+* @return Le code de sortie du programme.
+*
+* La map, aux terrains et hauteurs tirés au hasard, construit son Viewable complet, détruit aussitôt, autant de fois que demandé.
+* Sont écrits le nombre d'allocations et les temps de la première construction, puis la moyenne des suivantes,
+* qui réutilisent la mémoire libérée par les précédentes.
+*/
+int mapViewBench(const vector<string>& args_v);
+/**
+* @brief Mesure le chargement d'une map de 256x256 cases et les tests de collision de ses mobs.
+* @param args_v Le nombre de mobs, 10000 par défaut.
+* @return Le code de sortie du programme.
+*
+* Une map aux terrains et hauteurs tirés au hasard est écrite dans le répertoire MAPS_DIR par la fonction writeBenchMap.
+* Sa Map seule est lue et construite, puis détruite, et la map complète est chargée par un MapModel avant que le fichier soit supprimé.
+* Sont écrits les temps de chargement et de destruction de la Map et son nombre d'allocations, le temps de chargement du MapModel,
+* et les temps moyens par image des méthodes MapModel::moveObjects et MapModel::processInteractions.
+*/
+int mapCellsBench(const vector<string>& args_v);
+/**
+* @brief Compare la lecture d'une map par un flux et par projection du fichier en mémoire.
+* @param args_v La taille de la map, 512 par défaut.
+* @return Le code de sortie du programme.
+*
+* Une map sans objet, aux terrains et hauteurs tirés au hasard, est écrite dans le répertoire MAPS_DIR par la fonction writeBenchMap,
+* puis lue trois fois par chaque lecteur avant d'être supprimée. Pour chaque lecture sont écrits le temps de lecture des DataPackage,
+* le temps de construction de la Map et le nombre d'allocations.
+*/
+int mapLoadBench(const vector<string>& args_v);
+/**
+* @brief Mesure les déplacements et les interactions des mobs d'une map de 100x100 cases.
+* @param args_v Le nombre de mobs, 5000 par défaut, puis le nombre d'images, 100 par défaut.
+* @return Le code de sortie du programme.
+*
+* Une map plate est écrite dans le répertoire MAPS_DIR par la fonction writeBenchMap, puis chargée par un MapModel
+* et supprimée. Sont écrits le temps de chargement et les temps moyens par image des méthodes MapModel::moveObjects
+* et MapModel::processInteractions.
+*/
+int mobsBench(const vector<string>& args_v);
+/**
+* @brief Mesure la lecture d'un fichier wad.
+* @param args_v Le nom du wad (répertoire WAD_DIR, sans extension), "lacdorange" par défaut.
+* @return Le code de sortie du programme.
+*
+* Le wad est ouvert puis refermé par un PfWad. Sont écrits la taille du fichier, le temps de lecture et le nombre d'appels système de lecture.
+* Un wad déjà lu restant en mémoire, la lecture n'est mesurée qu'une fois par exécution.
+*/
+int wadReadBench(const vector<string>& args_v);
+
+#endif // BENCH_H_INCLUDED
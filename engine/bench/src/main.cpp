@@ -0,0 +1,92 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier principal du programme de mesures de performance <em>bench</em>.
+* @date xx/xx/xxxx
+*
+* Le programme s'utilise de la manière suivante, depuis le répertoire du jeu :
+*
+* <code>bench mesure [arguments]</code>
+*
+* Sans argument, la liste des mesures est écrite sur la sortie standard.
+* Les mesures sont déclarées dans le fichier "bench.h".
+*/
+
+#define SDL_MAIN_HANDLED
+
+#include "bench.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <SDL.h>
+#include "errors.h"
+#include "glfunc.h"
+#include "wad.h"
+
+/**
+* @brief Mesure de performance lançable depuis la ligne de commande.
+*/
+struct BenchEntry
+{
+	const char* name; //!< Le nom de la mesure.
+	int (*p_function)(const vector<string>&); //!< La fonction de mesure.
+	const char* usage; //!< Les arguments de la mesure.
+};
+
+/**
+* @brief Liste des mesures de ce programme.
+*/
+static const BenchEntry s_benches_t[] = {{"terrainbatch", terrainBatchBench, "[fichier map]"},
+                                         {"viewsort", viewSortBench, "[nombres de Viewable]"},
+                                         {"mapview", mapViewBench, "[nombre de constructions]"},
+                                         {"mapload", mapLoadBench, "[taille de la map]"},
+                                         {"mapcells", mapCellsBench, "[nombre de mobs]"},
+                                         {"mobs", mobsBench, "[nombre de mobs] [nombre d'images]"},
+                                         {"wadread", wadReadBench, "[nom du wad]"}};
+
+/**
+* @brief Fonction principale du programme <em>bench</em>.
+* @param argc Le nombre d'arguments.
+* @param argv Le nom de la mesure, puis ses arguments.
+* @return 0 si la mesure s'est déroulée correctement.
+*/
+int main(int argc, char* argv[])
+{
+	LOG(__DATE__ << " " << __TIME__ << "\nPOUFALOUF bench log\n\n");
+
+	srand(1); // les maps tirées au hasard sont identiques d'une exécution à l'autre
+	g_glRecordOnly = true;
+
+	unsigned int count = sizeof(s_benches_t)/sizeof(BenchEntry);
+	string name = (argc > 1)?argv[1]:"";
+	for (unsigned int i=0;i<count;i++)
+	{
+		if (name != s_benches_t[i].name)
+			continue;
+
+		vector<string> args_v;
+		for (int j=2;j<argc;j++)
+			args_v.push_back(argv[j]);
+
+		int rtn = 0;
+		try
+		{
+			rtn = s_benches_t[i].p_function(args_v);
+			PfWad::freeCatalogs();
+		}
+		catch (PfException& e)
+		{
+			LOG("Une erreur est survenue:\n" << e.what() << "\n");
+			cerr << e.what() << "\n";
+			rtn = 1;
+		}
+
+		return rtn;
+	}
+
+	cout << "Usage : bench mesure [arguments]\n";
+	for (unsigned int i=0;i<count;i++)
+		cout << "\t" << s_benches_t[i].name << " " << s_benches_t[i].usage << "\n";
+
+	return (name == "")?0:1;
+}
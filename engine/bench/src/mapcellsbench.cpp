@@ -0,0 +1,86 @@
+#include "bench.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include "errors.h"
+#include "misc.h"
+#include "datapackage.h"
+#include "map.h"
+#include "mapmodel.h"
+
+#define MAP_CELLS_SIZE 256 // la taille de la map écrite
+#define MAP_CELLS_MOBS 10000 // le nombre de mobs par défaut
+#define MAP_CELLS_FRAMES 100 // le nombre d'images mesurées
+#define MAP_CELLS_FILE "bench_cells" // le nom du fichier map écrit, supprimé à la fin de la mesure
+
+// lit et construit la Map seule, sans ses objets
+static void loadMap(const string& fileName)
+{
+	unsigned long allocations = benchAllocations();
+	double start = benchClock();
+	ifstream ifs(fileName.c_str(), ios::binary);
+	if (!ifs.is_open())
+		throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
+	int tmp;
+	ifs.read((char*) &tmp, sizeof(int));
+	ifs.read((char*) &tmp, sizeof(int)); // passer STRING_FLAG
+	readString(ifs);
+	DataPackage dp(ifs);
+	ifs.close();
+	Map* p_map = new Map(dp);
+	double loading = benchClock() - start;
+	allocations = benchAllocations() - allocations;
+
+	start = benchClock();
+	delete p_map;
+	double destruction = benchClock() - start;
+
+	cout << "\tMap seule : chargement " << loading << " ms, " << allocations << " allocations, destruction " << destruction << " ms\n";
+}
+
+int mapCellsBench(const vector<string>& args_v)
+{
+	unsigned int count = (args_v.empty())?MAP_CELLS_MOBS:strtoul(args_v[0].c_str(), 0, 10);
+	if (count == 0 || count > MAP_CELLS_SIZE*MAP_CELLS_SIZE/2)
+		throw PfException(__LINE__, __FILE__, string("Le nombre de mobs doit être compris entre 1 et ") + itostr(MAP_CELLS_SIZE*MAP_CELLS_SIZE/2) + ".");
+
+	string mapName = string(MAP_CELLS_FILE) + "." + MAPS_EXT, fileName = string(MAPS_DIR) + mapName;
+	writeBenchMap(fileName, MAP_CELLS_SIZE, false, count);
+	cout << "map " << MAP_CELLS_SIZE << "x" << MAP_CELLS_SIZE << ", " << count << " mobs\n";
+
+	MapModel* p_model = 0;
+	double start, loading;
+	try
+	{
+		loadMap(fileName);
+		start = benchClock();
+		p_model = new MapModel(mapName);
+		loading = benchClock() - start;
+	}
+	catch (PfException& e)
+	{
+		remove(fileName.c_str());
+		throw PfException(__LINE__, __FILE__, "Impossible de charger la map des mobs.", e);
+	}
+	remove(fileName.c_str());
+
+	// les mobs arrêtés par une falaise testent encore chaque image la hauteur des cases et des objets sous eux
+	double moveTime = 0.0, interactionTime = 0.0;
+	for (unsigned int i=0;i<MAP_CELLS_FRAMES;i++)
+	{
+		start = benchClock();
+		p_model->moveObjects();
+		moveTime += benchClock() - start;
+		start = benchClock();
+		p_model->processInteractions();
+		interactionTime += benchClock() - start;
+	}
+	delete p_model;
+
+	cout << "\tMapModel : chargement " << loading << " ms, par image (moyenne de " << MAP_CELLS_FRAMES << ") moveObjects "
+		<< moveTime/MAP_CELLS_FRAMES << " ms, processInteractions " << interactionTime/MAP_CELLS_FRAMES << " ms\n";
+
+	return 0;
+}
@@ -0,0 +1,93 @@
+#include "bench.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include "errors.h"
+#include "misc.h"
+#include "datapackage.h"
+#include "mappedfile.h"
+#include "map.h"
+
+#define MAP_LOAD_SIZE 512 // la taille par défaut de la map écrite
+#define MAP_LOAD_RUNS 3 // le nombre de lectures par lecteur
+#define MAP_LOAD_FILE "bench_load.map" // le nom du fichier map écrit, supprimé à la fin de la mesure
+
+// lit la map par un flux, comme avant la projection des fichiers map
+static void loadFromStream(const string& fileName, double& r_read, double& r_build, unsigned long& r_allocations)
+{
+	unsigned long allocations = benchAllocations();
+	double start = benchClock();
+	ifstream ifs(fileName.c_str(), ios::binary);
+	if (!ifs.is_open())
+		throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
+	int tmp;
+	ifs.read((char*) &tmp, sizeof(int));
+	ifs.read((char*) &tmp, sizeof(int)); // passer STRING_FLAG
+	readString(ifs);
+	DataPackage mapData(ifs);
+	DataPackage objectsData(ifs);
+	ifs.close();
+	r_read = benchClock() - start;
+
+	start = benchClock();
+	Map map(mapData);
+	r_build = benchClock() - start;
+	r_allocations = benchAllocations() - allocations;
+}
+
+// lit la map projetée en mémoire, comme MapPrefetcher::readMap
+static void loadFromMapping(const string& fileName, double& r_read, double& r_build, unsigned long& r_allocations)
+{
+	unsigned long allocations = benchAllocations();
+	double start = benchClock();
+	MappedFile file(fileName);
+	int tmp;
+	file.read(&tmp, sizeof(int));
+	file.read(&tmp, sizeof(int)); // passer STRING_FLAG
+	file.readString();
+	DataPackage mapData(file);
+	DataPackage objectsData(file);
+	r_read = benchClock() - start;
+
+	start = benchClock();
+	Map map(mapData);
+	r_build = benchClock() - start;
+	r_allocations = benchAllocations() - allocations;
+}
+
+int mapLoadBench(const vector<string>& args_v)
+{
+	unsigned int size = (args_v.empty())?MAP_LOAD_SIZE:strtoul(args_v[0].c_str(), 0, 10);
+	if (size == 0)
+		throw PfException(__LINE__, __FILE__, "La taille de la map doit être positive.");
+
+	string fileName = string(MAPS_DIR) + MAP_LOAD_FILE;
+	writeBenchMap(fileName, size, false, 0);
+	ifstream ifs(fileName.c_str(), ios::binary | ios::ate);
+	double fileSize = (double) ifs.tellg();
+	ifs.close();
+	cout << "map " << size << "x" << size << " : " << fileSize/(1024*1024) << " Mo\n";
+
+	double read, build;
+	unsigned long allocations;
+	try
+	{
+		for (unsigned int i=0;i<MAP_LOAD_RUNS;i++) // les deux lecteurs alternent, le fichier restant en cache
+		{
+			loadFromStream(fileName, read, build, allocations);
+			cout << "\tflux : lecture " << read << " ms, construction " << build << " ms, " << allocations << " allocations\n";
+			loadFromMapping(fileName, read, build, allocations);
+			cout << "\tprojection : lecture " << read << " ms, construction " << build << " ms, " << allocations << " allocations\n";
+		}
+	}
+	catch (PfException&)
+	{
+		remove(fileName.c_str());
+		throw;
+	}
+	remove(fileName.c_str());
+
+	return 0;
+}
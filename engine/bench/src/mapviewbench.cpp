@@ -0,0 +1,63 @@
+#include "bench.h"
+
+#include <iostream>
+#include <cstdlib>
+#include "viewable.h"
+#include "map.h"
+
+#define MAP_VIEW_SIZE 100 // la taille de la map tirée au hasard
+#define MAP_VIEW_TERRAINS 6 // le nombre de terrains du jeu de textures "lake"
+#define MAP_VIEW_BUILDS 10 // le nombre de constructions par défaut
+
+int mapViewBench(const vector<string>& args_v)
+{
+	unsigned int builds = (args_v.empty())?MAP_VIEW_BUILDS:strtoul(args_v[0].c_str(), 0, 10);
+	if (builds == 0)
+		builds = 1;
+
+	Map map(MAP_VIEW_SIZE, MAP_VIEW_SIZE, "lake");
+	for (unsigned int i=1;i<=MAP_VIEW_SIZE;i++)
+	{
+		for (unsigned int j=1;j<=MAP_VIEW_SIZE;j++)
+			map.changeCell(i, j, rand()%MAP_VIEW_TERRAINS, MAP_CELL_SQUARE_HEIGHT*(1+rand()%2));
+	}
+
+	// la première construction réserve la mémoire des suivantes, elle est écrite à part
+	double buildTime = 0.0, freeTime = 0.0, start;
+	unsigned long buildAllocs = 0, freeAllocs = 0, allocations;
+	for (unsigned int i=0;i<builds;i++)
+	{
+		allocations = benchAllocations();
+		start = benchClock();
+		Viewable* p_vw = map.generateViewable();
+		double buildDuration = benchClock() - start;
+		unsigned long buildCount = benchAllocations() - allocations;
+
+		allocations = benchAllocations();
+		start = benchClock();
+		delete p_vw;
+		double freeDuration = benchClock() - start;
+		unsigned long freeCount = benchAllocations() - allocations;
+
+		if (i == 0)
+		{
+			cout << "map " << MAP_VIEW_SIZE << "x" << MAP_VIEW_SIZE << ", première construction : "
+				<< buildCount << " allocations, " << buildDuration << " ms, destruction " << freeDuration << " ms\n";
+		}
+		else
+		{
+			buildTime += buildDuration;
+			freeTime += freeDuration;
+			buildAllocs += buildCount;
+			freeAllocs += freeCount;
+		}
+	}
+
+	if (builds > 1)
+	{
+		cout << "constructions suivantes (moyenne de " << builds-1 << ") : "
+			<< buildAllocs/(builds-1) << " allocations, " << buildTime/(builds-1) << " ms, destruction " << freeTime/(builds-1) << " ms\n";
+	}
+
+	return 0;
+}
@@ -0,0 +1,57 @@
+#include "bench.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include "errors.h"
+#include "misc.h"
+#include "mapmodel.h"
+
+#define MOBS_MAP_SIZE 100 // la taille de la map écrite
+#define MOBS_COUNT 5000 // le nombre de mobs par défaut
+#define MOBS_FRAMES 100 // le nombre d'images mesurées par défaut
+#define MOBS_FILE "bench_mobs" // le nom du fichier map écrit, supprimé à la fin de la mesure
+
+int mobsBench(const vector<string>& args_v)
+{
+	unsigned int count = (args_v.size() > 0)?strtoul(args_v[0].c_str(), 0, 10):MOBS_COUNT;
+	unsigned int frames = (args_v.size() > 1)?strtoul(args_v[1].c_str(), 0, 10):MOBS_FRAMES;
+	if (count == 0 || count > MOBS_MAP_SIZE*MOBS_MAP_SIZE/2)
+		throw PfException(__LINE__, __FILE__, string("Le nombre de mobs doit être compris entre 1 et ") + itostr(MOBS_MAP_SIZE*MOBS_MAP_SIZE/2) + ".");
+	if (frames == 0)
+		frames = 1;
+
+	string mapName = string(MOBS_FILE) + "." + MAPS_EXT, fileName = string(MAPS_DIR) + mapName;
+	writeBenchMap(fileName, MOBS_MAP_SIZE, true, count);
+
+	MapModel* p_model = 0;
+	double start = benchClock();
+	try
+	{
+		p_model = new MapModel(mapName);
+	}
+	catch (PfException& e)
+	{
+		remove(fileName.c_str());
+		throw PfException(__LINE__, __FILE__, "Impossible de créer le modèle de la map des mobs.", e);
+	}
+	double loading = benchClock() - start;
+	remove(fileName.c_str());
+
+	double moveTime = 0.0, interactionTime = 0.0;
+	for (unsigned int i=0;i<frames;i++)
+	{
+		start = benchClock();
+		p_model->moveObjects();
+		moveTime += benchClock() - start;
+		start = benchClock();
+		p_model->processInteractions();
+		interactionTime += benchClock() - start;
+	}
+	delete p_model;
+
+	cout << count << " mobs sur " << MOBS_MAP_SIZE << "x" << MOBS_MAP_SIZE << " cases, chargement " << loading << " ms\n"
+		<< "\tpar image (moyenne de " << frames << ") : moveObjects " << moveTime/frames << " ms, processInteractions " << interactionTime/frames << " ms\n";
+
+	return 0;
+}
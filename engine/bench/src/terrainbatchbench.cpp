@@ -0,0 +1,85 @@
+#include "bench.h"
+
+#include <iostream>
+#include <map>
+#include <set>
+#include "errors.h"
+#include "viewable.h"
+#include "glimage.h"
+#include "renderbackend.h"
+#include "map.h"
+#include "mapprefetcher.h"
+
+#define MIXED_MAP_SIZE 100 // la taille de la map tirée au hasard
+#define MIXED_MAP_TERRAINS 6 // le nombre de terrains du jeu de textures "lake"
+
+// rend les lots du terrain d'une map, seuls Viewable visibles liés à son Viewable
+static void renderTerrain(const string& title, const Map& rc_map)
+{
+	double start = benchClock();
+	Viewable* p_vw = rc_map.generateViewable();
+	double generation = benchClock() - start;
+
+	unsigned int cellImages = 0, minimum = 0;
+	map<int, set<unsigned int> > textures_set_map;
+	RecordingRenderBackend backend;
+	const Viewable* q_vw;
+	backend.beginFrame();
+	for (unsigned int i=0, size=p_vw->viewablesCount();i<size;i++)
+	{
+		q_vw = p_vw->viewableAt(i);
+		for (unsigned int j=0, size2=q_vw->imagesCount();j<size2;j++)
+		{
+			if (q_vw->isVisible())
+				backend.draw(q_vw->imageAt(j));
+			else if (q_vw->imageAt(j).isBatchable())
+				textures_set_map[q_vw->getLayer()].insert(q_vw->imageAt(j).getTextureIndex());
+			else
+				minimum++;
+		}
+		if (!q_vw->isVisible())
+			cellImages += q_vw->imagesCount();
+	}
+	backend.endFrame();
+	for (map<int, set<unsigned int> >::const_iterator it=textures_set_map.begin();it!=textures_set_map.end();++it)
+		minimum += it->second.size();
+
+	const RecordingRenderBackend::FrameStats& rc_stats = backend.frameStats(0);
+	cout << title << " : " << rc_map.getRowsCount() << "x" << rc_map.getColumnsCount() << " cases, " << textures_set_map.size() << " plans, "
+		<< "génération " << generation << " ms\n"
+		<< "\timages des cases : " << cellImages << " rendus\n"
+		<< "\tlots : " << rc_stats.drawCalls << " rendus, " << rc_stats.textureBinds << " changements de texture, " << rc_stats.vertices << " sommets\n"
+		<< "\tminimum : " << minimum << " rendus (une texture par plan)\n";
+
+	delete p_vw;
+}
+
+int terrainBatchBench(const vector<string>& args_v)
+{
+	string fileName = (args_v.empty())?"Lac.map":args_v[0];
+	PrefetchedMap* pn_data = MapPrefetcher::readMap(fileName);
+	Map* p_map = 0;
+	try
+	{
+		p_map = new Map(pn_data->mapData);
+	}
+	catch (PfException& e)
+	{
+		delete pn_data;
+		throw PfException(__LINE__, __FILE__, string("Impossible de créer la map ") + fileName + ".", e);
+	}
+	delete pn_data;
+
+	renderTerrain(fileName, *p_map);
+	delete p_map;
+
+	Map mixedMap(MIXED_MAP_SIZE, MIXED_MAP_SIZE, "lake");
+	for (unsigned int i=1;i<=MIXED_MAP_SIZE;i++)
+	{
+		for (unsigned int j=1;j<=MIXED_MAP_SIZE;j++)
+			mixedMap.changeCell(i, j, rand()%MIXED_MAP_TERRAINS, MAP_CELL_SQUARE_HEIGHT*(1+rand()%2));
+	}
+	renderTerrain("aléatoire", mixedMap);
+
+	return 0;
+}
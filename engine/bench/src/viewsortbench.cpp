@@ -0,0 +1,210 @@
+#include "bench.h"
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include "abstractview.h"
+#include "viewable.h"
+#include "glimage.h"
+#include "glitem.h"
+#include "misc.h"
+
+#define VIEW_SORT_LAYERS 1000 // le nombre de plans tirés, le plan 0 compris
+#define VIEW_SORT_TEXTURES 8 // le nombre de textures tirées
+#define VIEW_SORT_AREA 16 // le côté de la zone où sont placés les Viewable
+#define VIEW_SORT_FRAMES 10 // le nombre d'affichages mesurés
+#define VIEW_SORT_MOVED 100 // un Viewable sur VIEW_SORT_MOVED change de plan avant la mise à jour mesurée
+
+// vue sans affichage, retenant l'ordre des Viewable affichés si une liste lui est donnée
+class OrderView : public AbstractView
+{
+public:
+	OrderView() : m_count(0), mq_order_v(0) {}
+	unsigned int getCount() const {return m_count;}
+	void setOrder(vector<const Viewable*>* q_order_v) {mq_order_v = q_order_v;}
+private:
+	// le rectangle englobant des images sert à classer les Viewable dans la grille, comme pour GLView
+	virtual bool viewableBounds(const Viewable& rc_viewable, PfRectangle& r_bounds) const
+	{
+		if (rc_viewable.imagesCount() == 0)
+			return false;
+		r_bounds = rc_viewable.imageAt(0).boundingBox();
+		return true;
+	}
+	virtual void initializeDisplay() const {m_count = 0;}
+	virtual void displayViewable(const Viewable& rc_viewable) const
+	{
+		m_count++;
+		if (mq_order_v != 0)
+			mq_order_v->push_back(&rc_viewable);
+	}
+	virtual void finalizeDisplay() const {}
+
+	mutable unsigned int m_count;
+	vector<const Viewable*>* mq_order_v;
+};
+
+// affichage en plusieurs passes, une par plan, de l'AbstractView d'origine, sans attente entre deux images
+static unsigned int displayOld(const map<string, Viewable*>& rc_viewables_map, vector<const Viewable*>* q_order_v)
+{
+	unsigned int count = 0;
+	int nextLayer = 0;
+	vector<const Viewable*> q_vws_v, q_vws2_v;
+	vector<const Viewable*>* q_vws_v_p = &q_vws_v;
+	vector<const Viewable*>* q_vws2_v_p = &q_vws2_v;
+	vector<const Viewable*>* q_temp_v_p;
+	const Viewable* q_vw;
+
+	for (map<string, Viewable*>::const_iterator it=rc_viewables_map.begin();it!=rc_viewables_map.end();++it)
+	{
+		q_vw = it->second;
+		if (!q_vw->isVisible())
+			continue;
+		if (q_vw->getLayer() == 0)
+		{
+			count++;
+			if (q_order_v != 0)
+				q_order_v->push_back(q_vw);
+		}
+		else
+		{
+			q_vws_v.push_back(q_vw);
+			if (q_vw->getLayer() < nextLayer || nextLayer == 0)
+				nextLayer = q_vw->getLayer();
+		}
+	}
+
+	while (!q_vws_v_p->empty())
+	{
+		int currentLayer = nextLayer;
+		for (unsigned int i=0, size=q_vws_v_p->size();i<size;i++)
+		{
+			q_vw = (*q_vws_v_p)[i];
+			if (q_vw->getLayer() == currentLayer)
+			{
+				count++;
+				if (q_order_v != 0)
+					q_order_v->push_back(q_vw);
+			}
+			else
+			{
+				q_vws2_v_p->push_back(q_vw);
+				if (q_vw->getLayer() < nextLayer || nextLayer == currentLayer)
+					nextLayer = q_vw->getLayer();
+			}
+		}
+
+		q_vws_v_p->clear();
+		q_temp_v_p = q_vws2_v_p;
+		q_vws2_v_p = q_vws_v_p;
+		q_vws_v_p = q_temp_v_p;
+	}
+
+	return count;
+}
+
+// liste des Viewable de l'affichage d'origine : les Viewable des ModelItem modifiés sont recréés
+static void updateOld(const map<string, ModelItem*>& rc_items_map, map<string, Viewable*>& r_viewables_map)
+{
+	map<string, Viewable*>::iterator vwIt;
+	for (map<string, ModelItem*>::const_iterator it=rc_items_map.begin();it!=rc_items_map.end();++it)
+	{
+		vwIt = r_viewables_map.find(it->first);
+		if (vwIt == r_viewables_map.end())
+			vwIt = r_viewables_map.insert(pair<string, Viewable*>(it->first, it->second->generateViewable())).first;
+		else if (it->second->isModified() && !it->second->updateViewable(*(vwIt->second)))
+		{
+			delete vwIt->second;
+			vwIt->second = it->second->generateViewable();
+		}
+		vwIt->second->setVisible(true);
+	}
+}
+
+static void sortBench(unsigned int count)
+{
+	map<string, ModelItem*> pn_items_map;
+	vector<RectangleGLItem*> q_items_v;
+	char name[16];
+	for (unsigned int i=0;i<count;i++)
+	{
+		sprintf(name, "item_%06u", i);
+		RectangleGLItem* p_item = new RectangleGLItem(name, rand()%VIEW_SORT_LAYERS,
+													  PfRectangle((float) (rand()%(VIEW_SORT_AREA*100))/100, (float) (rand()%(VIEW_SORT_AREA*100))/100, 0.1, 0.1),
+													  1+rand()%VIEW_SORT_TEXTURES);
+		pn_items_map.insert(pair<string, ModelItem*>(name, p_item));
+		q_items_v.push_back(p_item);
+	}
+
+	OrderView view;
+	map<string, Viewable*> pn_viewables_map;
+	double start = benchClock();
+	view.update(pn_items_map);
+	double insertNew = benchClock() - start;
+	updateOld(pn_items_map, pn_viewables_map);
+	for (unsigned int i=0;i<count;i++) // comme après la mise à jour des vues par un GLModel
+		q_items_v[i]->setModified(false);
+
+	unsigned int drawnNew = 0, drawnOld = 0;
+	start = benchClock();
+	for (unsigned int i=0;i<VIEW_SORT_FRAMES;i++)
+	{
+		view.display();
+		drawnNew = view.getCount();
+	}
+	double displayNew = (benchClock() - start) / VIEW_SORT_FRAMES;
+	start = benchClock();
+	for (unsigned int i=0;i<VIEW_SORT_FRAMES;i++)
+		drawnOld = displayOld(pn_viewables_map, 0);
+	double displayOld_ = (benchClock() - start) / VIEW_SORT_FRAMES;
+
+	for (unsigned int i=0;i<count;i+=VIEW_SORT_MOVED)
+	{
+		q_items_v[i]->setLayer(rand()%VIEW_SORT_LAYERS);
+		q_items_v[i]->setModified(true);
+	}
+	start = benchClock();
+	view.update(pn_items_map);
+	double updateNew = benchClock() - start;
+	updateOld(pn_items_map, pn_viewables_map);
+	for (unsigned int i=0;i<count;i+=VIEW_SORT_MOVED)
+		q_items_v[i]->setModified(false);
+
+	// les deux affichages doivent parcourir les mêmes Viewable dans le même ordre, comparés par nom
+	vector<const Viewable*> q_orderNew_v, q_orderOld_v;
+	view.setOrder(&q_orderNew_v);
+	view.display();
+	view.setOrder(0);
+	displayOld(pn_viewables_map, &q_orderOld_v);
+	bool same = (q_orderNew_v.size() == q_orderOld_v.size());
+	for (unsigned int i=0, size=q_orderNew_v.size();same && i<size;i++)
+		same = (q_orderNew_v[i]->getName() == q_orderOld_v[i]->getName() && q_orderNew_v[i]->getLayer() == q_orderOld_v[i]->getLayer());
+
+	cout << count << " Viewable, " << drawnNew << "/" << drawnOld << " affichés, ordre " << (same?"identique":"DIFFÉRENT") << "\n"
+		<< "\taffichage : " << displayOld_ << " ms en plusieurs passes, " << displayNew << " ms avec la liste triée\n"
+		<< "\tmise à jour de la liste triée : " << insertNew << " ms à la création, "
+		<< updateNew << " ms après le changement de plan de " << (count+VIEW_SORT_MOVED-1)/VIEW_SORT_MOVED << " Viewable\n";
+
+	for (map<string, Viewable*>::iterator it=pn_viewables_map.begin();it!=pn_viewables_map.end();++it)
+		delete it->second;
+	for (map<string, ModelItem*>::iterator it=pn_items_map.begin();it!=pn_items_map.end();++it)
+		delete it->second;
+}
+
+int viewSortBench(const vector<string>& args_v)
+{
+	if (args_v.empty())
+	{
+		sortBench(1000);
+		sortBench(10000);
+		sortBench(100000);
+	}
+	else
+	{
+		for (unsigned int i=0, size=args_v.size();i<size;i++)
+			sortBench(strtoul(args_v[i].c_str(), 0, 10));
+	}
+
+	return 0;
+}
@@ -0,0 +1,28 @@
+#include "bench.h"
+
+#include <iostream>
+#include <fstream>
+#include "wad.h"
+
+int wadReadBench(const vector<string>& args_v)
+{
+	string wadName = (args_v.empty())?"lacdorange":args_v[0];
+	string fileName = string(WAD_DIR) + wadName + "." + WAD_EXT;
+
+	ifstream ifs(fileName.c_str(), ios::binary | ios::ate);
+	double size = (ifs.is_open())?(double) ifs.tellg():0.0;
+	ifs.close();
+
+	// le wad est lu une seule fois par exécution, les wads lus restant en mémoire
+	unsigned long readCalls = benchReadCalls();
+	double start = benchClock();
+	{
+		PfWad wad(wadName);
+	}
+	double duration = benchClock() - start;
+	readCalls = benchReadCalls() - readCalls;
+
+	cout << fileName << " : " << size/(1024*1024) << " Mo, lecture " << duration << " ms, " << readCalls << " appels système de lecture\n";
+
+	return 0;
+}
@@ -23,8 +23,9 @@ void convertTxtToTex(const string& fileName)
 
 		// création du fichier
 
-		ofstream ofs(outputName.c_str(), ios::binary);
-		if (!ofs.is_open())
+		vector<char> buffer_v;
+		ofstream ofs;
+		if (!openBufferedBinaryFile(ofs, buffer_v, outputName))
 		{
 			ifs.close();
 			throw FileException(__LINE__, __FILE__, "impossible de créer le fichier.", outputName);
@@ -100,14 +101,11 @@ void convertTxtToTex(const string& fileName)
 
 				counter = 0;
 				str2 = str.substr(1);
-				for (int i=0;i<ENUM_PF_TEXTURE_SCRIPT_SECTION_COUNT;i++)
+				PfTextureScriptSection textureSection;
+				if (enumFrom(str2, textureSection))
 				{
-					if (str2 == textFrom((PfTextureScriptSection) i))
-					{
-						ofs.write((char*) &i, sizeof(int));
-						section = i;
-						break;
-					}
+					section = textureSection;
+					ofs.write((char*) &section, sizeof(int));
 				}
 			}
 			else
@@ -66,7 +66,6 @@ void addResToWad(ifstream& r_txtFile, ofstream& r_wadFile)
 	r_txtFile.seekg(0, ios::beg);
 
 	unsigned int size;
-	char c;
 
 	// Ajout des textures
 
@@ -92,13 +91,7 @@ void addResToWad(ifstream& r_txtFile, ofstream& r_wadFile)
 	size = g_sounds_map.size();
 	r_wadFile.write((char*) &size, sizeof(unsigned int));
 	for (map<string, int>::iterator it=g_sounds_map.begin();it!=g_sounds_map.end();it++)
-	{
-		const char* p_cstr = it->first.c_str();
-		for (unsigned int i=0, sz=it->first.size();i<sz;i++)
-			r_wadFile.write(p_cstr + i, sizeof(char));
-		c = '\0';
-		r_wadFile.write(&c, sizeof(char));
-	}
+		writeString(r_wadFile, it->first);
 }
 
 void addObjectsToWad(ifstream& r_txtFile, ofstream& r_wadFile, const string& fileName)
@@ -116,18 +109,13 @@ void addObjectsToWad(ifstream& r_txtFile, ofstream& r_wadFile, const string& fil
 		}
 		if (str.at(0) == '$')
 		{
-			for (i=0;i<ENUM_PF_WAD_SLOT_COUNT;i++)
-			{
-				if (textFrom((PfWadSlot) i) == str.substr(1))
-				{
-				    int tmp = NEW_SLOT_FLAG;
-				    r_wadFile.write((char*) &tmp, sizeof(int));
-					r_wadFile.write((char*) &i, sizeof(int));
-					break;
-				}
-			}
-			if (i == ENUM_PF_WAD_SLOT_COUNT)
+			PfWadSlot slot;
+			if (!enumFrom(str.substr(1), slot))
 				throw PfException(__LINE__, __FILE__, "Erreur dans le script : slot de wad attendu et non trouvé.");
+			int tmp = NEW_SLOT_FLAG;
+			r_wadFile.write((char*) &tmp, sizeof(int));
+			i = slot;
+			r_wadFile.write((char*) &i, sizeof(int));
             addPropertiesToObject(r_txtFile, r_wadFile, fileName);
 			addAnimsToObject(r_txtFile, r_wadFile, fileName);
 			i = END_OF_SECTION;
@@ -163,49 +151,39 @@ void addPropertiesToObject(ifstream& r_txtFile, ofstream& r_wadFile, const strin
         str = readString(r_txtFile, END_OF_LINE);
         posE = str.find_first_of("=");
 
-        for (i=0;i<ENUM_PF_WAD_OBJ_PROPERTY_COUNT;i++)
+        PfWadObjProperty property;
+        if (!enumFrom(str.substr(1, posE-1), property))
+            throw ScriptException(__LINE__, __FILE__, "erreur dans le script : propriété d'objet attendue et non trouvée.", fileName, str);
+        i = property;
+        r_wadFile.write((char*) &i, sizeof(int));
+
+        switch (property)
         {
-            if (str.substr(1, posE-1) == textFrom((PfWadObjProperty) i))
+        case WADOBJ_COLHEIGHT:
+            fTmp = atof(str.substr(posE+1).c_str());
+            r_wadFile.write((char*) &fTmp, sizeof(float));
+            break;
+        case WADOBJ_BOX:
+            str2 = str.substr(posE+1, str.find_first_of(";")-posE-1);
+            enumFrom(str2, boxType);
+            r_wadFile.write((char*) &boxType, sizeof(PfBoxType));
+            posTmp = str.find_first_of(";") + 1;
+            for (int k=0;k<4;k++)
             {
-                r_wadFile.write((char*) &i, sizeof(int));
-
-                switch ((PfWadObjProperty) i)
-                {
-                case WADOBJ_COLHEIGHT:
-                    fTmp = atof(str.substr(posE+1).c_str());
-                    r_wadFile.write((char*) &fTmp, sizeof(float));
-                    break;
-                case WADOBJ_BOX:
-                    str2 = str.substr(posE+1, str.find_first_of(";")-posE-1);
-                    for (int k=0;k<ENUM_PF_BOX_TYPE_COUNT;k++)
-                    {
-                        if (textFrom((PfBoxType) k) == str2)
-                            boxType = (PfBoxType) k;
-                    }
-                    r_wadFile.write((char*) &boxType, sizeof(PfBoxType));
-                    posTmp = str.find_first_of(";") + 1;
-                    for (int k=0;k<4;k++)
-                    {
-                        fTmp = atof(str.substr(posTmp, str.find_first_of(";", posTmp)-posTmp).c_str());
-                        posTmp = str.find_first_of(";", posTmp) + 1;
-                        r_wadFile.write((char*) &fTmp, sizeof(float));
-                    }
-                    break;
-                case WADOBJ_CENTER:
-                    fTmp = atof(str.substr(posE+1, str.find_first_of(";")-posE-1).c_str());
-                    r_wadFile.write((char*) &fTmp, sizeof(float));
-                    fTmp = atof(str.substr(str.find_first_of(";")+1).c_str());
-                    r_wadFile.write((char*) &fTmp, sizeof(float));
-                    break;
-                default:
-                    break;
-                }
-
-                break;
+                fTmp = atof(str.substr(posTmp, str.find_first_of(";", posTmp)-posTmp).c_str());
+                posTmp = str.find_first_of(";", posTmp) + 1;
+                r_wadFile.write((char*) &fTmp, sizeof(float));
             }
+            break;
+        case WADOBJ_CENTER:
+            fTmp = atof(str.substr(posE+1, str.find_first_of(";")-posE-1).c_str());
+            r_wadFile.write((char*) &fTmp, sizeof(float));
+            fTmp = atof(str.substr(str.find_first_of(";")+1).c_str());
+            r_wadFile.write((char*) &fTmp, sizeof(float));
+            break;
+        default:
+            break;
         }
-        if (i == ENUM_PF_WAD_OBJ_PROPERTY_COUNT)
-            throw ScriptException(__LINE__, __FILE__, "erreur dans le script : propriété d'objet attendue et non trouvée.", fileName, str);
     }
 }
 
@@ -259,15 +237,13 @@ void addAnimsToObject(ifstream& r_txtFile, ofstream& r_wadFile, const string& fi
 
 		if (str.at(0) == '[' && str.at(str.size()-1) == ']')
 		{
-			for (int i=0;i<ENUM_PF_ANIMATION_STATUS_COUNT;i++)
+			PfAnimationStatus readStatus;
+			if (enumFrom(str.substr(1, str.size()-2), readStatus))
 			{
-				if (str.substr(1, str.size()-2) == textFrom((PfAnimationStatus) i))
-				{
-					r_wadFile.write((char*) &i, sizeof(int));
-					r_wadFile.write((char*) &linesInAnim_v[readAnims], sizeof(int));
-					status = (PfAnimationStatus) i;
-					break;
-				}
+				int i = readStatus;
+				r_wadFile.write((char*) &i, sizeof(int));
+				r_wadFile.write((char*) &linesInAnim_v[readAnims], sizeof(int));
+				status = readStatus;
 			}
 			readAnims++;
 		}
@@ -359,11 +335,9 @@ void addAnimsToObject(ifstream& r_txtFile, ofstream& r_wadFile, const string& fi
 				{
 					str2 = str.substr(pos + 1, str.find_first_of(";", pos + 1) - pos - 1);
 					pos = str.find_first_of(";", pos + 1);
-					for (int k=0;k<ENUM_PF_MSC_VALUE_COUNT;k++)
-					{
-						if (str2 == textFrom((PfMscValue) k))
-							flags |= enumtopfflag32(k);
-					}
+					PfMscValue value;
+					if (enumFrom(str2, value))
+						flags |= value;
 				}
 				r_wadFile.write((char*) &flags, sizeof(int));
 
@@ -382,14 +356,7 @@ void addAnimsToObject(ifstream& r_txtFile, ofstream& r_wadFile, const string& fi
 				r_wadFile.write((char*) &option, sizeof(int));
 				str2 = str.substr(4, str.find_first_of(";")-4);
 				PfBoxType boxType = BOX_TYPE_COLLISION;
-				for (int i=0;i<ENUM_PF_BOX_TYPE_COUNT;i++)
-                {
-                    if (str2 == textFrom((PfBoxType) i))
-                    {
-                        boxType = (PfBoxType) i;
-                        break;
-                    }
-                }
+				enumFrom(str2, boxType);
                 r_wadFile.write((char*) &boxType, sizeof(PfBoxType));
                 str2 = str.substr(str.find_first_of(";")+1);
                 unsigned int val = atoi(str2.c_str());
@@ -463,8 +430,9 @@ void convertTxtToWad(const string& fileName)
 		string outputName = string(OBJ_DIR) + DIR_SEPARATOR + fileName.substr(fileName.find_last_of(DIR_SEPARATOR)+1, fileName.find('.')-fileName.find_last_of(DIR_SEPARATOR)-1) + ".wad";
 
 		// création du fichier
-		ofstream ofs(outputName.c_str(), ios::binary);
-		if (!ofs.is_open())
+		vector<char> buffer_v;
+		ofstream ofs;
+		if (!openBufferedBinaryFile(ofs, buffer_v, outputName))
 		{
 			ifs.close();
 			throw FileException(__LINE__, __FILE__, "impossible de créer le fichier.", outputName);
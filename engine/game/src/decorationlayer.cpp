@@ -0,0 +1,236 @@
+#include "decorationlayer.h"
+
+#include <algorithm>
+#include "misc.h"
+#include "errors.h"
+#include "viewable.h"
+#include "glimage.h"
+#include "mapobject.h"
+
+// comparaison exacte de deux rectangles, les rectangles d'un objet immobile étant recalculés à l'identique
+static bool sameRect(const PfRectangle& rc_a, const PfRectangle& rc_b)
+{
+	return rc_a.getX() == rc_b.getX() && rc_a.getY() == rc_b.getY() && rc_a.getW() == rc_b.getW() && rc_a.getH() == rc_b.getH();
+}
+
+static bool sameColor(const PfColor& rc_a, const PfColor& rc_b)
+{
+	return rc_a.getR() == rc_b.getR() && rc_a.getG() == rc_b.getG() && rc_a.getB() == rc_b.getB();
+}
+
+// ordre de regroupement des éléments d'un plan : par texture puis par couleur
+static bool instanceOrder(const DecorationInstance* q_a, const DecorationInstance* q_b)
+{
+	if (q_a->textureIndex != q_b->textureIndex)
+		return q_a->textureIndex < q_b->textureIndex;
+	if (q_a->color.getR() != q_b->color.getR())
+		return q_a->color.getR() < q_b->color.getR();
+	if (q_a->color.getG() != q_b->color.getG())
+		return q_a->color.getG() < q_b->color.getG();
+	return q_a->color.getB() < q_b->color.getB();
+}
+
+DecorationLayer::DecorationLayer(const string& name) : ModelItem(name) {}
+
+bool DecorationLayer::addObject(MapObject& r_object)
+{
+	if (!r_object.isDecoration() || r_object.isStatic() || !r_object.isCoordRelativeToBorder()
+		|| m_sources_map.find(r_object.getName()) != m_sources_map.end())
+		return false;
+
+	Source& r_source = m_sources_map[r_object.getName()];
+	r_source.q_object = &r_object;
+	readState(r_object, r_source);
+	refresh(r_source);
+
+	r_object.setDecorated(true);
+	r_object.setModified(true);
+	m_modified = true;
+
+	return true;
+}
+
+void DecorationLayer::removeObject(const MapObject& rc_object)
+{
+	map<string, Source>::iterator it = m_sources_map.find(rc_object.getName());
+	if (it == m_sources_map.end())
+		return;
+
+	markLayersDirty(it->second.instances_v);
+	m_sources_map.erase(it);
+	m_modified = true;
+}
+
+unsigned int DecorationLayer::instancesCount() const
+{
+	unsigned int rtn = 0;
+	for (map<string, Source>::const_iterator it=m_sources_map.begin();it!=m_sources_map.end();++it)
+		rtn += it->second.instances_v.size();
+
+	return rtn;
+}
+
+void DecorationLayer::update()
+{
+	Source state;
+	for (map<string, Source>::iterator it=m_sources_map.begin();it!=m_sources_map.end();++it)
+	{
+		readState(*(it->second.q_object), state);
+		if (!sameState(state, it->second))
+		{
+			readState(*(it->second.q_object), it->second);
+			refresh(it->second);
+		}
+	}
+
+	m_modified = !m_dirtyLayers_set.empty();
+}
+
+Viewable* DecorationLayer::generateViewable() const
+{
+	Viewable* p_rtn = new Viewable(m_name);
+	p_rtn->setVisible(true);
+
+	map<int, vector<const DecorationInstance*> > q_instances_v_map;
+	for (map<string, Source>::const_iterator it=m_sources_map.begin();it!=m_sources_map.end();++it)
+	{
+		for (unsigned int i=0, size=it->second.instances_v.size();i<size;i++)
+			q_instances_v_map[it->second.instances_v[i].layer].push_back(&(it->second.instances_v[i]));
+	}
+
+	try
+	{
+		for (map<int, vector<const DecorationInstance*> >::iterator it=q_instances_v_map.begin();it!=q_instances_v_map.end();++it)
+			p_rtn->addViewable(generateBatch(it->first, it->second));
+	}
+	catch (PfException& e)
+	{
+		delete p_rtn;
+		throw ViewableGenerationException(__LINE__, __FILE__, "Impossible de regrouper les éléments de décor.", getName(), e);
+	}
+
+	#ifdef DBG_DECORATIONS
+	if (g_debug)
+		g_dbInt_v_map["regenDecorations"].push_back(q_instances_v_map.size());
+	#endif
+
+	m_dirtyLayers_set.clear();
+
+	return p_rtn;
+}
+
+bool DecorationLayer::updateViewable(Viewable& r_viewable) const
+{
+	if (m_dirtyLayers_set.empty())
+		return true;
+
+	map<int, vector<const DecorationInstance*> > q_instances_v_map;
+	for (map<string, Source>::const_iterator it=m_sources_map.begin();it!=m_sources_map.end();++it)
+	{
+		for (unsigned int i=0, size=it->second.instances_v.size();i<size;i++)
+		{
+			if (m_dirtyLayers_set.find(it->second.instances_v[i].layer) != m_dirtyLayers_set.end())
+				q_instances_v_map[it->second.instances_v[i].layer].push_back(&(it->second.instances_v[i]));
+		}
+	}
+
+	#ifdef DBG_DECORATIONS
+	if (g_debug)
+		g_dbInt_v_map["regenDecorations"].push_back(m_dirtyLayers_set.size());
+	#endif
+
+	// les lots des plans modifiés sont remplacés, même vides, afin de conserver un Viewable lié par plan déjà utilisé
+	try
+	{
+		int layer;
+		for (unsigned int i=0, size=r_viewable.viewablesCount();i<size;i++)
+		{
+			layer = r_viewable.viewableAt(i)->getLayer();
+			if (m_dirtyLayers_set.erase(layer) > 0)
+				r_viewable.replaceViewable(i, generateBatch(layer, q_instances_v_map[layer]));
+		}
+		for (set<int>::const_iterator it=m_dirtyLayers_set.begin();it!=m_dirtyLayers_set.end();++it)
+		{
+			if (!q_instances_v_map[*it].empty())
+				r_viewable.addViewable(generateBatch(*it, q_instances_v_map[*it]));
+		}
+	}
+	catch (PfException& e)
+	{
+		m_dirtyLayers_set.clear();
+		throw ViewableGenerationException(__LINE__, __FILE__, "Impossible de regrouper les éléments de décor.", getName(), e);
+	}
+
+	m_dirtyLayers_set.clear();
+
+	return true;
+}
+
+void DecorationLayer::readState(const MapObject& rc_object, Source& r_source)
+{
+	const PfAnimationFrame& rc_frame = rc_object.getAnimationGroup().currentFrame();
+
+	r_source.rect = rc_object.getRect();
+	r_source.z = rc_object.getZ();
+	r_source.layer = rc_object.getLayer();
+	r_source.code = rc_object.getObjCode();
+	r_source.color = rc_object.getColor();
+	r_source.textureIndex = rc_frame.getTextureIndex();
+	r_source.coordRect = rc_frame.textCoordRectangle(rc_object.getOrientation());
+}
+
+bool DecorationLayer::sameState(const Source& rc_a, const Source& rc_b)
+{
+	return sameRect(rc_a.rect, rc_b.rect) && rc_a.z == rc_b.z && rc_a.layer == rc_b.layer && rc_a.code == rc_b.code
+		&& sameColor(rc_a.color, rc_b.color) && rc_a.textureIndex == rc_b.textureIndex && sameRect(rc_a.coordRect, rc_b.coordRect);
+}
+
+void DecorationLayer::refresh(Source& r_source)
+{
+	markLayersDirty(r_source.instances_v);
+	r_source.instances_v.clear();
+	r_source.q_object->decorationInstances(r_source.instances_v);
+	markLayersDirty(r_source.instances_v);
+}
+
+void DecorationLayer::markLayersDirty(const vector<DecorationInstance>& rc_instances_v)
+{
+	for (unsigned int i=0, size=rc_instances_v.size();i<size;i++)
+		m_dirtyLayers_set.insert(rc_instances_v[i].layer);
+}
+
+Viewable* DecorationLayer::generateBatch(int layer, vector<const DecorationInstance*>& q_instances_v) const
+{
+	Viewable* p_rtn = new Viewable(m_name + "_lot_" + itostr(layer));
+	p_rtn->setVisible(true);
+	p_rtn->changeLayer(layer);
+
+	// le tri est stable afin que les éléments d'une même série restent dans l'ordre des objets
+	stable_sort(q_instances_v.begin(), q_instances_v.end(), instanceOrder);
+
+	vector<PfRectangle> rects_v, coordRects_v;
+	try
+	{
+		for (unsigned int i=0, size=q_instances_v.size();i<size;)
+		{
+			rects_v.clear();
+			coordRects_v.clear();
+			unsigned int j = i;
+			for (;j<size && q_instances_v[j]->textureIndex == q_instances_v[i]->textureIndex
+					&& sameColor(q_instances_v[j]->color, q_instances_v[i]->color);j++)
+			{
+				rects_v.push_back(q_instances_v[j]->rect);
+				coordRects_v.push_back(q_instances_v[j]->coordRect);
+			}
+			p_rtn->addImage(new GLImage(rects_v, q_instances_v[i]->textureIndex, coordRects_v, rects_v.size(), q_instances_v[i]->color));
+			i = j;
+		}
+	}
+	catch (PfException& e)
+	{
+		delete p_rtn;
+		throw PfException(__LINE__, __FILE__, string("Impossible de regrouper les éléments de décor du plan ") + itostr(layer) + ".", e);
+	}
+
+	return p_rtn;
+}
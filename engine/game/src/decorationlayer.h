@@ -0,0 +1,195 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe DecorationLayer et ses éléments.
+* @date xx/xx/xxxx
+*/
+
+#ifndef DECORATIONLAYER_H_INCLUDED
+#define DECORATIONLAYER_H_INCLUDED
+
+#include "gen.h"
+
+#include <string>
+#include <map>
+#include <set>
+#include <vector>
+#include "modelitem.h"
+#include "geometry.h"
+
+class MapObject;
+
+/**
+* @brief Structure représentant un élément de décor : une image texturée rectangulaire à un plan de perspective.
+*/
+struct DecorationInstance
+{
+	/**
+	* @brief Constructeur DecorationInstance.
+	* @param r le rectangle de l'élément, en coordonnées de la map.
+	* @param t l'indice de texture de l'élément.
+	* @param c le fragment de texture de l'élément.
+	* @param col la couleur de l'élément.
+	* @param l le plan de perspective de l'élément.
+	*/
+	DecorationInstance(const PfRectangle& r, unsigned int t, const PfRectangle& c, const PfColor& col, int l) :
+		rect(r), textureIndex(t), coordRect(c), color(col), layer(l) {}
+
+	PfRectangle rect; //!< Le rectangle de l'élément, en coordonnées de la map.
+	unsigned int textureIndex; //!< L'indice de texture de l'élément.
+	PfRectangle coordRect; //!< Le fragment de texture de l'élément (case de la texture, convertie en région d'atlas par GLImage si besoin).
+	PfColor color; //!< La couleur de l'élément.
+	int layer; //!< Le plan de perspective de l'élément.
+};
+
+/**
+* @brief Couche de décor statique d'une map, affichant les éléments de décor de plusieurs MapObject.
+*
+* Les objets de décor (MapObject::isDecoration), comme les objets Jungle, Grass ou Fence, génèrent de nombreuses petites images.
+* Plutôt que d'être affichées chacune par un Viewable lié à celui de son objet, ces images sont décrites par des DecorationInstance,
+* conservées par cette couche, et regroupées pour chaque plan de perspective en une GLImage par texture et par couleur (constructeur GLImage 4).
+* Une map très végétalisée ne compte ainsi que quelques centaines de Viewable de décor, un par plan, au lieu de dizaines de milliers.
+*
+* Les objets ajoutés (DecorationLayer::addObject) sont marqués décorés (MapObject::setDecorated) : leur propre Viewable ne contient plus d'image.
+*
+* Rien n'est régénéré tant que le décor ne change pas.
+* A chaque mise à jour (DecorationLayer::update), l'état de chaque objet dont dépendent ses éléments (rectangle, altitude, plan, couleur,
+* code objet et frame en cours) est comparé à celui de la mise à jour précédente.
+* Seuls les éléments des objets modifiés sont recalculés, et seuls les plans de perspective concernés sont regroupés à nouveau
+* (DecorationLayer::updateViewable).
+*
+* @warning
+* Cette couche ne conserve pas les objets, qui doivent lui être retirés (DecorationLayer::removeObject) avant d'être détruits.
+*
+* @warning
+* Les plans à regrouper sont oubliés une fois le Viewable mis à jour : une couche ne doit être affichée que par une seule vue.
+*/
+class DecorationLayer : public ModelItem
+{
+	public:
+		/*
+		* Constructeurs et destructeur
+		* ----------------------------
+		*/
+		/**
+		* @brief Constructeur DecorationLayer.
+		* @param name le nom de cette couche.
+		*/
+		explicit DecorationLayer(const string& name = DECORATION_NAME);
+		/*
+		* Méthodes
+		* --------
+		*/
+		/**
+		* @brief Ajoute les éléments de décor d'un objet à cette couche.
+		* @param r_object l'objet.
+		* @return <code>false</code> si l'objet n'est pas un objet de décor (MapObject::isDecoration), s'il est statique,
+		* si ses coordonnées ne sont pas relatives aux bordures de la vue, ou s'il est déjà dans cette couche.
+		*
+		* L'objet est marqué décoré et modifié.
+		*/
+		bool addObject(MapObject& r_object);
+		/**
+		* @brief Retire les éléments de décor d'un objet de cette couche.
+		* @param rc_object l'objet.
+		*
+		* Si l'objet n'est pas dans cette couche, ne fait rien.
+		*/
+		void removeObject(const MapObject& rc_object);
+		/**
+		* @brief Retourne le nombre d'éléments de décor de cette couche.
+		* @return le nombre d'éléments.
+		*/
+		unsigned int instancesCount() const;
+		/*
+		* Redéfinitions
+		* -------------
+		*/
+		/**
+		* @brief Met à jour cette couche.
+		*
+		* Recalcule les éléments des objets dont l'état a changé depuis la mise à jour précédente,
+		* et marque cette couche modifiée si des plans de perspective sont à regrouper à nouveau.
+		*/
+		virtual void update();
+		/**
+		* @brief Génère un Viewable à partir de ce ModelItem.
+		* @return le Viewable créé.
+		* @throw ViewableGenerationException si les images d'un plan ne peuvent être regroupées.
+		*
+		* Le Viewable retourné ne contient aucune image. Il lui est lié un Viewable par plan de perspective (DecorationLayer::generateBatch).
+		*
+		* @warning
+		* De la mémoire est allouée pour le pointeur retourné.
+		*/
+		virtual Viewable* generateViewable() const;
+		/**
+		* @brief Met à jour sur place un Viewable généré par DecorationLayer::generateViewable.
+		* @param r_viewable le Viewable à mettre à jour.
+		* @return <code>true</code>.
+		* @throw ViewableGenerationException si les images d'un plan ne peuvent être regroupées.
+		*
+		* Seuls les Viewable liés des plans de perspective modifiés depuis la dernière mise à jour du Viewable sont remplacés.
+		* Les plans nouvellement utilisés sont ajoutés à la suite.
+		*/
+		virtual bool updateViewable(Viewable& r_viewable) const;
+
+	private:
+		/**
+		* @brief Structure regroupant un objet de cette couche, son état et ses éléments de décor.
+		*/
+		struct Source
+		{
+			MapObject* q_object; //!< L'objet.
+			PfRectangle rect; //!< Le rectangle de l'objet.
+			int z; //!< L'altitude de l'objet.
+			int layer; //!< Le plan de perspective de l'objet.
+			int code; //!< Le code objet.
+			PfColor color; //!< La couleur de l'objet.
+			unsigned int textureIndex; //!< L'indice de texture de la frame en cours.
+			PfRectangle coordRect; //!< Le fragment de texture de la frame en cours.
+			vector<DecorationInstance> instances_v; //!< Les éléments de décor de l'objet.
+		};
+
+		/**
+		* @brief Lit l'état d'un objet dont dépendent ses éléments de décor.
+		* @param rc_object l'objet.
+		* @param r_source la structure à remplir, dont seuls les champs d'état sont modifiés.
+		*/
+		static void readState(const MapObject& rc_object, Source& r_source);
+		/**
+		* @brief Compare les états de deux structures Source.
+		* @param rc_a la première structure.
+		* @param rc_b la seconde structure.
+		* @return <code>true</code> si les états sont identiques.
+		*/
+		static bool sameState(const Source& rc_a, const Source& rc_b);
+		/**
+		* @brief Recalcule les éléments de décor d'un objet.
+		* @param r_source la structure de l'objet, dont l'état doit être à jour.
+		*
+		* Les plans de perspective des éléments, avant et après recalcul, sont marqués à regrouper.
+		*/
+		void refresh(Source& r_source);
+		/**
+		* @brief Marque à regrouper les plans de perspective d'une liste d'éléments.
+		* @param rc_instances_v les éléments.
+		*/
+		void markLayersDirty(const vector<DecorationInstance>& rc_instances_v);
+		/**
+		* @brief Regroupe les éléments d'un plan de perspective dans un Viewable.
+		* @param layer le plan de perspective.
+		* @param q_instances_v les éléments de ce plan, dans l'ordre des objets.
+		* @return le Viewable contenant le lot.
+		* @throw PfException si les images ne peuvent être créées.
+		*
+		* Les éléments sont triés par texture puis par couleur, chaque série d'éléments de même texture et de même couleur
+		* étant rendue par une seule GLImage (constructeur GLImage 4).
+		*/
+		Viewable* generateBatch(int layer, vector<const DecorationInstance*>& q_instances_v) const;
+
+		map<string, Source> m_sources_map; //!< Les objets de cette couche, par nom.
+		mutable set<int> m_dirtyLayers_set; //!< Les plans de perspective à regrouper lors de la prochaine mise à jour du Viewable.
+};
+
+#endif // DECORATIONLAYER_H_INCLUDED
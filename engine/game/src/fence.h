@@ -64,6 +64,13 @@ public:
     * Pour cela, les box dfinies dans le wad sont utilises, normalement au nombre de trois pour une barrire.
     */
     virtual void update();
+    /**
+    * @brief Indique si cet objet est un objet de dcor.
+    * @return <code>true</code>.
+    *
+    * L'image de cet objet ne change qu'avec son code objet.
+    */
+    virtual bool isDecoration() const {return true;}
 
 protected:
     /*
@@ -22,7 +22,9 @@
 
 #ifndef NDEBUG
 #define DBG_MOVEZ // MapModel::moveZ
+//#define DBG_REGENCELLS // Map::generateViewable | Map::updateViewable
 //#define DBG_ADDOBJECTS // MapModel::MapModel | MapEditorModel::MapEditorModel | MapEditorModel::addObject
+//#define DBG_DECORATIONS // DecorationLayer::generateViewable | DecorationLayer::updateViewable
 #endif
 
 #define PFGAME_VERSION 0 //!< L'identifiant de version du jeu.
@@ -39,6 +41,7 @@
 #define SYSTEM_FILE_PREFIX "PF_" //!< Le préfixe des fichiers ressources système.
 
 #define MAP_NAME "zzMap2D" //!< Le nom d'un ModelItem Map : zz permet aux cases, à plan égal avec un objet, d'être affichées devant.
+#define DECORATION_NAME "DECORATION" //!< Le nom du ModelItem DecorationLayer d'une map, affichant les objets de décor.
 #define MAP_LAYER 500 //!< Le plan de perspective le plus en arrière d'une map 2D vue de haut.
 #define MAP_MAX_LINES_COUNT 100 //!< Le nombre maximal de lignes ou de colonnes d'une map.
 #define MAP_CELL_SIZE 0.08 //!< La taille d'une case de map.
@@ -52,5 +55,7 @@
 #define MAP_STEPS_PER_CELL 16 //!< Le nombre de pas par case.
 #define MAP_STEP_SIZE (MAP_CELL_SIZE/MAP_STEPS_PER_CELL) //!< La taille d'un pas horizontal en pixels.
 #define MAP_GRAVITY 1 //!< L'accélération de la pesanteur.
+#define MAP_TOPOLOGY_LOG_CELLS 1000 //!< Le nombre de cases modifiées à partir duquel la durée d'une modification de topologie est écrite dans le fichier log.
+#define MAP_PREFETCH_BUDGET (32*1024*1024) //!< La taille maximale en octets des fichiers map lus en tâche de fond (classe MapPrefetcher).
 
 #endif // GEN_H_INCLUDED
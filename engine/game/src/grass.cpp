@@ -4,6 +4,7 @@
 #include "glimage.h"
 #include "errors.h"
 #include "misc.h"
+#include "decorationlayer.h"
 
 Grass::Grass(const string& name, const PfRectangle& rect) : MapObject(name, rect)
 {
@@ -28,96 +29,68 @@ void Grass::generateElements(const Grass& rc_grass)
     m_rows_v = rc_grass.m_rows_v;
 }
 
-Viewable* Grass::generateViewable() const
+void Grass::rowInstances(unsigned int row, vector<DecorationInstance>& r_instances_v) const
 {
-    Viewable* p_rtn = new Viewable(getName(), PfRectangle(), getLayer(), 0, 0, PfRectangle(), PfColor::WHITE, isCoordRelativeToBorder(), isStatic());
-
     const PfAnimationFrame* pc_frame = &(getAnimationGroup().currentFrame());
-    GLImage *p_glImage, *p_glImage2;
-
+    unsigned int size = m_rows_v.size();
     int code = getObjCode();
+    bool mainLine = false, leftBorder = false, rightBorder = false;
 
-    bool mainLine, leftBorder, rightBorder;
-    for (unsigned int i=0, size=m_rows_v.size();i<size;i++)
+    if (code == 0 || ((code & PfOrientation::SOUTH) && row < size/8) || ((code & PfOrientation::NORTH) && row >= size*7/8))
+        mainLine = true;
+    else
     {
-        p_glImage = 0;
-        p_glImage2 = 0;
+        if (code & PfOrientation::EAST)
+            leftBorder = true;
+        else if ((code & PfOrientation::NORTH_EAST) && row >= size*7/8)
+            leftBorder = true;
+        else if ((code & PfOrientation::SOUTH_EAST) && row < size/8)
+            leftBorder = true;
+
+        if (code & PfOrientation::WEST)
+            rightBorder = true;
+        else if ((code & PfOrientation::NORTH_WEST) && row >= size*7/8)
+            rightBorder = true;
+        else if ((code & PfOrientation::SOUTH_WEST) && row < size/8)
+            rightBorder = true;
+    }
 
-        mainLine = false;
-        leftBorder = rightBorder = false;
+    PfRectangle rect(rect_x(), rect_y()+(float) row/size*rect_h(), rect_w(), rect_h());
+    float coordY = 1.0 - (m_rows_v[row]-1) * pc_frame->textCoordRectangle().getH();
+    float coordW = pc_frame->textCoordRectangle().getW(), coordH = pc_frame->textCoordRectangle().getH();
+    int layer = getLayer() - (int) (((float) row/size + FLOAT_MARGIN)*MAP_STEPS_PER_CELL) * MAP_MAX_HEIGHT + 1; // +1 pour le layer afin qu' Y gal les herbes soient devant
+
+    if (mainLine)
+        r_instances_v.push_back(DecorationInstance(rect, pc_frame->getTextureIndex(), PfRectangle(0.33, coordY, coordW, coordH), getColor(), layer));
+    if (leftBorder)
+        r_instances_v.push_back(DecorationInstance(rect, pc_frame->getTextureIndex(), PfRectangle(0.0, coordY, coordW, coordH), getColor(), layer));
+    if (rightBorder)
+        r_instances_v.push_back(DecorationInstance(rect, pc_frame->getTextureIndex(), PfRectangle(0.66, coordY, coordW, coordH), getColor(), layer));
+}
 
-        if (code == 0 || ((code & PfOrientation::SOUTH) && i < size/8) || ((code & PfOrientation::NORTH) && i >= size*7/8))
-            mainLine = true;
-        else
-        {
-            if (code & PfOrientation::EAST)
-                leftBorder = true;
-            else if ((code & PfOrientation::NORTH_EAST) && i >= size*7/8)
-                leftBorder = true;
-            else if ((code & PfOrientation::SOUTH_EAST) && i < size/8)
-                leftBorder = true;
-
-            if (code & PfOrientation::WEST)
-                rightBorder = true;
-            else if ((code & PfOrientation::NORTH_WEST) && i >= size*7/8)
-                rightBorder = true;
-            else if ((code & PfOrientation::SOUTH_WEST) && i < size/8)
-                rightBorder = true;
-        }
+void Grass::decorationInstances(vector<DecorationInstance>& r_instances_v) const
+{
+    for (unsigned int i=0, size=m_rows_v.size();i<size;i++)
+        rowInstances(i, r_instances_v);
+}
 
-        if (mainLine)
-        {
-            p_glImage = new GLImage(PfRectangle(rect_x(), rect_y()+(float) i/size*rect_h(), rect_w(), rect_h()),
-                                    pc_frame->getTextureIndex(),
-                                    PfRectangle(0.33, 1.0 - (m_rows_v[i]-1) * pc_frame->textCoordRectangle().getH(),
-                                                pc_frame->textCoordRectangle().getW(), pc_frame->textCoordRectangle().getH()),
-                                    getColor(), isCoordRelativeToBorder(), isStatic());
-        }
-        else
-        {
-            if (leftBorder)
-            {
-                p_glImage = new GLImage(PfRectangle(rect_x(), rect_y()+(float) i/size*rect_h(), rect_w(), rect_h()),
-                                        pc_frame->getTextureIndex(),
-                                        PfRectangle(0.0, 1.0 - (m_rows_v[i]-1) * pc_frame->textCoordRectangle().getH(),
-                                                    pc_frame->textCoordRectangle().getW(), pc_frame->textCoordRectangle().getH()),
-                                        getColor(), isCoordRelativeToBorder(), isStatic());
-            }
-            if (rightBorder)
-            {
-                if (!p_glImage)
-                {
-                    p_glImage = new GLImage(PfRectangle(rect_x(), rect_y()+(float) i/size*rect_h(), rect_w(), rect_h()),
-                                            pc_frame->getTextureIndex(),
-                                            PfRectangle(0.66, 1.0 - (m_rows_v[i]-1) * pc_frame->textCoordRectangle().getH(),
-                                                        pc_frame->textCoordRectangle().getW(), pc_frame->textCoordRectangle().getH()),
-                                            getColor(), isCoordRelativeToBorder(), isStatic());
-                }
-                else
-                {
-                    p_glImage2 = new GLImage(PfRectangle(rect_x(), rect_y()+(float) i/size*rect_h(), rect_w(), rect_h()),
-                                             pc_frame->getTextureIndex(),
-                                             PfRectangle(0.66, 1.0 - (m_rows_v[i]-1) * pc_frame->textCoordRectangle().getH(),
-                                                         pc_frame->textCoordRectangle().getW(), pc_frame->textCoordRectangle().getH()),
-                                             getColor(), isCoordRelativeToBorder(), isStatic());
-                }
-            }
-        }
-        if (p_glImage)
-        {
-            p_rtn->addViewable(new Viewable(getName() + "_row_" + itostr(i), *p_glImage,
-                                            getLayer() - (int) (((float) i/size + FLOAT_MARGIN)*MAP_STEPS_PER_CELL) * MAP_MAX_HEIGHT + 1));
-                                            // +1 pour le layer afin qu' Y gal les herbes soient devant
-        }
-        if (p_glImage2)
+Viewable* Grass::generateViewable() const
+{
+    if (isDecorated())
+        return MapObject::generateViewable();
+
+    Viewable* p_rtn = new Viewable(getName(), PfRectangle(), getLayer(), 0, 0, PfRectangle(), PfColor::WHITE, isCoordRelativeToBorder(), isStatic());
+
+    vector<DecorationInstance> instances_v;
+    for (unsigned int i=0, size=m_rows_v.size();i<size;i++)
+    {
+        instances_v.clear();
+        rowInstances(i, instances_v);
+        for (unsigned int j=0, size2=instances_v.size();j<size2;j++)
         {
-            p_rtn->addViewable(new Viewable(getName() + "_row_" + itostr(i) + "_2", *p_glImage2,
-                               getLayer() - (int) (((float) i/size + FLOAT_MARGIN)*MAP_STEPS_PER_CELL) * MAP_MAX_HEIGHT + 1));
+            GLImage gl(instances_v[j].rect, instances_v[j].textureIndex, instances_v[j].coordRect, instances_v[j].color, isCoordRelativeToBorder(), isStatic());
+            p_rtn->addViewable(new Viewable(getName() + "_row_" + itostr(i) + ((j==0)?"":"_2"), gl, instances_v[j].layer));
         }
-
-        delete p_glImage;
-        if (p_glImage2)
-            delete p_glImage2;
     }
 
     return p_rtn;
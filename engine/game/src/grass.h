@@ -78,6 +78,18 @@ class Grass : public MapObject
         * En fin de mthode, le vecteur Grass::m_rows_v est gal  celui du paramtre.
         */
         void generateElements(const Grass& rc_grass);
+        /**
+        * @brief Indique si cet objet est un objet de dcor.
+        * @return <code>true</code>.
+        */
+        virtual bool isDecoration() const {return true;}
+        /**
+        * @brief Ajoute  une liste les lments de dcor de cet objet.
+        * @param r_instances_v la liste  complter.
+        *
+        * Les lments de chaque range d'herbe sont ajouts dans l'ordre des ranges (Grass::rowInstances).
+        */
+        virtual void decorationInstances(vector<DecorationInstance>& r_instances_v) const;
 
         /*
         * Redfinitions
@@ -87,10 +99,22 @@ class Grass : public MapObject
         * @brief Gnre un Viewable  partir de ce ModelItem.
         * @return le Viewable cr.
         *
+        * Un Viewable li est gnr pour chaque lment de chaque range d'herbe (Grass::rowInstances).
+        *
+        * Si cet objet est dcor, appelle la mthode MapObject::generateViewable.
+        *
         * @warning
         * De la mmoire est alloue pour le pointeur retourn.
         */
         virtual Viewable* generateViewable() const;
+        /**
+        * @brief Met  jour sur place un Viewable gnr par Grass::generateViewable.
+        * @param r_viewable Le Viewable  mettre  jour.
+        * @return <code>false</code> si cet objet n'est pas dcor : les brins d'herbe sont toujours rgnrs.
+        *
+        * Si cet objet est dcor, appelle la mthode MapObject::updateViewable.
+        */
+        virtual bool updateViewable(Viewable& r_viewable) const {return (isDecorated() && MapObject::updateViewable(r_viewable));}
         /**
 		* @brief Srialise cet objet.
 		* @param r_ofs le flux en criture.
@@ -115,6 +139,15 @@ class Grass : public MapObject
 		virtual void loadData(DataPackage& r_data);
 
     private:
+        /**
+        * @brief Ajoute  une liste les lments d'une range d'herbe.
+        * @param row l'indice de la range.
+        * @param r_instances_v la liste  complter.
+        *
+        * Selon le code objet, la range compte la case du milieu, ou les cases de bordure gauche et droite, ou aucune case.
+        */
+        void rowInstances(unsigned int row, vector<DecorationInstance>& r_instances_v) const;
+
         vector<unsigned int> m_rows_v; //!< Les ranges d'herbe, chaque lment reprsentant une case de texture.
 };
 
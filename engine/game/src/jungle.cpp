@@ -5,6 +5,7 @@
 #include "errors.h"
 #include "misc.h"
 #include "map.h"
+#include "decorationlayer.h"
 
 Jungle::Jungle(const string& name, const PfRectangle& rect) : MapObject(name, rect)
 {
@@ -75,15 +76,12 @@ void Jungle::generateJungleElements(int minEleCount, int maxEleCount, float marg
     }
 }
 
-Viewable* Jungle::generateViewable() const
+void Jungle::decorationInstances(vector<DecorationInstance>& r_instances_v) const
 {
-    Viewable* p_rtn = new Viewable(getName(), PfRectangle(), getLayer(), 0, 0, PfRectangle(), PfColor::WHITE, isCoordRelativeToBorder(), isStatic());
-
     float x, y, w, h;
     const PfAnimationFrame* pc_frame = &(getAnimationGroup().currentFrame());
     int columns = (int) (1./(pc_frame->textCoordRectangle().getW()-FLOAT_MARGIN));
 
-    GLImage* p_gl;
     for (unsigned int i=0, size=m_elements_v.size();i<size;i++)
     {
         x = rect_x() + m_elements_v[i].rect.getX()*rect_w();
@@ -91,12 +89,27 @@ Viewable* Jungle::generateViewable() const
         w = m_elements_v[i].rect.getW()*rect_w();
         h = m_elements_v[i].rect.getH()*rect_h();
         PfRectangle r(x, y, w, h);
-        p_gl = new GLImage(r, pc_frame->getTextureIndex(),
-                           PfRectangle(((m_elements_v[i].textureIndex-1)%columns) * pc_frame->textCoordRectangle().getW(),
-                                        1.0 - ((m_elements_v[i].textureIndex-1)/columns+1) * pc_frame->textCoordRectangle().getH(),
-                                        pc_frame->textCoordRectangle().getW(), pc_frame->textCoordRectangle().getH()),
-                           getColor(), isCoordRelativeToBorder(), isStatic());
-        p_rtn->addViewable(new Viewable(getName()+"_ele"+itostr(i+1), *p_gl, Map::layerAt(r, getZ())));
+        r_instances_v.push_back(DecorationInstance(r, pc_frame->getTextureIndex(),
+                                                   PfRectangle(((m_elements_v[i].textureIndex-1)%columns) * pc_frame->textCoordRectangle().getW(),
+                                                               1.0 - ((m_elements_v[i].textureIndex-1)/columns+1) * pc_frame->textCoordRectangle().getH(),
+                                                               pc_frame->textCoordRectangle().getW(), pc_frame->textCoordRectangle().getH()),
+                                                   getColor(), Map::layerAt(r, getZ())));
+    }
+}
+
+Viewable* Jungle::generateViewable() const
+{
+    if (isDecorated())
+        return MapObject::generateViewable();
+
+    Viewable* p_rtn = new Viewable(getName(), PfRectangle(), getLayer(), 0, 0, PfRectangle(), PfColor::WHITE, isCoordRelativeToBorder(), isStatic());
+
+    vector<DecorationInstance> instances_v;
+    decorationInstances(instances_v);
+    for (unsigned int i=0, size=instances_v.size();i<size;i++)
+    {
+        GLImage gl(instances_v[i].rect, instances_v[i].textureIndex, instances_v[i].coordRect, instances_v[i].color, isCoordRelativeToBorder(), isStatic());
+        p_rtn->addViewable(new Viewable(getName()+"_ele"+itostr(i+1), gl, instances_v[i].layer));
     }
 
     return p_rtn;
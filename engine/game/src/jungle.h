@@ -99,6 +99,18 @@ class Jungle : public MapObject
         * Si la marge est de 0,25, un autre lment ne pourra pas tre pos de sorte que son centre soit plus proche de 0,25/2 du centre d'un autre lment.
         */
         void generateJungleElements(int minEleCount, int maxEleCount, float margin);
+        /**
+        * @brief Indique si cet objet est un objet de dcor.
+        * @return <code>true</code>.
+        */
+        virtual bool isDecoration() const {return true;}
+        /**
+        * @brief Ajoute  une liste les lments de dcor de cet objet.
+        * @param r_instances_v la liste  complter.
+        *
+        * Un lment est ajout par JungleElement, dans le fragment de texture dsign par son indice et au plan de perspective de son rectangle.
+        */
+        virtual void decorationInstances(vector<DecorationInstance>& r_instances_v) const;
 
         /*
         * Redfinitions
@@ -108,12 +120,22 @@ class Jungle : public MapObject
         * @brief Gnre un Viewable  partir de ce ModelItem.
         * @return le Viewable cr.
         *
-        * Une image est gnre pour chaque JungleElement de cet objet.
+        * Une image est gnre pour chaque JungleElement de cet objet (Jungle::decorationInstances).
+        *
+        * Si cet objet est dcor, appelle la mthode MapObject::generateViewable.
         *
         * @warning
         * De la mmoire est alloue pour le pointeur retourn.
         */
         virtual Viewable* generateViewable() const;
+        /**
+        * @brief Met  jour sur place un Viewable gnr par Jungle::generateViewable.
+        * @param r_viewable Le Viewable  mettre  jour.
+        * @return <code>false</code> si cet objet n'est pas dcor : les Viewable lis des JungleElement sont toujours rgnrs.
+        *
+        * Si cet objet est dcor, appelle la mthode MapObject::updateViewable.
+        */
+        virtual bool updateViewable(Viewable& r_viewable) const {return (isDecorated() && MapObject::updateViewable(r_viewable));}
         /**
 		* @brief Srialise cet objet.
 		* @param r_ofs le flux en criture.
@@ -24,6 +24,18 @@
 * Or, c'est faux, la texture de la police par exemple est définie dans le fichier "gen.h".
 * Il faut donc faire attention à donner des indices très élevés aux autres générateurs de textures potentiels, comme pour la police par exemple,
 * car les PfWad démarrent à 0.
+*
+* @subsection PointCacheWad Le cache des wads
+*
+* Chaque fichier WAD n'est lu qu'une fois durant l'exécution du programme : ses données sont conservées dans le cache PfWad::s_catalogs_map,
+* et ses textures et ses sons restent chargés.
+* Rouvrir un wad, par exemple lors d'un changement de map ou de menu, ne coûte donc qu'une recherche dans ce cache.
+* Le cache est vidé avant la fermeture de SDL, FMOD et OpenGL (fonction <em>closeEverything</em>).
+*
+* @subsection PointLectureMaps La lecture des maps liées
+*
+* Durant une partie, les fichiers des maps liées à la map en cours sont lus par un thread de travail (classe MapPrefetcher).
+* Lors du passage à l'une d'elles, seuls la map, ses objets et leurs Viewable restent à créer, par le thread propriétaire du contexte OpenGL.
 */
 
 #define SDL_MAIN_HANDLED // apparemment, sans ça, le main de SDL entre en conflit avec le mien
@@ -45,6 +57,7 @@
 #include "launcher.h"
 #include "menumvcsystem.h"
 #include "mapmvcsystem.h"
+#include "mapprefetcher.h"
 #include "mapeditormvcsystem.h"
 #include "wad.h"
 #include "datapackage.h"
@@ -54,6 +67,7 @@
 * @throw PfException si une erreur survient.
 *
 * Le modèle de sélection des niveaux est affiché, puis le jeu est lancé.
+* Les maps liées à la map en cours sont lues en tâche de fond par un MapPrefetcher commun à toute la partie.
 */
 void newGame()
 {
@@ -78,9 +92,10 @@ void newGame()
 			{
 				HIDE_CURSOR();
 				string mapName = files_v[val-1];
+				MapPrefetcher prefetcher;
 				while (mapName != "")
                 {
-                    MapMVCSystem* p_mapMVCSystem = new MapMVCSystem(mapName);
+                    MapMVCSystem* p_mapMVCSystem = new MapMVCSystem(mapName, &prefetcher);
                     p_mapMVCSystem->run();
                     DataPackage dp = p_mapMVCSystem->values();
                     mapName = dp.nextString();
@@ -278,6 +293,7 @@ int main(int argc, char* argv[])
 		LOG("Une erreur est survenue:\n" << e.what() << "\n");
 		try
 		{
+			PfWad::freeCatalogs();
 			closeEverything();
 		}
 		catch (PfException& e2)
@@ -293,6 +309,7 @@ int main(int argc, char* argv[])
 
 	try
 	{
+		PfWad::freeCatalogs();
 		closeEverything();
 	}
 	catch (PfException& e)
@@ -723,32 +723,21 @@ int Map::layerAt(const PfRectangle& rc_rect, int z)
 }
 
 Map::Map(unsigned int rows, unsigned int columns, const string& texName) :
-    GLItem(MAP_NAME, MAP_LAYER), m_rowsCount(rows), m_columnsCount(columns), m_seed(rand()), m_textureSet(texName), m_groundType(Map::MAP_GROUND_FLOOR)
+    GLItem(MAP_NAME, MAP_LAYER), m_rowsCount(rows), m_columnsCount(columns), m_seed(rand()), m_textureSet(texName), m_groundType(Map::MAP_GROUND_FLOOR), m_queryStamp(0)
 {
 	if (rows == 0 || columns == 0 || rows > MAP_MAX_LINES_COUNT || columns > MAP_MAX_LINES_COUNT)
 		throw ConstructorException(__LINE__, __FILE__, string("Dimensions invalides pour la map : rows = ") + itostr(rows) + " col = " + itostr(columns) + ".", "Map");
 
-	mp_cells_t2 = new Cell**[rows];
-	for (unsigned int i=0;i<rows;i++)
-	{
-		mp_cells_t2[i] = new Cell*[columns];
-		for (unsigned int j=0;j<columns;j++)
-			mp_cells_t2[i][j] = new Cell(i+1, j+1, 0, m_textureSet);
-	}
+	mp_cells_v.reserve(rows*columns);
 	for (unsigned int i=0;i<rows;i++)
 	{
 		for (unsigned int j=0;j<columns;j++)
-		{
-			for (int ori=PfOrientation::CARDINAL_NW;ori<=PfOrientation::CARDINAL_W;ori++)
-				mp_cells_t2[i][j]->assignNeighbour(nextConstCell(i+1, j+1, PfOrientation((PfOrientation::PfCardinalPoint) ori).toFlag()), (PfOrientation::PfCardinalPoint) ori);
-		}
+			mp_cells_v.push_back(new Cell(i+1, j+1, 0, m_textureSet));
 	}
-	m_objectsNames_v_t2 = new vector<string>*[rows];
-	for (unsigned int i=0;i<rows;i++)
-		m_objectsNames_v_t2[i] = new vector<string>[columns];
+	initializeCells();
 }
 
-Map::Map(DataPackage& r_data) : GLItem(MAP_NAME, MAP_LAYER), m_rowsCount(1), m_columnsCount(1), m_seed(0), m_textureSet(""), m_groundType(Map::MAP_GROUND_FLOOR)
+Map::Map(DataPackage& r_data) : GLItem(MAP_NAME, MAP_LAYER), m_rowsCount(1), m_columnsCount(1), m_seed(0), m_textureSet(""), m_groundType(Map::MAP_GROUND_FLOOR), m_queryStamp(0)
 {
 	try
 	{
@@ -764,9 +753,6 @@ Map::Map(DataPackage& r_data) : GLItem(MAP_NAME, MAP_LAYER), m_rowsCount(1), m_c
                 case SAVE_DIM:
                     m_rowsCount = r_data.nextUInt();
                     m_columnsCount = r_data.nextUInt();
-                    mp_cells_t2 = new Cell**[m_rowsCount];
-                    for (unsigned int i=0;i<m_rowsCount;i++)
-                        mp_cells_t2[i] = new Cell*[m_columnsCount];
                     break;
                 case SAVE_SEED:
                     m_seed = r_data.nextUInt();
@@ -775,11 +761,9 @@ Map::Map(DataPackage& r_data) : GLItem(MAP_NAME, MAP_LAYER), m_rowsCount(1), m_c
                     m_textureSet = PfMapTextureSet(r_data.nextString());
                     break;
                 case SAVE_CELLS:
-                    for (unsigned int i=0;i<m_rowsCount;i++)
-                    {
-                        for (unsigned int j=0;j<m_columnsCount;j++)
-                            mp_cells_t2[i][j] = new Cell(r_data, m_textureSet);
-                    }
+                    mp_cells_v.reserve(m_rowsCount*m_columnsCount);
+                    for (unsigned int i=0, size=m_rowsCount*m_columnsCount;i<size;i++)
+                        mp_cells_v.push_back(new Cell(r_data, m_textureSet));
                     break;
                 case SAVE_GROUNDTYPE:
                     m_groundType = (Map::MapGroundType) r_data.nextEnum();
@@ -803,18 +787,10 @@ Map::Map(DataPackage& r_data) : GLItem(MAP_NAME, MAP_LAYER), m_rowsCount(1), m_c
 
 		if (section < 0 || section > SAVE_END || r_data.isOver())
 			throw ConstructorException(__LINE__, __FILE__, "Données non valides.", "Map");
+		if (mp_cells_v.size() != m_rowsCount*m_columnsCount)
+			throw ConstructorException(__LINE__, __FILE__, "Nombre de cases non valide.", "Map");
 
-		for (unsigned int i=0;i<m_rowsCount;i++)
-		{
-			for (unsigned int j=0;j<m_columnsCount;j++)
-			{
-				for (int ori=PfOrientation::CARDINAL_NW;ori<=PfOrientation::CARDINAL_W;ori++)
-					mp_cells_t2[i][j]->assignNeighbour(nextConstCell(i+1, j+1, PfOrientation((PfOrientation::PfCardinalPoint) ori).toFlag()), (PfOrientation::PfCardinalPoint) ori);
-			}
-		}
-		m_objectsNames_v_t2 = new vector<string>*[m_rowsCount];
-		for (unsigned int i=0;i<m_rowsCount;i++)
-			m_objectsNames_v_t2[i] = new vector<string>[m_columnsCount];
+		initializeCells();
 	}
 	catch (PfException& e)
 	{
@@ -824,16 +800,8 @@ Map::Map(DataPackage& r_data) : GLItem(MAP_NAME, MAP_LAYER), m_rowsCount(1), m_c
 
 Map::~Map()
 {
-	for (unsigned int i=0;i<m_rowsCount;i++)
-	{
-		for (unsigned int j=0;j<m_columnsCount;j++)
-			delete mp_cells_t2[i][j];
-		delete [] mp_cells_t2[i];
-	}
-	delete [] mp_cells_t2;
-	for (unsigned int i=0;i<m_rowsCount;i++)
-		delete [] m_objectsNames_v_t2[i];
-	delete [] m_objectsNames_v_t2;
+	for (unsigned int i=0, size=mp_cells_v.size();i<size;i++)
+		delete mp_cells_v[i];
 }
 
 const Cell* Map::cell(unsigned int row, unsigned int col) const
@@ -844,7 +812,7 @@ const Cell* Map::cell(unsigned int row, unsigned int col) const
 	if (col == 0 || col > m_columnsCount)
 		throw ArgumentException(__LINE__, __FILE__, string("colonne non valide : ") + itostr(col) + " sur " + itostr(m_columnsCount) + ".", "col", "Map::cell");
 
-	return mp_cells_t2[row-1][col-1];
+	return mp_cells_v[cellIndex(row, col)];
 }
 
 const Cell* Map::cell(pair<unsigned int, unsigned int> coord) const
@@ -856,20 +824,50 @@ vector<pair<unsigned int, unsigned int> > Map::cellsCoord(const PfRectangle& rec
 {
 	vector<pair<unsigned int, unsigned int> > rtn_v;
 
-	float x1 = MAX(0, rect.getX()) + FLOAT_MARGIN;
-	float x2 = MIN(MAP_CELL_SIZE*m_columnsCount, rect.getX() + rect.getW()) - FLOAT_MARGIN;
-	float y1 = MAX(0, rect.getY()-(float) (z-MAP_CELL_SQUARE_HEIGHT)/MAP_CELL_SQUARE_HEIGHT*MAP_CELL_SIZE) + FLOAT_MARGIN;
-	float y2 = MIN(MAP_CELL_SIZE*m_rowsCount, rect.getY() + rect.getH()-(float) (z-MAP_CELL_SQUARE_HEIGHT)/MAP_CELL_SQUARE_HEIGHT*MAP_CELL_SIZE) - FLOAT_MARGIN;
-
-	for (unsigned int i=(unsigned int) (y1/MAP_CELL_SIZE+FLOAT_MARGIN)+1, size=(unsigned int) (y2/MAP_CELL_SIZE-FLOAT_MARGIN)+1;i<=size;i++)
+	unsigned int row1, row2, col1, col2;
+	cellsBounds(rect, z, row1, row2, col1, col2);
+	for (unsigned int i=row1;i<=row2;i++)
 	{
-		for (unsigned int j=(unsigned int) (x1/MAP_CELL_SIZE+FLOAT_MARGIN)+1, size2=(unsigned int) (x2/MAP_CELL_SIZE-FLOAT_MARGIN)+1;j<=size2;j++)
+		for (unsigned int j=col1;j<=col2;j++)
 			rtn_v.push_back(pair<unsigned int, unsigned int>(i, j));
 	}
 
 	return rtn_v;
 }
 
+void Map::objectsInRect(const PfRectangle& rect, int z, vector<unsigned int>& r_handles_v) const
+{
+	r_handles_v.clear();
+
+	// chaque objet est marqué du numéro de cette recherche lorsqu'il est ajouté, ce qui évite les doublons sans recherche dans la liste
+	if (++m_queryStamp == 0)
+	{
+		m_objectsStamps_v.assign(m_objectsStamps_v.size(), 0);
+		m_queryStamp = 1;
+	}
+	if (m_objectsStamps_v.size() < m_objectsNames_v.size())
+		m_objectsStamps_v.resize(m_objectsNames_v.size(), 0);
+
+	unsigned int row1, row2, col1, col2, handle;
+	cellsBounds(rect, z, row1, row2, col1, col2);
+	for (unsigned int i=row1;i<=row2;i++)
+	{
+		for (unsigned int j=col1;j<=col2;j++)
+		{
+			const vector<unsigned int>& handles_v = m_cellsObjects_v_v[cellIndex(i, j)];
+			for (unsigned int k=0, size=handles_v.size();k<size;k++)
+			{
+				handle = handles_v[k];
+				if (m_objectsStamps_v[handle] != m_queryStamp)
+				{
+					m_objectsStamps_v[handle] = m_queryStamp;
+					r_handles_v.push_back(handle);
+				}
+			}
+		}
+	}
+}
+
 Cell* Map::nextCell(unsigned int row, unsigned int col, pfflag orientation)
 {
 	if (row == 0 || row > m_rowsCount)
@@ -890,7 +888,7 @@ Cell* Map::nextCell(unsigned int row, unsigned int col, pfflag orientation)
 
 	if (r <= 0 || c <= 0 || (unsigned int) r > m_rowsCount || (unsigned int) c > m_columnsCount)
 		return 0;
-	return mp_cells_t2[r-1][c-1];
+	return mp_cells_v[cellIndex(r, c)];
 }
 
 const Cell* Map::nextConstCell(unsigned int row, unsigned int col, pfflag orientation) const
@@ -913,7 +911,7 @@ const Cell* Map::nextConstCell(unsigned int row, unsigned int col, pfflag orient
 
 	if (r <= 0 || c <= 0 || (unsigned int) r > m_rowsCount || (unsigned int) c > m_columnsCount)
 		return 0;
-	return mp_cells_t2[r-1][c-1];
+	return mp_cells_v[cellIndex(r, c)];
 }
 
 void Map::changeCell(unsigned int row, unsigned int col, int terrainIndex, int z)
@@ -923,7 +921,9 @@ void Map::changeCell(unsigned int row, unsigned int col, int terrainIndex, int z
 	if (col == 0 || col > m_columnsCount)
 		throw ArgumentException(__LINE__, __FILE__, string("colonne non valide : ") + itostr(col) + " sur " + itostr(m_columnsCount) + ".", "col", "Map::changeCell");
 
-	mp_cells_t2[row-1][col-1]->modify(terrainIndex, (z>=0)?z:mp_cells_t2[row-1][col-1]->getZ());
+	mp_cells_v[cellIndex(row, col)]->modify(terrainIndex, (z>=0)?z:m_cellsZ_v[cellIndex(row, col)]);
+	markCellDirty(row, col);
+	refreshCellsData(row, col);
 
 	m_modified = true;
 }
@@ -935,7 +935,9 @@ void Map::changeCellSlope(unsigned int row, unsigned int col, PfOrientation::PfC
 	if (col == 0 || col > m_columnsCount)
 		throw ArgumentException(__LINE__, __FILE__, string("colonne non valide : ") + itostr(col) + " sur " + itostr(m_columnsCount) + ".", "col", "Map::changeCellSlope");
 
-	mp_cells_t2[row-1][col-1]->changeSlope(slopeOri, deltaSlope, forceOri);
+	mp_cells_v[cellIndex(row, col)]->changeSlope(slopeOri, deltaSlope, forceOri);
+	markCellDirty(row, col);
+	refreshCellsData(row, col);
 
 	m_modified = true;
 }
@@ -945,14 +947,40 @@ vector<string> Map::objectsOnCell(pair<unsigned int, unsigned int> coord_pair) c
 	if (coord_pair.first == 0 || coord_pair.first > m_rowsCount || coord_pair.second == 0 || coord_pair.second > m_columnsCount)
 		throw ArgumentException(__LINE__, __FILE__, string("Coordonnées invalides : ") + itostr(coord_pair.first) + ";" + itostr(coord_pair.second)  + ".", "coord_pair", "Map::objectsOnCell");
 
-	vector<string> rtn_v;
+	const vector<unsigned int>& handles_v = m_cellsObjects_v_v[cellIndex(coord_pair.first, coord_pair.second)];
+	vector<string> rtn_v(handles_v.size());
 
-	for (unsigned int i=0, size=m_objectsNames_v_t2[coord_pair.first-1][coord_pair.second-1].size();i<size;i++)
-		rtn_v.push_back(m_objectsNames_v_t2[coord_pair.first-1][coord_pair.second-1][i]);
+	for (unsigned int i=0, size=handles_v.size();i<size;i++)
+		rtn_v[i] = m_objectsNames_v[handles_v[i]];
 
 	return rtn_v;
 }
 
+const vector<unsigned int>& Map::objectHandlesOnCell(pair<unsigned int, unsigned int> coord_pair) const
+{
+	if (coord_pair.first == 0 || coord_pair.first > m_rowsCount || coord_pair.second == 0 || coord_pair.second > m_columnsCount)
+		throw ArgumentException(__LINE__, __FILE__, string("Coordonnées invalides : ") + itostr(coord_pair.first) + ";" + itostr(coord_pair.second)  + ".", "coord_pair", "Map::objectHandlesOnCell");
+
+	return m_cellsObjects_v_v[cellIndex(coord_pair.first, coord_pair.second)];
+}
+
+const string& Map::objectName(unsigned int handle) const
+{
+	if (handle >= m_objectsNames_v.size() || m_objectsNames_v[handle].empty())
+		throw ArgumentException(__LINE__, __FILE__, string("Identifiant d'objet non valide : ") + itostr(handle) + ".", "handle", "Map::objectName");
+
+	return m_objectsNames_v[handle];
+}
+
+unsigned int Map::objectHandle(const string& name) const
+{
+	map<string, unsigned int>::const_iterator it = m_objectsHandles_map.find(name);
+	if (it == m_objectsHandles_map.end())
+		throw ArgumentException(__LINE__, __FILE__, string("L'objet ") + name + " n'est pas sur cette map.", "name", "Map::objectHandle");
+
+	return it->second;
+}
+
 void Map::addObject(MapObject& r_object, unsigned int row, unsigned int col)
 {
 	int z = 0;
@@ -996,10 +1024,7 @@ void Map::addObject(MapObject& r_object, unsigned int row, unsigned int col)
 	r_object.changeZ(z);
 	bool hasColl = (r_object.zone(BOX_TYPE_COLLISION) != 0);
 	r_object.setLayer(layerAt(hasColl?r_object.zone(BOX_TYPE_COLLISION)->getRect():r_object.getRect(), r_object.getZ()));
-	m_cellsUnderObjects_v_map[r_object.getName()] = cellsCoord(r_object.getRect(), z);
-	vector<pair<unsigned int, unsigned int> >* p_v = &(m_cellsUnderObjects_v_map[r_object.getName()]); // pour la facilité
-	for (unsigned int i=0, size=p_v->size();i<size;i++)
-		m_objectsNames_v_t2[(*p_v)[i].first-1][(*p_v)[i].second-1].push_back(r_object.getName());
+	placeObject(r_object.getName(), cellsCoord(r_object.getRect(), z));
 	r_object.setModified(true);
 }
 
@@ -1014,28 +1039,22 @@ void Map::removeObjects(const PfRectangle& rect, int z)
 void Map::removeObjects(const pair<unsigned int, unsigned int>& coord_pair)
 {
 	// suppression par la méthode des noms pour que toute autre case contenant cet objet soit également vidée.
-	removeObjects(m_objectsNames_v_t2[coord_pair.first-1][coord_pair.second-1]);
+	removeObjects(objectsOnCell(coord_pair));
 }
 
 void Map::removeObjects(const vector<string> names_v)
 {
+	map<string, unsigned int>::iterator handleIt;
 	for (vector<string>::const_iterator namesIt=names_v.begin();namesIt!=names_v.end();++namesIt)
 	{
-		if (m_cellsUnderObjects_v_map.find(*namesIt) == m_cellsUnderObjects_v_map.end())
+		handleIt = m_objectsHandles_map.find(*namesIt);
+		if (handleIt == m_objectsHandles_map.end())
 			throw ArgumentException(__LINE__, __FILE__, "L'un des éléments de la liste n'est pas trouvable lors de la suppression d'un objet de la map par son nom.", "r_names_v", "Map::removeObjects");
 
-		for (vector<pair<unsigned int, unsigned int> >::iterator cellsIt=m_cellsUnderObjects_v_map[*namesIt].begin();cellsIt!=m_cellsUnderObjects_v_map[*namesIt].end();++cellsIt)
-		{
-			for (vector<string>::iterator deleteIt=m_objectsNames_v_t2[cellsIt->first-1][cellsIt->second-1].begin();deleteIt!=m_objectsNames_v_t2[cellsIt->first-1][cellsIt->second-1].end();++deleteIt)
-			{
-				if (*namesIt == *deleteIt)
-				{
-					m_objectsNames_v_t2[cellsIt->first-1][cellsIt->second-1].erase(deleteIt);
-					break;
-				}
-			}
-		}
-		m_cellsUnderObjects_v_map.erase(*namesIt);
+		unplaceObject(handleIt->second);
+		m_objectsNames_v[handleIt->second] = "";
+		m_freeHandles_v.push_back(handleIt->second);
+		m_objectsHandles_map.erase(handleIt);
 	}
 }
 
@@ -1048,11 +1067,12 @@ void Map::removeObject(const string& name)
 
 void Map::updateObjectPosition(MapObject& r_object)
 {
-    removeObject(r_object.getName());
-    m_cellsUnderObjects_v_map[r_object.getName()] = cellsCoord(r_object.getRect(), r_object.getZ());
-	vector<pair<unsigned int, unsigned int> >* p_v = &(m_cellsUnderObjects_v_map[r_object.getName()]); // pour la facilité
-	for (unsigned int i=0, size=p_v->size();i<size;i++)
-		m_objectsNames_v_t2[(*p_v)[i].first-1][(*p_v)[i].second-1].push_back(r_object.getName());
+	map<string, unsigned int>::const_iterator handleIt = m_objectsHandles_map.find(r_object.getName());
+	if (handleIt == m_objectsHandles_map.end())
+		throw ArgumentException(__LINE__, __FILE__, string("L'objet ") + r_object.getName() + " n'est pas sur cette map.", "r_object", "Map::updateObjectPosition");
+
+	unplaceObject(handleIt->second);
+	placeObject(r_object.getName(), cellsCoord(r_object.getRect(), r_object.getZ()));
 }
 
 int Map::stepsBeforeCollision(const PfRectangle& pathRect, PfOrientation::PfOrientationValue orientation, int z) const
@@ -1096,7 +1116,7 @@ int Map::stepsBeforeCollision(const PfRectangle& pathRect, PfOrientation::PfOrie
 				tmp = 0;
 				for (int i=firstCell-1;i>0;i--)
 				{
-					if (cell(i, col)->zAt(PfOrientation::CARDINAL_N, true) <= MAX(z, cell(i+1, col)->zAt(PfOrientation::CARDINAL_S, true)))
+					if (cornerZ(i, col, PfOrientation::CARDINAL_N) <= MAX(z, cornerZ(i+1, col, PfOrientation::CARDINAL_S)))
 						tmp += MAP_STEPS_PER_CELL;
 					else
 						break;
@@ -1113,7 +1133,7 @@ int Map::stepsBeforeCollision(const PfRectangle& pathRect, PfOrientation::PfOrie
 				tmp = 0;
 				for (int i=firstCell-1;i>0;i--)
 				{
-					if (cell(row, i)->zAt(PfOrientation::CARDINAL_E, true) <= MAX(z, cell(row, i+1)->zAt(PfOrientation::CARDINAL_W, true)))
+					if (cornerZ(row, i, PfOrientation::CARDINAL_E) <= MAX(z, cornerZ(row, i+1, PfOrientation::CARDINAL_W)))
 						tmp += MAP_STEPS_PER_CELL;
 					else
 						break;
@@ -1130,7 +1150,7 @@ int Map::stepsBeforeCollision(const PfRectangle& pathRect, PfOrientation::PfOrie
 				tmp = 0;
 				for (int i=firstCell+1;i<=(int)m_rowsCount;i++)
 				{
-					if (cell(i, col)->zAt(PfOrientation::CARDINAL_S, true) <= MAX(z, cell(i-1, col)->zAt(PfOrientation::CARDINAL_N, true)))
+					if (cornerZ(i, col, PfOrientation::CARDINAL_S) <= MAX(z, cornerZ(i-1, col, PfOrientation::CARDINAL_N)))
 						tmp += MAP_STEPS_PER_CELL;
 					else
 						break;
@@ -1147,7 +1167,7 @@ int Map::stepsBeforeCollision(const PfRectangle& pathRect, PfOrientation::PfOrie
 				tmp = 0;
 				for (int i=firstCell+1;i<=(int)m_columnsCount;i++)
 				{
-					if (cell(row, i)->zAt(PfOrientation::CARDINAL_W, true) <= MAX(z, cell(row, i-1)->zAt(PfOrientation::CARDINAL_E, true)))
+					if (cornerZ(row, i, PfOrientation::CARDINAL_W) <= MAX(z, cornerZ(row, i-1, PfOrientation::CARDINAL_E)))
 						tmp += MAP_STEPS_PER_CELL;
 					else
 						break;
@@ -1177,13 +1197,12 @@ int Map::zStepsForNextCell(unsigned int row, unsigned int col, pfflag32 ori) con
 	if (col == 0 || col > m_columnsCount)
 		throw ArgumentException(__LINE__, __FILE__, string("Coordonnées non valides : (") + itostr(row) + ";" + itostr(col) + ").", "col", "Map::zStepsForNextCell");
 
-	const Cell* pc_cell = mp_cells_t2[row-1][col-1];
 	const Cell* pc_nextCell = nextConstCell(row, col, ori);
 
 	if (pc_nextCell == 0)
 		return 0;
 
-	return pc_nextCell->getZ() - pc_cell->getZ();
+	return m_cellsZ_v[cellIndex(pc_nextCell->getRow(), pc_nextCell->getCol())] - m_cellsZ_v[cellIndex(row, col)];
 }
 
 unsigned int Map::mapLinksCount() const
@@ -1253,6 +1272,7 @@ unsigned int Map::scriptEntriesCount() const
 void Map::update()
 {
 	m_modified = false;
+	m_dirtyCells_set.clear();
 }
 
 Viewable* Map::generateViewable() const
@@ -1260,6 +1280,7 @@ Viewable* Map::generateViewable() const
 	Viewable* p_return = new Viewable(m_name);
 	p_return->setVisible(true);
 	Viewable* p_tmp;
+	map<int, vector<const Viewable*> > q_cells_v_map;
 
 	for (unsigned int i=0;i<m_rowsCount;i++)
 	{
@@ -1267,20 +1288,108 @@ Viewable* Map::generateViewable() const
 		{
 			try
 			{
-				p_tmp = mp_cells_t2[i][j]->generateViewable();
-				p_return->addViewable(p_tmp);
+				p_tmp = mp_cells_v[i*m_columnsCount+j]->generateViewable();
 			}
 			catch (PfException& e)
 			{
 				throw ViewableGenerationException(__LINE__, __FILE__, string("Impossible de générer la case aux coordonnées (") + itostr(i+1) + ";" + itostr(j+1) + ").",
 													getName() + ",case("+itostr(i+1)+";"+itostr(j+1)+").", e);
 			}
+			p_tmp->setVisible(false); // les images de la case sont affichées par le lot de son plan de perspective
+			p_return->addViewable(p_tmp);
+			if (p_tmp->imagesCount() > 0)
+				q_cells_v_map[p_tmp->getLayer()].push_back(p_tmp);
 		}
 	}
 
+	try
+	{
+		for (map<int, vector<const Viewable*> >::const_iterator it=q_cells_v_map.begin();it!=q_cells_v_map.end();++it)
+			p_return->addViewable(generateBatch(it->first, it->second));
+	}
+	catch (PfException& e)
+	{
+		throw ViewableGenerationException(__LINE__, __FILE__, "Impossible de regrouper les images des cases.", getName(), e);
+	}
+
+	#ifdef DBG_REGENCELLS
+	if (g_debug)
+		g_dbInt_v_map["regenCells"].push_back(m_rowsCount*m_columnsCount);
+	#endif
+
 	return p_return;
 }
 
+bool Map::updateViewable(Viewable& r_viewable) const
+{
+	unsigned int cellsCount = m_rowsCount*m_columnsCount;
+	if (m_dirtyCells_set.empty() || r_viewable.viewablesCount() < cellsCount)
+		return false;
+
+	// régénération des cases modifiées, en notant les plans de perspective concernés avant et après modification
+
+	set<int> layers_set;
+	unsigned int row, col, index;
+	Viewable* p_tmp;
+	for (set<pair<unsigned int, unsigned int> >::const_iterator it=m_dirtyCells_set.begin();it!=m_dirtyCells_set.end();++it)
+	{
+		row = it->first;
+		col = it->second;
+		index = cellIndex(row, col);
+		try
+		{
+			layers_set.insert(r_viewable.viewableAt(index)->getLayer());
+			p_tmp = mp_cells_v[index]->generateViewable();
+			p_tmp->setVisible(false);
+			layers_set.insert(p_tmp->getLayer());
+			r_viewable.replaceViewable(index, p_tmp);
+		}
+		catch (PfException& e)
+		{
+			throw ViewableGenerationException(__LINE__, __FILE__, string("Impossible de régénérer la case aux coordonnées (") + itostr(row) + ";" + itostr(col) + ").",
+												getName() + ",case("+itostr(row)+";"+itostr(col)+").", e);
+		}
+	}
+
+	// reconstruction des lots des plans concernés
+
+	map<int, vector<const Viewable*> > q_cells_v_map;
+	const Viewable* q_vw;
+	for (unsigned int i=0;i<cellsCount;i++)
+	{
+		q_vw = r_viewable.viewableAt(i);
+		if (q_vw->imagesCount() > 0 && layers_set.find(q_vw->getLayer()) != layers_set.end())
+			q_cells_v_map[q_vw->getLayer()].push_back(q_vw);
+	}
+
+	try
+	{
+		int layer;
+		for (unsigned int i=cellsCount, size=r_viewable.viewablesCount();i<size;i++)
+		{
+			layer = r_viewable.viewableAt(i)->getLayer();
+			if (layers_set.erase(layer) > 0)
+				r_viewable.replaceViewable(i, generateBatch(layer, q_cells_v_map[layer]));
+		}
+		for (set<int>::const_iterator it=layers_set.begin();it!=layers_set.end();++it)
+		{
+			if (!q_cells_v_map[*it].empty())
+				r_viewable.addViewable(generateBatch(*it, q_cells_v_map[*it]));
+		}
+	}
+	catch (PfException& e)
+	{
+		throw ViewableGenerationException(__LINE__, __FILE__, "Impossible de regrouper les images des cases.", getName(), e);
+	}
+
+	#ifdef DBG_REGENCELLS
+	if (g_debug)
+		g_dbInt_v_map["regenCells"].push_back(m_dirtyCells_set.size());
+	#endif
+
+	return true;
+}
+
 void Map::saveData(ofstream& r_ofs) const
 {
 	WRITE_ENUM(r_ofs, SAVE_DIM);
@@ -1294,11 +1403,8 @@ void Map::saveData(ofstream& r_ofs) const
 	WRITE_STRING(r_ofs, m_textureSet.getName());
 
 	WRITE_ENUM(r_ofs, SAVE_CELLS);
-	for (unsigned int i=0;i<m_rowsCount;i++)
-	{
-		for (unsigned int j=0;j<m_columnsCount;j++)
-			mp_cells_t2[i][j]->saveData(r_ofs);
-	}
+	for (unsigned int i=0, size=mp_cells_v.size();i<size;i++)
+		mp_cells_v[i]->saveData(r_ofs);
 
 	WRITE_ENUM(r_ofs, SAVE_GROUNDTYPE);
 	WRITE_ENUM(r_ofs, m_groundType);
@@ -1322,6 +1428,79 @@ void Map::saveData(ofstream& r_ofs) const
 	WRITE_ENUM(r_ofs, SAVE_END);
 }
 
+Viewable* Map::generateBatch(int layer, const vector<const Viewable*>& q_cells_v) const
+{
+	Viewable* p_rtn = new Viewable(m_name + "_lot_" + itostr(layer));
+	p_rtn->setVisible(true);
+	p_rtn->changeLayer(layer);
+
+	vector<vector<const GLImage*> > q_groups_v; // groupes d'images rendues en un appel, dans l'ordre d'affichage
+	vector<vector<PfRectangle> > boxes_v_v; // rectangles englobants des images de chaque groupe
+	map<unsigned int, unsigned int> lastGroups_map; // dernier groupe de chaque texture
+	const GLImage* q_img;
+	try
+	{
+		for (unsigned int i=0, size=q_cells_v.size();i<size;i++)
+		{
+			for (unsigned int j=0, size2=q_cells_v[i]->imagesCount();j<size2;j++)
+			{
+				q_img = &(q_cells_v[i]->imageAt(j));
+				PfRectangle box = q_img->boundingBox();
+				unsigned int group = q_groups_v.size();
+				map<unsigned int, unsigned int>::const_iterator it = lastGroups_map.find(q_img->getTextureIndex());
+				if (q_img->isBatchable() && it != lastGroups_map.end())
+				{
+					// l'image rejoint le dernier groupe de sa texture si elle ne recouvre aucune image affichée après lui
+					group = it->second;
+					for (unsigned int k=it->second+1, size3=q_groups_v.size();k<size3 && group!=size3;k++)
+					{
+						for (unsigned int l=0, size4=boxes_v_v[k].size();l<size4;l++)
+						{
+							if (box.contains(boxes_v_v[k][l], false))
+							{
+								group = size3;
+								break;
+							}
+						}
+					}
+				}
+				if (group == q_groups_v.size())
+				{
+					q_groups_v.push_back(vector<const GLImage*>());
+					boxes_v_v.push_back(vector<PfRectangle>());
+					if (q_img->isBatchable())
+						lastGroups_map[q_img->getTextureIndex()] = group;
+				}
+				q_groups_v[group].push_back(q_img);
+				boxes_v_v[group].push_back(box);
+			}
+		}
+		for (unsigned int i=0, size=q_groups_v.size();i<size;i++)
+		{
+			if (q_groups_v[i][0]->isBatchable())
+				p_rtn->addImage(new GLImage(q_groups_v[i]));
+			else
+				p_rtn->addImage(new GLImage(*(q_groups_v[i][0])));
+		}
+	}
+	catch (PfException& e)
+	{
+		delete p_rtn;
+		throw PfException(__LINE__, __FILE__, string("Impossible de regrouper les images du plan ") + itostr(layer) + ".", e);
+	}
+
+	return p_rtn;
+}
+
+void Map::markCellDirty(unsigned int row, unsigned int col)
+{
+	for (unsigned int i=(row>1?row-1:1), maxRow=MIN(m_rowsCount, row+1);i<=maxRow;i++)
+	{
+		for (unsigned int j=(col>1?col-1:1), maxCol=MIN(m_columnsCount, col+1);j<=maxCol;j++)
+			m_dirtyCells_set.insert(pair<unsigned int, unsigned int>(i, j));
+	}
+}
+
 bool Map::isCellHidden(unsigned int row, unsigned int col) const
 {
 	if (row == 0 || row > m_rowsCount)
@@ -1329,10 +1508,7 @@ bool Map::isCellHidden(unsigned int row, unsigned int col) const
 	if (col == 0 || col > m_columnsCount)
 		throw ArgumentException(__LINE__, __FILE__, string("Coordonnées non valides : (") + itostr(row) + ";" + itostr(col) + ").", "col", "Map::isCellHidden");
 
-	const Cell* pc_cell = mp_cells_t2[row-1][col-1];
-	const Cell* pc_nextCell = nextConstCell(row, col, PfOrientation::SOUTH);
-
-	return (pc_nextCell != 0 && pc_nextCell->getZ() >= pc_cell->getZ() + MAP_CELL_SQUARE_HEIGHT);
+	return (row > 1 && m_cellsZ_v[cellIndex(row-1, col)] >= m_cellsZ_v[cellIndex(row, col)] + MAP_CELL_SQUARE_HEIGHT);
 }
 
 bool Map::isCliffVisible(unsigned int row, unsigned int col) const
@@ -1352,12 +1528,119 @@ int Map::heightOfVisibleCliff(unsigned int row, unsigned int col) const
 	if (col == 0 || col > m_columnsCount)
 		throw ArgumentException(__LINE__, __FILE__, string("Coordonnées non valides : (") + itostr(row) + ";" + itostr(col) + ").", "col", "Map::isCliffVisible");
 
-	const Cell* pc_cell = mp_cells_t2[row-1][col-1];
-	const Cell* pc_nextCell = nextConstCell(row, col, PfOrientation::SOUTH);
-
-	int rtn = pc_cell->getZ();
-	if (pc_nextCell != 0)
-		rtn = MAX(0, rtn - pc_nextCell->getZ());
+	int rtn = m_cellsZ_v[cellIndex(row, col)];
+	if (row > 1)
+		rtn = MAX(0, rtn - m_cellsZ_v[cellIndex(row-1, col)]);
 
 	return rtn;
 }
+
+void Map::initializeCells()
+{
+	unsigned int cellsCount = m_rowsCount*m_columnsCount;
+
+	for (unsigned int i=0;i<m_rowsCount;i++)
+	{
+		for (unsigned int j=0;j<m_columnsCount;j++)
+		{
+			for (int ori=PfOrientation::CARDINAL_NW;ori<=PfOrientation::CARDINAL_W;ori++)
+				mp_cells_v[i*m_columnsCount+j]->assignNeighbour(nextConstCell(i+1, j+1, PfOrientation((PfOrientation::PfCardinalPoint) ori).toFlag()), (PfOrientation::PfCardinalPoint) ori);
+		}
+	}
+
+	m_cellsZ_v.assign(cellsCount, 0);
+	m_cellsCornersZ_v.assign(cellsCount*8, 0);
+	for (unsigned int i=0;i<cellsCount;i++)
+		refreshCellData(i);
+
+	m_cellsObjects_v_v.assign(cellsCount, vector<unsigned int>());
+}
+
+void Map::refreshCellsData(unsigned int row, unsigned int col)
+{
+	// les altitudes aux points cardinaux d'une case dépendent de ses voisines
+	for (unsigned int i=(row>1?row-1:1), maxRow=MIN(m_rowsCount, row+1);i<=maxRow;i++)
+	{
+		for (unsigned int j=(col>1?col-1:1), maxCol=MIN(m_columnsCount, col+1);j<=maxCol;j++)
+			refreshCellData(cellIndex(i, j));
+	}
+}
+
+void Map::refreshCellData(unsigned int index)
+{
+	const Cell* q_cell = mp_cells_v[index];
+	m_cellsZ_v[index] = q_cell->getZ();
+	for (int ori=PfOrientation::CARDINAL_NW;ori<=PfOrientation::CARDINAL_W;ori++)
+		m_cellsCornersZ_v[index*8+ori] = q_cell->zAt((PfOrientation::PfCardinalPoint) ori, true);
+}
+
+void Map::cellsBounds(const PfRectangle& rect, int z, unsigned int& r_row1, unsigned int& r_row2, unsigned int& r_col1, unsigned int& r_col2) const
+{
+	float x1 = MAX(0, rect.getX()) + FLOAT_MARGIN;
+	float x2 = MIN(MAP_CELL_SIZE*m_columnsCount, rect.getX() + rect.getW()) - FLOAT_MARGIN;
+	float y1 = MAX(0, rect.getY()-(float) (z-MAP_CELL_SQUARE_HEIGHT)/MAP_CELL_SQUARE_HEIGHT*MAP_CELL_SIZE) + FLOAT_MARGIN;
+	float y2 = MIN(MAP_CELL_SIZE*m_rowsCount, rect.getY() + rect.getH()-(float) (z-MAP_CELL_SQUARE_HEIGHT)/MAP_CELL_SQUARE_HEIGHT*MAP_CELL_SIZE) - FLOAT_MARGIN;
+
+	r_row1 = (unsigned int) (y1/MAP_CELL_SIZE+FLOAT_MARGIN)+1;
+	r_row2 = (unsigned int) (y2/MAP_CELL_SIZE-FLOAT_MARGIN)+1;
+	r_col1 = (unsigned int) (x1/MAP_CELL_SIZE+FLOAT_MARGIN)+1;
+	r_col2 = (unsigned int) (x2/MAP_CELL_SIZE-FLOAT_MARGIN)+1;
+}
+
+int Map::cornerZ(unsigned int row, unsigned int col, PfOrientation::PfCardinalPoint ori) const
+{
+	if (row == 0 || row > m_rowsCount)
+		throw ArgumentException(__LINE__, __FILE__, string("ligne non valide : ") + itostr(row) + " sur " + itostr(m_rowsCount) + ".", "row", "Map::cornerZ");
+	if (col == 0 || col > m_columnsCount)
+		throw ArgumentException(__LINE__, __FILE__, string("colonne non valide : ") + itostr(col) + " sur " + itostr(m_columnsCount) + ".", "col", "Map::cornerZ");
+
+	return m_cellsCornersZ_v[cellIndex(row, col)*8+ori];
+}
+
+void Map::placeObject(const string& name, const vector<pair<unsigned int, unsigned int> >& coords_v)
+{
+	unsigned int handle;
+	map<string, unsigned int>::const_iterator handleIt = m_objectsHandles_map.find(name);
+	if (handleIt != m_objectsHandles_map.end())
+		handle = handleIt->second;
+	else if (!m_freeHandles_v.empty())
+	{
+		handle = m_freeHandles_v.back();
+		m_freeHandles_v.pop_back();
+		m_objectsNames_v[handle] = name;
+		m_objectsHandles_map[name] = handle;
+	}
+	else
+	{
+		handle = m_objectsNames_v.size();
+		m_objectsNames_v.push_back(name);
+		m_objectsCells_v_v.push_back(vector<unsigned int>());
+		m_objectsHandles_map[name] = handle;
+	}
+
+	vector<unsigned int>& r_cells_v = m_objectsCells_v_v[handle];
+	unplaceObject(handle); // un objet ajouté deux fois ne doit pas apparaître en double sur ses cases
+	for (unsigned int i=0, size=coords_v.size();i<size;i++)
+	{
+		r_cells_v.push_back(cellIndex(coords_v[i].first, coords_v[i].second));
+		m_cellsObjects_v_v[r_cells_v.back()].push_back(handle);
+	}
+}
+
+void Map::unplaceObject(unsigned int handle)
+{
+	vector<unsigned int>& r_cells_v = m_objectsCells_v_v[handle];
+	for (unsigned int i=0, size=r_cells_v.size();i<size;i++)
+	{
+		vector<unsigned int>& r_handles_v = m_cellsObjects_v_v[r_cells_v[i]];
+		for (vector<unsigned int>::iterator it=r_handles_v.begin();it!=r_handles_v.end();++it)
+		{
+			if (*it == handle)
+			{
+				r_handles_v.erase(it);
+				break;
+			}
+		}
+	}
+	r_cells_v.clear();
+}
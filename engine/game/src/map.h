@@ -11,6 +11,7 @@
 #include "gen.h"
 #include <vector>
 #include <map>
+#include <set>
 #include <string>
 #include "glitem.h"
 #include "serializable.h"
@@ -281,9 +282,19 @@ class Cell : public PolygonGLItem, public Serializable
 * Une map est constituée de cases réparties en lignes et colonnes.
 * La coordonnée (1;1) correspond à la case à l'extrême Sud-Ouest.
 *
-* A chaque fois qu'une case de la map est modifiée, c'est toute la map qui est reconstruite.
+* A chaque fois qu'une case de la map est modifiée, elle est marquée à régénérer avec ses huit voisines (falaises, bordures et étalements
+* dépendent des cases voisines). Lors de la mise à jour de la vue, seuls les Viewable liés correspondant à ces cases sont régénérés (Map::updateViewable).
+*
+* Pour limiter le nombre d'appels de rendu, les images des cases ne sont pas affichées case par case : pour chaque plan de perspective,
+* les images de même texture sont regroupées en une seule GLImage, sans changer l'ordre d'affichage des images qui se recouvrent (Map::generateBatch).
 * Les cases ne doivent jamais être détruites et reconstruites, sous peine de perdre les liens entre cases voisines.
 *
+* Les cases sont stockées ligne par ligne dans une liste unique (Map::cellIndex).
+* Les données utilisées par les calculs de collision (hauteurs, altitudes aux points cardinaux) sont recopiées dans des listes parallèles
+* mises à jour à chaque modification de case, afin d'éviter de parcourir les objets Cell.
+* De même, les objets présents sur chaque case sont référencés par des identifiants entiers attribués par la map (Map::objectHandlesOnCell),
+* leurs noms n'étant stockés qu'une fois (Map::objectName).
+*
 * Le nom d'une map est toujours MAP_NAME (fichier "gen.h").
 *
 * Chaque case a pour plan de perspective la valeur MAP_LAYER (fichier "gen.h") auquel s'ajoute le terme
@@ -386,6 +397,19 @@ class Map : public GLItem, public Serializable
 		*/
 		vector<pair<unsigned int, unsigned int> > cellsCoord(const PfRectangle& rect, int z);
 		/**
+		* @brief Retourne les identifiants des objets présents sur les cases contenues dans le rectangle passé en paramètre.
+		* @param rect le rectangle à considérer.
+		* @param z la hauteur du rectangle à considérer.
+		* @param r_handles_v la liste à remplir, sans doublon, vidée au préalable.
+		*
+		* Les cases considérées sont celles retournées par Map::cellsCoord.
+		* Les cases de cette map servent ainsi de grille uniforme de recherche des objets, tenue à jour par Map::addObject et Map::updateObjectPosition.
+		*
+		* Les doublons sont évités en marquant chaque objet rencontré (Map::m_objectsStamps_v) :
+		* le coût de la recherche est proportionnel au nombre d'objets rencontrés sur les cases.
+		*/
+		void objectsInRect(const PfRectangle& rect, int z, vector<unsigned int>& r_handles_v) const;
+		/**
 		* @brief Retourne la case voisine de celle aux coordonnées spécifiées.
 		* @param row la ligne de la case principale.
 		* @param col la colonne de la case principale.
@@ -424,7 +448,7 @@ class Map : public GLItem, public Serializable
 		* La case n'est pas vraiment remplacée, ce sont ses propriétés qui sont modifiées au moyen de la méthode Cell::modify.
 		*
 		* @remarks
-		* Cette map est marquée modifiée.
+		* Cette map est marquée modifiée, la case et ses voisines sont marquées à régénérer.
 		*/
 		void changeCell(unsigned int row, unsigned int col, int terrainIndex, int z = -1);
 		/**
@@ -439,7 +463,7 @@ class Map : public GLItem, public Serializable
 		* Appelle Cell::changeSlope.
 		*
 		* @remarks
-		* Cette map est marquée modifiée.
+		* Cette map est marquée modifiée, la case et ses voisines sont marquées à régénérer.
 		*/
 		void changeCellSlope(unsigned int row, unsigned int col, PfOrientation::PfCardinalPoint slopeOri, int deltaSlope, bool forceOri = false);
 		/**
@@ -450,6 +474,32 @@ class Map : public GLItem, public Serializable
 		*/
 		vector<string> objectsOnCell(pair<unsigned int, unsigned int> coord_pair) const;
 		/**
+		* @brief Retourne la liste des identifiants des objets présents sur la case aux coordonnées spécifiées.
+		* @param coord_pair les coordonnées de la case.
+		* @return la liste d'identifiants, à convertir en noms au moyen de la méthode Map::objectName.
+		* @throw ArgumentException si les coordonnées ne sont pas valides.
+		*
+		* Contrairement à la méthode Map::objectsOnCell, aucune copie n'est réalisée.
+		* La référence retournée n'est plus valable après ajout, suppression ou déplacement d'un objet.
+		*/
+		const vector<unsigned int>& objectHandlesOnCell(pair<unsigned int, unsigned int> coord_pair) const;
+		/**
+		* @brief Retourne le nom de l'objet dont l'identifiant est spécifié.
+		* @param handle l'identifiant de l'objet sur cette map.
+		* @return le nom de l'objet.
+		* @throw ArgumentException si aucun objet de cette map n'a cet identifiant.
+		*
+		* Les identifiants d'objets sont attribués par cette map lors de l'ajout d'un objet, et réutilisés après sa suppression.
+		*/
+		const string& objectName(unsigned int handle) const;
+		/**
+		* @brief Retourne l'identifiant d'un objet de cette map.
+		* @param name le nom de l'objet.
+		* @return l'identifiant de l'objet.
+		* @throw ArgumentException si l'objet n'est pas sur cette map.
+		*/
+		unsigned int objectHandle(const string& name) const;
+		/**
 		* @brief Ajoute un objet aux coordonnées spécifiées.
 		* @param r_object l'objet à placer.
 		* @param row la ligne de la case.
@@ -485,8 +535,8 @@ class Map : public GLItem, public Serializable
 		* @param names_v la liste des noms à supprimer.
 		*
 		* @remarks
-		* La liste passée en paramètre n'est pas en référence car il est généralement probable que ce soit Map::m_objectsNames_v_t2 qui soit utilisé.
-		* Comme les listes de cette variable sont modifiées, cela perturbe les itérateurs.
+		* La liste passée en paramètre n'est pas en référence car il est généralement probable qu'elle soit construite à partir des listes
+		* Map::m_cellsObjects_v_v. Comme ces listes sont modifiées, cela perturberait les itérateurs.
 		*
 		* @warning
 		* Les objets ne sont pas réellement détruits, ils sont juste retirés de cette map.
@@ -504,7 +554,8 @@ class Map : public GLItem, public Serializable
 		* @brief Met à jour la position d'un objet sur les cases de cette Map.
 		* @param r_object l'objet.
 		*
-		* Met à jour les champs Map::m_objectsNames_v_t2 et Map::m_cellsUnderObjects_v_map.
+		* Met à jour les champs Map::m_cellsObjects_v_v et Map::m_objectsCells_v_v.
+		* @throw ArgumentException si l'objet n'a pas été ajouté à cette map.
 		*/
 		void updateObjectPosition(MapObject& r_object);
 		/**
@@ -597,7 +648,7 @@ class Map : public GLItem, public Serializable
 		/**
 		* @brief Met à jour ce ModelItem.
 		*
-		* Passe le booléen ModelItem::m_modified à l'état faux.
+		* Passe le booléen ModelItem::m_modified à l'état faux et vide la liste des cases à régénérer.
 		*/
 		virtual void update();
 		/**
@@ -609,11 +660,26 @@ class Map : public GLItem, public Serializable
 		* Les cases génèrent les images du Nord vers le Sud afin d'avoir les cases les plus au sud en avant (gestion du relief et des plans de perspective).
 		* Pour chaque case, cette map ajoute des GLImage pour le relief et les bordures des cases.
 		*
+		* Les Viewable des cases sont liés au Viewable retourné dans l'ordre des lignes puis des colonnes,
+		* la case (row;col) se trouvant à l'indice (row-1)*Map::m_columnsCount + (col-1).
+		* Ils sont invisibles et ne servent qu'à construire les lots d'images liés à leur suite, un par plan de perspective (Map::generateBatch).
+		*
 		* @warning
 		* De la mémoire est allouée pour le pointeur retourné.
 		*/
 		virtual Viewable* generateViewable() const;
 		/**
+		* @brief Met à jour un Viewable déjà généré par cette map.
+		* @param r_viewable le Viewable à mettre à jour.
+		* @return <code>true</code> si le Viewable a été mis à jour, <code>false</code> s'il doit être entièrement régénéré.
+		* @throw ViewableGenerationException si la génération d'une case échoue.
+		*
+		* Seuls les Viewable liés des cases de la liste Map::m_dirtyCells_set sont régénérés et remplacés dans <em>r_viewable</em>.
+		* Les lots des plans de perspective de ces cases, avant et après modification, sont ensuite reconstruits.
+		* Si cette liste est vide ou si le nombre de Viewable liés ne correspond pas au nombre de cases, <code>false</code> est retourné.
+		*/
+		virtual bool updateViewable(Viewable& r_viewable) const;
+		/**
 		* @brief Sérialise cet objet.
 		* @param r_ofs le flux en écriture.
 		*
@@ -633,6 +699,95 @@ class Map : public GLItem, public Serializable
 		void setGroundType(MapGroundType type) {m_groundType = type;}
 
 	private:
+		/**
+		* @brief Génère le lot d'images d'un plan de perspective.
+		* @param layer le plan de perspective.
+		* @param q_cells_v les Viewable des cases de ce plan, dans l'ordre d'affichage.
+		* @return le Viewable contenant le lot.
+		* @throw PfException si les images ne peuvent être regroupées.
+		*
+		* L'ordre d'affichage des images qui se recouvrent est conservé : les bordures, étalements et falaises, semi-transparents, restent dessinés
+		* après la texture principale de leur case. Les images sont réparties en groupes, chacun regroupé en une GLImage (constructeur GLImage 3) :
+		* une image rejoint le dernier groupe de sa texture si son rectangle englobant ne recouvre aucune image des groupes suivants,
+		* et commence un nouveau groupe sinon. Un plan est ainsi le plus souvent rendu en un appel par texture.
+		* Les images ne pouvant être regroupées (GLImage::isBatchable) sont copiées telles quelles et forment chacune un groupe.
+		*
+		* @warning
+		* De la mémoire est allouée pour le pointeur retourné.
+		*/
+		Viewable* generateBatch(int layer, const vector<const Viewable*>& q_cells_v) const;
+		/**
+		* @brief Retourne l'indice d'une case dans les listes de cases de cette map.
+		* @param row la ligne de la case, à partir de 1.
+		* @param col la colonne de la case, à partir de 1.
+		* @return l'indice (row-1)*Map::m_columnsCount + (col-1).
+		*
+		* Les coordonnées ne sont pas vérifiées.
+		*/
+		unsigned int cellIndex(unsigned int row, unsigned int col) const {return (row-1)*m_columnsCount + (col-1);}
+		/**
+		* @brief Assigne leurs voisines aux cases et initialise les listes de données des cases et d'objets.
+		*
+		* Appelée par les constructeurs une fois toutes les cases créées.
+		*/
+		void initializeCells();
+		/**
+		* @brief Met à jour les données mises en cache d'une case et de ses huit voisines.
+		* @param row la ligne de la case.
+		* @param col la colonne de la case.
+		*
+		* Les voisines hors de la map sont ignorées.
+		*/
+		void refreshCellsData(unsigned int row, unsigned int col);
+		/**
+		* @brief Met à jour les données mises en cache d'une case (Map::m_cellsZ_v et Map::m_cellsCornersZ_v).
+		* @param index l'indice de la case (Map::cellIndex).
+		*/
+		void refreshCellData(unsigned int index);
+		/**
+		* @brief Retourne l'altitude d'une case à un point cardinal, arrondie à l'entier supérieur.
+		* @param row la ligne de la case.
+		* @param col la colonne de la case.
+		* @param ori le point cardinal.
+		* @return l'altitude, équivalente à Cell::zAt(ori, true).
+		* @throw ArgumentException si les coordonnées ne sont pas valides.
+		*
+		* La valeur est lue dans la liste Map::m_cellsCornersZ_v sans passer par la case.
+		*/
+		int cornerZ(unsigned int row, unsigned int col, PfOrientation::PfCardinalPoint ori) const;
+		/**
+		* @brief Calcule les lignes et colonnes extrêmes des cases contenues dans un rectangle.
+		* @param rect le rectangle à considérer.
+		* @param z la hauteur du rectangle à considérer.
+		* @param r_row1 la première ligne, à remplir.
+		* @param r_row2 la dernière ligne, à remplir.
+		* @param r_col1 la première colonne, à remplir.
+		* @param r_col2 la dernière colonne, à remplir.
+		*
+		* Voir Map::cellsCoord.
+		*/
+		void cellsBounds(const PfRectangle& rect, int z, unsigned int& r_row1, unsigned int& r_row2, unsigned int& r_col1, unsigned int& r_col2) const;
+		/**
+		* @brief Place un objet sur des cases, en lui attribuant un identifiant s'il n'en a pas encore.
+		* @param name le nom de l'objet.
+		* @param coords_v les coordonnées des cases recouvertes par l'objet.
+		*
+		* Si l'objet était déjà placé, il est d'abord retiré de ses anciennes cases.
+		*/
+		void placeObject(const string& name, const vector<pair<unsigned int, unsigned int> >& coords_v);
+		/**
+		* @brief Retire un objet de toutes ses cases, sans libérer son identifiant.
+		* @param handle l'identifiant de l'objet.
+		*/
+		void unplaceObject(unsigned int handle);
+		/**
+		* @brief Marque une case et ses huit voisines comme étant à régénérer.
+		* @param row la ligne de la case.
+		* @param col la colonne de la case.
+		*
+		* Les voisines hors de la map sont ignorées.
+		*/
+		void markCellDirty(unsigned int row, unsigned int col);
 		/**
 		* @brief Indique si une case est cachée par une case au sud.
 		* @param row la ligne de la case concernée.
@@ -661,13 +816,21 @@ class Map : public GLItem, public Serializable
 		unsigned int m_rowsCount; //!< Le nombre de lignes de cette map.
 		unsigned int m_columnsCount; //!< Le nombre de colonnes de cette map.
 		unsigned int m_seed; //!< La graine de hasard (comme c'est poétique...).
-		Cell*** mp_cells_t2; //!< Les cases de cette map.
-		vector<string>** m_objectsNames_v_t2; //!< Les listes de noms d'objets par case de cette map.
-		map<string, vector<pair<unsigned int, unsigned int> > > m_cellsUnderObjects_v_map; //!< La map des cellules contenant l'objet dont le nom est la clé (permet le parcours inverse par rapport à Map::m_objectsNames_v_t2).
+		vector<Cell*> mp_cells_v; //!< Les cases de cette map, ligne par ligne (Map::cellIndex).
+		vector<int> m_cellsZ_v; //!< Les hauteurs des cases, dans le même ordre que Map::mp_cells_v.
+		vector<int> m_cellsCornersZ_v; //!< Les altitudes des cases à chacun des 8 points cardinaux (Map::cornerZ), 8 valeurs consécutives par case.
+		vector<vector<unsigned int> > m_cellsObjects_v_v; //!< Les identifiants des objets présents sur chaque case, dans le même ordre que Map::mp_cells_v.
+		vector<vector<unsigned int> > m_objectsCells_v_v; //!< Les indices des cases recouvertes par chaque objet, par identifiant d'objet (parcours inverse de Map::m_cellsObjects_v_v).
+		vector<string> m_objectsNames_v; //!< Les noms des objets par identifiant, une chaîne vide indiquant un identifiant libre.
+		map<string, unsigned int> m_objectsHandles_map; //!< Les identifiants des objets de cette map par nom.
+		vector<unsigned int> m_freeHandles_v; //!< Les identifiants libérés, réutilisés en priorité.
+		mutable vector<unsigned int> m_objectsStamps_v; //!< Le numéro de la dernière recherche Map::objectsInRect ayant rencontré chaque objet, par identifiant.
 		PfMapTextureSet m_textureSet; //!< Le jeu de textures de cette map.
 		MapGroundType m_groundType; //!< Le comportement du niveau 0 de cette map.
+		mutable unsigned int m_queryStamp; //!< Le numéro de la dernière recherche Map::objectsInRect.
 		vector<string> m_mapLinks_v; //!< La liste des liens vers d'autres maps.
 		vector<string> m_scriptEntries_v; //!< La liste des textes associés à cette map.
+		set<pair<unsigned int, unsigned int> > m_dirtyCells_set; //!< Les coordonnées des cases dont le Viewable est à régénérer.
 };
 
 #endif // MAP_H_INCLUDED
@@ -45,6 +45,12 @@ class MapBackground : public AnimatedGLItem
         * De la mmoire est alloue pour le pointeur retourn.
         */
         virtual Viewable* generateViewable() const;
+        /**
+        * @brief Retourne <code>false</code> : la mosaque est toujours rgnre.
+        * @param r_viewable Le Viewable  mettre  jour.
+        * @return <code>false</code>.
+        */
+        virtual bool updateViewable(Viewable& r_viewable) const {return false;}
 
     private:
         unsigned int m_rows; //!< le nombre de fois qu'il faut rpter le dcor verticalement
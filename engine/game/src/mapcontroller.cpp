@@ -2,8 +2,13 @@
 
 #include "mapmodel.h"
 #include "eventhandler.h"
+#include "errors.h"
+#include "profiler.h"
 
-MapController::MapController(MapModel& r_model) : GLController(r_model) {}
+MapController::MapController(MapModel& r_model) : GLController(r_model)
+{
+	applyInputSettings();
+}
 
 void MapController::update()
 {
@@ -49,6 +54,21 @@ void MapController::update()
         #ifndef NDEBUG
         g_debug = m_eventHandler.isKeyPressed(SDLK_F1);
         #endif
+
+        #ifdef PROFILING
+        if (m_eventHandler.isKeyPressed(SDLK_F2, true))
+        {
+            try
+            {
+                Profiler::exportTrace();
+                LOG("Trace écrite : " << PROFILER_TRACE_FILE << "\n");
+            }
+            catch (PfException& e)
+            {
+                LOG(e.what() << "\n");
+            }
+        }
+        #endif
     }
 
 	// Actions
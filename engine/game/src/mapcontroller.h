@@ -28,6 +28,8 @@ class MapController : public GLController
 		/**
 		* @brief Constructeur MapController.
 		* @param r_model le modèle géré par ce contrôleur.
+		*
+		* Les entrées sont enregistrées ou rejouées selon la configuration (GLController::applyInputSettings).
 		*/
 		explicit MapController(MapModel& r_model);
 		/*
@@ -48,7 +50,8 @@ class MapController : public GLController
 		* <li>touche LALT enfoncée : instruction INSTRUCTION_JUMP,</li>
 		* <li>touche LCTRL enfoncée : instruction INSTRUCTION_ACTIVATE, 1,</li>
 		* <li>touche LCTRL relâchée : instruction INSTRUCTION_ACTIVATE, 0,</li>
-		* <li>touche F1 : enfoncée, <em>g_debug</em> (fichier "gen.h") est vrai, faux sinon.</li></ul>
+		* <li>touche F1 : enfoncée, <em>g_debug</em> (fichier "gen.h") est vrai, faux sinon,</li>
+		* <li>touche F2 enfoncée : si la macro PROFILING est définie, écriture de la trace du profileur (Profiler::exportTrace).</li></ul>
 		*
 		* Enfin, quelque soit le statut, les actions suivantes sont réalisées :
 		* <ul><li>appel de la méthode GLController::update,</li>
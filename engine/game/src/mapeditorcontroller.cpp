@@ -8,7 +8,10 @@
 #include "geometry.h"
 #include "misc.h"
 
-MapEditorController::MapEditorController(MapEditorModel& r_model) : GLController(r_model) {}
+MapEditorController::MapEditorController(MapEditorModel& r_model) : GLController(r_model)
+{
+	applyInputSettings();
+}
 
 void MapEditorController::update()
 {
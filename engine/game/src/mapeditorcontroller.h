@@ -26,6 +26,8 @@ class MapEditorController : public GLController
 		/**
 		* @brief Constructeur MapEditorController.
 		* @param r_model le modèle géré par ce contrôleur.
+		*
+		* Les entrées sont enregistrées ou rejouées selon la configuration (GLController::applyInputSettings).
 		*/
 		explicit MapEditorController(MapEditorModel& r_model);
 		/*
@@ -1,8 +1,10 @@
 #include "mapeditormodel.h"
 
 #include <set>
+#include <SDL.h>
 #include "misc.h"
 #include "datapackage.h"
+#include "mappedfile.h"
 #include "errors.h"
 #include "pfgui.h"
 #include "mapbackground.h"
@@ -77,28 +79,25 @@ MapEditorModel::MapEditorModel(const string& fileName):
 		switchPhase("Edit");
 
 		string str(string(MAPS_DIR) + fileName);
-		ifstream ifs(str.c_str(), ios::binary);
-		if (!ifs.is_open())
-			throw ArgumentException(__LINE__, __FILE__, string("Impossible d'ouvrir le fichier ") + fileName + ".", "fileName", "MapEditorModel::MapEditorModel");
+		MappedFile file(str); // les DataPackage lisent leurs valeurs en place dans le fichier, qui doit exister jusqu' la fin du chargement
 		int tmp;
-		ifs.read((char*) &tmp, sizeof(int));
+		file.read(&tmp, sizeof(int));
 		if (tmp != PFGAME_VERSION)
 		{
-			ifs.close();
 			throw PfException(__LINE__, __FILE__, string("Le fichier ") + fileName + " n'est pas de la version la plus rcente.\n\tVersion actuelle : " +
                      itostr(PFGAME_VERSION) + "\n\tVersion du fichier : " + itostr(tmp));
 		}
 
-        ifs.read((char*) &tmp, sizeof(int)); // passer STRING_FLAG
-		str = readString(ifs);
+        file.read(&tmp, sizeof(int)); // passer STRING_FLAG
+		str = file.readString();
 		if (str != "")
 			mp_wad = new PfWad(str, "launcher_load_menu", "PF_launcher_menu");
 		else
 			throw PfException(__LINE__, __FILE__, string("Le fichier ") + fileName + " fait rfrence  un WAD inexistant.");
 
-		DataPackage dp(ifs); // rencontre un DT_END aprs la map.
+		DataPackage dp(file); // rencontre un DT_END aprs la map.
 		mp_map = new Map(dp);
-		dp = DataPackage(ifs); // finit le fichier.
+		dp = DataPackage(file); // finit le fichier.
 		unsigned int objectsCount = dp.nextUInt();
 		for (unsigned int i=0;i<objectsCount;i++)
 		{
@@ -122,7 +121,6 @@ MapEditorModel::MapEditorModel(const string& fileName):
                                                                                               GAME_MAP));
             addItem(p_background);
         }
-		ifs.close();
 
 		addItem(mp_map);
 
@@ -1207,114 +1205,163 @@ void MapEditorModel::updateCursors()
 
 void MapEditorModel::changeTopology(int z, unsigned int radius, TextureGenerationMode mode, bool rel, int behavior, unsigned int minValue, unsigned int slope)
 {
-	int newZ;
-	// < ligne < colonne , +/-modif > >
-	map<unsigned int, map<unsigned int, int> > cellsModif_map;
-	map<unsigned int, map<unsigned int, int> >::iterator rowIt;
-	map<unsigned int, int>::iterator colIt;
-	float** f_t2;
+	if (m_selCoord_v.empty())
+		return;
+
+	#ifndef NDEBUG
+	unsigned int time = SDL_GetTicks();
+	#endif
+
+	// bote englobante des cases slectionnes, largie du rayon et limite  la map
+	int minRow = MAX_NUMBER, maxRow = 0, minCol = MAX_NUMBER, maxCol = 0;
+	for (unsigned int i=0, size=m_selCoord_v.size();i<size;i++)
+	{
+		minRow = MIN(minRow, (int) m_selCoord_v[i].first - (int) radius);
+		maxRow = MAX(maxRow, (int) m_selCoord_v[i].first + (int) radius);
+		minCol = MIN(minCol, (int) m_selCoord_v[i].second - (int) radius);
+		maxCol = MAX(maxCol, (int) m_selCoord_v[i].second + (int) radius);
+	}
+	minRow = MAX(1, minRow);
+	maxRow = MIN((int) mp_map->getRowsCount(), maxRow);
+	minCol = MAX(1, minCol);
+	maxCol = MIN((int) mp_map->getColumnsCount(), maxCol);
+	if (minRow > maxRow || minCol > maxCol)
+		return;
+	unsigned int w = maxCol - minCol + 1, h = maxRow - minRow + 1;
+
+	// hauteurs vises par case de la bote ; les cases slectionnes vont quoi qu'il arrive  leur propre hauteur vise
+	vector<int> targets_v(w*h, 0);
+	vector<bool> touched_v(w*h, false);
+	vector<bool> selected_v(w*h, false);
+
+	// la texture ne dpend que de la hauteur vise : elle n'est recalcule que si celle-ci change d'une case slectionne  l'autre
+	vector<float> texture_v;
+	const float* q_t = 0;
+	bool textureValid = false;
+	int textureZ = 0;
 	unsigned int l = 1 + radius * 2;
-	int row, col;
+	int newZ, row, col;
+	unsigned int index;
 	for (unsigned int i=0, size=m_selCoord_v.size();i<size;i++)
 	{
 		newZ = (rel?mp_map->cell(m_selCoord_v[i].first, m_selCoord_v[i].second)->getZ()+z:z);
 
-		if (mode == GRAPHICS_NOISE)
-			f_t2 = generate2DTexture(l, l, mode, (float) newZ, MAP_MAX_LINES_COUNT/(2*(slope+6)), mp_map->getSeed());
-		else
-			f_t2 = generate2DTexture(l, l, mode, (float) newZ, slope);
+		if (!textureValid || newZ != textureZ)
+		{
+			if (mode == GRAPHICS_NOISE)
+				fill2DTexture(texture_v, l, l, mode, (float) newZ, MAP_MAX_LINES_COUNT/(2*(slope+6)), mp_map->getSeed());
+			else
+				fill2DTexture(texture_v, l, l, mode, (float) newZ, slope);
+			q_t = &(texture_v[0]);
+			textureValid = (mode != GRAPHICS_RANDOM);
+			textureZ = newZ;
+		}
 
 		for (unsigned int j=0;j<l;j++)
 		{
 			row = m_selCoord_v[i].first-radius+j;
-			if (row < 1 || row > (int) mp_map->getRowsCount())
+			if (row < minRow || row > maxRow)
 				continue;
-			rowIt = cellsModif_map.find(row);
 			for (unsigned int k=0;k<l;k++)
 			{
 				col = m_selCoord_v[i].second-radius+k;
-				if (col < 1 || col > (int) mp_map->getColumnsCount())
+				if (col < minCol || col > maxCol)
+					continue;
+				index = (row-minRow)*w + col-minCol;
+				if (selected_v[index])
 					continue;
-				if (rowIt != cellsModif_map.end())
-					colIt = rowIt->second.find(col);
+				if (touched_v[index])
+					targets_v[index] = MAX(targets_v[index], q_t[j*l+k]);
 				else
-					colIt = cellsModif_map[row].end();
-
-				// calcul du poids (distance  la slection, calcule par couronnes)
-				if (colIt == cellsModif_map[row].end())
 				{
-					cellsModif_map[row][col] = MAX(minValue, f_t2[j][k]);
-					rowIt = cellsModif_map.find(row);
-					colIt = rowIt->second.find(col);
+					targets_v[index] = MAX(minValue, q_t[j*l+k]);
+					touched_v[index] = true;
 				}
-				else
-					colIt->second = MAX(colIt->second, f_t2[j][k]);
 			}
 		}
 
-		for (unsigned int j=0;j<l;j++)
-			delete [] f_t2[j];
-		delete [] f_t2;
+		index = (m_selCoord_v[i].first-minRow)*w + m_selCoord_v[i].second-minCol;
+		targets_v[index] = newZ;
+		touched_v[index] = true;
+		selected_v[index] = true;
 	}
 
-	vector<pair<unsigned int, unsigned int> > tmp_v;
-	bool ANIM_SELECTED;
-	for (rowIt=cellsModif_map.begin();rowIt!=cellsModif_map.end();++rowIt)
+	vector<pair<unsigned int, unsigned int> > cells_v;
+	vector<int> z_v;
+	for (unsigned int i=0;i<h;i++)
 	{
-		for (colIt=rowIt->second.begin();colIt!=rowIt->second.end();++colIt)
+		for (unsigned int j=0;j<w;j++)
 		{
-			ANIM_SELECTED = false;
-			tmp_v.clear();
-			tmp_v.push_back(pair<unsigned int, unsigned int>(rowIt->first, colIt->first));
-			// Quoi qu'il arrive, les cases slectionnes vont  newZ.
-			for (unsigned int i=0, size=m_selCoord_v.size();i<size;i++)
-			{
-				if (m_selCoord_v[i].first == rowIt->first && m_selCoord_v[i].second == colIt->first)
-					ANIM_SELECTED = true;
-			}
-			changeCellsHeight(tmp_v, (ANIM_SELECTED?newZ:colIt->second), false, behavior);
+			if (!touched_v[i*w+j])
+				continue;
+			cells_v.push_back(pair<unsigned int, unsigned int>(minRow+i, minCol+j));
+			z_v.push_back(targets_v[i*w+j]);
 		}
 	}
+	changeCellsHeight(cells_v, z_v, false, behavior);
+
+	#ifndef NDEBUG
+	if (cells_v.size() >= MAP_TOPOLOGY_LOG_CELLS)
+		LOG("changeTopology: " << cells_v.size() << " cases, " << m_selCoord_v.size() << " slectionnes, " << SDL_GetTicks() - time << " ms\n");
+	#endif
 }
 
 void MapEditorModel::changeCellsHeight(const vector<pair<unsigned int, unsigned int> >& rc_cells_v, int z, bool rel, int behavior)
 {
-	const Cell* pc_cell;
-	vector<string> objects_v;
+	changeCellsHeight(rc_cells_v, vector<int>(rc_cells_v.size(), z), rel, behavior);
+}
+
+void MapEditorModel::changeCellsHeight(const vector<pair<unsigned int, unsigned int> >& rc_cells_v, const vector<int>& rc_z_v, bool rel, int behavior)
+{
+	if (rc_z_v.size() != rc_cells_v.size())
+		throw ArgumentException(__LINE__, __FILE__, "Les listes de cases et de hauteurs n'ont pas la mme taille.", "rc_z_v", "MapEditorModel::changeCellsHeight");
+
+	// objets prsents sur les cases, chacun retenu une seule fois avec la premire case o il est trouv
+	vector<string> names_v;
+	vector<MapObject*> objects_v;
+	vector<unsigned int> objectsCells_v;
+	set<unsigned int> handles_set;
 	MapObject* p_object;
 	for (unsigned int i=0, size=rc_cells_v.size();i<size;i++)
 	{
-		unsigned int row = rc_cells_v[i].first;
-		unsigned int col = rc_cells_v[i].second;
 		try
 		{
-			pc_cell = mp_map->cell(row, col);
-			objects_v = mp_map->objectsOnCell(pair<unsigned int, unsigned int>(row, col));
+			const vector<unsigned int>& rc_handles_v = mp_map->objectHandlesOnCell(rc_cells_v[i]);
+			for (unsigned int j=0, size2=rc_handles_v.size();j<size2;j++)
+			{
+				if (!handles_set.insert(rc_handles_v[j]).second)
+					continue;
+				const string& rc_name = mp_map->objectName(rc_handles_v[j]);
+				p_object = findItem<MapObject>(rc_name);
+				if (p_object == 0)
+					throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + rc_name + ".");
+				names_v.push_back(rc_name);
+				objects_v.push_back(p_object);
+				objectsCells_v.push_back(i);
+			}
 		}
-		catch (PfException& e)
+		catch (ArgumentException& e)
 		{
 			throw PfException(__LINE__, __FILE__, "Coordonnes invalides pour l'une des cases slectionnes.", e);
 		}
-		for (unsigned int j=0, size2=objects_v.size();j<size2;j++)
-		{
-			p_object = dynamic_cast<MapObject*>(findItem<MapObject>(objects_v[j]));
-			if (p_object == 0)
-				throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + p_object->getName() + ".");
-			mp_map->removeObject(p_object->getName());
-		}
-		int newZ = rel?pc_cell->getZ()+z:z;
+	}
+
+	mp_map->removeObjects(names_v);
+
+	const Cell* pc_cell;
+	int newZ;
+	for (unsigned int i=0, size=rc_cells_v.size();i<size;i++)
+	{
+		pc_cell = mp_map->cell(rc_cells_v[i].first, rc_cells_v[i].second);
+		newZ = rel?pc_cell->getZ()+rc_z_v[i]:rc_z_v[i];
 		if (behavior != 0)
 			newZ = (behavior<0)?MIN(pc_cell->getZ(), newZ):MAX(pc_cell->getZ(), newZ);
 		newZ = MIN(MAP_MAX_HEIGHT, MAX(0, newZ));
-		mp_map->changeCell(row, col, pc_cell->getTerrainIndex(), newZ);
-		for (unsigned int j=0, size2=objects_v.size();j<size2;j++)
-		{
-			p_object = dynamic_cast<MapObject*>(findItem<MapObject>(objects_v[j]));
-			if (p_object == 0)
-				throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + p_object->getName() + ".");
-			mp_map->addObject(*p_object, row, col);
-		}
+		mp_map->changeCell(rc_cells_v[i].first, rc_cells_v[i].second, pc_cell->getTerrainIndex(), newZ);
 	}
+
+	for (unsigned int i=0, size=objects_v.size();i<size;i++)
+		mp_map->addObject(*(objects_v[i]), rc_cells_v[objectsCells_v[i]].first, rc_cells_v[objectsCells_v[i]].second);
 }
 
 void MapEditorModel::changeSelCellsHeight(int z, bool rel)
@@ -1568,8 +1615,9 @@ void MapEditorModel::saveMap()
 		vector<string> maps_v = filesInDir(MAPS_DIR, MAPS_EXT);
 
 		string str(string(MAPS_DIR) + m_currentMapName + "." + MAPS_EXT);
-		ofstream ofs(str.c_str(), ios::binary);
-		if (!ofs.is_open())
+		vector<char> buffer_v;
+		ofstream ofs;
+		if (!openBufferedBinaryFile(ofs, buffer_v, str))
 			throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", str);
 		int tmp = PFGAME_VERSION;
 		ofs.write((char*) &tmp, sizeof(int));
@@ -1601,14 +1649,11 @@ void MapEditorModel::saveMap()
             }
 
 			// on enregistre le slot de wad  partir du nom
-			for (unsigned int i=0;i<ENUM_PF_WAD_SLOT_COUNT;i++)
+			PfWadSlot slot;
+			if (enumFrom(it->substr(0, it->find_last_of("_")), slot))
 			{
-				if (textFrom((PfWadSlot) i) == it->substr(0, it->find_last_of("_")))
-                {
-                    WRITE_INT(ofs, NEW_SLOT_FLAG);
-					WRITE_INT(ofs, i);
-					break;
-                }
+				WRITE_INT(ofs, NEW_SLOT_FLAG);
+				WRITE_INT(ofs, slot);
 			}
 			// puis on enregistre les donnes de l'objet
 			p_object->saveData(ofs);
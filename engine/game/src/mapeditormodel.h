@@ -208,6 +208,13 @@ class MapEditorModel : public GLModel, public MultiPhases, public InstructionRea
 		* @param behavior 0 : modification systmatique, <0 : modification uniquement si la nouvelle hauteur est infrieure  l'ancienne, >0 : modification uniquement si la nouvelle hauteur est suprieure  l'ancienne.
 		* @param minValue la hauteur minimale des cases.
 		* @param slope la pente  utiliser.
+		*
+		* Les hauteurs vises sont accumules dans une grille dense couvrant la bote englobante des cases slectionnes, largie du rayon,
+		* l'appartenance  la slection tant marque dans une seconde grille de boolens.
+		* Chaque case slectionne prend sa propre hauteur vise, les autres cases la plus grande hauteur de texture qui les recouvre.
+		* Toutes les hauteurs sont ensuite appliques en un seul appel  MapEditorModel::changeCellsHeight.
+		*
+		* En debug, la dure de la modification est crite dans le fichier log si au moins MAP_TOPOLOGY_LOG_CELLS cases sont modifies.
 		*/
 		void changeTopology(int z, unsigned int radius, TextureGenerationMode mode, bool rel = false, int behavior = 0, unsigned int minValue = 4, unsigned int slope = 1);
 		/**
@@ -224,6 +231,21 @@ class MapEditorModel : public GLModel, public MultiPhases, public InstructionRea
 		*/
 		void changeCellsHeight(const vector<pair<unsigned int, unsigned int> >& rc_cells_v, int z, bool rel = false, int behavior = 0);
 		/**
+		* @brief Modifie la hauteur des cases aux coordonnes spcifies, chaque case ayant sa propre hauteur.
+		* @param rc_cells_v la liste des cases concernes.
+		* @param rc_z_v la hauteur de chaque case, dans l'ordre de la liste des cases.
+		* @param rel vrai si les valeurs de hauteur sont relatives  la hauteur des cases.
+		* @param behavior 0 : modification systmatique, <0 : modification uniquement si la nouvelle hauteur est infrieure  l'ancienne, >0 : modification uniquement si la nouvelle hauteur est suprieure  l'ancienne.
+		* @throw ArgumentException si les deux listes n'ont pas la mme taille.
+		* @throw PfException si un problme survient lors de la mise  jour de la hauteur d'un objet.
+		*
+		* Les objets prsents sur l'ensemble des cases sont retirs de la map en une fois, puis les hauteurs sont modifies,
+		* puis chaque objet est ajout  nouveau, une seule fois, sur la premire case de la liste o il a t trouv.
+		*
+		* Les cases sont limites en hauteur entre les valeurs 0 et MAP_MAX_HEIGHT.
+		*/
+		void changeCellsHeight(const vector<pair<unsigned int, unsigned int> >& rc_cells_v, const vector<int>& rc_z_v, bool rel = false, int behavior = 0);
+		/**
 		* @brief Modifie la hauteur des cases slectionnes.
 		* @param z la hauteur des cases.
 		* @param rel vrai si la valeur de hauteur est relative  la hauteur des cases.
@@ -1,5 +1,6 @@
 #include "mapmodel.h"
 
+#include <algorithm>
 #include "wad.h"
 #include "glfunc.h"
 #include "misc.h"
@@ -8,41 +9,32 @@
 #include "mapbackground.h"
 #include "errors.h"
 #include "mapzone.h"
+#include "mapprefetcher.h"
 
 #define MAP_GUI_WAD_NAME "PF_map_gui" //!< Le nom du wad à utiliser pour l'interface utilisateur sur une map.
 
-MapModel::MapModel(const string& fileName) : m_effects(EFFECT_NONE), m_userActivation(false)
+MapModel::MapModel(const string& fileName, MapPrefetcher* p_prefetcher) : mp_decorations(0), m_effects(EFFECT_NONE), m_userActivation(false)
 {
+	PrefetchedMap* pn_data = 0; // les DataPackage lisent leurs valeurs en place dans le fichier, qui doit exister jusqu'à la fin du chargement
 	try
 	{
-		string str(string(MAPS_DIR) + fileName);
-		ifstream ifs(str.c_str(), ios::binary);
-		if (!ifs.is_open())
-			throw ArgumentException(__LINE__, __FILE__, string("Impossible d'ouvrir le fichier ") + fileName + ".", "fileName", "MapModel::MapModel");
-		int tmp;
-		ifs.read((char*) &tmp, sizeof(int));
-		if (tmp != PFGAME_VERSION)
-		{
-			ifs.close();
-			throw FileException(__LINE__, __FILE__, string("Le fichier ") + fileName + " n'est pas de la version la plus récente.\n\tVersion actuelle : "
-                       + itostr(PFGAME_VERSION) + "\n\tVersion du fichier : " + itostr(tmp), str);
-		}
+		if (p_prefetcher != 0)
+			pn_data = p_prefetcher->adopt(fileName);
+		if (pn_data == 0)
+			pn_data = MapPrefetcher::readMap(fileName);
+		else
+			LOG("Map lue en tâche de fond : " << fileName << "\n");
 
-		PfWad* p_wad;
-		ifs.read((char*) &tmp, sizeof(int)); // passer STRING_FLAG
-		str = readString(ifs);
-		if (str != "")
-			p_wad = new PfWad(str, "launcher_load_menu", "PF_launcher_menu");
-		else
-			throw PfException(__LINE__, __FILE__, string("Le fichier ") + fileName + " fait référence à un wad inexistant.");
+		PfWad* p_wad = new PfWad(pn_data->wadName, "launcher_load_menu", "PF_launcher_menu");
 
-		DataPackage dp(ifs);
-		mp_map = new Map(dp);
-		dp = DataPackage(ifs);
-		ifs.close();
+		mp_map = new Map(pn_data->mapData);
+		DataPackage& dp = pn_data->objectsData;
 
 		addItem(mp_map);
 
+		mp_decorations = new DecorationLayer();
+		addItem(mp_decorations);
+
 		MapObject* p_object;
 		unsigned int objectsCount = dp.nextUInt();
 		for (unsigned int i=0;i<objectsCount;i++)
@@ -59,6 +51,7 @@ MapModel::MapModel(const string& fileName) : m_effects(EFFECT_NONE), m_userActiv
 			try
 			{
 				mp_map->addObject(*p_object);
+				indexMapObject(*p_object);
 
 				#ifdef DBG_ADDOBJECTS
                 LOG("Added: " << textFrom(slot) << " at layer " << itostr(p_object->getLayer()) << "\n");
@@ -69,6 +62,7 @@ MapModel::MapModel(const string& fileName) : m_effects(EFFECT_NONE), m_userActiv
 				throw PfException(__LINE__, __FILE__, string("Impossible d'ajouter l'objet ") + p_object->getName() + ".", e);
 			}
 		}
+		mp_decorations->update(); // prise en compte des plans attribués par la map
         if (dp.nextChar() != 0)
         {
             MapBackground* p_background = dynamic_cast<MapBackground*>(p_wad->generateGLItem(WAD_BACKGROUND, PfRectangle(), 0,
@@ -89,16 +83,26 @@ MapModel::MapModel(const string& fileName) : m_effects(EFFECT_NONE), m_userActiv
 		createGUI(p_wad);
 
 		delete p_wad;
+		delete pn_data;
+		pn_data = 0;
+
+		// les maps liées sont lues pendant que celle-ci est jouée
+		if (p_prefetcher != 0)
+		{
+			for (unsigned int i=1, size=mp_map->mapLinksCount();i<=size;i++)
+				p_prefetcher->request(mp_map->mapLink(i) + "." + MAPS_EXT);
+		}
 	}
 	catch (PfException& e)
 	{
+		delete pn_data;
 		throw ConstructorException(__LINE__, __FILE__, "Impossible de créer la map pour ce modèle.", "MapModel", e);
 	}
 }
 
 void MapModel::moveObjects()
 {
-	vector<MapObject*> p_objects_v = findAllItems<MapObject>();
+	vector<MapObject*> p_objects_v = mq_objects_v;
 	for (unsigned int i=0, size=p_objects_v.size();i<size;i++)
 	{
 		MapObject* p_obj = p_objects_v[i];
@@ -136,11 +140,10 @@ void MapModel::applyEffects()
 
 void MapModel::processInteractions()
 {
-    vector<MapObject*> p_objects_v = findAllItems<MapObject>();
+    vector<MapObject*> p_objects_v = mq_objects_v;
     MapObject *p_obj, *p_otherObject;
     const MapZone *q_actionZone, *q_otherZone;
-    vector<pair<unsigned int, unsigned int> > cellsInRect_v;
-    vector<string> objects_v, tmp_v;
+    vector<MapObject*> p_others_v;
     bool objectInTriggerZone;
     for (unsigned int n=0, count=p_objects_v.size();n<count;n++)
     {
@@ -152,21 +155,10 @@ void MapModel::processInteractions()
             PfRectangle actionRect(q_actionZone->getRect());
             actionRect.shift(PfOrientation::SOUTH, ((float) p_obj->getZ()-MAP_CELL_SQUARE_HEIGHT)/MAP_CELL_SQUARE_HEIGHT*MAP_CELL_SIZE);
 
-            cellsInRect_v = mp_map->cellsCoord(q_actionZone->getRect(), p_obj->getZ());
-            objects_v.clear();
-            tmp_v.clear();
-            for (unsigned int i=0, size=cellsInRect_v.size();i<size;i++)
-            {
-                tmp_v = mp_map->objectsOnCell(cellsInRect_v[i]);
-                addOnlyNewValues(tmp_v, objects_v);
-            }
-            for (unsigned int i=0, size=objects_v.size();i<size;i++)
+            p_others_v = objectsInRect(q_actionZone->getRect(), p_obj->getZ(), *p_obj);
+            for (unsigned int i=0, size=p_others_v.size();i<size;i++)
             {
-                if (objects_v[i] == p_obj->getName())
-                    continue;
-                p_otherObject = findItem<MapObject>(objects_v[i]);
-                if (p_otherObject == 0)
-                    continue;
+                p_otherObject = p_others_v[i];
 
                 // Gestion des zones DOOR
 
@@ -180,7 +172,7 @@ void MapModel::processInteractions()
                         if (p_obj->getName() == m_controlledMobName)
                             p_obj->setObjCode(p_otherObject->getObjCode());
                         else
-                            mp_map->removeObject(p_obj->getName());
+                            removeMapObject(*p_obj);
                     }
                 }
 
@@ -236,21 +228,10 @@ void MapModel::processInteractions()
             PfRectangle triggerRect(q_otherZone->getRect());
             triggerRect.shift(PfOrientation::SOUTH, ((float) p_obj->getZ()-MAP_CELL_SQUARE_HEIGHT)/MAP_CELL_SQUARE_HEIGHT*MAP_CELL_SIZE);
 
-            cellsInRect_v = mp_map->cellsCoord(q_otherZone->getRect(), p_obj->getZ());
-            tmp_v.clear();
-            objects_v.clear();
-            for (unsigned int i=0, size=cellsInRect_v.size();i<size;i++)
+            p_others_v = objectsInRect(q_otherZone->getRect(), p_obj->getZ(), *p_obj);
+            for (unsigned int i=0, size=p_others_v.size();i<size;i++)
             {
-                tmp_v = mp_map->objectsOnCell(cellsInRect_v[i]);
-                addOnlyNewValues(tmp_v, objects_v);
-            }
-            for (unsigned int i=0, size=objects_v.size();i<size;i++)
-            {
-                p_otherObject = findItem<MapObject>(objects_v[i]);
-                if (p_otherObject == 0)
-                    continue;
-                if (p_otherObject->getName() == p_obj->getName())
-                    continue;
+                p_otherObject = p_others_v[i];
                 if (p_otherObject->zone(BOX_TYPE_ACTION) == 0)
                     continue;
                 PfRectangle rect(p_otherObject->zone(BOX_TYPE_ACTION)->getRect());
@@ -423,22 +404,9 @@ unsigned int MapModel::stepsBeforeCollision(const MapObject& rc_obj) const
 
 	if (steps > 0)
 	{
-		const MapObject* q_obj;
-		vector<pair<unsigned int, unsigned int> > cellsOnPath_v = mp_map->cellsCoord(rc_obj.pathRect(), rc_obj.getZ());
-		vector<string> objectsOnPath_v;
-		for (unsigned int i=0, size=cellsOnPath_v.size();i<size;i++)
-		{
-			objectsOnPath_v = mp_map->objectsOnCell(cellsOnPath_v[i]);
-			for (unsigned int j=0, size2=objectsOnPath_v.size();j<size2;j++)
-			{
-				q_obj = findConstItem<MapObject>(objectsOnPath_v[j]);
-				if (q_obj == 0)
-					throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + objectsOnPath_v[j] + ".");
-				if (q_obj->getName() == rc_obj.getName())
-					continue;
-				steps = MIN(steps, (int) (rc_obj.distanceBeforeCollision(*q_obj)/MAP_CELL_SIZE*MAP_STEPS_PER_CELL+FLOAT_MARGIN));
-			}
-		}
+		vector<MapObject*> q_objectsOnPath_v = objectsInRect(rc_obj.pathRect(), rc_obj.getZ(), rc_obj);
+		for (unsigned int i=0, size=q_objectsOnPath_v.size();i<size;i++)
+			steps = MIN(steps, (int) (rc_obj.distanceBeforeCollision(*(q_objectsOnPath_v[i]))/MAP_CELL_SIZE*MAP_STEPS_PER_CELL+FLOAT_MARGIN));
 	}
 
 	return steps;
@@ -467,121 +435,92 @@ unsigned int MapModel::zStepsBeforeCellCollision(const MapObject& rc_obj) const
 
 unsigned int MapModel::zStepsBeforeObjectUpCollision(const MapObject& rc_obj) const
 {
-	vector<string> objects_v, tmp_v;
+	vector<MapObject*> q_objects_v;
 	const MapObject* q_collObj;
-	vector<pair<unsigned int, unsigned int> > cellsInRect_v;
 	PfRectangle collRect(rc_obj.rect_x(), rc_obj.rect_y(), 0.0, 0.0);
 	const MapZone* q_zone = rc_obj.constZone(BOX_TYPE_COLLISION);
 	if (q_zone != 0)
-        collRect = q_zone->getRect();
-	cellsInRect_v = mp_map->cellsCoord(collRect, rc_obj.getZ());
-
-	for (unsigned int j=0, size=cellsInRect_v.size();j<size;j++)
-	{
-		tmp_v = mp_map->objectsOnCell(cellsInRect_v[j]);
-		for (unsigned int k=0, size2=tmp_v.size();k<size2;k++)
-			objects_v.push_back(tmp_v[k]);
-	}
-
-	for (int step=rc_obj.getZ();step<MAP_MAX_HEIGHT;step++)
-	{
-		for (unsigned int j=0, size=objects_v.size();j<size;j++)
-		{
-			q_collObj = findConstItem<MapObject>(objects_v[j]);
-			if (q_collObj == 0)
-				throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + objects_v[j] + ".");
-			if (q_collObj->getName() == rc_obj.getName())
-				continue;
-
-			if (rc_obj.getZ() >= q_collObj->getZ())
-				continue;
-			if (rc_obj.isColliding(*q_collObj, step - rc_obj.getZ(), false))
-				return (unsigned int) (step - rc_obj.getZ());
-		}
-	}
-
-	return (unsigned int) (MAP_MAX_HEIGHT - rc_obj.getZ());
+        collRect = q_zone->getRect();
+	q_objects_v = objectsInRect(collRect, rc_obj.getZ(), rc_obj);
+
+	// première altitude de collision au-dessus de l'objet, calculée par intervalle plutôt que pas à pas
+	int z = rc_obj.getZ(), minZ, maxZ, step = MAP_MAX_HEIGHT;
+	for (unsigned int j=0, size=q_objects_v.size();j<size;j++)
+	{
+		q_collObj = q_objects_v[j];
+
+		if (z >= q_collObj->getZ() || !rc_obj.collisionZInterval(*q_collObj, minZ, maxZ, 0, false))
+			continue;
+		minZ = MAX(z, minZ);
+		if (minZ <= MIN(MAP_MAX_HEIGHT-1, maxZ))
+			step = MIN(step, minZ);
+	}
+
+	return (unsigned int) (step - z);
 }
 
 unsigned int MapModel::zStepsBeforeObjectDownCollision(const MapObject& rc_obj) const
 {
-	vector<string> objects_v, tmp_v;
-	const MapObject* q_collObj;
-	vector<pair<unsigned int, unsigned int> > cellsInRect_v;
+	vector<MapObject*> q_objects_v;
+	const MapObject* q_collObj;
 	PfRectangle collRect;
 	const MapZone* q_zone = rc_obj.constZone(BOX_TYPE_COLLISION);
 	if (q_zone != 0)
-        collRect = q_zone->getRect();
-	cellsInRect_v = mp_map->cellsCoord(collRect, rc_obj.getZ());
-
-	for (unsigned int j=0, size=cellsInRect_v.size();j<size;j++)
-	{
-		tmp_v = mp_map->objectsOnCell(cellsInRect_v[j]);
-		addOnlyNewValues(tmp_v, objects_v);
-	}
-
-	for (int step=rc_obj.getZ();step>0;step--)
-	{
-		for (unsigned int j=0, size=objects_v.size();j<size;j++)
-		{
-			q_collObj = findConstItem<MapObject>(objects_v[j]);
-			if (q_collObj == 0)
-				throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + objects_v[j] + ".");
-			if (q_collObj->getName() == rc_obj.getName())
-				continue;
-
-			if (rc_obj.isColliding(*q_collObj, step - rc_obj.getZ(), false))
-				return (unsigned int) (rc_obj.getZ() - step);
-		}
-	}
-
-	return MAX(0, rc_obj.getZ());
+        collRect = q_zone->getRect();
+	q_objects_v = objectsInRect(collRect, rc_obj.getZ(), rc_obj);
+
+	// première altitude de collision sous l'objet, calculée par intervalle plutôt que pas à pas
+	int z = rc_obj.getZ(), minZ, maxZ, step = 0;
+	for (unsigned int j=0, size=q_objects_v.size();j<size;j++)
+	{
+		q_collObj = q_objects_v[j];
+
+		if (!rc_obj.collisionZInterval(*q_collObj, minZ, maxZ, 0, false))
+			continue;
+		maxZ = MIN(z, maxZ);
+		if (maxZ >= MAX(1, minZ))
+			step = MAX(step, maxZ);
+	}
+
+	return (step > 0)?(unsigned int) (z - step):MAX(0, z);
 }
 
 int MapModel::maxZUnderObject(const MapObject& rc_obj) const
 {
-	vector<pair<unsigned int, unsigned int> > cellsInRect_v;
-	vector<string> objects_v, tmp_v;
+	vector<pair<unsigned int, unsigned int> > cellsInRect_v;
+	vector<MapObject*> q_objects_v;
 	PfRectangle collRect(rc_obj.rect_x(), rc_obj.rect_y(), 0.0, 0.0);
 	const MapZone* q_zone = rc_obj.constZone(BOX_TYPE_COLLISION);
 	if (q_zone != 0)
         collRect = q_zone->getRect();
 	cellsInRect_v = mp_map->cellsCoord(collRect, rc_obj.getZ());
-	int maxZ = 0, tmpZ;
+	int maxGroundZ = 0, tmpZ;
 	const MapObject* q_obj;
+	int minZ, maxZ;
 
 	for (unsigned int i=0, size=cellsInRect_v.size();i<size;i++)
 	{
 		// boucle de contrôle d'altitude
 
 		tmpZ = mp_map->cell(cellsInRect_v[i])->maxZIn(collRect, rc_obj.getZ(), true);
-		maxZ = MAX(maxZ, tmpZ);
-
-		// on en profite pour remplir la liste d'objets
-
-		tmp_v = mp_map->objectsOnCell(cellsInRect_v[i]);
-		for (unsigned int k=0, size2=tmp_v.size();k<size2;k++)
-			objects_v.push_back(tmp_v[k]);
+		maxGroundZ = MAX(maxGroundZ, tmpZ);
 	}
 
-	for (unsigned int i=0, size=objects_v.size();i<size;i++)
+	q_objects_v = objectsInRect(collRect, rc_obj.getZ(), rc_obj);
+	for (unsigned int i=0, size=q_objects_v.size();i<size;i++)
 	{
-		q_obj = findConstItem<MapObject>(objects_v[i]);
-		if (q_obj == 0)
-			throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + objects_v[i] + ".");
-		if (q_obj->getName() == rc_obj.getName())
-			continue;
+		q_obj = q_objects_v[i];
 
         unsigned int collHeight = 0;
         q_zone = q_obj->constZone(BOX_TYPE_COLLISION);
         if (q_zone != 0)
             collHeight = q_zone->getHeight();
 		tmpZ = q_obj->getZ() + collHeight;
-		if (tmpZ <= rc_obj.getZ() && rc_obj.isColliding(*q_obj, tmpZ - rc_obj.getZ(), false))
-			maxZ = MAX(maxZ, tmpZ);
+		if (tmpZ <= rc_obj.getZ() && rc_obj.collisionZInterval(*q_obj, minZ, maxZ, 0, false)) // le sommet de l'objet est toujours dans l'intervalle
+			maxGroundZ = MAX(maxGroundZ, tmpZ);
 	}
 
-	return maxZ;
+	return maxGroundZ;
 }
 
 void MapModel::updateLayer(MapObject& r_obj)
@@ -591,21 +530,10 @@ void MapModel::updateLayer(MapObject& r_obj)
 
     if (hasColl)
     {
-        vector<string> objectsOnPath_v, tmp_v;
-        vector<pair<unsigned int, unsigned int> > cellsInRect_v = mp_map->cellsCoord(r_obj.constZone(BOX_TYPE_COLLISION, true)->getRect(), r_obj.getZ());
-        for (unsigned int i=0, size=cellsInRect_v.size();i<size;i++)
-        {
-            tmp_v = mp_map->objectsOnCell(cellsInRect_v[i]);
-            for (unsigned int j=0, size2=tmp_v.size();j<size2;j++)
-                objectsOnPath_v.push_back(tmp_v[j]);
-        }
-        for (unsigned int i=0, size=objectsOnPath_v.size();i<size;i++)
+        vector<MapObject*> p_objectsOnPath_v = objectsInRect(r_obj.constZone(BOX_TYPE_COLLISION, true)->getRect(), r_obj.getZ(), r_obj);
+        for (unsigned int i=0, size=p_objectsOnPath_v.size();i<size;i++)
         {
-            MapObject* p_collObj = findItem<MapObject>(objectsOnPath_v[i]);
-            if (p_collObj == 0)
-                throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + objectsOnPath_v[i] + ".");
-            if (p_collObj->getName() == r_obj.getName())
-                continue;
+            MapObject* p_collObj = p_objectsOnPath_v[i];
             if (r_obj.getZ() > p_collObj->getZ() && r_obj.isColliding(*p_collObj))
                 layer = MAX(layer, p_collObj->getLayer()+1);
         }
@@ -643,3 +571,71 @@ void MapModel::createGUI(PfWad* p_wad)
 	    throw PfException(__LINE__, __FILE__, "Impossible de créer l'ensemble des composants GUI.", e);
 	}
 }
+
+void MapModel::indexMapObject(MapObject& r_obj)
+{
+	unsigned int handle = mp_map->objectHandle(r_obj.getName());
+	if (handle >= mq_mapObjects_v.size())
+		mq_mapObjects_v.resize(handle+1, (MapObject*) 0);
+	mq_mapObjects_v[handle] = &r_obj;
+}
+
+void MapModel::removeMapObject(const MapObject& rc_obj)
+{
+	unsigned int handle = mp_map->objectHandle(rc_obj.getName());
+	if (handle < mq_mapObjects_v.size())
+		mq_mapObjects_v[handle] = 0;
+	mp_map->removeObject(rc_obj.getName());
+}
+
+vector<MapObject*> MapModel::objectsInRect(const PfRectangle& rect, int z, const MapObject& rc_obj) const
+{
+	vector<MapObject*> p_rtn_v;
+	MapObject* p_obj;
+
+	mp_map->objectsInRect(rect, z, m_handles_v);
+	p_rtn_v.reserve(m_handles_v.size());
+	for (unsigned int i=0, size=m_handles_v.size();i<size;i++)
+	{
+		p_obj = mapObject(m_handles_v[i]);
+		if (p_obj == 0)
+			throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet ") + mp_map->objectName(m_handles_v[i]) + ".");
+		if (p_obj != &rc_obj)
+			p_rtn_v.push_back(p_obj);
+	}
+
+	return p_rtn_v;
+}
+
+void MapModel::itemAdded(unsigned int, ModelItem* p_item)
+{
+	MapObject* p_obj = dynamic_cast<MapObject*>(p_item);
+	if (p_obj != 0)
+	{
+		mq_objects_v.push_back(p_obj);
+		if (mp_decorations != 0)
+			mp_decorations->addObject(*p_obj);
+	}
+}
+
+void MapModel::itemRemoved(unsigned int, ModelItem* p_item)
+{
+	if (p_item == mp_decorations)
+	{
+		mp_decorations = 0;
+		return;
+	}
+
+	MapObject* p_obj = dynamic_cast<MapObject*>(p_item);
+	if (p_obj != 0 && mp_decorations != 0)
+		mp_decorations->removeObject(*p_obj);
+
+	vector<MapObject*>::iterator it = find(mq_objects_v.begin(), mq_objects_v.end(), p_item);
+	if (it != mq_objects_v.end())
+		mq_objects_v.erase(it);
+	for (unsigned int i=0, size=mq_mapObjects_v.size();i<size;i++)
+	{
+		if (mq_mapObjects_v[i] == p_item)
+			mq_mapObjects_v[i] = 0;
+	}
+}
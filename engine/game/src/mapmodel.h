@@ -19,9 +19,15 @@
 #include "enum.h"
 #include "mapobject.h"
 #include "wad.h"
+#include "decorationlayer.h"
+
+class MapPrefetcher;
 
 /**
 * @brief Modèle MVC dédié à la gestion d'une map vue de haut.
+*
+* Les objets de la map sont indexés par ce modèle (MapModel::mq_objects_v, MapModel::mq_mapObjects_v) afin que les boucles de déplacement
+* et d'interaction n'aient à rechercher aucun objet par son nom.
 */
 class MapModel : public GLModel, public InstructionReader
 {
@@ -33,15 +39,20 @@ class MapModel : public GLModel, public InstructionReader
 		/**
 		* @brief Constructeur MapModel.
 		* @param fileName le nom du fichier de la map à ouvrir.
+		* @param p_prefetcher Le MapPrefetcher ayant éventuellement lu la map en tâche de fond, 0 si aucun.
 		* @throw ConstructorException si une erreur survient lors de la création de la map.
 		*
+		* Si le MapPrefetcher a déjà lu le fichier, ses données sont récupérées (MapPrefetcher::adopt),
+		* sinon le fichier est lu par la méthode MapPrefetcher::readMap.
+		* Une fois la map créée, la lecture des maps liées est demandée au MapPrefetcher.
+		*
 		* Les textures de terrain sont ajoutées ici, aux indices TERRAIN_TEXTURE_INDEX et TERRAIN_TEXTURE_INDEX_2 (fichier "gen.h").
 		*
 		* La caméra est installée :
 		* <ul><li>elle suit le mob contrôlé (nommé MOB_1),</li>
 		* <li>ses limites sont fixées aux limites de la map.</li></ul>
 		*/
-		MapModel(const string& fileName);
+		MapModel(const string& fileName, MapPrefetcher* p_prefetcher = 0);
 		/**
 		* @brief Destructeur MapModel.
 		*/
@@ -213,11 +224,64 @@ class MapModel : public GLModel, public InstructionReader
 		* @throw PfException si une erreur survient lors de la création d'un objet.
 		*/
 		void createGUI(PfWad* p_wad);
+		/**
+		* @brief Référence un objet placé sur la map dans la liste MapModel::mq_mapObjects_v.
+		* @param r_obj l'objet.
+		* @throw ArgumentException si l'objet n'est pas sur la map.
+		*/
+		void indexMapObject(MapObject& r_obj);
+		/**
+		* @brief Retire un objet de la map et de la liste MapModel::mq_mapObjects_v.
+		* @param rc_obj l'objet.
+		* @throw ArgumentException si l'objet n'est pas sur la map.
+		*
+		* L'objet n'est pas retiré de ce modèle.
+		*/
+		void removeMapObject(const MapObject& rc_obj);
+		/**
+		* @brief Retourne l'objet de la map dont l'identifiant est spécifié.
+		* @param handle l'identifiant de l'objet sur la map (Map::objectHandlesOnCell).
+		* @return l'objet, 0 s'il n'est pas connu de ce modèle.
+		*/
+		MapObject* mapObject(unsigned int handle) const {return (handle < mq_mapObjects_v.size())?mq_mapObjects_v[handle]:0;}
+		/**
+		* @brief Retourne les objets présents sur les cases de la map contenues dans un rectangle, sans doublon.
+		* @param rect le rectangle à considérer.
+		* @param z la hauteur du rectangle à considérer.
+		* @param rc_obj un objet à exclure de la liste.
+		* @return la liste des objets.
+		* @throw PfException si un objet de la map n'est pas connu de ce modèle.
+		*
+		* Les objets sont recherchés par Map::objectsInRect, les cases de la map servant de grille de recherche.
+		*/
+		vector<MapObject*> objectsInRect(const PfRectangle& rect, int z, const MapObject& rc_obj) const;
+		/*
+		* Redéfinitions
+		* -------------
+		*/
+		/**
+		* @brief Ajoute l'objet à la liste MapModel::mq_objects_v s'il s'agit d'un MapObject.
+		* @param handle l'identifiant de l'objet dans ce modèle.
+		* @param p_item l'objet ajouté.
+		*
+		* L'objet est également ajouté à la couche de décor MapModel::mp_decorations, qui ne retient que les objets de décor.
+		*/
+		virtual void itemAdded(unsigned int handle, ModelItem* p_item);
+		/**
+		* @brief Retire l'objet des listes MapModel::mq_objects_v et MapModel::mq_mapObjects_v, ainsi que de la couche de décor.
+		* @param handle l'identifiant de l'objet dans ce modèle.
+		* @param p_item l'objet supprimé.
+		*/
+		virtual void itemRemoved(unsigned int handle, ModelItem* p_item);
 
 		Map* mp_map; //!< La map de ce modèle.
+		DecorationLayer* mp_decorations; //!< La couche affichant les objets de décor de ce modèle, 0 si elle a été supprimée.
 		string m_controlledMobName; //!< Le nom du mob contrôlé.
 		pfflag32 m_effects; //!< Les effets à prendre en compte.
 		bool m_userActivation; //!< Indique si une activation par l'utilisateur est en cours.
+		vector<MapObject*> mq_objects_v; //!< Les MapObject de ce modèle, dans l'ordre d'ajout.
+		vector<MapObject*> mq_mapObjects_v; //!< Les MapObject de ce modèle par identifiant sur la map (Map::objectHandle), 0 pour un identifiant inconnu.
+		mutable vector<unsigned int> m_handles_v; //!< Liste de travail de MapModel::objectsInRect, conservée pour éviter les allocations.
 };
 
 #endif // MAPMODEL_H_INCLUDED
@@ -4,9 +4,9 @@
 #include "glview.h"
 #include "mapcontroller.h"
 
-MapMVCSystem::MapMVCSystem(const string& fileName)
+MapMVCSystem::MapMVCSystem(const string& fileName, MapPrefetcher* p_prefetcher)
 {
-	mp_model = new MapModel(fileName);
+	mp_model = new MapModel(fileName, p_prefetcher);
 	mp_view = new GLView;
 	mp_controller = new MapController(*(dynamic_cast<MapModel*>(mp_model)));
 	m_selfDestructible = true;
@@ -11,6 +11,8 @@
 #include "gen.h"
 #include "mvcsystem.h"
 
+class MapPrefetcher;
+
 /**
 * @brief Système MVC dédié à la gestion d'une map 2D vue de haut.
 */
@@ -24,8 +26,9 @@ class MapMVCSystem : public MVCSystem
 		/**
 		* @brief Constructeur MapMVCSystem.
 		* @param fileName le nom du fichier de la map à ouvrir.
+		* @param p_prefetcher Le MapPrefetcher lisant les maps liées en tâche de fond, 0 si aucun.
 		*/
-		MapMVCSystem(const string& fileName);
+		MapMVCSystem(const string& fileName, MapPrefetcher* p_prefetcher = 0);
 };
 
 #endif // MAPMVCSYSTEM_H_INCLUDED
@@ -3,6 +3,7 @@
 #include "errors.h"
 #include "viewable.h"
 #include "datapackage.h"
+#include "decorationlayer.h"
 #include "mob.h"
 #include "misc.h"
 
@@ -10,7 +11,7 @@
 
 MapObject::MapObject(const string& name, const PfRectangle& rect, PfOrientation::PfOrientationValue orientation) :
 AnimatedGLItem(name, 0, rect), m_z(MAP_CELL_SQUARE_HEIGHT), m_speed(0), m_speedZ(0), m_objStat(OBJSTAT_NONE), m_effects(EFFECT_NONE),
-m_floating(false), m_objCode(0)
+m_floating(false), m_objCode(0), m_decorated(false)
 {
 	changeOrientation(orientation);
 }
@@ -80,6 +81,15 @@ PfRectangle MapObject::pathRect() const
 }
 
 bool MapObject::isColliding(const MapObject& rc_object, int dz, bool borders) const
+{
+	int minZ, maxZ;
+	if (!collisionZInterval(rc_object, minZ, maxZ, dz, borders))
+		return false;
+
+	return (m_z + dz >= minZ && m_z + dz <= maxZ); // = pour qu'un objet tienne sur un autre
+}
+
+bool MapObject::collisionZInterval(const MapObject& rc_object, int& r_minZ, int& r_maxZ, int dz, bool borders) const
 {
 	PfRectangle collRect, thisCollRect;
 	int collHeight = 0, thisCollHeight = 0;
@@ -100,13 +110,13 @@ bool MapObject::isColliding(const MapObject& rc_object, int dz, bool borders) co
                         collRect.getW(), collRect.getH());
     thisCollRect = PfRectangle(thisCollRect.getX(), thisCollRect.getY() + dz*MAP_CELL_SIZE/MAP_CELL_SQUARE_HEIGHT,
                         thisCollRect.getW(), thisCollRect.getH());
-	if (collRect.contains(thisCollRect, borders))
-	{
-		if (m_z + dz <= rc_object.getZ() + collHeight && m_z + dz + (int) thisCollHeight >= rc_object.getZ())
-			return true; // = pour qu'un objet tienne sur un autre
-	}
+	if (!collRect.contains(thisCollRect, borders))
+		return false;
+
+	r_minZ = rc_object.getZ() - thisCollHeight;
+	r_maxZ = rc_object.getZ() + collHeight;
 
-	return false;
+	return true;
 }
 
 float MapObject::distanceBeforeCollision(const MapObject& rc_object) const
@@ -308,7 +318,7 @@ void MapObject::update()
 
 Viewable* MapObject::generateViewable() const
 {
-	Viewable* p_vw = AnimatedGLItem::generateViewable();
+	Viewable* p_vw = (m_decorated?new Viewable(getName()):AnimatedGLItem::generateViewable());
 	#ifndef NDEBUG
 	if (g_debug)
     {
@@ -330,6 +340,27 @@ Viewable* MapObject::generateViewable() const
 	return p_vw;
 }
 
+bool MapObject::updateViewable(Viewable& r_viewable) const
+{
+	#ifndef NDEBUG
+	if (g_debug)
+		return false;
+	#endif
+
+	if (m_decorated)
+		return (r_viewable.imagesCount() == 0 && r_viewable.viewablesCount() == 0);
+
+	return AnimatedGLItem::updateViewable(r_viewable);
+}
+
+void MapObject::decorationInstances(vector<DecorationInstance>& r_instances_v) const
+{
+	PfColor color(getAnimationGroup().currentFrame().getColor());
+	r_instances_v.push_back(DecorationInstance(getRect(), getAnimationGroup().currentFrame().getTextureIndex(),
+											   getAnimationGroup().currentFrame().textCoordRectangle(getOrientation()),
+											   ((color==PfColor::WHITE)?getColor():color), getLayer()));
+}
+
 void MapObject::saveData(ofstream& r_ofs) const
 {
 	WRITE_ENUM(r_ofs, MapObject::SAVE_ORIENTATION);
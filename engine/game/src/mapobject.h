@@ -19,6 +19,8 @@
 #include "enum.h"
 #include "mapzone.h"
 
+struct DecorationInstance;
+
 /**
 * @brief Objet d'une map 2D vue de haut.
 *
@@ -147,6 +149,22 @@ class MapObject : public AnimatedGLItem, public Serializable, public Instruction
 		*/
 		bool isColliding(const MapObject& rc_object, int dz = 0, bool borders = false) const;
 		/**
+		* @brief Calcule l'intervalle des altitudes de cet objet pour lesquelles il est en collision avec un autre.
+		* @param rc_object l'objet avec lequel tester la collision.
+		* @param r_minZ l'altitude minimale de collision, à remplir.
+		* @param r_maxZ l'altitude maximale de collision, à remplir.
+		* @param dz le déplacement Z à affecter à cet objet pour le test de recouvrement des rectangles.
+		* @param borders vrai si deux objets se touchant uniquement par les bordures (non recouvrement) doivent être considérés en collision.
+		* @return faux si les rectangles de collision ne se recouvrent pas, auquel cas les altitudes ne sont pas modifiées.
+		*
+		* La correction de Z étant appliquée aux deux rectangles de collision, leur recouvrement ne dépend pas de l'altitude testée.
+		* MapObject::isColliding retourne donc vrai pour un déplacement <em>dz</em> si et seulement si cette méthode retourne vrai
+		* et que l'altitude MapObject::m_z + <em>dz</em> est comprise entre <em>r_minZ</em> et <em>r_maxZ</em> inclus.
+		*
+		* Cela permet de remplacer un parcours des altitudes pas à pas par un simple test d'intervalle.
+		*/
+		bool collisionZInterval(const MapObject& rc_object, int& r_minZ, int& r_maxZ, int dz = 0, bool borders = false) const;
+		/**
 		* @brief Calcule la distance à parcourir par cet objet avant d'entrer en collision avec l'objet passé en paramètre.
 		* @param rc_object l'objet de collision.
 		* @return la distance à parcourir avant collision.
@@ -242,6 +260,20 @@ class MapObject : public AnimatedGLItem, public Serializable, public Instruction
 		* Par défaut, retire simplement l'état OBJSTAT_ACTIVATED de cet objet.
 		*/
 		virtual pfflag32 deactivate();
+		/**
+		* @brief Indique si cet objet est un objet de décor, affiché par la couche DecorationLayer de la map.
+		* @return <code>false</code> par défaut.
+		*
+		* Un objet de décor ne se déplace pas et ne change d'image que rarement : ses images peuvent être regroupées avec celles des autres objets de décor.
+		*/
+		virtual bool isDecoration() const {return false;}
+		/**
+		* @brief Ajoute à une liste les éléments de décor de cet objet.
+		* @param r_instances_v la liste à compléter.
+		*
+		* Par défaut, ajoute un élément reprenant l'image de la frame en cours, comme la méthode AnimatedGLItem::generateViewable.
+		*/
+		virtual void decorationInstances(vector<DecorationInstance>& r_instances_v) const;
 		/*
 		* Redéfinitions
 		* -------------
@@ -275,11 +307,25 @@ class MapObject : public AnimatedGLItem, public Serializable, public Instruction
 		*
 		* Appelle la méthode AnimatedGLItem::generateViewable, puis, dans le cas où g_debug (fichier "gen.h") est vrai, la zone de collision est affichée.
 		*
+		* Si cet objet est décoré (MapObject::m_decorated), le Viewable ne contient aucune image, celles-ci étant affichées par la couche DecorationLayer.
+		*
 		* @warning
 		* De la mémoire est allouée pour le pointeur retourné.
 		*/
 		virtual Viewable* generateViewable() const;
 		/**
+		* @brief Met à jour sur place un Viewable généré par MapObject::generateViewable.
+		* @param r_viewable Le Viewable à mettre à jour.
+		* @return <code>true</code> si le Viewable a été mis à jour, <code>false</code> s'il doit être régénéré.
+		* @throw ViewableGenerationException si les données de l'image ne peuvent être mises à jour.
+		*
+		* Appelle la méthode AnimatedGLItem::updateViewable, sauf dans le cas où g_debug (fichier "gen.h") est vrai,
+		* où le Viewable est régénéré afin d'afficher les zones.
+		*
+		* Si cet objet est décoré (MapObject::m_decorated), le Viewable vide n'a pas à être mis à jour.
+		*/
+		virtual bool updateViewable(Viewable& r_viewable) const;
+		/**
 		* @brief Sérialise cet objet.
 		* @param r_ofs le flux en écriture.
 		*
@@ -322,6 +368,8 @@ class MapObject : public AnimatedGLItem, public Serializable, public Instruction
 		void setBoxAnimLinks(const map<PfAnimationStatus, vector<pair<PfBoxType, unsigned int> > >& links) {m_boxAnimLinks_v_map = links;}
 		const PfPoint& getCenter() const {return m_center;}
 		void setCenter(const PfPoint& center) {m_center = center;}
+		bool isDecorated() const {return m_decorated;}
+		void setDecorated(bool decorated) {m_decorated = decorated;}
 
 	protected:
 		/*
@@ -400,6 +448,7 @@ class MapObject : public AnimatedGLItem, public Serializable, public Instruction
 		int m_objCode; //!< Code objet.
 		map<PfAnimationStatus, vector<pair<PfBoxType, unsigned int> > > m_boxAnimLinks_v_map; //!< La liste des liens animations <-> zones.
 		PfPoint m_center; //!< Le centre d'un objet, servant notamment à son placement sur la map lors d'un clic dans l'éditeur.
+		bool m_decorated; //!< Indique si les images de cet objet sont affichées par une couche DecorationLayer plutôt que par son propre Viewable.
 };
 
 #endif // MAPOBJECT_H_INCLUDED
@@ -0,0 +1,222 @@
+#include "mapprefetcher.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include "errors.h"
+#include "misc.h"
+#include "mappedfile.h"
+#include "profiler.h"
+
+#define PAGE_SIZE_GUESS 4096 // un pas de lecture inférieur ou égal à la taille d'une page mémoire
+
+// lit un octet par page afin que le système charge le fichier projeté depuis le disque
+static void touchPages(const MappedFile& rc_file)
+{
+	volatile unsigned char byte = 0;
+	for (unsigned int i=0, size=rc_file.getSize();i<size;i+=PAGE_SIZE_GUESS)
+		byte = byte + (unsigned char) rc_file.getData()[i];
+}
+
+// PrefetchedMap
+
+PrefetchedMap::PrefetchedMap(MappedFile* pn_file) : pn_file(pn_file) {}
+
+PrefetchedMap::~PrefetchedMap()
+{
+	delete pn_file;
+}
+
+// MapPrefetcher
+
+PrefetchedMap* MapPrefetcher::readMap(const string& fileName)
+{
+	string str(string(MAPS_DIR) + fileName);
+	PrefetchedMap* pn_data = 0;
+	try
+	{
+		pn_data = new PrefetchedMap(new MappedFile(str));
+		MappedFile& r_file = *(pn_data->pn_file);
+		touchPages(r_file);
+
+		int tmp;
+		r_file.read(&tmp, sizeof(int));
+		if (tmp != PFGAME_VERSION)
+		{
+			throw FileException(__LINE__, __FILE__, string("Le fichier ") + fileName + " n'est pas de la version la plus récente.\n\tVersion actuelle : "
+                       + itostr(PFGAME_VERSION) + "\n\tVersion du fichier : " + itostr(tmp), str);
+		}
+
+		r_file.read(&tmp, sizeof(int)); // passer STRING_FLAG
+		pn_data->wadName = r_file.readString();
+		if (pn_data->wadName == "")
+			throw PfException(__LINE__, __FILE__, string("Le fichier ") + fileName + " fait référence à un wad inexistant.");
+
+		pn_data->mapData = DataPackage(r_file);
+		pn_data->objectsData = DataPackage(r_file);
+	}
+	catch (PfException& e)
+	{
+		delete pn_data;
+		throw PfException(__LINE__, __FILE__, string("Impossible de lire la map ") + fileName + ".", e);
+	}
+
+	return pn_data;
+}
+
+MapPrefetcher::MapPrefetcher(unsigned int budget) :
+	m_budget(budget), m_residentSize(0), m_stop(false), mp_thread(0), mp_mutex(0), mp_requestCond(0), mp_readCond(0)
+{
+	mp_mutex = SDL_CreateMutex();
+	mp_requestCond = SDL_CreateCond();
+	mp_readCond = SDL_CreateCond();
+	if (mp_mutex == 0 || mp_requestCond == 0 || mp_readCond == 0)
+	{
+		if (mp_mutex != 0)
+			SDL_DestroyMutex(mp_mutex);
+		if (mp_requestCond != 0)
+			SDL_DestroyCond(mp_requestCond);
+		if (mp_readCond != 0)
+			SDL_DestroyCond(mp_readCond);
+		throw ConstructorException(__LINE__, __FILE__, string("Impossible de créer les objets de synchronisation : ") + SDL_GetError(), "MapPrefetcher");
+	}
+
+	mp_thread = SDL_CreateThread(prefetchThread, "MapPrefetch", this);
+	if (mp_thread == 0) // les maps seront lues lors du passage
+		LOG("Impossible de créer le thread de lecture des maps : " << SDL_GetError() << "\n");
+}
+
+MapPrefetcher::~MapPrefetcher()
+{
+	if (mp_thread != 0)
+	{
+		SDL_LockMutex(mp_mutex);
+		m_stop = true;
+		SDL_CondBroadcast(mp_requestCond);
+		SDL_UnlockMutex(mp_mutex);
+
+		SDL_WaitThread(mp_thread, 0);
+	}
+
+	for (map<string, PrefetchedMap*>::iterator it=mpn_maps_map.begin();it!=mpn_maps_map.end();++it)
+		delete it->second;
+
+	SDL_DestroyMutex(mp_mutex);
+	SDL_DestroyCond(mp_requestCond);
+	SDL_DestroyCond(mp_readCond);
+}
+
+void MapPrefetcher::request(const string& fileName)
+{
+	if (mp_thread == 0 || fileName == "")
+		return;
+
+	SDL_LockMutex(mp_mutex);
+	if (mpn_maps_map.find(fileName) != mpn_maps_map.end())
+	{
+		m_recent_list.remove(fileName);
+		m_recent_list.push_front(fileName);
+	}
+	else if (fileName != m_current && find(m_pending_list.begin(), m_pending_list.end(), fileName) == m_pending_list.end())
+	{
+		m_pending_list.push_back(fileName);
+		SDL_CondSignal(mp_requestCond);
+	}
+	SDL_UnlockMutex(mp_mutex);
+}
+
+PrefetchedMap* MapPrefetcher::adopt(const string& fileName)
+{
+	if (mp_thread == 0 || fileName == "")
+		return 0;
+
+	SDL_LockMutex(mp_mutex);
+	m_pending_list.remove(fileName);
+	while (m_current == fileName)
+		SDL_CondWait(mp_readCond, mp_mutex);
+
+	PrefetchedMap* p_data = 0;
+	map<string, PrefetchedMap*>::iterator it = mpn_maps_map.find(fileName);
+	if (it != mpn_maps_map.end())
+	{
+		p_data = it->second;
+		m_residentSize -= p_data->pn_file->getSize();
+		mpn_maps_map.erase(it);
+		m_recent_list.remove(fileName);
+	}
+	SDL_UnlockMutex(mp_mutex);
+
+	return p_data;
+}
+
+unsigned int MapPrefetcher::residentSize() const
+{
+	SDL_LockMutex(mp_mutex);
+	unsigned int size = m_residentSize;
+	SDL_UnlockMutex(mp_mutex);
+
+	return size;
+}
+
+int MapPrefetcher::prefetchThread(void* p_prefetcher)
+{
+	((MapPrefetcher*) p_prefetcher)->prefetchMaps();
+
+	return 0;
+}
+
+void MapPrefetcher::prefetchMaps()
+{
+	string fileName;
+	PrefetchedMap* p_data;
+
+	#ifdef PROFILING
+	Profiler::nameThread("MapPrefetch");
+	#endif
+
+	SDL_LockMutex(mp_mutex);
+	while (true)
+	{
+		while (!m_stop && m_pending_list.empty())
+			SDL_CondWait(mp_requestCond, mp_mutex);
+		if (m_stop)
+			break;
+
+		fileName = m_current = m_pending_list.front();
+		m_pending_list.pop_front();
+		SDL_UnlockMutex(mp_mutex);
+
+		// lecture hors du mutex, aucune exception ne doit quitter le thread
+		p_data = 0;
+		try
+		{
+			PROFILE_SCOPE("readMap");
+			p_data = readMap(fileName);
+		}
+		catch (exception&) {} // la map sera relue lors du passage, qui signalera l'erreur
+
+		SDL_LockMutex(mp_mutex);
+		m_current.clear();
+		if (p_data != 0)
+		{
+			mpn_maps_map.insert(pair<string, PrefetchedMap*>(fileName, p_data));
+			m_recent_list.push_front(fileName);
+			m_residentSize += p_data->pn_file->getSize();
+			evict();
+		}
+		SDL_CondBroadcast(mp_readCond);
+	}
+	SDL_UnlockMutex(mp_mutex);
+}
+
+void MapPrefetcher::evict()
+{
+	map<string, PrefetchedMap*>::iterator it;
+	while (m_residentSize > m_budget && !m_recent_list.empty())
+	{
+		it = mpn_maps_map.find(m_recent_list.back());
+		m_residentSize -= it->second->pn_file->getSize();
+		delete it->second;
+		mpn_maps_map.erase(it);
+		m_recent_list.pop_back();
+	}
+}
@@ -0,0 +1,153 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe MapPrefetcher.
+* @date xx/xx/xxxx
+*/
+
+#ifndef MAPPREFETCHER_H_INCLUDED
+#define MAPPREFETCHER_H_INCLUDED
+
+#include "gen.h"
+
+#include <string>
+#include <list>
+#include <map>
+#include <SDL.h>
+#include "noncopyable.h"
+#include "datapackage.h"
+
+class MappedFile;
+
+/**
+* @brief Structure regroupant les données d'un fichier map, lues et vérifiées mais pas encore converties en objets.
+*
+* Les DataPackage lisent leurs valeurs en place dans le fichier projeté, détruit avec cette structure.
+*/
+struct PrefetchedMap : private NonCopyable
+{
+	/**
+	* @brief Constructeur PrefetchedMap.
+	* @param pn_file Le fichier projeté, détruit par cette structure.
+	*/
+	explicit PrefetchedMap(MappedFile* pn_file);
+	/**
+	* @brief Destructeur PrefetchedMap.
+	*
+	* Détruit le fichier projeté.
+	*/
+	~PrefetchedMap();
+
+	MappedFile* pn_file; //!< Le fichier projeté.
+	string wadName; //!< Le nom du wad utilisé par la map.
+	DataPackage mapData; //!< Les données de la map (constructeur Map::Map(DataPackage&)).
+	DataPackage objectsData; //!< Les données des objets et de l'arrière-plan de la map.
+};
+
+/**
+* @brief Lecture en tâche de fond des fichiers map liés à la map en cours.
+*
+* Les maps demandées (MapPrefetcher::request) sont lues par un thread de travail au moyen de la méthode MapPrefetcher::readMap :
+* le fichier est projeté en mémoire, ses pages sont parcourues pour être chargées depuis le disque, puis ses DataPackage sont vérifiés.
+* Lors du passage à une map liée, le modèle récupère ces données (MapPrefetcher::adopt) au lieu de relire le fichier.
+*
+* Les maps lues sont conservées tant que la somme de leurs tailles ne dépasse pas le budget MapPrefetcher::m_budget.
+* Au-delà, les maps les moins récemment demandées sont abandonnées.
+*
+* La création de la map et de ses objets reste à la charge du thread propriétaire du contexte OpenGL,
+* car elle ajoute des textures (wad et textures de terrain).
+*
+* Si le thread ne peut pas être créé, les demandes sont ignorées et les maps sont lues lors du passage, comme sans cette classe.
+*/
+class MapPrefetcher : private NonCopyable
+{
+	public:
+		/**
+		* @brief Lit et vérifie un fichier map.
+		* @param fileName Le nom du fichier dans le répertoire MAPS_DIR (fichier "gen.h").
+		* @return Les données de la map, à détruire par l'appelant.
+		* @throw PfException si le fichier ne peut pas être lu, s'il n'est pas de la version la plus récente ou si ses données sont invalides.
+		*
+		* Cette fonction n'utilise ni OpenGL ni aucune variable globale, elle peut être appelée par n'importe quel thread.
+		*/
+		static PrefetchedMap* readMap(const string& fileName);
+
+		/*
+		* Constructeurs et destructeur
+		* ----------------------------
+		*/
+		/**
+		* @brief Constructeur MapPrefetcher.
+		* @param budget La taille maximale en octets des maps conservées.
+		* @throw ConstructorException si les objets de synchronisation ne peuvent pas être créés.
+		*/
+		explicit MapPrefetcher(unsigned int budget = MAP_PREFETCH_BUDGET);
+		/**
+		* @brief Destructeur MapPrefetcher.
+		*
+		* Attend la fin de la lecture en cours, abandonne les autres et détruit les maps non récupérées.
+		*/
+		~MapPrefetcher();
+		/*
+		* Méthodes
+		* --------
+		*/
+		/**
+		* @brief Demande la lecture d'une map en tâche de fond.
+		* @param fileName Le nom du fichier dans le répertoire MAPS_DIR (fichier "gen.h").
+		*
+		* Si la map est déjà lue, elle devient la plus récemment demandée.
+		*/
+		void request(const string& fileName);
+		/**
+		* @brief Récupère une map lue en tâche de fond.
+		* @param fileName Le nom du fichier dans le répertoire MAPS_DIR (fichier "gen.h").
+		* @return Les données de la map, à détruire par l'appelant, 0 si la map n'a pas été lue.
+		*
+		* Si la map est en cours de lecture, cette méthode attend la fin de celle-ci.
+		* Si elle est seulement en attente, sa demande est annulée.
+		*/
+		PrefetchedMap* adopt(const string& fileName);
+		/**
+		* @brief Retourne la taille des maps conservées.
+		* @return La taille en octets.
+		*/
+		unsigned int residentSize() const;
+		/*
+		* Accesseurs
+		* ----------
+		*/
+		unsigned int getBudget() const {return m_budget;} //!< Accesseur.
+
+	private:
+		/**
+		* @brief Fonction exécutée par le thread de lecture.
+		* @param p_prefetcher Le MapPrefetcher.
+		* @return 0.
+		*/
+		static int prefetchThread(void* p_prefetcher);
+		/**
+		* @brief Lit les maps demandées jusqu'à l'arrêt de ce MapPrefetcher.
+		*/
+		void prefetchMaps();
+		/**
+		* @brief Abandonne les maps les moins récemment demandées jusqu'à respecter le budget.
+		*
+		* Le mutex doit être verrouillé.
+		*/
+		void evict();
+
+		unsigned int m_budget; //!< La taille maximale en octets des maps conservées.
+		unsigned int m_residentSize; //!< La taille en octets des maps conservées.
+		map<string, PrefetchedMap*> mpn_maps_map; //!< Les maps lues, par nom de fichier.
+		list<string> m_recent_list; //!< Les noms des maps lues, de la plus récemment demandée à la plus ancienne.
+		list<string> m_pending_list; //!< Les noms des maps à lire, dans l'ordre des demandes.
+		string m_current; //!< Le nom de la map en cours de lecture, vide si aucune.
+		bool m_stop; //!< Indique au thread qu'il doit s'arrêter.
+		SDL_Thread* mp_thread; //!< Le thread de lecture, 0 s'il n'a pas pu être créé.
+		SDL_mutex* mp_mutex; //!< Le mutex protégeant les membres ci-dessus.
+		SDL_cond* mp_requestCond; //!< Signalé à une demande ou à l'arrêt.
+		SDL_cond* mp_readCond; //!< Signalé à la fin d'une lecture.
+};
+
+#endif // MAPPREFETCHER_H_INCLUDED
@@ -3,6 +3,7 @@
 #include "errors.h"
 #include "misc.h"
 #include "glfunc.h"
+#include "textureatlas.h"
 #include "enum.h"
 
 unsigned int PfMapTextureSet::s_newTerrainIndex = TERRAIN_TEXTURE_INDEX;
@@ -45,16 +46,19 @@ PfMapTextureSet::PfMapTextureSet(const string& texName) : m_name(texName)
 			g_texIndexes_map[texName] = s_newTerrainIndex;
 		}
 
+		// les fichiers de terrain, de falaises, de débordements et de bordures sont regroupés dans un atlas
+		TextureAtlas atlas;
 		int counter;
 		ifs.read((char*) &counter, sizeof(int));
 		for (int i=0;i<counter;i++)
 		{
 			if (i > 0)
 				m_terrainIDs_v.push_back(m_terrainIDs_v[0]+1);
-			addTexture(ifs, m_terrainIDs_v[i]);
+			addTexture(ifs, m_terrainIDs_v[i], atlas);
 			if (m_terrainIDs_v[i] >= s_newTerrainIndex)
 				s_newTerrainIndex++;
 		}
+		addAtlas(atlas);
 
 		// Remplissages par défaut
 
@@ -57,6 +57,9 @@ PfRectangle rectFromTextureIndex(int index, unsigned int rowsCount = TERRAIN_CEL
 * Ainsi, si la texture a déjà été ajoutée au contexte OpenGL, le champ statique
 * PfMapTextureSet::s_newTerrainIndex n'est pas utilisé ni incrémenté, les textures ne sont pas rechargées.
 *
+* Les fichiers d'un jeu de textures sont regroupés dans un TextureAtlas (fichier "textureatlas.h" de la bibliothèque PfMedia) :
+* les images du terrain, de ses falaises, débordements et bordures sont ainsi rendues sans changement de texture.
+*
 * Les textures du terrain de base ont chacune une priorité en cas de recouvrement. Par défaut, cette priorité est 0.
 * La map PfMapTextureSet::m_spreadingLayers_map associe à chaque case une priorité.
 * Si deux priorités sont égales, l'indice de la case détermine la priorité, l'indice le plus élevé étant au plan le plus en avant.
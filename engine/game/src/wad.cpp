@@ -3,7 +3,10 @@
 #include "glitem.h"
 #include "misc.h"
 #include "errors.h"
+#include "binaryreader.h"
 #include "glfunc.h"
+#include "pngdecodingpool.h"
+#include "textureatlas.h"
 #include "fmodfunc.h"
 #include "pfgui.h"
 #include "mapobject.h"
@@ -18,67 +21,39 @@
 
 bool PfWad::s_wadOpen = false;
 unsigned int PfWad::s_maxTextureIndex = 0;
-map<string, unsigned int> g_wadFirstIndexes_map;
+map<string, PfWadCatalog*> PfWad::s_catalogs_map;
 
-PfWad::PfWad(const string& wadName) : m_resCount(0), m_totalTextCount(0), m_totalSoundCount(0), m_currentLoadStep(0), m_name(wadName), m_prevSoundsCount(0)
+PfWad::PfWad(const string& wadName) : m_totalTextCount(0), m_totalSoundCount(0), m_currentLoadStep(0), m_name(wadName), mpn_catalog(0), mpn_decodingPool(0), mpn_atlas(0)
 {
 	if (s_wadOpen)
 		throw PfException(__LINE__, __FILE__, "Impossible de créer l'objet PfWad : un PfWad est déjà ouvert.");
 
-	string str = string(WAD_DIR) + wadName + "." + WAD_EXT;
-	ifstream ifs(str.c_str(), ios::binary);
-
-	int val;
-
-	unsigned int offset = s_maxTextureIndex;
-    if (g_wadFirstIndexes_map.find(wadName) != g_wadFirstIndexes_map.end())
-        offset = g_wadFirstIndexes_map[wadName];
 	try
 	{
-		// Tests de validité
-
-		if (!ifs.is_open())
-			throw FileException(__LINE__, __FILE__, "impossible d'ouvrir le fichier.", wadName + "." + WAD_EXT);
-
-		ifs.read((char*) &val, sizeof(int));
-		if (val != PFGAME_VERSION)
-		{
-			ifs.close();
-			throw FileException(__LINE__, __FILE__, string("ce fichier est d'une version dépassée (version ") + itostr(val) + "). La version actuelle est " + itostr(PFGAME_VERSION) + ".", wadName + "." + WAD_EXT);
-		}
-
-		// Ajout des ressources
-
-		addRes(ifs, offset);
-		addSlots(ifs, offset);
-
-		if (ifs.fail())
-        {
-            ifs.close();
-            throw FileException(__LINE__, __FILE__, "fichier WAD non valide.", wadName + "." + WAD_EXT);
-        }
-
-		ifs.close();
+		useCatalog(*loadCatalog(wadName));
 	}
 	catch (PfException& e)
 	{
-		if (ifs.is_open())
-			ifs.close();
 		throw ConstructorException(__LINE__, __FILE__, string("impossible de créer le WAD ") + wadName + ".", "PfWad", e);
 	}
 
-	g_wadFirstIndexes_map.insert(pair<string, unsigned int>(wadName, offset));
-
 	s_wadOpen = true;
 }
 
-PfWad::PfWad(const string& wadName, const string& menuName, const string& menuWadName) : m_resCount(0),
-m_totalTextCount(0), m_totalSoundCount(0), m_currentLoadStep(0), m_name(wadName), m_prevSoundsCount(0)
+PfWad::PfWad(const string& wadName, const string& menuName, const string& menuWadName) : m_totalTextCount(0), m_totalSoundCount(0),
+m_currentLoadStep(0), m_name(wadName), mpn_catalog(0), mpn_decodingPool(0), mpn_atlas(0)
 {
 	if (s_wadOpen)
 		throw PfException(__LINE__, __FILE__, "Impossible de créer l'objet PfWad : un PfWad est déjà ouvert.");
 
-    unsigned int offset;
+	map<string, PfWadCatalog*>::iterator catIt = s_catalogs_map.find(wadName);
+	if (catIt != s_catalogs_map.end()) // wad déjà lu : rien à charger, le menu de progression est inutile
+	{
+		useCatalog(*(catIt->second));
+		s_wadOpen = true;
+		return;
+	}
+
 	try
 	{
 		PfWad* p_wad = new PfWad(menuWadName);
@@ -90,12 +65,8 @@ m_totalTextCount(0), m_totalSoundCount(0), m_currentLoadStep(0), m_name(wadName)
 		if (!ifs.is_open())
 			throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", wadStr);
 
-		unsigned int uval = 0;
+		unsigned int uval = 0, offset = s_maxTextureIndex;
 		int ival = 0, preVal = -1;
-
-		offset = s_maxTextureIndex;
-        if (g_wadFirstIndexes_map.find(wadName) != g_wadFirstIndexes_map.end())
-            offset = g_wadFirstIndexes_map[wadName];
 
 		ifs.read((char*) &ival, sizeof(int));
 		if (ival != PFGAME_VERSION)
@@ -104,6 +75,7 @@ m_totalTextCount(0), m_totalSoundCount(0), m_currentLoadStep(0), m_name(wadName)
 			ifs.close();
 			throw FileException(__LINE__, __FILE__, string("ce fichier est d'une version dépassée (version ") + itostr(ival) + "). La version actuelle est " + itostr(PFGAME_VERSION) + ".", wadStr);
 		}
+		BinaryReader reader(ifs);
 		do
 		{
 			if (m_totalTextCount > 0 || m_totalSoundCount > 0)
@@ -115,31 +87,52 @@ m_totalTextCount(0), m_totalSoundCount(0), m_currentLoadStep(0), m_name(wadName)
 				p_loadingMVCSystem->run(true);
 				preVal = ival;
 			}
-			uval = loadStepByStep(ifs, offset);
+			uval = loadStepByStep(reader, offset);
 		} while (uval != 0);
 		ifs.close();
 		delete p_loadingMVCSystem;
 	}
 	catch (PfException& e)
 	{
+		if (mpn_decodingPool != 0)
+		{
+			delete mpn_decodingPool;
+			mpn_decodingPool = 0;
+		}
+		if (mpn_atlas != 0)
+		{
+			delete mpn_atlas;
+			mpn_atlas = 0;
+		}
+		if (mpn_catalog != 0)
+		{
+			delete mpn_catalog;
+			mpn_catalog = 0;
+		}
 		throw ConstructorException(__LINE__, __FILE__, "Erreur de lecture des fichiers.", "PfWad", e);
 	}
 
-	g_wadFirstIndexes_map.insert(pair<string, unsigned int>(wadName, offset));
-
 	s_wadOpen = true;
 }
 
 PfWad::~PfWad()
 {
+	if (mpn_decodingPool != 0)
+		delete mpn_decodingPool;
+	if (mpn_atlas != 0)
+		delete mpn_atlas;
+	if (mpn_catalog != 0)
+		delete mpn_catalog;
 	s_wadOpen = false;
 }
 
 AnimatedGLItem* PfWad::generateGLItem(PfWadSlot slot, const PfRectangle& rectangle, int layer, int value1, int value2, float value3, float value4, PfGameMode gameMode)
 {
-	if (m_wadObjects_map.find(slot) == m_wadObjects_map.end())
+	const PfWadObject* q_object = wadObject(slot);
+	if (q_object == 0)
 		throw ArgumentException(__LINE__, __FILE__, string("Le slot ") + textFrom(slot) + " n'est pas dans le wad " + m_name + ".", "slot", "PfWad::generateGLItem");
-	if (m_wadObjects_map[slot].frames_v_map.size() == 0)
+	const PfWadObject& rc_object = *q_object;
+	if (rc_object.frames_v_map.size() == 0)
 		throw PfException(__LINE__, __FILE__, string("L'objet au slot ") + textFrom(slot) + " n'a pas d'animation.");
 
 	AnimatedGLItem* p_rtn = 0;
@@ -156,11 +149,11 @@ AnimatedGLItem* PfWad::generateGLItem(PfWadSlot slot, const PfRectangle& rectang
 
 	// pour les widgets : choix de la map d'animations
 	PfWidget::PfWidgetStatusMap stMap = PfWidget::WIDGET_IDLE_MAP;
-	if (m_wadObjects_map[slot].frames_v_map.find(ANIM_HIGHLIGHTED) != m_wadObjects_map[slot].frames_v_map.end())
+	if (rc_object.frames_v_map.find(ANIM_HIGHLIGHTED) != rc_object.frames_v_map.end())
 		stMap = PfWidget::WIDGET_HIGHLIGHT_MAP;
-	if (m_wadObjects_map[slot].frames_v_map.find(ANIM_SELECTED) != m_wadObjects_map[slot].frames_v_map.end())
+	if (rc_object.frames_v_map.find(ANIM_SELECTED) != rc_object.frames_v_map.end())
 		stMap = PfWidget::WIDGET_SELECT_MAP;
-	if (m_wadObjects_map[slot].frames_v_map.find(ANIM_ACTIVATED) != m_wadObjects_map[slot].frames_v_map.end())
+	if (rc_object.frames_v_map.find(ANIM_ACTIVATED) != rc_object.frames_v_map.end())
 		stMap = PfWidget::WIDGET_STANDARD_MAP;
 	// fin du traitement widgets
 
@@ -203,13 +196,13 @@ AnimatedGLItem* PfWad::generateGLItem(PfWadSlot slot, const PfRectangle& rectang
 					break;
 			}
 
-			z_it = m_wadObjects_map[slot].zones_v_map.find(BOX_TYPE_MAIN);
-			if (z_it != m_wadObjects_map[slot].zones_v_map.end() && z_it->second.size() > 0)
+			z_it = rc_object.zones_v_map.find(BOX_TYPE_MAIN);
+			if (z_it != rc_object.zones_v_map.end() && z_it->second.size() > 0)
 				p_rtn->setRect(PfRectangle(p_rtn->rect_x(), p_rtn->rect_y(), z_it->second[0].getRect().getW(), z_it->second[0].getRect().getH()));
             for (int i=1;i<ENUM_PF_BOX_TYPE_COUNT;i++)
             {
-                z_it = m_wadObjects_map[slot].zones_v_map.find((PfBoxType) i);
-                if (z_it != m_wadObjects_map[slot].zones_v_map.end())
+                z_it = rc_object.zones_v_map.find((PfBoxType) i);
+                if (z_it != rc_object.zones_v_map.end())
                 {
                     for (unsigned int j=0, size=z_it->second.size();j<size;j++)
                         (dynamic_cast<MapObject*>(p_rtn))->addZone(z_it->first, z_it->second[j]);
@@ -217,8 +210,8 @@ AnimatedGLItem* PfWad::generateGLItem(PfWadSlot slot, const PfRectangle& rectang
             }
             if (slot != WAD_BACKGROUND)
             {
-                (dynamic_cast<MapObject*>(p_rtn))->setBoxAnimLinks(m_wadObjects_map[slot].boxAnimLinks_v_map);
-                (dynamic_cast<MapObject*>(p_rtn))->setCenter(m_wadObjects_map[slot].center);
+                (dynamic_cast<MapObject*>(p_rtn))->setBoxAnimLinks(rc_object.boxAnimLinks_v_map);
+                (dynamic_cast<MapObject*>(p_rtn))->setCenter(rc_object.center);
             }
 			break;
 		default:
@@ -275,18 +268,22 @@ AnimatedGLItem* PfWad::generateGLItem(PfWadSlot slot, const PfRectangle& rectang
 
 	// Ajout des animations
 
-	for (map<PfAnimationStatus, vector<PfAnimationFrame> >::iterator it=m_wadObjects_map[slot].frames_v_map.begin();it!=m_wadObjects_map[slot].frames_v_map.end();++it)
+	map<PfAnimationStatus, pfflag32>::const_iterator flagsIt;
+	pfflag32 flags;
+	for (map<PfAnimationStatus, vector<PfAnimationFrame> >::const_iterator it=rc_object.frames_v_map.begin();it!=rc_object.frames_v_map.end();++it)
 	{
+		flagsIt = rc_object.flags_map.find(it->first);
+		flags = (flagsIt != rc_object.flags_map.end())?flagsIt->second:0;
 		PfAnimation* p_anim = new PfAnimation;
 		for (unsigned int i=0, size=it->second.size();i<size;i++)
 		{
 			PfAnimationFrame* p_frame = new PfAnimationFrame(it->second[i]);
-			if (m_wadObjects_map[slot].flags_map[it->first] & WADMSC_TURNABLE)
+			if (flags & WADMSC_TURNABLE)
 				p_frame->addProperties(PfAnimationFrame::FRAME_TURNABLE);
 			p_anim->addFrame(p_frame);
 		}
 		p_anim->reset();
-		if (m_wadObjects_map[slot].flags_map[it->first] & WADMSC_LOOP)
+		if (flags & WADMSC_LOOP)
 			p_anim->setLoop(true);
 		p_rtn->addAnimation(p_anim, it->first);
 	}
@@ -314,54 +311,36 @@ AnimatedGLItem* PfWad::generateGLItem(PfWadSlot slot, const PfRectangle& rectang
 
 void PfWad::addWad(const string& wadName)
 {
-	string str = string(WAD_DIR) + wadName + "." + WAD_EXT;
-	ifstream ifs(str.c_str(), ios::binary);
-
-	if (!ifs.is_open())
-		throw FileException(__LINE__, __FILE__, "impossible d'ouvrir le fichier.", wadName + "." + WAD_EXT);
-
-    m_prevSoundsCount = m_sounds_v.size();
-
-	int val;
-	ifs.read((char*) &val, sizeof(int));
-	if (val != PFGAME_VERSION)
+	const PfWadCatalog* q_catalog;
+	try
 	{
-	   	ifs.close();
-	   	throw FileException(__LINE__, __FILE__, string("ce fichier est d'une version dépassée (version ") + itostr(val) + "). La version actuelle est " + itostr(PFGAME_VERSION) + ".", wadName + "." + WAD_EXT);
+		q_catalog = loadCatalog(wadName);
 	}
-
-	unsigned int offset = s_maxTextureIndex;
-    if (g_wadFirstIndexes_map.find(wadName) != g_wadFirstIndexes_map.end())
-        offset = g_wadFirstIndexes_map[wadName];
-	try
+	catch (FileException&)
 	{
-		addRes(ifs, offset);
-		addSlots(ifs, offset);
+		throw;
 	}
 	catch (PfException& e)
 	{
-		ifs.close();
 		throw ArgumentException(__LINE__, __FILE__, string("Le WAD ") + wadName + " n'est pas valide.", "wadName", "PfWad::addWad", e);
 	}
 
-	g_wadFirstIndexes_map.insert(pair<string, unsigned int>(wadName, offset));
-
-	ifs.close();
+	useCatalog(*q_catalog);
 }
-
+
 pair<unsigned int, PfRectangle> PfWad::icon(PfWadSlot slot) const
 {
     pair<unsigned int, PfRectangle> rtn;
 
-    map<PfWadSlot, PfWadObject>::const_iterator it = m_wadObjects_map.find(slot);
-    if (it == m_wadObjects_map.end())
+    map<PfWadSlot, const PfWadObject*>::const_iterator it = mq_wadObjects_map.find(slot);
+    if (it == mq_wadObjects_map.end())
         throw PfException(__LINE__, __FILE__, string("Impossible de trouver l'objet au slot ") + textFrom(slot) + ".");
-    if (it->second.frames_v_map.find(ANIM_IDLE) == it->second.frames_v_map.end())
+    if (it->second->frames_v_map.find(ANIM_IDLE) == it->second->frames_v_map.end())
         throw PfException(__LINE__, __FILE__, string("Animation ANIM_IDLE non trouvée, impossible de générer une icône au slot ") + textFrom(it->first) + ".");
-    if (it->second.frames_v_map.find(ANIM_IDLE)->second.size() == 0)
+    if (it->second->frames_v_map.find(ANIM_IDLE)->second.size() == 0)
         throw PfException(__LINE__, __FILE__, string("Animation ANIM_IDLE sans frame, impossible de générer une icône au slot ") + textFrom(it->first) + ".");
-    rtn = pair<unsigned int, PfRectangle>(it->second.frames_v_map.find(ANIM_IDLE)->second[0].getTextureIndex(),
-                                          it->second.frames_v_map.find(ANIM_IDLE)->second[0].textCoordRectangle());
+    rtn = pair<unsigned int, PfRectangle>(it->second->frames_v_map.find(ANIM_IDLE)->second[0].getTextureIndex(),
+                                          it->second->frames_v_map.find(ANIM_IDLE)->second[0].textCoordRectangle());
 
     return rtn;
 }
@@ -370,7 +349,7 @@ vector<pair<unsigned int, PfRectangle> > PfWad::icons(const set<PfWadSlot>& excl
 {
 	vector<pair<unsigned int, PfRectangle> > rtn_v;
 
-	for (map<PfWadSlot, PfWadObject>::const_iterator it=m_wadObjects_map.begin();it!=m_wadObjects_map.end();++it)
+	for (map<PfWadSlot, const PfWadObject*>::const_iterator it=mq_wadObjects_map.begin();it!=mq_wadObjects_map.end();++it)
 	{
 		if (excludedSlots_set.find(it->first) != excludedSlots_set.end())
 			continue;
@@ -384,7 +363,7 @@ vector<PfWadSlot> PfWad::slots(const set<PfWadSlot>& excludedSlots_set) const
 {
     vector<PfWadSlot> rtn_v;
 
-    for (map<PfWadSlot, PfWadObject>::const_iterator it=m_wadObjects_map.begin();it!=m_wadObjects_map.end();++it)
+    for (map<PfWadSlot, const PfWadObject*>::const_iterator it=mq_wadObjects_map.begin();it!=mq_wadObjects_map.end();++it)
     {
         if (excludedSlots_set.find(it->first) != excludedSlots_set.end())
 			continue;
@@ -396,37 +375,54 @@ vector<PfWadSlot> PfWad::slots(const set<PfWadSlot>& excludedSlots_set) const
 
 bool PfWad::hasSlot(PfWadSlot slot) const
 {
-    return (m_wadObjects_map.find(slot) != m_wadObjects_map.end());
+    return (mq_wadObjects_map.find(slot) != mq_wadObjects_map.end());
 }
 
-unsigned int PfWad::loadStepByStep(ifstream& r_ifs, unsigned int textureIndexOffset)
+unsigned int PfWad::loadStepByStep(BinaryReader& r_reader, unsigned int textureIndexOffset)
 {
 	if (m_currentLoadStep == 0)
-		r_ifs.read((char*) &m_totalTextCount, sizeof(unsigned int));
-	if (m_currentLoadStep == m_totalTextCount)
-		r_ifs.read((char*) &m_totalSoundCount, sizeof(unsigned int));
+	{
+		// toutes les images sont lues d'un coup puis décodées en parallèle, seul l'ajout au contexte OpenGL se fait pas à pas
+		r_reader.read((char*) &m_totalTextCount, sizeof(unsigned int));
+		if (mpn_catalog == 0)
+		{
+			mpn_catalog = new PfWadCatalog();
+			mpn_catalog->firstTextureIndex = textureIndexOffset;
+		}
+		if (mpn_decodingPool == 0)
+			mpn_decodingPool = new PNGDecodingPool();
+		if (mpn_atlas == 0)
+			mpn_atlas = new TextureAtlas();
+		for (unsigned int i=1;i<=m_totalTextCount;i++)
+		{
+			unsigned int ind = i + textureIndexOffset;
+			if (!queueTexture(r_reader, ind, *mpn_decodingPool))
+				m_currentLoadStep++;
+			if (ind >= s_maxTextureIndex)
+				s_maxTextureIndex++;
+		}
+	}
 
-	if (m_currentLoadStep < m_totalTextCount)
+	if (mpn_decodingPool != 0)
 	{
-		unsigned int ind = m_currentLoadStep + 1 + textureIndexOffset;
-		addTexture(r_ifs, ind);
-		if (ind >= s_maxTextureIndex)
-			s_maxTextureIndex++;
-		m_resCount++;
-		m_currentLoadStep++;
+		if (m_currentLoadStep < m_totalTextCount)
+			m_currentLoadStep += uploadDecodedTextures(*mpn_decodingPool, true, mpn_atlas);
+		if (m_currentLoadStep < m_totalTextCount)
+			return m_currentLoadStep;
+		delete mpn_decodingPool;
+		mpn_decodingPool = 0;
+		addAtlas(*mpn_atlas);
+		delete mpn_atlas;
+		mpn_atlas = 0;
+		r_reader.read((char*) &m_totalSoundCount, sizeof(unsigned int));
 	}
-	else if (m_currentLoadStep < m_totalTextCount + m_totalSoundCount)
+
+	if (m_currentLoadStep < m_totalTextCount + m_totalSoundCount)
 	{
-	   	string str;
-		char c;
-	   	do
-	   	{
-		   	r_ifs.read(&c, sizeof(char));
-		   	str.append(1, c);
-	   	} while (c != '\0' && r_ifs.good());
+	   	string str = r_reader.readString();
 		try
 		{
-	   		m_sounds_v.push_back(addSound(string(SOUNDS_DIR) + str, false));
+	   		mpn_catalog->sounds_v.push_back(addSound(string(SOUNDS_DIR) + str, false));
 		}
 		catch (PfException& e)
 		{
@@ -436,41 +432,114 @@ unsigned int PfWad::loadStepByStep(ifstream& r_ifs, unsigned int textureIndexOff
 	}
 	else
 	{
-		addSlots(r_ifs, textureIndexOffset);
+		addSlots(r_reader, *mpn_catalog);
+		map<string, PfWadCatalog*>::iterator it = s_catalogs_map.find(m_name);
+		if (it == s_catalogs_map.end())
+			it = s_catalogs_map.insert(pair<string, PfWadCatalog*>(m_name, mpn_catalog)).first;
+		else
+			delete mpn_catalog; // wad déjà lu par ailleurs, les ressources chargées sont les mêmes
+		mpn_catalog = 0;
+		useCatalog(*(it->second));
 		m_currentLoadStep = 0;
 	}
 
 	return m_currentLoadStep;
 }
 
-void PfWad::addRes(ifstream& r_ifs, unsigned int textureIndexOffset)
+void PfWad::freeCatalogs()
+{
+	for (map<string, PfWadCatalog*>::iterator it=s_catalogs_map.begin();it!=s_catalogs_map.end();++it)
+		delete it->second;
+	s_catalogs_map.clear();
+}
+
+PfWadCatalog* PfWad::loadCatalog(const string& wadName)
+{
+	map<string, PfWadCatalog*>::iterator it = s_catalogs_map.find(wadName);
+	if (it != s_catalogs_map.end())
+		return it->second;
+
+	string str = string(WAD_DIR) + wadName + "." + WAD_EXT;
+	ifstream ifs(str.c_str(), ios::binary);
+	if (!ifs.is_open())
+		throw FileException(__LINE__, __FILE__, "impossible d'ouvrir le fichier.", wadName + "." + WAD_EXT);
+
+	int val;
+	ifs.read((char*) &val, sizeof(int));
+	if (val != PFGAME_VERSION)
+	{
+		ifs.close();
+		throw FileException(__LINE__, __FILE__, string("ce fichier est d'une version dépassée (version ") + itostr(val) + "). La version actuelle est " + itostr(PFGAME_VERSION) + ".", wadName + "." + WAD_EXT);
+	}
+
+	PfWadCatalog* pn_catalog = new PfWadCatalog();
+	pn_catalog->firstTextureIndex = s_maxTextureIndex;
+	try
+	{
+		BinaryReader reader(ifs);
+		addRes(reader, *pn_catalog);
+		addSlots(reader, *pn_catalog);
+
+		if (reader.fail())
+			throw FileException(__LINE__, __FILE__, "fichier WAD non valide.", wadName + "." + WAD_EXT);
+	}
+	catch (PfException&)
+	{
+		delete pn_catalog;
+		ifs.close();
+		throw;
+	}
+	ifs.close();
+
+	s_catalogs_map.insert(pair<string, PfWadCatalog*>(wadName, pn_catalog));
+
+	return pn_catalog;
+}
+
+void PfWad::useCatalog(const PfWadCatalog& rc_catalog)
+{
+	for (map<PfWadSlot, PfWadObject>::const_iterator it=rc_catalog.wadObjects_map.begin();it!=rc_catalog.wadObjects_map.end();++it)
+	{
+		if (mq_wadObjects_map.find(it->first) != mq_wadObjects_map.end())
+			throw ArgumentException(__LINE__, __FILE__, string("Plusieurs définitions du slot ") + textFrom(it->first) + ".", "rc_catalog", "PfWad::useCatalog");
+	}
+	for (map<PfWadSlot, PfWadObject>::const_iterator it=rc_catalog.wadObjects_map.begin();it!=rc_catalog.wadObjects_map.end();++it)
+		mq_wadObjects_map.insert(pair<PfWadSlot, const PfWadObject*>(it->first, &(it->second)));
+}
+
+const PfWadObject* PfWad::wadObject(PfWadSlot slot) const
+{
+	map<PfWadSlot, const PfWadObject*>::const_iterator it = mq_wadObjects_map.find(slot);
+
+	return (it != mq_wadObjects_map.end())?it->second:0;
+}
+
+void PfWad::addRes(BinaryReader& r_reader, PfWadCatalog& r_catalog)
 {
 	unsigned int uint;
 	string str;
-	char c;
 
-	r_ifs.read((char*) &uint, sizeof(unsigned int));
+	// les images sont décodées en parallèle pendant la lecture du flux, puis regroupées dans un atlas ajouté au contexte OpenGL
+	PNGDecodingPool decodingPool;
+	TextureAtlas atlas;
+	r_reader.read((char*) &uint, sizeof(unsigned int));
 	for (unsigned int i=1;i<=uint;i++)
 	{
-		unsigned int ind = i + textureIndexOffset;
-	   	addTexture(r_ifs, ind);
+		unsigned int ind = i + r_catalog.firstTextureIndex;
+	   	queueTexture(r_reader, ind, decodingPool);
 		if (ind >= s_maxTextureIndex) // ne pas incrémenter quand il n'y a pas chargement
 			s_maxTextureIndex++;
-		m_resCount++;
 	}
+	while (uploadDecodedTextures(decodingPool, true, &atlas) > 0) {}
+	addAtlas(atlas);
 
-	r_ifs.read((char*) &uint, sizeof(unsigned int));
+	r_reader.read((char*) &uint, sizeof(unsigned int));
 	for (unsigned int i=1;i<=uint;i++)
 	{
-	   	str.clear();
-	   	do
-	   	{
-		   	r_ifs.read(&c, sizeof(char));
-		   	str.append(1, c);
-	   	} while (c != '\0' && r_ifs.good());
+	   	str = r_reader.readString();
 		try
 		{
-	   		m_sounds_v.push_back(addSound(string(SOUNDS_DIR) + str, false));
+	   		r_catalog.sounds_v.push_back(addSound(string(SOUNDS_DIR) + str, false));
 		}
 		catch (PfException& e)
 		{
@@ -479,7 +548,7 @@ void PfWad::addRes(ifstream& r_ifs, unsigned int textureIndexOffset)
 	}
 }
 
-void PfWad::addSlots(ifstream& r_ifs, unsigned int textureIndexOffset)
+void PfWad::addSlots(BinaryReader& r_reader, PfWadCatalog& r_catalog)
 {
 	int val, val2;
 	float fVal, fVal2;
@@ -494,101 +563,101 @@ void PfWad::addSlots(ifstream& r_ifs, unsigned int textureIndexOffset)
 	pfflag32 flags;
 	PfRectangle rect, mainRect;
 
-	while (r_ifs.good())
+	while (r_reader.good())
 	{
 		flags = WADMSC_NONE;
 
-		r_ifs.read((char*) &val, sizeof(int));
+		r_reader.read((char*) &val, sizeof(int));
 		if (val == END_OF_LIST_INT)
 			break;
-        r_ifs.read((char*) &val, sizeof(int)); // on relit une valeur car la première est donc NEW_SLOT_FLAG.
+        r_reader.read((char*) &val, sizeof(int)); // on relit une valeur car la première est donc NEW_SLOT_FLAG.
 		if (val < 0 || val >= ENUM_PF_WAD_SLOT_COUNT)
 			throw PfException(__LINE__, __FILE__, "Le slot lu n'est pas valide.");
 
 		PfWadSlot s = (PfWadSlot) val;
 
-		if (m_wadObjects_map.find(s) != m_wadObjects_map.end())
+		if (r_catalog.wadObjects_map.find(s) != r_catalog.wadObjects_map.end())
 			throw PfException(__LINE__, __FILE__, string("Plusieurs définitions du slot ") + textFrom(s) + ".");
 
-        r_ifs.read((char*) &count, sizeof(int));
-		if (r_ifs.fail())
+        r_reader.read((char*) &count, sizeof(int));
+		if (r_reader.fail())
 			break;
         colHeight = 1.0; // hauteur de collision par défaut
         for (int i=0;i<count;i++) // nombre de propriétés
         {
-            r_ifs.read((char*) &val, sizeof(int));
+            r_reader.read((char*) &val, sizeof(int));
 			if (val < 0 || val >= ENUM_PF_WAD_OBJ_PROPERTY_COUNT)
 				throw PfException(__LINE__, __FILE__, "Propriété d'objet non valide.");
             switch ((PfWadObjProperty) val)
             {
             case WADOBJ_COLHEIGHT:
-                r_ifs.read((char*) &colHeight, sizeof(float));
+                r_reader.read((char*) &colHeight, sizeof(float));
                 break;
             case WADOBJ_BOX:
-                r_ifs.read((char*) &boxType, sizeof(PfBoxType));
+                r_reader.read((char*) &boxType, sizeof(PfBoxType));
                 for (int k=0;k<4;k++)
-                    r_ifs.read((char*) &coord[k], sizeof(float));
+                    r_reader.read((char*) &coord[k], sizeof(float));
                 if (boxType == BOX_TYPE_MAIN)
                     rect = mainRect = PfRectangle(0.0, 0.0, coord[2]*MAP_CELL_SIZE, coord[3]*MAP_CELL_SIZE);
                 else
                 {
-                    if (m_wadObjects_map[s].zones_v_map.find(BOX_TYPE_MAIN) == m_wadObjects_map[s].zones_v_map.end())
+                    if (r_catalog.wadObjects_map[s].zones_v_map.find(BOX_TYPE_MAIN) == r_catalog.wadObjects_map[s].zones_v_map.end())
                         throw PfException(__LINE__, __FILE__, "BOX_TYPE_MAIN non définie, impossible de générer une autre box.");
                     rect = PfRectangle(coord[0]*mainRect.getW(),
                                        coord[1]*mainRect.getH(),
                                        coord[2]*mainRect.getW(),
                                        coord[3]*mainRect.getH());
                 }
-                m_wadObjects_map[s].zones_v_map[boxType].push_back(MapZone(rect, MAP_CELL_SQUARE_HEIGHT, (colHeight+FLOAT_MARGIN)*MAP_CELL_SQUARE_HEIGHT));
+                r_catalog.wadObjects_map[s].zones_v_map[boxType].push_back(MapZone(rect, MAP_CELL_SQUARE_HEIGHT, (colHeight+FLOAT_MARGIN)*MAP_CELL_SQUARE_HEIGHT));
                 break;
             case WADOBJ_CENTER:
-                r_ifs.read((char*) &fVal, sizeof(float));
-                r_ifs.read((char*) &fVal2, sizeof(float));
-                m_wadObjects_map[s].center = PfPoint(fVal, fVal2);
+                r_reader.read((char*) &fVal, sizeof(float));
+                r_reader.read((char*) &fVal2, sizeof(float));
+                r_catalog.wadObjects_map[s].center = PfPoint(fVal, fVal2);
                 break;
             }
         }
 
-		r_ifs.read((char*) &count, sizeof(int));
-		if (r_ifs.fail())
+		r_reader.read((char*) &count, sizeof(int));
+		if (r_reader.fail())
 			break;
 		for (int i=0;i<count;i++) // nombre d'animations
 		{
-			r_ifs.read((char*) &val, sizeof(int));
+			r_reader.read((char*) &val, sizeof(int));
 			if (val < 0 || val >= ENUM_PF_ANIMATION_STATUS_COUNT)
 				throw PfException(__LINE__, __FILE__, "Statut d'animation non valide.");
 			status = (PfAnimationStatus) val;
 			slowFactor = 1;
 
-			r_ifs.read((char*) &count2, sizeof(int));
-			if (r_ifs.fail())
+			r_reader.read((char*) &count2, sizeof(int));
+			if (r_reader.fail())
 				break;
 			for (int j=0;j<count2;j++) // nombre de lignes
 			{
-				r_ifs.read((char*) &val, sizeof(int));
+				r_reader.read((char*) &val, sizeof(int));
 				if (val < 0 || val >= ENUM_PF_WAD_SCRIPT_OPTION_COUNT)
 					throw PfException(__LINE__, __FILE__, "Option de wad non valide.");
 				bool snd;
 				switch ((PfWadScriptOption) val)
 				{
 					case WADTXT_IMG:
-						r_ifs.read((char*) &textureIndex, sizeof(unsigned int));
+						r_reader.read((char*) &textureIndex, sizeof(unsigned int));
 						break;
 					case WADTXT_SND:
-						r_ifs.read((char*) &soundIndex, sizeof(unsigned int));
+						r_reader.read((char*) &soundIndex, sizeof(unsigned int));
 						break;
 					case WADTXT_VID:
-						r_ifs.read((char*) &val2, sizeof(int));
+						r_reader.read((char*) &val2, sizeof(int));
 						count2 += val2 * 2; // WADTXT_IMG + WADTXT_FRM, VID indique que s'enchaîne une liste "cachée" de WADTXT_IMG et FRM
 						break;
 					case WADTXT_MSC:
-						r_ifs.read((char*) &flags, sizeof(int));
+						r_reader.read((char*) &flags, sizeof(int));
 						break;
 					case WADTXT_FRM:
 						snd = false;
 						for (int k=0;k<4;k++)
-							r_ifs.read(&crd[k], sizeof(char));
-						r_ifs.read((char*) &val, sizeof(int));
+							r_reader.read(&crd[k], sizeof(char));
+						r_reader.read((char*) &val, sizeof(int));
 						while (val != END_OF_LIST_INT)
 						{
 							if (val < 0 || val >= ENUM_PF_WAD_SCRIPT_OPTION_COUNT)
@@ -601,29 +670,29 @@ void PfWad::addSlots(ifstream& r_ifs, unsigned int textureIndexOffset)
 								default:
 									throw PfException(__LINE__, __FILE__, string("Option de frame non valide : ") + textFrom((PfWadScriptOption) val));
 							}
-							r_ifs.read((char*) &val, sizeof(int));
+							r_reader.read((char*) &val, sizeof(int));
 						}
-						m_wadObjects_map[s].frames_v_map[status].push_back(
-                                                         PfAnimationFrame(textureIndex + textureIndexOffset,
+						r_catalog.wadObjects_map[s].frames_v_map[status].push_back(
+                                                         PfAnimationFrame(textureIndex + r_catalog.firstTextureIndex,
                                                                           PfRectangle((crd[1]-1)*1./crd[3], (crd[2]-crd[0])*1./crd[2], 1./crd[3], 1./crd[2]),
-                                                                          snd?m_sounds_v[m_prevSoundsCount+soundIndex-1]:0));
+                                                                          snd?r_catalog.sounds_v[soundIndex-1]:0));
 						break;
 					case WADTXT_SLW:
-						r_ifs.read((char*) &slowFactor, sizeof(unsigned int));
+						r_reader.read((char*) &slowFactor, sizeof(unsigned int));
 						break;
                     case WADTXT_BOX:
-                        r_ifs.read((char*) &boxType, sizeof(PfBoxType));
-                        r_ifs.read((char*) &zoneIndex, sizeof(unsigned int));
-                        m_wadObjects_map[s].boxAnimLinks_v_map[status].push_back(pair<PfBoxType, unsigned int>(boxType, zoneIndex));
+                        r_reader.read((char*) &boxType, sizeof(PfBoxType));
+                        r_reader.read((char*) &zoneIndex, sizeof(unsigned int));
+                        r_catalog.wadObjects_map[s].boxAnimLinks_v_map[status].push_back(pair<PfBoxType, unsigned int>(boxType, zoneIndex));
                         break;
 					default:
 						break;
 				}
 			}
-			m_wadObjects_map[s].flags_map[status] = flags;
+			r_catalog.wadObjects_map[s].flags_map[status] = flags;
 			if (slowFactor > 1)
 			{
-				vector<PfAnimationFrame>* frames_v_p = &(m_wadObjects_map[s].frames_v_map[status]);
+				vector<PfAnimationFrame>* frames_v_p = &(r_catalog.wadObjects_map[s].frames_v_map[status]);
 				vector<PfAnimationFrame>::iterator it = frames_v_p->begin();
 				while (it != frames_v_p->end())
 				{
@@ -633,7 +702,7 @@ void PfWad::addSlots(ifstream& r_ifs, unsigned int textureIndexOffset)
 				}
 			}
 		}
-		r_ifs.read((char*) &val, sizeof(int)); // END_OF_SECTION
+		r_reader.read((char*) &val, sizeof(int)); // END_OF_SECTION
 		/*
 		* END_OF_SECTION était utile du temps lointain où l'on lisait les slots
 		* directement dans le fichier WAD.
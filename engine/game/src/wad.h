@@ -19,6 +19,10 @@
 #include "noncopyable.h"
 #include "mapzone.h"
 
+class PNGDecodingPool;
+class TextureAtlas;
+class BinaryReader;
+
 class AnimatedGLItem;
 class PfRectangle;
 
@@ -42,6 +46,22 @@ struct PfWadObject
 	PfPoint center; //!< Le centre de cet objet.
 };
 
+/**
+* @brief Structure regroupant les données lues dans un fichier WAD.
+*
+* Un catalogue est construit à la première ouverture d'un fichier WAD, puis conservé jusqu'à la fin du programme
+* dans un cache indexé par nom de wad (PfWad::s_catalogs_map).
+* Les textures et les sons qu'il référence restent chargés dans leurs contextes respectifs durant toute cette période.
+*
+* Les PfWad ne copient pas les catalogues, ils en référencent les objets.
+*/
+struct PfWadCatalog
+{
+	map<PfWadSlot, PfWadObject> wadObjects_map; //!< La map des objets de ce wad.
+	vector<unsigned int> sounds_v; //!< La liste des indices de sons (gérés par le fichier "fmodfunc.h") dans l'ordre du fichier WAD.
+	unsigned int firstTextureIndex; //!< Le décalage appliqué aux indices de textures de ce wad.
+};
+
 /**
 * @brief Classe permettant la manipulation d'un WAD.
 *
@@ -63,12 +83,14 @@ struct PfWadObject
 * Par défaut, le nom du wad est "".
 * Si un wad est ajouté par la méthode PfWad::addWad, alors c'est le premier nom qui est conservé.
 *
-* Afin d'éviter de stocker deux fois les textures d'un même wad qui serait ouvert deux fois,
-* la map g_wadFirstIndexes_map (fichier "wad.cpp") associe à chaque nom de wad ouvert durant l'exécution du programme
-* l'indice PfWad::m_firstTextureIndex.
-* Un wad ayant déjà été ouvert, à sa nouvelle création, prendra comme indice de première texture la valeur stockée,
-* ce qui conduira PfWad::addRes à ne pas charger deux fois le même fichier en mémoire
-* (car la fonction <em>addTexture</em> du fichier "glfunc.h" verra un indice de texture déjà existant).
+* Afin de ne pas lire deux fois un même wad, les données lues dans chaque fichier WAD sont conservées dans un PfWadCatalog,
+* stocké dans le cache PfWad::s_catalogs_map jusqu'à la fin du programme.
+* Un wad ayant déjà été ouvert n'est pas relu à sa nouvelle création : ses textures, ses sons et ses objets sont déjà chargés,
+* et ce PfWad référence simplement les objets du catalogue (PfWad::mq_wadObjects_map).
+* Le passage d'une map à l'autre ou d'un menu à l'autre ne coûte ainsi plus que la lecture du fichier de map ou de menu.
+*
+* Ce PfWad conserve en revanche ses propres compteurs d'objets générés (PfWad::m_indexes_map) : les noms des objets repartent de 1
+* à chaque création.
 *
 * Les PfWad déterminent leurs indices de texture en utilisant le champ statique PfWad::s_maxTextureIndex.
 * Les PfWad, se croyant seuls au monde, considèrent donc que rien d'autre qu'eux ne peut générer de textures.
@@ -81,6 +103,7 @@ class PfWad : private NonCopyable
     public:
 	    static bool s_wadOpen; //!< Indique si un wad est déjà ouvert dans ce programme.
 		static unsigned int s_maxTextureIndex; //!< Le dernier indice de texture utilisé.
+		static map<string, PfWadCatalog*> s_catalogs_map; //!< Le cache des catalogues des wads ouverts durant l'exécution du programme, par nom de wad.
 
 		/*
 		* Constructeurs et destructeur
@@ -93,6 +116,7 @@ class PfWad : private NonCopyable
 		* @throw ConstructorException si une erreur survient.
 		*
 		* Toute ressource trouvée est ajoutée au contexte.
+		* Si ce wad est déjà présent dans le cache PfWad::s_catalogs_map, le fichier n'est pas relu.
 		*
 		* A la fin du constructeur, le champ statique PfWad::s_wadOpen passe à l'état vrai, pour empêcher la création d'un autre PfWad.
 		*/
@@ -114,6 +138,8 @@ class PfWad : private NonCopyable
 		* A chaque itération, les valeurs du menu sont effacées et le pas de chargement est ajouté en tant que valeur.
 		*
 		* Ceci peut être utilisé pour afficher une barre de progression.
+		*
+		* Si ce wad est déjà présent dans le cache PfWad::s_catalogs_map, le fichier n'est pas relu et le menu n'est pas créé.
 		*/
 		PfWad(const string& wadName, const string& menuName, const string& menuWadName);
 		/**
@@ -192,6 +218,8 @@ class PfWad : private NonCopyable
 		* @param wadName le nom du WAD (nom du fichier sans l'extension).
 		* @throw FileException si le fichier ne peut pas être ouvert.
 		* @throw ArgumentException si le wad passé en paramètre n'est pas valide ou si l'un de ses slots a déjà été chargé dans ce PfWad.
+		*
+		* Comme à la construction, le fichier n'est pas relu si ce wad est déjà présent dans le cache PfWad::s_catalogs_map.
 		*/
 		void addWad(const string& wadName);
 		/**
@@ -228,7 +256,7 @@ class PfWad : private NonCopyable
 		bool hasSlot(PfWadSlot slot) const;
 		/**
 		* @brief Charge une ressource pour ce wad, à partir d'un flux prépositionné.
-		* @param r_ifs le flux en lecture, prépositionné.
+		* @param r_reader le lecteur du flux, prépositionné.
 		* @param textureIndexOffset le décalage à appliquer aux indices de textures associés aux ressources.
 		* @return le pas de chargement en fin de méthode (1 pour une ressource chargée, etc...)
 		* @throw PfException si une erreur survient lors de l'ajout de ressources.
@@ -236,12 +264,18 @@ class PfWad : private NonCopyable
 		* Le flux doit être placé juste après l'octet de version pour la première lecture.
 		*
 		* Si le champ PfWad::m_currentLoadStep est nul, alors le nombre total
-		* de textures est lu dans le flux, puis une texture est chargée (sauf
-		* si la valeur est 0). Le champ PfWad::m_totalTextCount est renseigné.
+		* de textures est lu dans le flux, puis toutes les images sont lues et
+		* confiées au PfWad::mpn_decodingPool, qui les décode en parallèle.
+		* Le champ PfWad::m_totalTextCount est renseigné.
+		*
+		* Tant que toutes les textures ne sont pas chargées, chaque appel attend
+		* la fin d'au moins un décodage et ajoute au PfWad::mpn_atlas toutes les images
+		* décodées disponibles : le pas de chargement avance d'autant.
+		* Une fois toutes les images décodées, l'atlas est ajouté au contexte OpenGL (fonction <em>addAtlas</em> du fichier "glfunc.h").
+		* Les textures déjà chargées par ailleurs comptent pour un pas dès la lecture des images.
 		*
-		* Si le champ PfWad::m_currentLoadStep est égal à PfWad::m_totalTextCount
-		* tout en étant non nul, alors le nombre total de sons est lu dans le flux,
-		* puis un son est chargé (sauf si la valeur est 0). Le champ
+		* Une fois toutes les textures chargées, le nombre total de sons est lu
+		* dans le flux, puis un son est chargé (sauf si la valeur est 0). Le champ
 		* PfWad::m_totalSoundCount est renseigné.
 		*
 		* Si le champ PfWad::m_currentLoadStep est égal à la somme des champs
@@ -251,13 +285,23 @@ class PfWad : private NonCopyable
 		* le champ PfWad::m_currentLoadStep.
 		*
 		* La méthode pas à pas ne peut être utilisée que pour l'initialisation d'un wad, et non dans une démarche similaire à PfWad::addWad.
-		* Le champ PfWad::m_prevResCount n'est pas considéré.
+		* Les données lues sont stockées dans le catalogue en cours de construction PfWad::mpn_catalog,
+		* qui est ajouté au cache PfWad::s_catalogs_map et référencé par ce PfWad une fois la lecture terminée.
 		*
-		* Le flux n'est pas rembobiné en fin de méthode.
+		* Le flux est lu par blocs au travers d'un BinaryReader (fichier "binaryreader.h" de la bibliothèque PfMisc),
+		* qui doit donc être le même d'un appel à l'autre.
 		*
 		* (contexte pas à pas)
 		*/
-		unsigned int loadStepByStep(ifstream& r_ifs, unsigned int textureIndexOffset);
+		unsigned int loadStepByStep(BinaryReader& r_reader, unsigned int textureIndexOffset);
+		/**
+		* @brief Vide le cache des catalogues de wads.
+		*
+		* Les textures et les sons référencés par les catalogues ne sont pas libérés.
+		* A n'appeler qu'en fin de programme, ou après libération de toutes les textures et de tous les sons,
+		* aucun PfWad ne devant alors exister.
+		*/
+		static void freeCatalogs();
 		/*
 		* Accesseurs
 		* ----------
@@ -266,33 +310,58 @@ class PfWad : private NonCopyable
 
 	private:
 		/**
+		* @brief Lit un fichier WAD et ajoute son catalogue au cache PfWad::s_catalogs_map.
+		* @param wadName le nom du WAD (nom du fichier sans l'extension).
+		* @return le catalogue ajouté.
+		* @throw FileException si le fichier ne peut pas être ouvert, est d'une version dépassée ou n'est pas valide.
+		* @throw PfException si une erreur survient lors de la lecture.
+		*
+		* Si ce wad est déjà dans le cache, le catalogue existant est retourné sans lecture.
+		*/
+		static PfWadCatalog* loadCatalog(const string& wadName);
+		/**
+		* @brief Référence les objets d'un catalogue dans ce PfWad.
+		* @param rc_catalog le catalogue.
+		* @throw ArgumentException si l'un des slots du catalogue est déjà présent dans ce PfWad.
+		*/
+		void useCatalog(const PfWadCatalog& rc_catalog);
+		/**
+		* @brief Retourne l'objet d'un slot de ce PfWad.
+		* @param slot le slot.
+		* @return l'objet, ou 0 si le slot n'est pas présent dans ce PfWad.
+		*/
+		const PfWadObject* wadObject(PfWadSlot slot) const;
+		/**
 		* @brief Ajoute les ressources d'un fichier WAD au contexte.
-		* @param r_ifs le flux en lecture, positionné juste après les quatre octets de version du programme (début de fichier + 4).
-		* @param textureIndexOffset le décalage à appliquer aux indices de textures associés aux ressources.
+		* @param r_reader le lecteur du flux, positionné juste après les quatre octets de version du programme (début de fichier + 4).
+		* @param r_catalog le catalogue à remplir, dont le champ PfWadCatalog::firstTextureIndex est renseigné.
 		* @throw PfException si une erreur survient lors de l'ajout de ressources.
+		*
+		* Les textures sont regroupées dans un TextureAtlas (fichier "textureatlas.h" de la bibliothèque PfMedia),
+		* afin de limiter les changements de texture au rendu.
 		*
 		* Le flux n'est pas rembobiné en fin de méthode.
 		*/
-		void addRes(ifstream& r_ifs, unsigned int textureIndexOffset);
+		static void addRes(BinaryReader& r_reader, PfWadCatalog& r_catalog);
 		/**
-		* @brief Génère les PfWadObject de ce PfWad à partir d'un fichier WAD.
-		* @param r_ifs le flux en lecture, positionné juste après les ressources.
-		* @param textureIndexOffset le décalage à appliquer aux indices de textures associés aux ressources.
+		* @brief Génère les PfWadObject d'un catalogue à partir d'un fichier WAD.
+		* @param r_reader le lecteur du flux, positionné juste après les ressources.
+		* @param r_catalog le catalogue à remplir, dont les sons sont déjà chargés.
 		* @throw PfException si une erreur survient.
 		*
 		* Le flux n'est pas rembobiné en fin de méthode.
 		*/
-		void addSlots(ifstream& r_ifs, unsigned int textureIndexOffset);
+		static void addSlots(BinaryReader& r_reader, PfWadCatalog& r_catalog);
 
-		map<PfWadSlot, PfWadObject> m_wadObjects_map; //!< La map des objets de ce wad.
+		map<PfWadSlot, const PfWadObject*> mq_wadObjects_map; //!< La map des objets de ce wad, stockés dans les catalogues du cache PfWad::s_catalogs_map.
 		map<string, int> m_indexes_map; //!< La map stockant le nombre d'objets correspondant à un slot de wad. La clé est le nom du slot (fonction <em>textFrom</em>, fichier "enum.h").
-		unsigned int m_resCount; //!< Le nombre d'indices de textures chargées.
 		unsigned int m_totalTextCount; //!< Le nombre total d'indices de textures à charger (pas à pas).
 		unsigned int m_totalSoundCount; //!< Le nombre total de sons à charger (pas à pas).
 		unsigned int m_currentLoadStep; //!< Le pas de chargement (pas à pas).
 		string m_name; //!< Le nom du fichier de ce wad.
-		vector<unsigned int> m_sounds_v; //!< La liste des indices de sons (gérés par le fichier "fmodfunc.h") dans l'ordre des ajouts par ce wad.
-		unsigned int m_prevSoundsCount; //!< Le nombre de sons chargés pour un premier wad (utilisé pour PfWad::addWad).
+		PfWadCatalog* mpn_catalog; //!< Le catalogue en cours de construction (pas à pas), 0 en dehors du chargement.
+		PNGDecodingPool* mpn_decodingPool; //!< Les threads décodant les images (pas à pas), 0 en dehors du chargement des textures.
+		TextureAtlas* mpn_atlas; //!< L'atlas regroupant les images décodées (pas à pas), 0 en dehors du chargement des textures.
 };
 
 #endif // WAD_H_INCLUDED
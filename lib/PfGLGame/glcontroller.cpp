@@ -3,6 +3,7 @@
 #include <SDL.h>
 #include "glfunc.h"
 #include "glmodel.h"
+#include "misc.h"
 
 GLController::GLController(GLModel& r_glmodel) : AbstractController(r_glmodel), m_fullscreen(SYSTEM_FULLSCREEN), m_flags(SYSTEM_SDL_FLAGS) {}
 
@@ -16,6 +17,32 @@ void GLController::flushInput()
 	m_eventHandler.reset();
 }
 
+void GLController::applyInputSettings()
+{
+	// une seule session pour tout le programme, chaque carte ou diteur crant son propre contrleur
+	static InputSession s_session;
+	static bool s_opened = false;
+
+	if (!s_opened)
+	{
+		s_opened = true;
+		try
+		{
+			if (ConfigSettings::s_inputReplay != "")
+				s_session.startReplay(ConfigSettings::s_inputReplay);
+			else if (ConfigSettings::s_inputRecord != "")
+				s_session.startRecording(ConfigSettings::s_inputRecord);
+		}
+		catch (PfException& e)
+		{
+			LOG("Impossible d'enregistrer ou de rejouer les entres : " << e.what() << "\n");
+		}
+	}
+
+	if (s_session.getMode() != InputSession::INPUT_LIVE)
+		m_eventHandler.setInputSession(&s_session);
+}
+
 void GLController::update()
 {
 	if (m_eventHandler.isQuitting())
@@ -201,3 +201,26 @@ Viewable* AnimatedGLItem::generateViewable() const
 	return p_tmp;
 }
 
+bool AnimatedGLItem::updateViewable(Viewable& r_viewable) const
+{
+	if (r_viewable.imagesCount() != 1 || r_viewable.viewablesCount() != 0)
+		return false;
+
+	PfColor color(m_animationGroup.currentFrame().getColor());
+
+	try
+	{
+		if (!r_viewable.imageAt(0).updateData(getRect(), m_animationGroup.currentFrame().getTextureIndex(), m_animationGroup.currentFrame().textCoordRectangle(m_orientation),
+											((color==PfColor::WHITE)?getColor():color), isCoordRelativeToBorder(), isStatic()))
+			return false;
+	}
+	catch (PfException& e)
+	{
+		throw ViewableGenerationException(__LINE__, __FILE__, "impossible de mettre à jour le Viewable.", m_name, e);
+	}
+	r_viewable.changeLayer(getLayer());
+	r_viewable.setSoundIndex(m_animationGroup.currentFrame().getSoundIndex());
+
+	return true;
+}
+
@@ -9,6 +9,7 @@
 #include <string>
 #include "pfgui.h"
 #include "misc.h"
+#include "profiler.h"
 
 #endif
 
@@ -23,7 +24,11 @@ void GLModel::showDebugInfo()
 	PfWidget* p_label = findItem<PfWidget>("DEBUG_LABEL");
 	if (g_debug)
 	{
-	    unsigned int size = g_dbInt_v_map.size() + g_dbFloat_v_map.size();
+	    vector<pair<string, float> > profile_v;
+	    #ifdef PROFILING
+	    Profiler::frameBreakdown(profile_v);
+	    #endif
+	    unsigned int size = g_dbInt_v_map.size() + g_dbFloat_v_map.size() + profile_v.size();
 	    if (size == 0)
             return;
 		if (p_label == 0)
@@ -51,6 +56,8 @@ void GLModel::showDebugInfo()
 				p_label->addText(str);
 			str.clear();
 		}
+		for (unsigned int i=0, sz=profile_v.size();i<sz;i++)
+			p_label->addText(profile_v[i].first + " = " + ftostr(profile_v[i].second) + " ms");
 		showItem("DEBUG_LABEL");
 	}
 	else if (p_label)
@@ -2,40 +2,75 @@
 
 #include <SDL.h>
 #include <string>
-#include "glfunc.h"
+#include "renderbackend.h"
 #include "fmodfunc.h"
 #include "viewable.h"
 #include "errors.h"
 #include "misc.h"
 
-GLView::GLView() : AbstractView(), m_viewport(0.0, 0.0, 1.0, Y_X_RATIO) {}
+static GLRenderBackend s_glBackend; // rendu par défaut, sans état
+
+GLView::GLView(RenderBackend* q_backend) : AbstractView(), m_viewport(0.0, 0.0, 1.0, Y_X_RATIO), mq_backend((q_backend != 0)?q_backend:&s_glBackend) {}
 
 void GLView::updateViewport(float x, float y)
 {
 	m_viewport = PfRectangle(x, y*Y_X_RATIO, 1.0, Y_X_RATIO);
 }
 
+void GLView::changeBackend(RenderBackend* q_backend)
+{
+	mq_backend = (q_backend != 0)?q_backend:&s_glBackend;
+}
+
 bool GLView::viewportContains(const Viewable& rc_viewable) const
 {
-	vector<PfPoint> pts_v;
 	for (unsigned int i=0, size=rc_viewable.imagesCount();i<size;i++)
 	{
 		if (rc_viewable.imageAt(i).isStatic())
 			return true;
-		pts_v = rc_viewable.imageAt(i).points();
-		for (unsigned int j=0, size2=pts_v.size();j<size2;j++)
-		{
-			if (m_viewport.contains(pts_v[j]))
-				return true;
-		}
+		// le rectangle englobant est testé plutôt que les sommets, afin qu'une image plus grande que le viewport reste visible
+		if (m_viewport.contains(rc_viewable.imageAt(i).boundingBox()))
+			return true;
 	}
 
 	return false;
 }
 
+bool GLView::viewableBounds(const Viewable& rc_viewable, PfRectangle& r_bounds) const
+{
+	unsigned int size = rc_viewable.imagesCount();
+	if (size == 0)
+		return false;
+
+	float minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+	for (unsigned int i=0;i<size;i++)
+	{
+		if (rc_viewable.imageAt(i).isStatic())
+			return false;
+		PfRectangle rect = rc_viewable.imageAt(i).boundingBox();
+		if (i == 0 || rect.getX() < minX)
+			minX = rect.getX();
+		if (i == 0 || rect.getY() < minY)
+			minY = rect.getY();
+		if (i == 0 || rect.getX() + rect.getW() > maxX)
+			maxX = rect.getX() + rect.getW();
+		if (i == 0 || rect.getY() + rect.getH() > maxY)
+			maxY = rect.getY() + rect.getH();
+	}
+	r_bounds = PfRectangle(minX, minY, maxX-minX, maxY-minY);
+
+	return true;
+}
+
+bool GLView::visibleArea(PfRectangle& r_area) const
+{
+	r_area = m_viewport;
+	return true;
+}
+
 void GLView::initializeDisplay() const
 {
-	clearGL();
+	mq_backend->beginFrame();
 }
 
 void GLView::displayViewable(const Viewable& viewable) const
@@ -44,7 +79,7 @@ void GLView::displayViewable(const Viewable& viewable) const
 	try
 	{
 		for (;i<size;i++)
-			drawGL(viewable.imageAt(i));
+			mq_backend->draw(viewable.imageAt(i));
 		if (viewable.getSoundIndex() != 0)
 			playSound(viewable.getSoundIndex());
 	}
@@ -56,8 +91,6 @@ void GLView::displayViewable(const Viewable& viewable) const
 
 void GLView::finalizeDisplay() const
 {
-	drawTransition();
-	flushGL();
-	swapSDLBuffers();
+	mq_backend->endFrame();
 }
 
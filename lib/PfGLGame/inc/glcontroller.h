@@ -24,6 +24,8 @@ class GLModel;
 *
 * Les événements SDL sont gérés par ce modèle sous la forme d'un EventHandler.
 * La méthode GLController::pollInput met à jour l'EventHandler et la méthode GLController::update utilise l'état stocké dans cette instance.
+*
+* Les contrôleurs dérivés peuvent enregistrer ou rejouer leurs entrées selon la configuration (GLController::applyInputSettings).
 */
 class GLController : public AbstractController
 {
@@ -75,6 +77,19 @@ public:
     virtual bool isAvailable() const;
 
 protected:
+    /**
+    * @brief Enregistre ou rejoue les entrées de ce contrôleur selon la configuration (structure ConfigSettings, fichier "misc.h").
+    *
+    * Au premier appel, une session InputSession propre au programme est ouverte :
+    * si ConfigSettings::s_inputReplay n'est pas vide, ce fichier est rejoué (InputSession::startReplay),
+    * sinon, si ConfigSettings::s_inputRecord n'est pas vide, les entrées sont enregistrées dans ce fichier (InputSession::startRecording).
+    * Les appels suivants ne rouvrent pas le fichier : la session est partagée par tous les contrôleurs successifs (une carte ou un éditeur par contrôleur),
+    * l'enregistrement se poursuivant et le rejeu reprenant là où le contrôleur précédent s'est arrêté.
+    *
+    * Si le fichier ne peut pas être ouvert, l'erreur est écrite dans le fichier log et les entrées restent celles de l'utilisateur.
+    */
+    void applyInputSettings();
+
     EventHandler m_eventHandler; //!< Le gestionnaire d'événements.
 
 private:
@@ -434,6 +434,22 @@ public:
     * De la mémoire est allouée pour le pointeur retourné.
     */
     virtual Viewable* generateViewable() const;
+    /**
+    * @brief Met à jour sur place un Viewable généré par AnimatedGLItem::generateViewable.
+    * @param r_viewable Le Viewable à mettre à jour.
+    * @return <code>true</code> si le Viewable a été mis à jour, <code>false</code> s'il doit être régénéré.
+    * @throw ViewableGenerationException si les données de l'image ne peuvent être mises à jour.
+    *
+    * Si le Viewable possède une seule image et aucun Viewable lié, alors les données de cette image sont remplacées
+    * (GLImage::updateData) d'après les informations de la frame actuelle, sans allocation.
+    * Le plan de perspective et l'indice de son du Viewable sont également mis à jour.
+    *
+    * Une animation ne changeant que l'indice de texture, les coordonnées de texture ou la couleur ne provoque donc aucune allocation.
+    *
+    * @warning
+    * Les classes filles redéfinissant AnimatedGLItem::generateViewable doivent également redéfinir cette méthode.
+    */
+    virtual bool updateViewable(Viewable& r_viewable) const;
     /*
     * Accesseurs
     * ----------
@@ -60,6 +60,9 @@ public:
     * Un label noir est affiché au coin supérieur gauche de l'écran, avec la liste des informations contenues dans les maps globales
     * <em>g_dbInt_v_map</em> et <em>g_dbFloat_v_map</em> (fichier "gen.h" de la bibliothèque PfMisc).
     * Ces deux maps sont effacées après affichage (pour le cycle de mise à jour des valeurs à chaque tour).
+    *
+    * Si la macro PROFILING est définie (fichier "misc_gen.h" de la bibliothèque PfMisc), le bilan de la dernière image
+    * (Profiler::frameBreakdown) est affiché à la suite, en millisecondes.
     */
     void showDebugInfo();
 
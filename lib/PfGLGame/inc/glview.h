@@ -14,11 +14,13 @@
 #include "geometry.h"
 
 class Viewable;
+class RenderBackend;
 
 /**
 * @brief Vue du système MVC spécialisée dans l'affichage d'images rendues grâce à OpenGL.
 *
-* Les Viewable sont rendus via l'interface OpenGL.
+* Les Viewable sont rendus via un RenderBackend (fichier "renderbackend.h" de la bibliothèque PfMedia), par défaut l'interface OpenGL (GLRenderBackend).
+* Un RecordingRenderBackend permet d'enregistrer et de mesurer le rendu sans fenêtre.
 *
 * Cette vue définit un viewport, rectangle caractéristant la partie visible du monde représenté.
 * Cette information est utilisée par la méthode AbstractView::viewportContains et seuls les Viewable compris dans cet espace sont affichés.
@@ -32,8 +34,12 @@ public:
     */
     /**
     * @brief Constructeur GLView.
+    * @param q_backend Le rendu à utiliser, 0 pour le rendu OpenGL.
+    *
+    * @warning
+    * Le rendu n'est pas détruit par cette vue, il doit exister tant qu'elle l'utilise.
     */
-    GLView();
+    explicit GLView(RenderBackend* q_backend = 0);
     /*
     * Redéfinitions
     * -------------
@@ -49,6 +55,18 @@ public:
     * d'un carré vers le haut à droite par rapport à la position initiale, ce qui ne serait pas le cas sans cette conversion.
     */
     void updateViewport(float x, float y);
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Modifie le rendu utilisé par cette vue.
+    * @param q_backend Le nouveau rendu, 0 pour le rendu OpenGL.
+    *
+    * @warning
+    * Le rendu n'est pas détruit par cette vue, il doit exister tant qu'elle l'utilise.
+    */
+    void changeBackend(RenderBackend* q_backend);
 
 private:
     /*
@@ -60,7 +78,8 @@ private:
     * @param rc_viewable Le viewable à tester.
     *
     * L'ensemble des images de ce Viewable sont testées.
-    * Si au moins une image a son rectangle entièrement ou partiellement compris dans le viewport, alors <code>true</code> est retourné.
+    * Si au moins une image a son rectangle englobant (GLImage::boundingBox) entièrement ou partiellement compris dans le viewport,
+    * alors <code>true</code> est retourné.
     *
     * Les Viewable contenant au moins une image statique sont toujours considérés visibles.
     *
@@ -71,9 +90,22 @@ private:
     */
     virtual bool viewportContains(const Viewable& rc_viewable) const;
     /**
+    * @brief Calcule le rectangle englobant d'un Viewable.
+    * @param rc_viewable Le Viewable.
+    * @param r_bounds Le rectangle à remplir, union des rectangles englobants des images du Viewable.
+    * @return <code>false</code> si le Viewable n'a aucune image ou contient au moins une image statique.
+    */
+    virtual bool viewableBounds(const Viewable& rc_viewable, PfRectangle& r_bounds) const;
+    /**
+    * @brief Calcule la zone visible de cette vue.
+    * @param r_area Le rectangle à remplir avec le viewport.
+    * @return <code>true</code>.
+    */
+    virtual bool visibleArea(PfRectangle& r_area) const;
+    /**
     * @brief Action réalisée par la vue avant l'affichage de tous les Viewable.
     *
-    * Appelle la fonction <em>clearGL</em>.
+    * Appelle la méthode RenderBackend::beginFrame.
     */
     virtual void initializeDisplay() const;
     /**
@@ -81,7 +113,7 @@ private:
     * @param viewable Le Viewable à afficher.
     * @throw PfException si une erreur survient lors de l'affichage du Viewable.
     *
-    * Appelle la fonction <em>drawGL</em> sur chaque GLImage du Viewable.
+    * Appelle la méthode RenderBackend::draw sur chaque GLImage du Viewable.
     *
     * Appelle la fonction <em>playSound</em> si le Viewable a un son à jouer.
     */
@@ -89,11 +121,12 @@ private:
     /**
     * @brief Action réalisée après affichage de tous les Viewable.
     *
-    * Appelle la fonction <em>drawTransition</em>, puis appelle les fonctions <em>flushGL</em> et <em>swapSDLBuffers</em>.
+    * Appelle la méthode RenderBackend::endFrame.
     */
     virtual void finalizeDisplay() const;
 
     PfRectangle m_viewport; //!< Le rectangle définissant la partie visible de cette vue.
+    RenderBackend* mq_backend; //!< Le rendu utilisé par cette vue, non détruit par celle-ci.
 };
 
 #endif // GLVIEW_H_INCLUDED
@@ -25,6 +25,9 @@
 * Les valeurs de l'énumération PfText::ZPosValue assignent des tableaux préconstruits au texte.
 *
 * Une série de GLImage peut être créée à partir de ce texte au moyen de la méthode PfText::toGLImages.
+* Tous les caractères y sont regroupés dans une seule image, afin d'être rendus en un seul appel OpenGL.
+* La disposition des caractères est conservée d'un appel à l'autre, et n'est recalculée que si le texte, son rectangle,
+* son nombre de lignes, son alignement ou sa portion affichée changent.
 *
 * Le caractère entrée peut-être utilisé, le texte rendra alors un retour à la ligne.
 *
@@ -59,6 +62,7 @@
 *
 * Si l'affichage est progressif, c'est le champ PfText::m_typingCounter qui détermine au final le nombre total de caractères à afficher, qui arrive à
 * une valeur maximale de PfText::m_displayedLength (ou contrainte géométrique) une fois le texte entièrement écrit.
+* Les caractères écrits sont alors placés comme dans le texte complet : un mot en cours d'écriture ne change pas de ligne.
 */
 class PfText
 {
@@ -137,6 +141,8 @@ public:
     * @param text Le nouveau texte.
     *
     * L'offset et la longueur affichée sont réinitialisés de sorte à afficher le texte complet.
+    *
+    * Si le texte est identique à l'actuel et déjà affiché en entier, rien n'est fait et la disposition des caractères reste valide.
     */
     void changeText(const string& text);
     /**
@@ -155,11 +161,16 @@ public:
     * @param relativeToBorders <code>true</code> si les images doivent être positionnées par rapport aux bordures.
     * @param stat <code>true</code> si ce texte ne doit pas se déplacer avec la caméra.
     * @param cursor Indique si un curseur de fin doit être affiché.
+    * @return La liste des images, comprenant au plus une image pour les caractères et une image pour le curseur.
+    *
+    * Les caractères affichés sont rendus par une seule GLImage en mode GL_TRIANGLES, construite à partir de la disposition conservée
+    * par ce texte (PfText::layoutGlyphs), qui n'est recalculée que si elle n'est plus valide.
+    * Dans le cadre d'un affichage progressif, seuls les premiers caractères de cette disposition sont repris.
     *
     * @warning
     * De la mémoire est allouée lors de la création du vecteur contenant les GLImage et lors de la création de chaque GLImage.
     *
-    * Le curseur est placé en fin de texte et a pour dimension la hauteur d'un caractère et le dixième de sa largeur.
+    * Le curseur est placé après le dernier caractère écrit et a pour dimension la hauteur d'un caractère et le dixième de sa largeur.
     */
     vector<GLImage*>* toGLImages(bool relativeToBorders = true, bool stat = false, bool cursor = false) const;
     /**
@@ -180,6 +191,8 @@ public:
     * @param offset La nouvelle position de départ, 0 pour le début du texte.
     * @param length Le nouveau nombre maximal de caractères à afficher.
     * @throw ArgumentException si les paramètres ne sont pas adaptés au contenu du texte.
+    *
+    * La disposition des caractères n'est invalidée que si la portion affichée change.
     */
     void changeDisplay(unsigned int offset, unsigned int length);
     /**
@@ -188,16 +201,34 @@ public:
     * En fonction de la valeur du champ PfText::m_typingMode, le compteur PfText::m_typingCounter est incrémenté d'une valeur spécifique.
     */
     void updateTyping();
+    /**
+    * @brief Modifie le rectangle des coordonnées de ce texte.
+    * @param rect Le nouveau rectangle.
+    *
+    * La disposition des caractères n'est invalidée que si le rectangle change.
+    */
+    void setRect(const PfRectangle& rect);
+    /**
+    * @brief Modifie le nombre de lignes affichées.
+    * @param linesCount Le nouveau nombre de lignes.
+    *
+    * La disposition des caractères n'est invalidée que si le nombre de lignes change.
+    */
+    void setLinesCount(unsigned int linesCount);
+    /**
+    * @brief Modifie l'alignement de ce texte dans son rectangle.
+    * @param align Le nouvel alignement.
+    *
+    * La disposition des caractères n'est invalidée que si l'alignement change.
+    */
+    void setAlignProp(TextAlignProp align);
     /*
     * Accesseurs
     * ----------
     */
     unsigned int getLength() const {return m_length;} //!< Accesseur.
     const PfRectangle& getRect() const {return m_rect;} //!< Accesseur.
-    void setRect(const PfRectangle& rect) {m_rect = rect;} //!< Accesseur.
     unsigned int getLinesCount() const {return m_linesCount;} //!< Accesseur.
-    void setLinesCount(unsigned int linesCount) {m_linesCount = linesCount;} //!< Accesseur.
-    void setAlignProp(TextAlignProp align) {m_alignProp = align;} //!< Accesseur.
     unsigned int getOffset() const {return m_offset;} //!< Accesseur.
     unsigned int getDisplayedLength() const {return m_displayedLength;} //!< Accesseur.
     /*
@@ -213,6 +244,20 @@ public:
     PfText& operator=(const PfText& text);
 
 private:
+    /**
+    * @brief Calcule la disposition des caractères de la portion affichée de ce texte, ainsi que la position du curseur de fin.
+    *
+    * Les listes PfText::m_glyphRects_v, PfText::m_glyphCoords_v et PfText::m_glyphIndexes_v sont remplies,
+    * sans tenir compte de l'affichage progressif, puis la disposition est marquée valide.
+    */
+    void layoutGlyphs() const;
+    /**
+    * @brief Retourne l'abscisse du curseur sur une ligne vide, au vu de l'alignement de ce texte.
+    * @param w La largeur d'un caractère.
+    * @return L'abscisse du curseur.
+    */
+    float lineStartX(float w) const;
+
     unsigned char* m_text_t; //!< Le texte à afficher.
     unsigned int m_length; //!< Le nombre de caractères dans ce texte.
     unsigned int m_textureIndex; //!< L'indice de texture de la police.
@@ -224,6 +269,12 @@ private:
     unsigned int m_displayedLength; //!< Le nombre de caractères du texte à afficher.
     TextTypingMode m_typingMode; //!< Le mode d'affichage du texte à afficher (caractère par caractère ou en un seul coup).
     unsigned int m_typingCounter; //!< Le nombre de caractères déjà écrits dans le cadre d'un affichage progressif.
+    mutable vector<PfRectangle> m_glyphRects_v; //!< Les rectangles des caractères affichés, conservés entre deux appels à PfText::toGLImages.
+    mutable vector<PfRectangle> m_glyphCoords_v; //!< Les fragments de texture des caractères affichés.
+    mutable vector<unsigned int> m_glyphIndexes_v; //!< L'indice dans le texte de chaque caractère affiché.
+    mutable float m_cursorX; //!< L'abscisse du curseur après le dernier caractère affiché.
+    mutable float m_cursorY; //!< L'ordonnée du curseur après le dernier caractère affiché.
+    mutable bool m_layoutValid; //!< Indique si la disposition des caractères est à jour.
 };
 
 #endif // PFTEXT_H_INCLUDED
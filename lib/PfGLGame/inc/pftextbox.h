@@ -145,6 +145,8 @@ class PfTextBox : public PfWidget
         * @return le Viewable créé.
         * @throw ViewableGenerationException si une erreur survient dans la gestion de l'affichage du texte.
         *
+        * Le texte est rendu par le PfText PfTextBox::m_textMesh, qui conserve la disposition de ses caractères d'un appel à l'autre.
+        *
         * @warning
         * De la mémoire est allouée pour le pointeur retourné.
         */
@@ -179,6 +181,7 @@ class PfTextBox : public PfWidget
 		float m_hMargin; //!< La marge horizontale de centrage du texte.
 		float m_vMargin; //!< La marge verticale de centrage du texte.
 		unsigned int m_fontTextureIndex; //!< L'indice de texture de la police du texte.
+		mutable PfText m_textMesh; //!< Le texte affiché, conservé pour ne recalculer la disposition de ses caractères que lorsqu'elle change.
 };
 
 #endif // PFTEXTBOX_H_INCLUDED
@@ -305,6 +305,12 @@ public:
     */
     virtual Viewable* generateViewable() const;
     /**
+    * @brief Retourne <code>false</code> : le Viewable d'un widget, qui contient son texte, est toujours régénéré.
+    * @param r_viewable Le Viewable à mettre à jour.
+    * @return <code>false</code>.
+    */
+    virtual bool updateViewable(Viewable& r_viewable) const {return false;}
+    /**
     * @brief Traite l'instruction passée en paramètre.
     * @return RETURN_NOTHING par défaut, RETURN_OK s'il y a eu sélection ou activation.
     *
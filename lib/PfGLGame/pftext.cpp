@@ -3,12 +3,13 @@
 #include "misc.h"
 
 PfText::PfText() : m_text_t(0), m_length(0), m_textureIndex(FONT_TEXTURE_INDEX), m_linesCount(0), m_alignProp(PfText::TEXT_ALIGN_CENTER),
-    m_offset(0), m_displayedLength(0), m_typingMode(PfText::TEXT_TYPING_ALLATONCE), m_typingCounter(0) {}
+    m_offset(0), m_displayedLength(0), m_typingMode(PfText::TEXT_TYPING_ALLATONCE), m_typingCounter(0), m_cursorX(0), m_cursorY(0), m_layoutValid(false) {}
 
 PfText::PfText(const string& text, unsigned int textureIndex, float zPos_t[256], const PfRectangle& rect, unsigned int linesCount,
                TextAlignProp align) :
 	m_length(text.size()), m_textureIndex(textureIndex), m_rect(rect), m_linesCount(linesCount), m_alignProp(align),
-	m_offset(0), m_displayedLength(text.size()), m_typingMode(PfText::TEXT_TYPING_ALLATONCE), m_typingCounter(text.size())
+	m_offset(0), m_displayedLength(text.size()), m_typingMode(PfText::TEXT_TYPING_ALLATONCE), m_typingCounter(text.size()),
+	m_cursorX(0), m_cursorY(0), m_layoutValid(false)
 {
 	m_text_t = new unsigned char[m_length];
 	for (unsigned int i=0;i<m_length;i++)
@@ -24,7 +25,8 @@ PfText::PfText(const string& text, unsigned int textureIndex, float zPos_t[256],
 PfText::PfText(const string& text, unsigned int textureIndex, const PfRectangle& rect, unsigned int linesCount, TextAlignProp align,
                ZPosValue zPosValue) :
 	m_length(text.size()), m_textureIndex(textureIndex), m_rect(rect), m_linesCount(linesCount), m_alignProp(align),
-	m_offset(0), m_displayedLength(text.size()), m_typingMode(PfText::TEXT_TYPING_ALLATONCE), m_typingCounter(text.size())
+	m_offset(0), m_displayedLength(text.size()), m_typingMode(PfText::TEXT_TYPING_ALLATONCE), m_typingCounter(text.size()),
+	m_cursorX(0), m_cursorY(0), m_layoutValid(false)
 {
 	m_text_t = new unsigned char[m_length];
 	for (unsigned int i=0;i<m_length;i++)
@@ -62,7 +64,7 @@ PfText::PfText(const string& text, unsigned int textureIndex, const PfRectangle&
 
 PfText::PfText(const PfText& text) : m_length(text.m_length), m_textureIndex(text.m_textureIndex), m_rect(text.m_rect), m_linesCount(text.m_linesCount),
     m_alignProp(text.m_alignProp), m_offset(text.m_offset), m_displayedLength(text.m_displayedLength),
-    m_typingMode(text.m_typingMode), m_typingCounter(text.m_typingCounter)
+    m_typingMode(text.m_typingMode), m_typingCounter(text.m_typingCounter), m_cursorX(0), m_cursorY(0), m_layoutValid(false)
 {
     for (int i=0;i<256;i++)
         m_zPos_t[i] = text.m_zPos_t[i];
@@ -80,6 +82,17 @@ PfText::~PfText()
 
 void PfText::changeText(const string& text)
 {
+    // texte inchang et affich en entier : le maillage reste valide
+    if (text.size() == m_length && m_offset == 0 && m_displayedLength == m_length)
+    {
+        unsigned int i = 0;
+        while (i < m_length && m_text_t[i] == (unsigned char) text.at(i))
+            i++;
+        if (i == m_length)
+            return;
+    }
+
+    m_layoutValid = false;
     if (m_text_t)
         delete [] m_text_t;
 	m_text_t = 0;
@@ -101,6 +114,7 @@ void PfText::changeText(const string& text)
 void PfText::addText(const string& text, bool newLine)
 {
     unsigned int m_initialLength = m_length;
+    m_layoutValid = false;
 
     string str;
     for (unsigned int i=0;i<m_length;i++)
@@ -135,34 +149,132 @@ vector<GLImage*>* PfText::toGLImages(bool relativeToBorders, bool stat, bool cur
 {
     vector<GLImage*>* pn_glImages_v_p_n = new vector<GLImage*>;
 
-    float x = 0, y = 0, w = m_rect.getH()/m_linesCount;
-	if (m_length == 0)
+    if (!m_layoutValid)
+        layoutGlyphs();
+
+    // seuls les caractres dj crits sont affichs, le maillage tant celui du texte complet
+    unsigned int count = m_glyphRects_v.size();
+    if (m_typingMode != TEXT_TYPING_ALLATONCE)
+    {
+        while (count > 0 && m_glyphIndexes_v[count-1] >= m_offset + m_typingCounter)
+            count--;
+    }
+    if (count > 0)
+        pn_glImages_v_p_n->push_back(new GLImage(m_glyphRects_v, m_textureIndex, m_glyphCoords_v, count, PfColor::WHITE, relativeToBorders, stat));
+
+    if (cursor)
     {
-        if (cursor)
+        float x, y, w = m_rect.getH()/m_linesCount;
+        if (count == 0)
+        {
+            x = lineStartX(w);
+            y = m_rect.getY() + (m_linesCount-1)*w;
+        }
+        else if (count == m_glyphRects_v.size())
         {
-            y = m_rect.getY() + (m_linesCount-1)*m_rect.getH()/m_linesCount;
-            switch (m_alignProp)
+            x = m_cursorX;
+            y = m_cursorY;
+        }
+        else // curseur plac aprs le dernier caractre crit
+        {
+            unsigned char c = m_text_t[m_glyphIndexes_v[count-1]];
+            y = m_glyphRects_v[count-1].getY() - m_zPos_t[(int) c]*w;
+            if (c != '\n')
+                x = m_glyphRects_v[count-1].getX() + w;
+            else
             {
-            case TEXT_ALIGN_LEFT:
-            case TEXT_ALIGN_JUSTIFIED:
-                x = m_rect.getX();
-                break;
-            case TEXT_ALIGN_CENTER:
-                x = m_rect.getX() + m_rect.getW()/2 - w/2;
-                break;
-            case TEXT_ALIGN_RIGHT:
-                x = m_rect.getX() + m_rect.getW() - 0.1*w;
-                break;
+                x = lineStartX(w);
+                y -= w;
             }
-            pn_glImages_v_p_n->push_back(new GLImage(PfRectangle(x, y, 0.1*w, w), PfColor::WHITE, GL_TRIANGLE_FAN, relativeToBorders, stat));
-        }
-		return pn_glImages_v_p_n;
-    }
+        }
+        pn_glImages_v_p_n->push_back(new GLImage(PfRectangle(x, y, 0.1*w, w), PfColor::WHITE, GL_TRIANGLE_FAN, relativeToBorders, stat));
+    }
+
+    return pn_glImages_v_p_n;
+}
+
+unsigned int PfText::charCountPerLine() const
+{
+    return (unsigned int) (m_rect.getW() / (m_rect.getH()/m_linesCount));
+}
+
+unsigned int PfText::displayedCharCount() const
+{
+    return charCountPerLine() * m_linesCount;
+}
+
+void PfText::changeDisplay(unsigned int offset, unsigned int length)
+{
+    if (offset > m_length || offset + length > m_length)
+        throw ArgumentException(__LINE__, __FILE__, string("Arguments inadapts, longueur du texte : ") + itostr(m_length) + ".\noffset=" + itostr(offset) + " ; length=" + itostr(length),
+                                "offset/length", "PfText::changeDisplay");
+
+    if (offset != m_offset || length != m_length)
+        m_layoutValid = false;
+    m_offset = offset;
+    m_length = length;
+}
+
+void PfText::updateTyping()
+{
+    switch (m_typingMode)
+    {
+    case TEXT_TYPING_ALLATONCE:
+        m_typingCounter = m_length;
+        break;
+    case TEXT_TYPING_SLOW:
+        if (m_typingCounter < m_length)
+            m_typingCounter++;
+        break;
+    case TEXT_TYPING_FAST:
+        if (m_typingCounter < m_length)
+            m_typingCounter += 2;
+        break;
+    }
+}
+
+void PfText::setRect(const PfRectangle& rect)
+{
+    if (rect.getX() != m_rect.getX() || rect.getY() != m_rect.getY() || rect.getW() != m_rect.getW() || rect.getH() != m_rect.getH())
+    {
+        m_rect = rect;
+        m_layoutValid = false;
+    }
+}
+
+void PfText::setLinesCount(unsigned int linesCount)
+{
+    if (linesCount != m_linesCount)
+    {
+        m_linesCount = linesCount;
+        m_layoutValid = false;
+    }
+}
+
+void PfText::setAlignProp(TextAlignProp align)
+{
+    if (align != m_alignProp)
+    {
+        m_alignProp = align;
+        m_layoutValid = false;
+    }
+}
+
+void PfText::layoutGlyphs() const
+{
+    m_glyphRects_v.clear();
+    m_glyphCoords_v.clear();
+    m_glyphIndexes_v.clear();
+
+    float x = 0, y = 0, w = m_rect.getH()/m_linesCount;
+    m_cursorX = lineStartX(w);
+    m_cursorY = m_rect.getY() + (m_linesCount-1)*w;
+    m_layoutValid = true;
+    if (m_length == 0)
+        return;
 
     unsigned int maxCharPerLine = charCountPerLine();
     unsigned int lastI = m_offset, charCount, displayCharCount, lastWord, maxI = m_offset + m_displayedLength;
-    if (m_typingMode != TEXT_TYPING_ALLATONCE)
-        maxI = MIN(maxI, m_offset + m_typingCounter);
 
     for (unsigned int line=0;line<m_linesCount;line++)
     {
@@ -203,8 +315,8 @@ vector<GLImage*>* PfText::toGLImages(bool relativeToBorders, bool stat, bool cur
             }
         }
 
-        // affichage de la ligne
-        y = m_rect.getY() + (m_linesCount-line-1)*m_rect.getH()/m_linesCount;
+        // placement de la ligne
+        y = m_rect.getY() + (m_linesCount-line-1)*w;
         switch (m_alignProp)
         {
         case TEXT_ALIGN_LEFT:
@@ -220,81 +332,37 @@ vector<GLImage*>* PfText::toGLImages(bool relativeToBorders, bool stat, bool cur
         }
         for (unsigned int i=lastI;i<lastI+charCount;i++)
         {
-            pn_glImages_v_p_n->push_back(new GLImage(PfRectangle(x, y + m_zPos_t[(int) m_text_t[i]]*w, w, w), m_textureIndex,
-                                                     PfRectangle(m_text_t[i]%16*1./16, (16-m_text_t[i]/16-1)*1./16, 1./16, 1./16),
-                                                     PfColor::WHITE, relativeToBorders, stat));
+            m_glyphRects_v.push_back(PfRectangle(x, y + m_zPos_t[(int) m_text_t[i]]*w, w, w));
+            m_glyphCoords_v.push_back(PfRectangle(m_text_t[i]%16*1./16, (16-m_text_t[i]/16-1)*1./16, 1./16, 1./16));
+            m_glyphIndexes_v.push_back(i);
             x += w;
             // si on n'est pas  la dernire ligne, traiter l'ventuelle justification
             if (m_alignProp == TEXT_ALIGN_JUSTIFIED && lastI+charCount < maxI && m_text_t[lastI+charCount-1] != '\n')
                 x += (m_rect.getW() - displayCharCount*w)/(displayCharCount-1);
         }
-        y -= w;
         lastI += charCount;
 
         if (lastI == maxI)
             break;
     }
-    if (cursor)
-    {
-        if (m_text_t[lastI-1] != '\n')
-            y += w;
-        else
-        {
-            switch (m_alignProp)
-            {
-            case TEXT_ALIGN_LEFT:
-            case TEXT_ALIGN_JUSTIFIED:
-                x = m_rect.getX();
-                break;
-            case TEXT_ALIGN_CENTER:
-                x = m_rect.getX() + m_rect.getW()/2 - w/2;
-                break;
-            case TEXT_ALIGN_RIGHT:
-                x = m_rect.getX() + m_rect.getW() - 0.1*w;
-                break;
-            }
-        }
-        pn_glImages_v_p_n->push_back(new GLImage(PfRectangle(x, y, 0.1*w, w), PfColor::WHITE, GL_TRIANGLE_FAN, relativeToBorders, stat));
-    }
-
-    return pn_glImages_v_p_n;
-}
 
-unsigned int PfText::charCountPerLine() const
-{
-    return (unsigned int) (m_rect.getW() / (m_rect.getH()/m_linesCount));
-}
-
-unsigned int PfText::displayedCharCount() const
-{
-    return charCountPerLine() * m_linesCount;
+    if (lastI > m_offset && m_text_t[lastI-1] == '\n')
+        y -= w; // curseur en dbut de ligne suivante
+    else if (lastI > m_offset)
+        m_cursorX = x;
+    m_cursorY = y;
 }
 
-void PfText::changeDisplay(unsigned int offset, unsigned int length)
+float PfText::lineStartX(float w) const
 {
-    if (offset > m_length || offset + length > m_length)
-        throw ArgumentException(__LINE__, __FILE__, string("Arguments inadapts, longueur du texte : ") + itostr(m_length) + ".\noffset=" + itostr(offset) + " ; length=" + itostr(length),
-                                "offset/length", "PfText::changeDisplay");
-
-    m_offset = offset;
-    m_length = length;
-}
-
-void PfText::updateTyping()
-{
-    switch (m_typingMode)
+    switch (m_alignProp)
     {
-    case TEXT_TYPING_ALLATONCE:
-        m_typingCounter = m_length;
-        break;
-    case TEXT_TYPING_SLOW:
-        if (m_typingCounter < m_length)
-            m_typingCounter++;
-        break;
-    case TEXT_TYPING_FAST:
-        if (m_typingCounter < m_length)
-            m_typingCounter += 2;
-        break;
+    case TEXT_ALIGN_CENTER:
+        return m_rect.getX() + m_rect.getW()/2 - w/2;
+    case TEXT_ALIGN_RIGHT:
+        return m_rect.getX() + m_rect.getW() - 0.1*w;
+    default:
+        return m_rect.getX();
     }
 }
 
@@ -311,6 +379,7 @@ PfText& PfText::operator=(const PfText& text)
         m_displayedLength = text.m_displayedLength;
         m_typingMode = text.m_typingMode;
         m_typingCounter = text.m_typingCounter;
+        m_layoutValid = false;
 
         for (int i=0;i<256;i++)
             m_zPos_t[i] = text.m_zPos_t[i];
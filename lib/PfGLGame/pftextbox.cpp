@@ -8,7 +8,8 @@
 PfTextBox::PfTextBox(const string& name, const PfRectangle& rect, unsigned int layer, float hMargin, float vMargin, unsigned int textureIndex,
                      PfWidget::PfWidgetStatusMap statusMap) :
 	PfWidget(name, rect.getX(), rect.getY(), rect.getW(), rect.getH(), layer, statusMap), m_cursorShown(false), m_fileNameChar(false),
-	m_multiLine(false), m_linesCount(1), m_hMargin(hMargin), m_vMargin(vMargin), m_fontTextureIndex(textureIndex) {}
+	m_multiLine(false), m_linesCount(1), m_hMargin(hMargin), m_vMargin(vMargin), m_fontTextureIndex(textureIndex),
+	m_textMesh("", textureIndex, PfRectangle(), 1, PfText::TEXT_ALIGN_JUSTIFIED) {}
 
 void PfTextBox::addChar(char c)
 {
@@ -119,24 +120,25 @@ Viewable* PfTextBox::generateViewable() const
 {
 	Viewable* p_ = PfWidget::generateViewable();
 
-	PfText text(m_text, m_fontTextureIndex, PfRectangle(rect_x()+m_hMargin*rect_w(), rect_y()+m_vMargin*rect_h(),
-                                                        (1-2*m_hMargin)*rect_w(), (1-2*m_vMargin)*rect_h()),
-                m_linesCount, PfText::TEXT_ALIGN_JUSTIFIED);
+	// le texte conserv ne recalcule la disposition de ses caractres que si l'un de ces paramtres a chang
+	m_textMesh.changeText(m_text);
+	m_textMesh.setRect(PfRectangle(rect_x()+m_hMargin*rect_w(), rect_y()+m_vMargin*rect_h(), (1-2*m_hMargin)*rect_w(), (1-2*m_vMargin)*rect_h()));
+	m_textMesh.setLinesCount(m_linesCount);
     try
     {
-        if (text.getLength() > 0)
+        if (m_textMesh.getLength() > 0)
         {
             unsigned int offset, length;
             offset = 0; // temporaire, en attente gestion dynamique
             length = m_text.size();
-            text.changeDisplay(offset, length);
+            m_textMesh.changeDisplay(offset, length);
         }
     }
     catch (PfException& e)
     {
         throw ViewableGenerationException(__LINE__, __FILE__, "Impossible d'afficher le texte.", p_->getName(), e);
     }
-	vector<GLImage*>* pn_images_v_p_n = text.toGLImages(isCoordRelativeToBorder(), isStatic(), m_cursorShown);
+	vector<GLImage*>* pn_images_v_p_n = m_textMesh.toGLImages(isCoordRelativeToBorder(), isStatic(), m_cursorShown);
 	for (unsigned int i=0, size=pn_images_v_p_n->size();i<size;i++)
 		p_->addImage(pn_images_v_p_n->at(i));
 	delete pn_images_v_p_n;
@@ -6,6 +6,8 @@
 #include "misc.h"
 #include "errors.h"
 
+AbstractModel::AbstractModel() : mq_items_v(1, (ModelItem*) 0) {} // l'identifiant 0 n'est jamais attribué
+
 AbstractModel::~AbstractModel()
 {
 	for (map<string, ModelItem*>::iterator it=mpn_modelItems_map.begin();it!=mpn_modelItems_map.end();++it)
@@ -38,10 +40,30 @@ void AbstractModel::notifyAll()
 
 void AbstractModel::addItem(ModelItem* p_item)
 {
-	if (mpn_modelItems_map.find(p_item->getName()) != mpn_modelItems_map.end()) // remplacer un objet existant
+	unsigned int handle;
+	map<string, unsigned int>::const_iterator handleIt = m_handles_map.find(p_item->getName());
+	if (handleIt != m_handles_map.end()) // remplacer un objet existant, qui conserve son identifiant
+	{
+		handle = handleIt->second;
+		itemRemoved(handle, mq_items_v[handle]);
 		removeObjectFromMap(mpn_modelItems_map, p_item->getName());
+	}
+	else if (!m_freeHandles_v.empty())
+	{
+		handle = m_freeHandles_v.back();
+		m_freeHandles_v.pop_back();
+		m_handles_map.insert(pair<string, unsigned int>(p_item->getName(), handle));
+	}
+	else
+	{
+		handle = mq_items_v.size();
+		mq_items_v.push_back(0);
+		m_handles_map.insert(pair<string, unsigned int>(p_item->getName(), handle));
+	}
 
 	mpn_modelItems_map.insert(pair<string, ModelItem*>(p_item->getName(), p_item));
+	mq_items_v[handle] = p_item;
+	itemAdded(handle, p_item);
 }
 
 void AbstractModel::removeItem(const string& keyName)
@@ -86,6 +108,14 @@ void AbstractModel::clearItem(const string& keyName)
 	#endif
 	#endif
 
+	map<string, unsigned int>::iterator handleIt = m_handles_map.find(keyName);
+	assert(handleIt != m_handles_map.end());
+	unsigned int handle = handleIt->second;
+	itemRemoved(handle, mq_items_v[handle]);
+	mq_items_v[handle] = 0;
+	m_freeHandles_v.push_back(handle);
+	m_handles_map.erase(handleIt); // à effacer avant la suppression de l'objet, la clé pouvant être une référence vers son nom
+
 	removeObjectFromMap(mpn_modelItems_map, keyName);
 
 	#ifndef NDEBUG
@@ -95,6 +125,14 @@ void AbstractModel::clearItem(const string& keyName)
 	#endif
 }
 
+unsigned int AbstractModel::itemHandle(const string& keyName) const
+{
+	map<string, unsigned int>::const_iterator it = m_handles_map.find(keyName);
+	if (it == m_handles_map.end())
+		return 0;
+	return it->second;
+}
+
 vector<ModelItem*> AbstractModel::modelItems()
 {
 	vector<ModelItem*> p_items_v;
@@ -2,12 +2,12 @@
 
 #include <cassert>
 #include <vector>
-#include <SDL.h>
 #include "viewable.h"
 #include "modelitem.h"
 #include "misc.h"
+#include "profiler.h"
 
-AbstractView::AbstractView() : m_timeCounter(SDL_GetTicks()) {}
+AbstractView::AbstractView() {}
 
 AbstractView::~AbstractView()
 {
@@ -20,97 +20,73 @@ AbstractView::~AbstractView()
 
 void AbstractView::display()
 {
-	int nextLayer = 0;
-	vector<const Viewable*> q_vws_v, q_vws2_v;
-	vector<const Viewable*>* q_vws_v_p = &q_vws_v;
-	vector<const Viewable*>* q_vws2_v_p = &q_vws2_v;
-	vector<const Viewable*>* q_temp_v_p;
 	const Viewable* q_vw;
-
-	uint32_t time = SDL_GetTicks() - m_timeCounter;
-	if (time < FPS_RATE)
-		SDL_Delay(FPS_RATE - time);
-	m_timeCounter = SDL_GetTicks();
+	vector<ViewableGrid::Entry> entries_v;
+	PfRectangle area;
 
 	initializeDisplay();
 
-	for (map<string, Viewable*>::const_iterator it=mpn_viewables_map.begin();it!=mpn_viewables_map.end();++it)
-	{
-		assert(it->second);
-		if (it->second->isVisible())
-		{
-			if (viewportContains(*(it->second)))
-			{
-		  		if (it->second->getLayer() == 0) // affiche les viewables de premier plan
-			   		displayViewable(*(it->second));
-				else // stocke les viewables des autres plans dans une liste
-				{
-					q_vws_v.push_back(it->second);
-					if (it->second->getLayer() < nextLayer || nextLayer == 0) // dtermine le prochain plan  afficher
-				   		nextLayer = it->second->getLayer();
-				}
-			}
-			// dans la premire boucle, les Viewable lis sont traits comme des Viewables normaux et sont tris
-			for (unsigned int i=0, size=it->second->viewablesCount();i<size;i++)
-			{
-				q_vw = it->second->viewableAt(i);
-				if (viewportContains(*q_vw))
-				{
-					if (q_vw->getLayer() == 0)
-						displayViewable(*q_vw);
-					else
-					{
-						q_vws_v.push_back(q_vw);
-						if (q_vw->getLayer() < nextLayer || nextLayer == 0)
-							nextLayer = q_vw->getLayer();
-					}
-				}
-			}
-		}
-	}
+	if (visibleArea(area)) // seuls les Viewable susceptibles de recouvrir la zone visible sont parcourus
+		m_grid.find(area, entries_v);
+	else
+		m_grid.findAll(entries_v);
 
-	while (!q_vws_v_p->empty()) // tant qu'il reste des plans dont les viewables n'ont pas encore t affichs
+	// la liste est dj trie par plan, par nom puis par texture, les Viewable lis y figurant comme des Viewable indpendants
 	{
-		int currentLayer = nextLayer;
-		for (unsigned int i=0, size=q_vws_v_p->size();i<size;i++) // boucle pour chaque viewable restant
+		PROFILE_SCOPE("drawGL");
+		for (unsigned int i=0, size=entries_v.size();i<size;i++)
 		{
-			q_vw = (*q_vws_v_p)[i];
-			if (q_vw->getLayer() == currentLayer) // ce viewable appartient au plan en cours d'affichage ?
+			if (!entries_v[i].q_parent->isVisible() || !entries_v[i].q_viewable->isVisible())
+				continue;
+			q_vw = entries_v[i].q_viewable;
+			if (viewportContains(*q_vw))
 				displayViewable(*q_vw);
-			else
-			{
-				q_vws2_v_p->push_back(q_vw); // liste des viewables non encore affichs
-				if (q_vw->getLayer() < nextLayer || nextLayer == currentLayer) // dtermine le prochain plan  afficher
-					nextLayer = q_vw->getLayer();
-			}
 		}
-
-		q_vws_v_p->clear(); // la liste utilise lors de cette itration est vide
-		q_temp_v_p = q_vws2_v_p; // la liste des viewables non encore affichs est transfre vers un pointeur temporaire
-		q_vws2_v_p = q_vws_v_p; // le pointeur 2 est interverti avec le pointeur 1 pour redevenir vide et jouer son rle de stockage de viewables non encore affichs...
-		q_vws_v_p = q_temp_v_p; // ...  la prochaine itration, tandis que q_vws_v_p regagne son rle de liste  parcourir.
 	}
 
-	finalizeDisplay();
+	{
+		PROFILE_SCOPE("finalizeDisplay");
+		finalizeDisplay();
+	}
 }
 
 void AbstractView::update(const map<string, ModelItem*>& p_modelItems_map)
 {
+	PROFILE_SCOPE("AbstractView::update");
+
+	#ifndef NDEBUG
+	unsigned int allocations = g_dbGLImageAllocations, generated = 0;
+	#endif
+
+	map<string, Viewable*>::iterator vwIt;
 	for (map<string, ModelItem*>::const_iterator it=p_modelItems_map.begin();it!=p_modelItems_map.end();++it)
 	{
 		assert(it->second);
+		vwIt = mpn_viewables_map.find(it->first);
 		// ModelItem dont la cl est encore inconnue
-		if (mpn_viewables_map.find(it->first) == mpn_viewables_map.end())
+		if (vwIt == mpn_viewables_map.end())
 		{
 			Viewable* p_vw = it->second->generateViewable();
 			assert(p_vw);
 			mpn_viewables_map.insert(pair<string, Viewable*>(it->first, p_vw));
+			indexViewable(it->first, p_vw);
+			#ifndef NDEBUG
+			generated++;
+			#endif
 		}
 		else if (it->second->isModified())
 		{
-			removeObjectFromMap(mpn_viewables_map, it->first);
-			Viewable* p_vw = it->second->generateViewable();
-			mpn_viewables_map.insert(pair<string, Viewable*>(it->first, p_vw));
+			m_grid.remove(vwIt->second);
+			if (!it->second->updateViewable(*(vwIt->second)))
+			{
+				removeObjectFromMap(mpn_viewables_map, it->first);
+				Viewable* p_vw = it->second->generateViewable();
+				mpn_viewables_map.insert(pair<string, Viewable*>(it->first, p_vw));
+				#ifndef NDEBUG
+				generated++;
+				#endif
+			}
+			indexViewable(it->first, mpn_viewables_map[it->first]);
 		}
 		switch (it->second->getStatus())
 		{
@@ -121,12 +97,21 @@ void AbstractView::update(const map<string, ModelItem*>& p_modelItems_map)
 				mpn_viewables_map[it->first]->setVisible(false);
 				break;
 			case ModelItem::DEAD:
+				m_grid.remove(mpn_viewables_map[it->first]);
 				removeObjectFromMap(mpn_viewables_map, it->first);
 				break;
 			default:
 				break;
 		}
 	}
+
+	#ifndef NDEBUG
+	if (g_debug) // en rgime tabli, aucun Viewable ne devrait tre gnr et aucune image alloue
+	{
+		g_dbInt_v_map["vwGen"].push_back(generated);
+		g_dbInt_v_map["glAlloc"].push_back(g_dbGLImageAllocations - allocations);
+	}
+	#endif
 }
 
 bool AbstractView::viewportContains(const Viewable&) const
@@ -134,3 +119,35 @@ bool AbstractView::viewportContains(const Viewable&) const
 	return true;
 }
 
+bool AbstractView::viewableBounds(const Viewable&, PfRectangle&) const
+{
+	return false;
+}
+
+bool AbstractView::visibleArea(PfRectangle&) const
+{
+	return false;
+}
+
+void AbstractView::indexViewable(const string& name, const Viewable* q_viewable)
+{
+	PfRectangle bounds;
+	ViewableGrid::Entry entry;
+	entry.q_parent = q_viewable;
+	entry.q_name = &(mpn_viewables_map.find(name)->first);
+
+	for (unsigned int i=0, size=q_viewable->viewablesCount();i<=size;i++)
+	{
+		entry.q_viewable = (i==0)?q_viewable:q_viewable->viewableAt(i-1);
+		entry.childIndex = i;
+		entry.layer = entry.q_viewable->getLayer();
+		entry.texture = (entry.q_viewable->imagesCount() > 0)?entry.q_viewable->imageAt(0).getTextureIndex():0;
+		if (i > 0 && !entry.q_viewable->isVisible()) // un Viewable li invisible n'est jamais affich
+			continue;
+		if (viewableBounds(*(entry.q_viewable), bounds))
+			m_grid.add(entry, bounds);
+		else
+			m_grid.addUnbounded(entry);
+	}
+}
+
@@ -40,6 +40,14 @@ class ModelItem;
 *
 * @warning
 * Les ModelItem doivent être stockés dans la map avec pour clés leurs noms. Ceci est nécessaire pour la bonne gestion des ModelItem par la suite.
+*
+* Chaque ModelItem ajouté reçoit un identifiant entier, stable jusqu'à sa suppression (AbstractModel::itemHandle).
+* Un ModelItem remplaçant un autre de même nom conserve son identifiant. Les identifiants libérés sont réutilisés, 0 n'est jamais attribué.
+* L'accès par identifiant (AbstractModel::itemAt) se fait en temps constant, sans recherche par nom.
+*
+* Les classes dérivées peuvent tenir leurs propres index typés (listes de pointeurs vers un type d'objet particulier par exemple)
+* en redéfinissant les méthodes AbstractModel::itemAdded et AbstractModel::itemRemoved, appelées à chaque ajout et suppression.
+* Ceci évite de recourir à AbstractModel::findAllItems ou AbstractModel::findItem dans les boucles de mise à jour.
 */
 class AbstractModel : private NonCopyable
 {
@@ -49,9 +57,15 @@ public:
     * ----------------------------
     */
     /**
+    * @brief Constructeur AbstractModel.
+    */
+    AbstractModel();
+    /**
     * @brief Destructeur AbstractModel.
     *
     * Détruit tous les ModelItem de la liste.
+    *
+    * La méthode AbstractModel::itemRemoved n'est pas appelée.
     */
     virtual ~AbstractModel();
     /*
@@ -123,6 +137,24 @@ protected:
     */
     void clearItem(const string& keyName);
     /**
+    * @brief Retourne l'identifiant de l'objet à la clé spécifiée.
+    * @param keyName La clé de l'objet.
+    * @return L'identifiant de l'objet, 0 s'il n'est pas trouvé.
+    */
+    unsigned int itemHandle(const string& keyName) const;
+    /**
+    * @brief Retourne l'objet dont l'identifiant est spécifié.
+    * @param handle L'identifiant de l'objet.
+    * @return Un pointeur sur l'objet, 0 si aucun objet n'a cet identifiant.
+    */
+    ModelItem* itemAt(unsigned int handle) {return (handle < mq_items_v.size())?mq_items_v[handle]:0;}
+    /**
+    * @brief Retourne l'objet dont l'identifiant est spécifié.
+    * @param handle L'identifiant de l'objet.
+    * @return Un pointeur constant sur l'objet, 0 si aucun objet n'a cet identifiant.
+    */
+    const ModelItem* constItemAt(unsigned int handle) const {return (handle < mq_items_v.size())?mq_items_v[handle]:0;}
+    /**
     * @brief Cherche l'objet à la clé spécifiée, du type spécifié.
     * @param keyName La clé de l'objet.
     * @return Un pointeur sur l'objet, 0 s'il n'est pas trouvé ou d'un autre type.
@@ -209,8 +241,30 @@ protected:
     virtual pair<float, float> viewportData() const = 0;
 
 private:
+    /**
+    * @brief Méthode appelée après l'ajout d'un ModelItem à la liste.
+    * @param handle L'identifiant attribué à l'objet.
+    * @param p_item L'objet ajouté.
+    *
+    * Par défaut, ne fait rien.
+    */
+    virtual void itemAdded(unsigned int handle, ModelItem* p_item) {}
+    /**
+    * @brief Méthode appelée avant la suppression d'un ModelItem de la liste.
+    * @param handle L'identifiant de l'objet.
+    * @param p_item L'objet, encore valide, qui va être détruit.
+    *
+    * Par défaut, ne fait rien.
+    *
+    * Cette méthode est également appelée pour l'objet remplacé lors de l'ajout d'un objet de même nom.
+    */
+    virtual void itemRemoved(unsigned int handle, ModelItem* p_item) {}
+
     map<string, ModelItem*> mpn_modelItems_map; //!< La liste des ModelItem de ce modèle, mémoire allouée dans cette classe (méthode AbstractModel::addItem).
     vector<AbstractView*> mp_views_v; //!< La liste des vues associées à ce modèle, pointeurs externes, pas d'allocation dans cette classe.
+    vector<ModelItem*> mq_items_v; //!< Les ModelItem de ce modèle par identifiant, 0 pour un identifiant libre.
+    map<string, unsigned int> m_handles_map; //!< Les identifiants des ModelItem de ce modèle par clé.
+    vector<unsigned int> m_freeHandles_v; //!< Les identifiants libérés, réutilisés en priorité.
 };
 
 #endif // ABSTRACTMODEL_H_INCLUDED
@@ -13,6 +13,8 @@
 #include <map>
 #include <string>
 #include "noncopyable.h"
+#include "geometry.h"
+#include "viewablegrid.h"
 
 class ModelItem;
 class Viewable;
@@ -51,8 +53,6 @@ public:
     */
     /**
     * @brief Constructeur AbstractView.
-    *
-    * Initialise le compteur de temps AbstractView::m_timeCounter d'après la fonction <em>SDL_GetTicks</em>.
     */
     AbstractView();
     /**
@@ -71,16 +71,24 @@ public:
     * Cette méthode est générale à tous les types de vue MVC.
     * C'est la méthode AbstractView::displayViewable qu'il faut redéfinir pour spécifier le mode d'affichage.
     *
-    * Cette méthode gère la fréquence d'affichage en gelant le programme si le dernier rafraîchissement
-    * s'est fait trop tôt par rapport à la valeur FPS_RATE (fichier "mvc_gen.h").
-    * La fonction <em>SDL_Delay</em> est utilisée pour retarder le déroulement du programme en cas d'avance.
+    * La fréquence d'affichage n'est pas gérée ici mais par la méthode MVCSystem::run.
     *
-    * Cette méthode trie les Viewable de la liste AbstractView::mpn_viewables_map en fonction de leurs plans de perspective et les affiche
-    * chacun au moyen de la méthode virtuelle AbstractView::displayViewable en commençant par le plan le plus profond (d'indice inférieur).
+    * Cette méthode affiche les Viewable de la liste AbstractView::mpn_viewables_map en fonction de leurs plans de perspective,
+    * chacun au moyen de la méthode virtuelle AbstractView::displayViewable, en commençant par le plan 0 puis par le plan le plus profond (d'indice inférieur).
+    * Au sein d'un même plan, les Viewable sont affichés par ordre alphabétique de nom, puis les Viewable liés à un même Viewable principal sont regroupés par texture.
     * Si un Viewable présente des Viewables liés, alors ceux-ci sont triés comme des Viewable indépendants.
-    * Seuls les Viewable visibles dans la vue (testés par la méthode AbstractView::viewportContains) sont affichés et triés.
+    * Seuls les Viewable visibles dans la vue (testés par la méthode AbstractView::viewportContains) sont affichés.
+    *
+    * Le tri n'est pas refait à chaque affichage : la grille AbstractView::m_grid conserve ses éléments dans l'ordre d'affichage,
+    * et cet ordre n'est mis à jour que lorsque AbstractView::update ajoute, regénère ou supprime un Viewable.
+    * L'affichage se fait donc en un seul parcours de liste.
     * Les Viewable liés subissent ce test de manière indépendante de leur Viewable principal, il est donc inutile dans les redéfinitions
     * de AbstractView de tenir compte des Viewable liés dans cette méthode de test.
+    * Les Viewable liés invisibles ne sont pas affichés, même si leur Viewable principal est visible.
+    *
+    * Les Viewable ne sont pas tous parcourus : seuls ceux que la grille AbstractView::m_grid associe à la zone retournée
+    * par la méthode AbstractView::visibleArea sont testés.
+    * Si cette méthode retourne <code>false</code>, tous les Viewable de la grille sont parcourus.
     *
     * Avant cela, la méthode virtuelle AbstractView::initializeDisplay est appelée.
     * Après l'affichage des Viewable, la méthode virtuelle AbstractView::finalizeDisplay est appelée.
@@ -91,13 +99,20 @@ public:
     * @param p_modelItems_map La map de ModelItem.
     *
     * Pour chaque ModelItem, si aucun Viewable n'est connu de cette vue avec le même nom, alors il est généré à partir du ModelItem
-    * (ModelItem::generateViewable). Si l'objet est connu mais marqué modifié, alors le Viewable est regénéré.
+    * (ModelItem::generateViewable). Si l'objet est connu mais marqué modifié, alors le ModelItem tente de mettre à jour le Viewable existant
+    * (ModelItem::updateViewable), et s'il n'y parvient pas, le Viewable est regénéré.
     *
     * L'état du ModelItem est ensuite utilisé pour effectuer les actions suivantes sur les Viewable gérés par la vue :
     * <ul><li>ModelItem::VISIBLE : rendre le Viewable visible,</li>
     * <li>ModelItem::INVISIBLE : rendre le Viewable invisible,</li>
     * <li>ModelItem::DEAD : suppression du Viewable.</li></ul>
     *
+    * Chaque Viewable généré ou mis à jour est référencé à nouveau dans la grille AbstractView::m_grid (AbstractView::indexViewable).
+    * Les Viewable liés invisibles à ce moment ne sont pas référencés.
+    *
+    * En debug, si <em>g_debug</em> est vrai, le nombre de Viewable générés et le nombre de tableaux alloués par des GLImage
+    * lors de cet appel sont ajoutés aux listes "vwGen" et "glAlloc" de <em>g_dbInt_v_map</em> (fichier "misc_gen.h" de la bibliothèque PfMisc).
+    *
     * @warning
     * Aucun pointeur passé en paramètre ne doit être nul. Une assertion vérifie ce point.
     */
@@ -127,6 +142,31 @@ private:
     */
     virtual bool viewportContains(const Viewable& rc_viewable) const;
     /**
+    * @brief Calcule le rectangle englobant d'un Viewable, utilisé pour le référencer dans la grille AbstractView::m_grid.
+    * @param rc_viewable Le Viewable.
+    * @param r_bounds Le rectangle à remplir.
+    * @return <code>false</code> si le Viewable n'a pas de rectangle englobant exploitable.
+    *
+    * Par défaut, retourne <code>false</code> : le Viewable est alors parcouru à chaque affichage.
+    *
+    * Les Viewable liés sont passés à cette méthode de manière indépendante de leur Viewable principal.
+    */
+    virtual bool viewableBounds(const Viewable& rc_viewable, PfRectangle& r_bounds) const;
+    /**
+    * @brief Calcule la zone visible de cette vue, dans le même repère que les rectangles de AbstractView::viewableBounds.
+    * @param r_area Le rectangle à remplir.
+    * @return <code>false</code> si la vue n'a pas de zone visible bornée.
+    *
+    * Par défaut, retourne <code>false</code> : tous les Viewable sont alors parcourus à chaque affichage.
+    */
+    virtual bool visibleArea(PfRectangle& r_area) const;
+    /**
+    * @brief Référence un Viewable et ses Viewable liés visibles dans la grille AbstractView::m_grid.
+    * @param name Le nom du Viewable dans la liste AbstractView::mpn_viewables_map.
+    * @param q_viewable Le Viewable.
+    */
+    void indexViewable(const string& name, const Viewable* q_viewable);
+    /**
     * @brief Action réalisée par la vue avant l'affichage de tous les Viewable.
     */
     virtual void initializeDisplay() const = 0;
@@ -143,7 +183,7 @@ private:
     virtual void finalizeDisplay() const = 0;
 
     map<string, Viewable*> mpn_viewables_map; //!< La map des viewables de cette vue. La méthode AbstractView::update y alloue de la mémoire.
-    uint32_t m_timeCounter; //!< Le compteur de temps servant à la gestion du taux FPS.
+    ViewableGrid m_grid; //!< La grille référençant les Viewable de la liste AbstractView::mpn_viewables_map et leurs Viewable liés.
 };
 
 #endif // ABSTRACTVIEW_H_INCLUDED
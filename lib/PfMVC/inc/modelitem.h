@@ -32,6 +32,7 @@ class Viewable;
 *
 * Si cet objet est marqué modifié, il générera un nouveau Viewable lors de la mise à jour de la vue. Ce Viewable sera alors visible sauf si
 * le statut actuel de cet objet est ModelItem::INVISIBLE.
+* Un ModelItem peut éviter cette régénération complète en redéfinissant la méthode ModelItem::updateViewable.
 *
 * Il est nécessaire de passer le booléen ModelItem::m_modified à <code>true</code> pour chaque modification, autrement il ne sera pas pris en compte
 * lors de l'affichage par la vue, qui ne génèrera pas de nouveau Viewable pour refléter le nouvel état.
@@ -78,6 +79,17 @@ public:
     * De la mémoire est allouée pour le pointeur retourné.
     */
     virtual Viewable* generateViewable() const = 0;
+    /**
+    * @brief Met à jour un Viewable déjà généré par ce ModelItem.
+    * @param r_viewable Le Viewable à mettre à jour, généré auparavant par ModelItem::generateViewable.
+    * @return <code>true</code> si le Viewable a été mis à jour, <code>false</code> s'il doit être entièrement régénéré.
+    *
+    * Cette méthode est appelée par AbstractView::update lorsque ce ModelItem est marqué modifié.
+    * Elle permet aux ModelItem complexes de ne régénérer que les parties modifiées de leur Viewable.
+    *
+    * Par défaut, rien n'est fait et <code>false</code> est retourné, la vue appelle alors ModelItem::generateViewable.
+    */
+    virtual bool updateViewable(Viewable& r_viewable) const {return false;}
     /*
     * Accesseurs
     * ----------
@@ -5,7 +5,8 @@
 * @date xx/xx/xxxx
 * @version 0.0.0
 *
-* La macro FPS_RATE est définie ici. Elle fixe le temps minimal entre deux rafraîchissements successifs de la vue.
+* Les macros MVC_TICK_DURATION et FPS_RATE sont définies ici. Elles fixent respectivement la durée d'un tour de mise à jour du modèle
+* et le temps minimal par défaut entre deux rafraîchissements successifs de la vue (voir MVCSystem::run).
 */
 
 /**
@@ -44,6 +45,10 @@
 
 #include "misc_gen.h"
 
-#define FPS_RATE 50 //!< La cadence de rafraîchissement de l'image en ms.
+#define FPS_RATE 50 //!< La cadence de rafraîchissement de l'image en ms, 0 pour aucune limite.
+#define MVC_TICK_DURATION 50 //!< La durée d'un tour de mise à jour du modèle en ms.
+#define MVC_MAX_TICKS_PER_FRAME 5 //!< Le nombre maximal de tours de mise à jour du modèle rattrapés entre deux affichages.
+#define VIEWABLE_GRID_CELL_SIZE 0.25 //!< La taille par défaut d'une case de ViewableGrid, dans les coordonnées des images.
+#define VIEWABLE_GRID_MAX_CELLS 4096 //!< Le nombre maximal de cases d'une ViewableGrid recouvertes par un même Viewable.
 
 #endif // MVC_GEN_H_INCLUDED
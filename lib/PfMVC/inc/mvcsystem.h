@@ -46,6 +46,13 @@ class AbstractController;
 * Quand la boucle infinie est appelée par la méthode MVCSystem::run, il est possible de préciser le mode <em>One Shot</em>.
 * Dans ce mode, les données utilisateurs ne sont pas traitées et la boucle ne s'exécute qu'une seule fois avant d'être quittée.
 *
+* La mise à jour du modèle et l'affichage de la vue sont découplés : le modèle est mis à jour par tours de durée fixe
+* (MVCSystem::m_tickDuration), indépendamment du temps pris par l'affichage. Si l'affichage prend du retard, plusieurs tours
+* sont enchaînés avant l'affichage suivant, si bien que la vitesse du jeu ne dépend pas de celle du rendu.
+* L'affichage peut être limité par une durée minimale entre deux images (MVCSystem::m_frameDuration).
+*
+* La méthode MVCSystem::runHeadless permet d'enchaîner des tours sans vue ni attente, pour tester ou mesurer la simulation seule.
+*
 * Il est possible via cette classe de récupérer des valeurs stockées dans le contrôleur. Ces valeurs peuvent être utilisées de diverses façons
 * pour transmettre des informations au programme dans la boucle principale ayant recours à un MVCSystem.
 * La méthode MVCSystem::values permet de faire ce lien, en retournant un DataPackage.
@@ -94,23 +101,50 @@ public:
     * Ceci se fait par appel de la méthode AbstractController::wakeUp.
     *
     * Ensuite, la boucle suivante est lancée et tourne tant que le contrôleur est à l'état AbstractController::ALIVE.
+    * Le temps écoulé depuis le tour précédent est ajouté à un accumulateur, puis, tant que l'accumulateur contient au moins
+    * MVCSystem::m_tickDuration millisecondes, un tour est exécuté (MVCSystem::tick) :
     * <ul><li>Si les entrées utilisateurs sont acceptées et qu'il ne s'agit pas d'un <em>One Shot</em>, elles sont traitées par appel à la méthode
     * AbstractController::pollInput. Si elles ne sont pas acceptées ou s'il s'agit d'un <em>One Shot</em>, alors la méthode AbstractController::flushInput
     * est appelée à la place.</li>
     * <li>Un nouveau test de réveil du contrôleur est effectué mais cette fois sans action. Si le contrôleur est endormi ou mort suite aux actions traitées,
-    * alors la boucle passe directement à la dernière ligne de cette liste.</li>
+    * alors le tour s'arrête là.</li>
     * <li>Le contrôleur est mis à jour par appel à la méthode AbstractController::update.
     * Typiquement, les données stockées par le gestionnaire d'événements utilisateurs sont utilisées pour mettre à jour le modèle au moyen d'actions
     * induites par le contrôleur.</li>
     * <li>Mise à jour des vues par le modèle par appel à la méthode AbstractModel::notifyAll.</li>
     * <li>Mise à jour des objets du modèle par appel à la méthode AbstractModel::updateItems. Cela se fait après mise à jour des vues,
     * et se traduit par exemple par la destruction d'un ModelItem de statut ModelItem::DEAD.
-    * Ce ModelItem aura entraîné la destruction du Viewable associé dans la vue et peut maintenant être effectivement détruit dans le modèle.</li>
-    * <li>Rendu des vues par appel à la méthode AbstractView::display.</li>
-    * <li>S'il s'agit d'un <em>One Shot</em>, passage du contrôleur en mode AbstractController::ASLEEP.</li></ul>
+    * Ce ModelItem aura entraîné la destruction du Viewable associé dans la vue et peut maintenant être effectivement détruit dans le modèle.</li></ul>
+    *
+    * Les vues étant notifiées à chaque tour, aucune modification ni destruction de ModelItem n'est perdue quand plusieurs tours se suivent.
+    *
+    * Au plus MVC_MAX_TICKS_PER_FRAME tours sont rattrapés entre deux affichages : au-delà, le retard est abandonné et le jeu ralentit.
+    *
+    * Si au moins un tour a été exécuté et que MVCSystem::m_frameDuration millisecondes au moins se sont écoulées depuis le dernier affichage
+    * (aucune limite si cette durée est nulle), alors les vues sont rendues par appel à la méthode AbstractView::display.
+    * La dernière image, après que le contrôleur a quitté l'état AbstractController::ALIVE, est toujours affichée.
+    * Sinon, le programme est gelé jusqu'au tour suivant par la fonction <em>SDL_Delay</em>.
+    * Sans nouveau tour, l'image serait identique à la précédente : l'affichage n'est donc jamais plus fréquent que les tours.
+    *
+    * En mode <em>One Shot</em>, un seul tour est exécuté, au plus tôt MVCSystem::m_tickDuration millisecondes après le tour précédent,
+    * suivi d'un affichage, puis le contrôleur passe en mode AbstractController::ASLEEP.
     */
     bool run(bool once = false);
     /**
+    * @brief Enchaîne des tours de mise à jour du modèle sans vue ni attente.
+    * @param ticksCount Le nombre de tours à exécuter, 0 pour continuer tant que le contrôleur est à l'état AbstractController::ALIVE.
+    * @return Le nombre de tours exécutés.
+    *
+    * Le contrôleur est réveillé, puis les tours sont exécutés comme dans la méthode MVCSystem::run, mais sans entrées utilisateurs
+    * (AbstractController::flushInput), sans notification des vues et sans affichage, le plus vite possible.
+    *
+    * Cette méthode sert à tester la simulation en charge ou à la mesurer, sans fenêtre.
+    *
+    * @warning
+    * Les vues n'étant pas notifiées, elles ne reflètent plus le modèle après l'appel de cette méthode.
+    */
+    unsigned int runHeadless(unsigned int ticksCount = 0);
+    /**
     * @brief Retourne les valeurs stockées dans le contrôleur de ce système.
     * @return La liste de valeurs.
     */
@@ -122,12 +156,35 @@ public:
     const AbstractModel* getModel() const {return mp_model;} //!< Accesseur.
     const AbstractView* getView() const {return mp_view;} //!< Accesseur.
     const AbstractController* getController() const {return mp_controller;} //!< Accesseur.
+    unsigned int getTickDuration() const {return m_tickDuration;} //!< Accesseur.
+    void setTickDuration(unsigned int tickDuration) {m_tickDuration = MAX(tickDuration, 1);} //!< Accesseur.
+    unsigned int getFrameDuration() const {return m_frameDuration;} //!< Accesseur.
+    void setFrameDuration(unsigned int frameDuration) {m_frameDuration = frameDuration;} //!< Accesseur.
 
 protected:
     AbstractModel* mp_model; //!< Le modèle de ce système.
     AbstractView* mp_view; //!< La vue de ce système.
     AbstractController* mp_controller; //!< Le contrôleur de ce système.
     bool m_selfDestructible; //!< Indique si les composants de ce système sont détruits par le destructeur.
+
+private:
+    /**
+    * @brief Exécute un tour de mise à jour du modèle.
+    * @param input <code>true</code> si les entrées utilisateurs peuvent être traitées.
+    * @param notify <code>true</code> si les vues doivent être notifiées.
+    * @return <code>false</code> si le tour s'est arrêté après le traitement des entrées, le contrôleur n'étant plus à l'état AbstractController::ALIVE.
+    *
+    * Voir la méthode MVCSystem::run pour le détail d'un tour.
+    *
+    * Chaque étape du tour est mesurée par le profileur (fichier "profiler.h" de la bibliothèque PfMisc),
+    * de même que l'affichage, suivi d'un appel à Profiler::endFrame.
+    */
+    bool tick(bool input, bool notify);
+
+    unsigned int m_tickDuration; //!< La durée d'un tour de mise à jour du modèle en ms, jamais nulle (MVC_TICK_DURATION par défaut).
+    unsigned int m_frameDuration; //!< La durée minimale entre deux affichages en ms, 0 pour aucune limite (FPS_RATE par défaut).
+    unsigned int m_lastTickTime; //!< Le temps, selon <em>SDL_GetTicks</em>, pris en compte lors du dernier tour.
+    unsigned int m_lastDisplayTime; //!< Le temps, selon <em>SDL_GetTicks</em>, du dernier affichage.
 };
 
 #endif // MVCSYSTEM_H_INCLUDED
@@ -37,6 +37,7 @@
 * Un Viewable peut posséder des liens vers d'autres Viewable.
 * Ces autres Viewable ne sont normalement pas ajoutés directement à la vue, et ce afin de créer des groupes de Viewable qui naissent et disparaissent en même temps.
 * Le nom des Viewables liés n'a pas d'importance.
+* Un Viewable lié invisible n'est pas affiché par la vue, il peut servir à conserver des données utilisées pour construire les autres Viewable liés.
 *
 * Si un Viewable possède plusieurs images sur le même plan, mieux vaut utiliser la liste d'images, car plus rapide à rendre.
 * Pour avoir un Viewable constitué de plusieurs images sur des plans de perspective différents, alors le lien vers d'autre Viewable doit être utilisé.
@@ -157,6 +158,18 @@ public:
     */
     void addViewable(Viewable* p_viewable);
     /**
+    * @brief Remplace le Viewable lié à l'indice spécifié.
+    * @param index L'indice du Viewable à remplacer.
+    * @param p_viewable Le nouveau Viewable.
+    * @throw ArgumentException si l'indice n'est pas valide ou si le Viewable est nul.
+    *
+    * L'ancien Viewable est détruit. L'ordre des Viewable liés est conservé.
+    *
+    * @warning
+    * Le Viewable lié sera détruit par le destructeur de ce Viewable.
+    */
+    void replaceViewable(unsigned int index, Viewable* p_viewable);
+    /**
     * @brief Retourne le nombre de GLImage de ce Viewable.
     * @return Le nombre d'images.
     */
@@ -169,6 +182,15 @@ public:
     */
     const GLImage& imageAt(unsigned int index) const;
     /**
+    * @brief Retourne la GLImage à l'indice spécifié, pour la modifier sur place.
+    * @param index L'indice de l'image à retourner.
+    * @return L'image à l'indice spécifié.
+    * @throw ArgumentException si l'indice n'est pas valide.
+    *
+    * Utilisée par les redéfinitions de ModelItem::updateViewable afin d'éviter de regénérer un Viewable.
+    */
+    GLImage& imageAt(unsigned int index);
+    /**
     * @brief Retourne le nombre de Viewable liés à celui-ci.
     * @return Le nombre de Viewable liés.
     */
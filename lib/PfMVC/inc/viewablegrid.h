@@ -0,0 +1,156 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe ViewableGrid.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef VIEWABLEGRID_H_INCLUDED
+#define VIEWABLEGRID_H_INCLUDED
+
+#include "mvc_gen.h"
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "geometry.h"
+#include "noncopyable.h"
+
+class Viewable;
+
+/**
+* @brief Grille uniforme répartissant des Viewable dans des cases selon leurs rectangles englobants.
+*
+* Cette grille permet à une vue de ne parcourir que les Viewable susceptibles d'être visibles dans une zone donnée,
+* au lieu de tester chaque Viewable à chaque affichage.
+*
+* Chaque Viewable référencé est ajouté à toutes les cases de la grille recouvertes par son rectangle englobant.
+* Les Viewable sans rectangle englobant (images statiques par exemple) sont ajoutés à une liste à part et sont retournés par toutes les recherches.
+*
+* Les éléments sont conservés triés dans l'ordre d'affichage (ViewableGrid::Entry::operator<), aussi bien dans chaque case que dans
+* la liste complète ViewableGrid::m_entries_set : cet ordre n'est mis à jour qu'à l'ajout ou au retrait d'un élément,
+* et les recherches retournent des listes déjà triées.
+*
+* Les Viewable sont regroupés par Viewable principal (ViewableGrid::Entry::q_parent), et c'est par Viewable principal qu'ils sont retirés de la grille.
+*
+* La grille n'est pas bornée : les cases sont créées à la demande.
+* Un Viewable recouvrant plus de VIEWABLE_GRID_MAX_CELLS cases est traité comme un Viewable sans rectangle englobant.
+*
+* @warning
+* La grille ne possède pas les Viewable qu'elle référence. Ils doivent en être retirés avant d'être détruits.
+*/
+class ViewableGrid : private NonCopyable
+{
+public:
+    /**
+    * @brief Elément référencé par une ViewableGrid.
+    *
+    * Les éléments sont ordonnés selon leur ordre d'affichage : le plan 0 d'abord, puis les autres plans par ordre croissant,
+    * puis, au sein d'un même plan, par nom de Viewable principal (un nom plus grand étant affiché devant à plan égal),
+    * par indice de texture au sein d'un même Viewable principal (pour limiter les changements de texture), et enfin par ViewableGrid::Entry::childIndex.
+    */
+    struct Entry
+    {
+        const Viewable* q_viewable; //!< Le Viewable référencé.
+        const Viewable* q_parent; //!< Le Viewable principal auquel celui-ci est lié, ou le Viewable lui-même.
+        const string* q_name; //!< Le nom du Viewable principal dans la vue, qui détermine l'ordre d'affichage.
+        unsigned int childIndex; //!< 0 pour le Viewable principal, l'indice du Viewable lié + 1 sinon.
+        int layer; //!< Le plan de perspective du Viewable au moment de son ajout.
+        unsigned int texture; //!< L'indice de texture de la première image du Viewable au moment de son ajout, 0 si aucune.
+
+        bool operator<(const Entry& rc_entry) const; //!< Opérateur de comparaison selon l'ordre d'affichage.
+        bool operator==(const Entry& rc_entry) const; //!< Opérateur d'égalité.
+    };
+
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur ViewableGrid.
+    * @param cellSize La taille d'une case de la grille.
+    */
+    explicit ViewableGrid(float cellSize = VIEWABLE_GRID_CELL_SIZE);
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Ajoute un élément à la grille.
+    * @param rc_entry L'élément à ajouter.
+    * @param bounds Le rectangle englobant du Viewable, considéré droit.
+    *
+    * Si ce rectangle recouvre plus de VIEWABLE_GRID_MAX_CELLS cases, l'élément est ajouté comme élément sans rectangle englobant.
+    */
+    void add(const Entry& rc_entry, const PfRectangle& bounds);
+    /**
+    * @brief Ajoute un élément sans rectangle englobant à la grille.
+    * @param rc_entry L'élément à ajouter.
+    *
+    * Cet élément sera retourné par toutes les recherches.
+    */
+    void addUnbounded(const Entry& rc_entry);
+    /**
+    * @brief Retire de la grille tous les éléments d'un Viewable principal.
+    * @param q_parent Le Viewable principal.
+    */
+    void remove(const Viewable* q_parent);
+    /**
+    * @brief Retire tous les éléments de la grille.
+    */
+    void clear();
+    /**
+    * @brief Retourne les éléments dont le rectangle englobant recouvre une case de la grille en commun avec un rectangle.
+    * @param rect Le rectangle de recherche, considéré droit.
+    * @param r_entries_v La liste à remplir, triée selon l'ordre des éléments et sans doublon.
+    *
+    * Les listes triées des cases concernées sont fusionnées, sans nouveau tri.
+    *
+    * Les éléments sans rectangle englobant sont toujours retournés.
+    *
+    * La liste passée en paramètre est vidée avant d'être remplie.
+    */
+    void find(const PfRectangle& rect, vector<Entry>& r_entries_v) const;
+    /**
+    * @brief Retourne tous les éléments de la grille.
+    * @param r_entries_v La liste à remplir, triée selon l'ordre des éléments et sans doublon.
+    *
+    * La liste passée en paramètre est vidée avant d'être remplie.
+    */
+    void findAll(vector<Entry>& r_entries_v) const;
+
+private:
+    /**
+    * @brief Prédicat identifiant les éléments d'un Viewable principal.
+    */
+    struct ParentPredicate
+    {
+        explicit ParentPredicate(const Viewable* q_parent); //!< Constructeur ParentPredicate.
+        bool operator()(const Entry& rc_entry) const; //!< Retourne <code>true</code> si l'élément appartient au Viewable principal.
+
+        const Viewable* mq_parent; //!< Le Viewable principal recherché.
+    };
+
+    /**
+    * @brief Insère un élément dans une liste triée en conservant l'ordre.
+    * @param r_entries_v La liste triée.
+    * @param rc_entry L'élément à insérer.
+    */
+    static void insertSorted(vector<Entry>& r_entries_v, const Entry& rc_entry);
+    /**
+    * @brief Retourne la coordonnée de case correspondant à une coordonnée.
+    * @param coord La coordonnée, en abscisse ou en ordonnée.
+    * @return La coordonnée de case.
+    */
+    int cellCoord(float coord) const;
+
+    float m_cellSize; //!< La taille d'une case de la grille.
+    map<pair<int, int>, vector<Entry> > m_cells_v_map; //!< Les éléments triés de chaque case, par coordonnées de case.
+    vector<Entry> m_unbounded_v; //!< Les éléments sans rectangle englobant, triés.
+    set<Entry> m_entries_set; //!< Tous les éléments de la grille, dans l'ordre d'affichage.
+    map<const Viewable*, vector<Entry> > m_parentEntries_v_map; //!< Les éléments de chaque Viewable principal.
+    map<const Viewable*, vector<pair<int, int> > > m_parentCells_v_map; //!< Les cases occupées par les éléments de chaque Viewable principal.
+};
+
+#endif // VIEWABLEGRID_H_INCLUDED
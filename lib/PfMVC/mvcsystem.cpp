@@ -1,12 +1,15 @@
 #include "mvcsystem.h"
 
 #include <cassert>
+#include <SDL.h>
 #include "abstractmodel.h"
 #include "abstractview.h"
 #include "abstractcontroller.h"
+#include "profiler.h"
 
 MVCSystem::MVCSystem(AbstractModel* p_model, AbstractView* p_view, AbstractController* p_controller, bool selfDestructible) :
-	mp_model(p_model), mp_view(p_view), mp_controller(p_controller), m_selfDestructible(selfDestructible)
+	mp_model(p_model), mp_view(p_view), mp_controller(p_controller), m_selfDestructible(selfDestructible), m_tickDuration(MVC_TICK_DURATION),
+	m_frameDuration(FPS_RATE), m_lastTickTime(0), m_lastDisplayTime(0)
 {
 	if (mp_model != 0 && mp_view != 0) // pas d'assertion ici, car le constructeur mère standard des classes dérivées est appelé sans argument.
 		mp_model->addView(*mp_view);
@@ -28,26 +31,89 @@ bool MVCSystem::run(bool once)
 {
 	assert(mp_model && mp_view && mp_controller);
 
+	unsigned int time, accumulator;
+	bool updated;
+
 	mp_controller->wakeUp();
-	while (mp_controller->getStatus() == AbstractController::ALIVE)
+	if (once)
 	{
-		if (mp_controller->isAvailable() && !once)
-			mp_controller->pollInput();
-		else
-			mp_controller->flushInput();
 		if (mp_controller->getStatus() == AbstractController::ALIVE)
 		{
-			mp_controller->update();
-			mp_model->notifyAll();
-			mp_model->updateItems();
-			mp_view->display();
-		}
-		if (once)
+			time = SDL_GetTicks() - m_lastTickTime;
+			if (time < m_tickDuration)
+				SDL_Delay(m_tickDuration - time);
+			m_lastTickTime = m_lastDisplayTime = SDL_GetTicks();
+			if (tick(false, true))
+			{
+				PROFILE_SCOPE("display");
+				mp_view->display();
+			}
+			#ifdef PROFILING
+			Profiler::endFrame();
+			#endif
 			mp_controller->setStatus(AbstractController::ASLEEP);
+		}
+
+		return (mp_controller->getStatus() != AbstractController::DEAD);
+	}
+
+	// le premier tour est exécuté immédiatement, le temps passé hors de cette boucle n'est pas rattrapé
+	accumulator = m_tickDuration;
+	m_lastTickTime = SDL_GetTicks();
+	while (mp_controller->getStatus() == AbstractController::ALIVE)
+	{
+		time = SDL_GetTicks();
+		accumulator += time - m_lastTickTime;
+		m_lastTickTime = time;
+		if (accumulator > MVC_MAX_TICKS_PER_FRAME*m_tickDuration)
+			accumulator = MVC_MAX_TICKS_PER_FRAME*m_tickDuration;
+
+		updated = false;
+		while (accumulator >= m_tickDuration && mp_controller->getStatus() == AbstractController::ALIVE)
+		{
+			updated = tick(true, true);
+			accumulator -= m_tickDuration;
+		}
+
+		// la dernière image est affichée même si le contrôleur vient de quitter l'état ALIVE
+		if (updated && (m_frameDuration == 0 || time - m_lastDisplayTime >= m_frameDuration
+						|| mp_controller->getStatus() != AbstractController::ALIVE))
+		{
+			{
+				PROFILE_SCOPE("display");
+				mp_view->display();
+			}
+			#ifdef PROFILING
+			Profiler::endFrame();
+			#endif
+			// la date de référence avance d'une image, pour ne pas sauter d'image à cause des imprécisions de SDL_Delay
+			if (m_frameDuration != 0 && time - m_lastDisplayTime < 2*m_frameDuration)
+				m_lastDisplayTime += m_frameDuration;
+			else
+				m_lastDisplayTime = time;
+		}
+		else if (mp_controller->getStatus() == AbstractController::ALIVE)
+			SDL_Delay(m_tickDuration - accumulator);
 	}
 
 	return (mp_controller->getStatus() != AbstractController::DEAD);
 }
+
+unsigned int MVCSystem::runHeadless(unsigned int ticksCount)
+{
+	assert(mp_model && mp_controller);
+
+	unsigned int ticks = 0;
+
+	mp_controller->wakeUp();
+	while (mp_controller->getStatus() == AbstractController::ALIVE && (ticksCount == 0 || ticks < ticksCount))
+	{
+		tick(false, false);
+		ticks++;
+	}
+
+	return ticks;
+}
 
 const DataPackage& MVCSystem::values() const
 {
@@ -55,3 +121,32 @@ const DataPackage& MVCSystem::values() const
 
 	return mp_controller->getValues();
 }
+
+bool MVCSystem::tick(bool input, bool notify)
+{
+	if (input && mp_controller->isAvailable())
+	{
+		PROFILE_SCOPE("pollInput");
+		mp_controller->pollInput();
+	}
+	else
+		mp_controller->flushInput();
+	if (mp_controller->getStatus() != AbstractController::ALIVE)
+		return false;
+
+	{
+		PROFILE_SCOPE("update");
+		mp_controller->update();
+	}
+	if (notify)
+	{
+		PROFILE_SCOPE("notifyAll");
+		mp_model->notifyAll();
+	}
+	{
+		PROFILE_SCOPE("updateItems");
+		mp_model->updateItems();
+	}
+
+	return true;
+}
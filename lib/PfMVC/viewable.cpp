@@ -78,6 +78,17 @@ void Viewable::addViewable(Viewable* p_viewable)
 		mp_viewables_v.push_back(p_viewable);
 }
 
+void Viewable::replaceViewable(unsigned int index, Viewable* p_viewable)
+{
+	if (index >= mp_viewables_v.size())
+		throw ArgumentException(__LINE__, __FILE__, string("Indice non valide, l'indice doit être compris entre 0 et ") + itostr(mp_viewables_v.size()) + ".", "index", "Viewable::replaceViewable");
+	if (p_viewable == 0)
+		throw ArgumentException(__LINE__, __FILE__, "Le Viewable de remplacement est nul.", "p_viewable", "Viewable::replaceViewable");
+
+	delete mp_viewables_v[index];
+	mp_viewables_v[index] = p_viewable;
+}
+
 unsigned int Viewable::imagesCount() const
 {
 	return mp_glImages_v.size();
@@ -90,6 +101,13 @@ const GLImage& Viewable::imageAt(unsigned int index) const
 	return *(mp_glImages_v[index]);
 }
 
+GLImage& Viewable::imageAt(unsigned int index)
+{
+	if (index >= mp_glImages_v.size())
+		throw ArgumentException(__LINE__, __FILE__, string("Indice non valide, l'indice doit être compris entre 0 et ") + itostr(mp_glImages_v.size()) + ".", "index", "Viewable::imageAt");
+	return *(mp_glImages_v[index]);
+}
+
 unsigned int Viewable::viewablesCount() const
 {
 	return mp_viewables_v.size();
@@ -0,0 +1,142 @@
+#include "viewablegrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+bool ViewableGrid::Entry::operator<(const Entry& rc_entry) const
+{
+	if ((layer == 0) != (rc_entry.layer == 0)) // le plan 0 est affiché en premier
+		return (layer == 0);
+	if (layer != rc_entry.layer)
+		return layer < rc_entry.layer;
+	if (q_name != rc_entry.q_name)
+		return *q_name < *(rc_entry.q_name);
+	if (texture != rc_entry.texture) // seulement entre Viewable liés à un même Viewable principal
+		return texture < rc_entry.texture;
+	return childIndex < rc_entry.childIndex;
+}
+
+bool ViewableGrid::Entry::operator==(const Entry& rc_entry) const
+{
+	return (q_name == rc_entry.q_name && childIndex == rc_entry.childIndex);
+}
+
+ViewableGrid::ParentPredicate::ParentPredicate(const Viewable* q_parent) : mq_parent(q_parent) {}
+
+bool ViewableGrid::ParentPredicate::operator()(const Entry& rc_entry) const
+{
+	return (rc_entry.q_parent == mq_parent);
+}
+
+ViewableGrid::ViewableGrid(float cellSize) : m_cellSize(cellSize) {}
+
+void ViewableGrid::add(const Entry& rc_entry, const PfRectangle& bounds)
+{
+	int minX = cellCoord(bounds.getX()), maxX = cellCoord(bounds.getX() + bounds.getW());
+	int minY = cellCoord(bounds.getY()), maxY = cellCoord(bounds.getY() + bounds.getH());
+	if ((maxX-minX+1)*(maxY-minY+1) > VIEWABLE_GRID_MAX_CELLS)
+	{
+		addUnbounded(rc_entry);
+		return;
+	}
+
+	m_entries_set.insert(rc_entry);
+	m_parentEntries_v_map[rc_entry.q_parent].push_back(rc_entry);
+	vector<pair<int, int> >& r_cells_v = m_parentCells_v_map[rc_entry.q_parent];
+
+	for (int i=minX;i<=maxX;i++)
+	{
+		for (int j=minY;j<=maxY;j++)
+		{
+			pair<int, int> coord(i, j);
+			insertSorted(m_cells_v_map[coord], rc_entry);
+			r_cells_v.push_back(coord);
+		}
+	}
+}
+
+void ViewableGrid::addUnbounded(const Entry& rc_entry)
+{
+	m_entries_set.insert(rc_entry);
+	m_parentEntries_v_map[rc_entry.q_parent].push_back(rc_entry);
+	insertSorted(m_unbounded_v, rc_entry);
+}
+
+void ViewableGrid::remove(const Viewable* q_parent)
+{
+	map<const Viewable*, vector<pair<int, int> > >::iterator it = m_parentCells_v_map.find(q_parent);
+	if (it != m_parentCells_v_map.end())
+	{
+		sort(it->second.begin(), it->second.end());
+		it->second.erase(unique(it->second.begin(), it->second.end()), it->second.end());
+		for (unsigned int i=0, size=it->second.size();i<size;i++)
+		{
+			map<pair<int, int>, vector<Entry> >::iterator cellIt = m_cells_v_map.find(it->second[i]);
+			if (cellIt == m_cells_v_map.end())
+				continue;
+			vector<Entry>& r_entries_v = cellIt->second;
+			r_entries_v.erase(remove_if(r_entries_v.begin(), r_entries_v.end(), ParentPredicate(q_parent)), r_entries_v.end());
+			if (r_entries_v.empty())
+				m_cells_v_map.erase(cellIt);
+		}
+		m_parentCells_v_map.erase(it);
+	}
+
+	m_unbounded_v.erase(remove_if(m_unbounded_v.begin(), m_unbounded_v.end(), ParentPredicate(q_parent)), m_unbounded_v.end());
+
+	map<const Viewable*, vector<Entry> >::iterator entIt = m_parentEntries_v_map.find(q_parent);
+	if (entIt != m_parentEntries_v_map.end())
+	{
+		for (unsigned int i=0, size=entIt->second.size();i<size;i++)
+			m_entries_set.erase(entIt->second[i]);
+		m_parentEntries_v_map.erase(entIt);
+	}
+}
+
+void ViewableGrid::clear()
+{
+	m_cells_v_map.clear();
+	m_unbounded_v.clear();
+	m_parentCells_v_map.clear();
+	m_parentEntries_v_map.clear();
+	m_entries_set.clear();
+}
+
+void ViewableGrid::find(const PfRectangle& rect, vector<Entry>& r_entries_v) const
+{
+	r_entries_v = m_unbounded_v;
+
+	int minX = cellCoord(rect.getX()), maxX = cellCoord(rect.getX() + rect.getW());
+	int minY = cellCoord(rect.getY()), maxY = cellCoord(rect.getY() + rect.getH());
+	map<pair<int, int>, vector<Entry> >::const_iterator it;
+	for (int i=minX;i<=maxX;i++)
+	{
+		for (int j=minY;j<=maxY;j++)
+		{
+			it = m_cells_v_map.find(pair<int, int>(i, j));
+			if (it != m_cells_v_map.end()) // les listes des cases étant triées, elles sont simplement fusionnées
+			{
+				unsigned int middle = r_entries_v.size();
+				r_entries_v.insert(r_entries_v.end(), it->second.begin(), it->second.end());
+				inplace_merge(r_entries_v.begin(), r_entries_v.begin() + middle, r_entries_v.end());
+			}
+		}
+	}
+
+	r_entries_v.erase(unique(r_entries_v.begin(), r_entries_v.end()), r_entries_v.end());
+}
+
+void ViewableGrid::findAll(vector<Entry>& r_entries_v) const
+{
+	r_entries_v.assign(m_entries_set.begin(), m_entries_set.end());
+}
+
+void ViewableGrid::insertSorted(vector<Entry>& r_entries_v, const Entry& rc_entry)
+{
+	r_entries_v.insert(upper_bound(r_entries_v.begin(), r_entries_v.end(), rc_entry), rc_entry);
+}
+
+int ViewableGrid::cellCoord(float coord) const
+{
+	return (int) floor(coord/m_cellSize);
+}
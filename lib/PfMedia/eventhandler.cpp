@@ -1,7 +1,7 @@
 #include "eventhandler.h"
 
 EventHandler::EventHandler() : m_leftMouse(EVENT_RELEASED), m_rightMouse(EVENT_RELEASED), m_mouseRelX(0), m_mouseRelY(0), m_quitting(false),
-    m_caret(false), m_umlaut(false), m_tilde(false) {}
+    m_caret(false), m_umlaut(false), m_tilde(false), mq_session(0) {}
 
 void EventHandler::pollEvents()
 {
@@ -28,8 +28,29 @@ void EventHandler::pollEvents()
 		m_rightMouse = EVENT_RELEASED;
 	m_inputText_v.clear();
 
+	// Rejeu
+
+	if (mq_session != 0 && mq_session->getMode() == InputSession::INPUT_REPLAY)
+	{
+		// la fentre reste ractive, mais seule sa fermeture est prise en compte
+		SDL_PumpEvents();
+		if (SDL_HasEvent(SDL_QUIT))
+			m_quitting = true;
+		SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
+
+		if (!readTick())
+		{
+			LOG("Fin du rejeu des entres.\n");
+			mq_session->stop();
+			m_quitting = true;
+		}
+		return;
+	}
+
 	// Traitement des vnements SDL
 
+	PfPoint previousCoord = m_mouseCoord;
+	bool wasQuitting = m_quitting;
 	unsigned char c;
 	SDL_Event event;
 	while (SDL_PollEvent(&event))
@@ -70,6 +91,9 @@ void EventHandler::pollEvents()
 				break;
 		}
 	}
+
+	if (mq_session != 0 && mq_session->getMode() == InputSession::INPUT_RECORD)
+		writeTick(previousCoord, wasQuitting);
 }
 
 void EventHandler::reset()
@@ -150,6 +174,115 @@ bool EventHandler::isRightMouseButtonReleased(bool justNow) const
 	return false; // pour le compilateur
 }
 
+void EventHandler::writeTick(const PfPoint& rc_previousCoord, bool wasQuitting)
+{
+	vector<pair<int, unsigned char> > keys_v;
+	for (map<SDL_Keycode, EventHandlerCode>::const_iterator it=m_keys_map.begin();it!=m_keys_map.end();++it)
+	{
+		// l'initialisation de EventHandler::pollEvents ne laissant que des tats stables, les autres touches n'ont pas chang
+		if (it->second == EVENT_JUST_PRESSED || it->second == EVENT_JUST_RELEASED)
+			keys_v.push_back(pair<int, unsigned char>((int) it->first, (unsigned char) it->second));
+	}
+	bool motion = (m_mouseRelX != 0 || m_mouseRelY != 0
+				   || m_mouseCoord.getX() != rc_previousCoord.getX() || m_mouseCoord.getY() != rc_previousCoord.getY());
+
+	unsigned char flags = 0;
+	if (!keys_v.empty())
+		flags |= INPUT_FLAG_KEYS;
+	if (m_leftMouse == EVENT_JUST_PRESSED || m_leftMouse == EVENT_JUST_RELEASED
+		|| m_rightMouse == EVENT_JUST_PRESSED || m_rightMouse == EVENT_JUST_RELEASED)
+		flags |= INPUT_FLAG_MOUSE;
+	if (motion)
+		flags |= INPUT_FLAG_MOTION;
+	if (!m_inputText_v.empty())
+		flags |= INPUT_FLAG_TEXT;
+	if (m_quitting && !wasQuitting)
+		flags |= INPUT_FLAG_QUIT;
+
+	mq_session->write(&flags, sizeof(unsigned char));
+	if (flags & INPUT_FLAG_KEYS)
+	{
+		unsigned short count = keys_v.size();
+		mq_session->write(&count, sizeof(unsigned short));
+		for (unsigned int i=0;i<count;i++)
+		{
+			mq_session->write(&(keys_v[i].first), sizeof(int));
+			mq_session->write(&(keys_v[i].second), sizeof(unsigned char));
+		}
+	}
+	if (flags & INPUT_FLAG_MOUSE)
+	{
+		unsigned char buttons[2] = {(unsigned char) m_leftMouse, (unsigned char) m_rightMouse};
+		mq_session->write(buttons, 2*sizeof(unsigned char));
+	}
+	if (flags & INPUT_FLAG_MOTION)
+	{
+		float coord[2] = {m_mouseCoord.getX(), m_mouseCoord.getY()};
+		int rel[2] = {m_mouseRelX, m_mouseRelY};
+		mq_session->write(coord, 2*sizeof(float));
+		mq_session->write(rel, 2*sizeof(int));
+	}
+	if (flags & INPUT_FLAG_TEXT)
+	{
+		unsigned short size = m_inputText_v.size();
+		mq_session->write(&size, sizeof(unsigned short));
+		mq_session->write(&(m_inputText_v[0]), size);
+	}
+}
+
+bool EventHandler::readTick()
+{
+	unsigned char flags;
+	if (!mq_session->read(&flags, sizeof(unsigned char)))
+		return false;
+
+	if (flags & INPUT_FLAG_KEYS)
+	{
+		unsigned short count;
+		int key;
+		unsigned char code;
+		if (!mq_session->read(&count, sizeof(unsigned short)))
+			return false;
+		for (unsigned int i=0;i<count;i++)
+		{
+			if (!mq_session->read(&key, sizeof(int)) || !mq_session->read(&code, sizeof(unsigned char)) || code > EVENT_JUST_RELEASED)
+				return false;
+			m_keys_map[(SDL_Keycode) key] = (EventHandlerCode) code;
+		}
+	}
+	if (flags & INPUT_FLAG_MOUSE)
+	{
+		unsigned char buttons[2];
+		if (!mq_session->read(buttons, 2*sizeof(unsigned char)) || buttons[0] > EVENT_JUST_RELEASED || buttons[1] > EVENT_JUST_RELEASED)
+			return false;
+		m_leftMouse = (EventHandlerCode) buttons[0];
+		m_rightMouse = (EventHandlerCode) buttons[1];
+	}
+	if (flags & INPUT_FLAG_MOTION)
+	{
+		float coord[2];
+		int rel[2];
+		if (!mq_session->read(coord, 2*sizeof(float)) || !mq_session->read(rel, 2*sizeof(int)))
+			return false;
+		m_mouseCoord = PfPoint(coord[0], coord[1]);
+		m_mouseRelX = rel[0];
+		m_mouseRelY = rel[1];
+	}
+	if (flags & INPUT_FLAG_TEXT)
+	{
+		unsigned short size;
+		if (!mq_session->read(&size, sizeof(unsigned short)))
+			return false;
+		m_inputText_v.resize(size);
+		if (size > 0 && !mq_session->read(&(m_inputText_v[0]), size))
+			return false;
+	}
+	if (flags & INPUT_FLAG_QUIT)
+		m_quitting = true;
+
+	return true;
+}
+
 unsigned char EventHandler::handleTextKey(SDL_Scancode code)
 {
     SDL_Keycode kCode = SDL_GetKeyFromScancode(code);
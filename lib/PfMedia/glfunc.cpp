@@ -2,12 +2,26 @@
 
 #include <map>
 #include "errors.h"
+#include "binaryreader.h"
 #include "pngtoglloader.h"
+#include "pngdecodingpool.h"
+#include "textureatlas.h"
 #include "glimage.h"
 
 SDL_Window* gp_mainScreen = 0;
 SDL_Renderer* gp_renderer = 0;
 map<unsigned int, unsigned int> g_texturesNames_map;
+map<unsigned int, pair<unsigned int, PfRectangle> > g_atlasRegions_map; // indice de texture regroupée -> indice de page et région
+unsigned int g_nextAtlasIndex = ATLAS_TEXTURE_INDEX;
+unsigned int g_boundTextureIndex = 0; // indice de la dernière texture liée au contexte, 0 si inconnue
+GLDrawStats g_glStats = {0, 0, 0};
+bool g_glRecordOnly = false;
+
+// indique si une texture a déjà été ajoutée, directement ou dans un atlas
+static bool isTextureLoaded(unsigned int textureIndex)
+{
+	return (g_texturesNames_map.find(textureIndex) != g_texturesNames_map.end() || g_atlasRegions_map.find(textureIndex) != g_atlasRegions_map.end());
+}
 
 void initGL()
 {
@@ -72,6 +86,9 @@ void swapSDLBuffers()
 
 void translateCamera(float x, float y)
 {
+	if (g_glRecordOnly)
+		return;
+
 	glMatrixMode(GL_MODELVIEW);
 	glLoadIdentity();
 	glTranslatef(-x, -y*Y_X_RATIO, 0.0);
@@ -81,11 +98,12 @@ void addTexture(const string& fileName, unsigned int textureIndex)
 {
 	try
 	{
-		if (g_texturesNames_map.find(textureIndex) == g_texturesNames_map.end())
+		if (!isTextureLoaded(textureIndex))
 		{
 			PNGToGLLoader image(fileName);
 			image.addTextureToGL();
 			g_texturesNames_map.insert(pair<unsigned int, unsigned int>(textureIndex, image.getName()));
+			g_boundTextureIndex = 0;
 		}
 	}
 	catch (PfException& e)
@@ -101,11 +119,10 @@ void addTexture(ifstream& r_ifs, unsigned int textureIndex)
 		unsigned int length;
 		r_ifs.read((char*) &length, sizeof(unsigned int));
 
-		if (g_texturesNames_map.find(textureIndex) == g_texturesNames_map.end())
+		if (!isTextureLoaded(textureIndex))
 		{
 			char* dt_t = new char[length]; // détruit par le destructeur de PNGDataBuffer.
-			for (unsigned int i=0;i<length;i++)
-				r_ifs.read(&dt_t[i], sizeof(char));
+			r_ifs.read(dt_t, length);
 			if (r_ifs.fail())
 			{
 				r_ifs.close();
@@ -116,6 +133,7 @@ void addTexture(ifstream& r_ifs, unsigned int textureIndex)
 			PNGToGLLoader image(dataBuffer);
 			image.addTextureToGL();
 			g_texturesNames_map.insert(pair<unsigned int, unsigned int>(textureIndex, image.getName()));
+			g_boundTextureIndex = 0;
 		}
 		else
 			r_ifs.seekg(length, ios::cur);
@@ -126,13 +144,163 @@ void addTexture(ifstream& r_ifs, unsigned int textureIndex)
 	}
 }
 
+void addTexture(PNGToGLLoader& r_image, unsigned int textureIndex)
+{
+	if (isTextureLoaded(textureIndex))
+		return;
+
+	r_image.addTextureToGL();
+	g_texturesNames_map.insert(pair<unsigned int, unsigned int>(textureIndex, r_image.getName()));
+	g_boundTextureIndex = 0;
+}
+
+void addTexture(ifstream& r_ifs, unsigned int textureIndex, TextureAtlas& r_atlas)
+{
+	unsigned int length;
+	r_ifs.read((char*) &length, sizeof(unsigned int));
+
+	if (isTextureLoaded(textureIndex))
+	{
+		r_ifs.seekg(length, ios::cur);
+		return;
+	}
+
+	char* dt_t = new char[length]; // détruit par le destructeur de PNGDataBuffer
+	r_ifs.read(dt_t, length);
+	if (r_ifs.fail())
+	{
+		delete [] dt_t;
+		throw PfException(__LINE__, __FILE__, "Impossible de lire le fichier PNG, peut-être est-il corrompu.");
+	}
+	PNGDataBuffer dataBuffer(dt_t, length);
+	PNGToGLLoader* p_image;
+	try
+	{
+		p_image = new PNGToGLLoader(dataBuffer);
+	}
+	catch (PfException& e)
+	{
+		throw PfException(__LINE__, __FILE__, "Impossible de charger le fichier PNG depuis le flux passé en paramètre.", e);
+	}
+	if (!r_atlas.addImage(textureIndex, p_image)) // image trop grande pour l'atlas
+	{
+		addTexture(*p_image, textureIndex);
+		delete p_image;
+	}
+}
+
+unsigned int addAtlas(TextureAtlas& r_atlas)
+{
+	r_atlas.pack();
+
+	unsigned int count = r_atlas.pagesCount(), first = g_nextAtlasIndex;
+	for (unsigned int i=0;i<count;i++)
+	{
+		if (!g_glRecordOnly)
+		{
+			GLuint texName;
+			glGenTextures(1, &texName);
+			glBindTexture(GL_TEXTURE_2D, texName);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+			glTexImage2D(GL_TEXTURE_2D, 0, 4, r_atlas.getSize(), r_atlas.pageHeight(i), 0, GL_RGBA, GL_UNSIGNED_BYTE, r_atlas.pageTexels(i));
+			g_texturesNames_map.insert(pair<unsigned int, unsigned int>(first + i, texName));
+		}
+		g_nextAtlasIndex++;
+	}
+	g_boundTextureIndex = 0;
+
+	const map<unsigned int, pair<unsigned int, PfRectangle> >& rc_regions_map = r_atlas.getRegions();
+	for (map<unsigned int, pair<unsigned int, PfRectangle> >::const_iterator it=rc_regions_map.begin();it!=rc_regions_map.end();++it)
+	{
+		if (!isTextureLoaded(it->first))
+			g_atlasRegions_map.insert(pair<unsigned int, pair<unsigned int, PfRectangle> >(it->first, pair<unsigned int, PfRectangle>(first + it->second.first, it->second.second)));
+	}
+	r_atlas.releaseTexels();
+
+	return count;
+}
+
+bool atlasRegion(unsigned int textureIndex, unsigned int& r_atlasIndex, PfRectangle& r_rect)
+{
+	if (g_atlasRegions_map.empty())
+		return false;
+
+	map<unsigned int, pair<unsigned int, PfRectangle> >::const_iterator it = g_atlasRegions_map.find(textureIndex);
+	if (it == g_atlasRegions_map.end())
+		return false;
+
+	r_atlasIndex = it->second.first;
+	r_rect = it->second.second;
+
+	return true;
+}
+
+bool queueTexture(BinaryReader& r_reader, unsigned int textureIndex, PNGDecodingPool& r_pool)
+{
+	unsigned int length;
+	r_reader.read((char*) &length, sizeof(unsigned int));
+
+	if (isTextureLoaded(textureIndex))
+	{
+		r_reader.skip(length);
+		return false;
+	}
+
+	char* dt_t = new char[length]; // détruit par le PNGDecodingPool
+	r_reader.read(dt_t, length);
+	if (r_reader.fail())
+	{
+		delete [] dt_t;
+		throw PfException(__LINE__, __FILE__, "Impossible de lire le fichier PNG, peut-être est-il corrompu.");
+	}
+	r_pool.addImage(textureIndex, dt_t, length);
+
+	return true;
+}
+
+unsigned int uploadDecodedTextures(PNGDecodingPool& r_pool, bool wait, TextureAtlas* p_atlas)
+{
+	unsigned int count = 0, textureIndex;
+	PNGToGLLoader* p_image;
+
+	try
+	{
+		// attente éventuelle de la première image seulement, les suivantes sont ajoutées si elles sont déjà prêtes
+		while (r_pool.nextImage(textureIndex, p_image, wait && count == 0))
+		{
+			if (p_atlas == 0 || !p_atlas->addImage(textureIndex, p_image))
+			{
+				addTexture(*p_image, textureIndex);
+				delete p_image;
+			}
+			count++;
+		}
+	}
+	catch (PfException& e)
+	{
+		throw PfException(__LINE__, __FILE__, "Impossible de charger les images décodées.", e);
+	}
+
+	return count;
+}
+
 void bindTexture(unsigned int textureIndex)
 {
-	map<unsigned int, unsigned int>::iterator it = g_texturesNames_map.find(textureIndex);
-	if (it != g_texturesNames_map.end())
-		glBindTexture(GL_TEXTURE_2D, it->second);
-	else
-		throw ArgumentException(__LINE__, __FILE__, "L'indice de texture ne correspond à aucune texture chargée.", "textureIndex", "bindTexture");
+	if (textureIndex == g_boundTextureIndex)
+		return;
+
+	if (!g_glRecordOnly)
+	{
+		map<unsigned int, unsigned int>::iterator it = g_texturesNames_map.find(textureIndex);
+		if (it != g_texturesNames_map.end())
+			glBindTexture(GL_TEXTURE_2D, it->second);
+		else
+			throw ArgumentException(__LINE__, __FILE__, "L'indice de texture ne correspond à aucune texture chargée.", "textureIndex", "bindTexture");
+	}
+
+	g_boundTextureIndex = textureIndex;
+	g_glStats.textureBinds++;
 }
 
 void drawGL(const GLImage& rc_glImage)
@@ -140,6 +308,15 @@ void drawGL(const GLImage& rc_glImage)
 	if (!rc_glImage.isValid())
 		return;
 
+	g_glStats.drawCalls++;
+	g_glStats.vertices += rc_glImage.getVerticesCount();
+	if (g_glRecordOnly)
+	{
+		if (rc_glImage.isTextured())
+			bindTexture(rc_glImage.getTextureIndex());
+		return;
+	}
+
 	if (rc_glImage.isStatic())
 	{
 		glMatrixMode(GL_MODELVIEW);
@@ -147,10 +324,6 @@ void drawGL(const GLImage& rc_glImage)
 		glLoadIdentity();
 	}
 
-	GLubyte indices_t[MAX_VERTICES_PER_POLYGON];
-	for (GLubyte i=0;i<MAX_VERTICES_PER_POLYGON;i++)
-		indices_t[i] = i;
-
 	if (rc_glImage.getAngle() > 1.0 || rc_glImage.getAngle() < -1.0)
 	{
 		glMatrixMode(GL_MODELVIEW);
@@ -164,13 +337,13 @@ void drawGL(const GLImage& rc_glImage)
 	{
 		bindTexture(rc_glImage.getTextureIndex());
 		glInterleavedArrays(GL_T2F_C3F_V3F, 0, rc_glImage.getData());
-		glDrawElements(rc_glImage.getMode(), rc_glImage.getVerticesCount(), GL_UNSIGNED_BYTE, indices_t);
+		glDrawArrays(rc_glImage.getMode(), 0, rc_glImage.getVerticesCount());
 	}
 	else
 	{
 		glDisable(GL_TEXTURE_2D);
 		glInterleavedArrays(GL_C3F_V3F, 0, rc_glImage.getData());
-		glDrawElements(rc_glImage.getMode(), rc_glImage.getVerticesCount(), GL_UNSIGNED_BYTE, indices_t);
+		glDrawArrays(rc_glImage.getMode(), 0, rc_glImage.getVerticesCount());
 		glEnable(GL_TEXTURE_2D);
 	}
 
@@ -210,6 +383,15 @@ void freeTextures()
 	for(map<unsigned int, unsigned int>::iterator it=g_texturesNames_map.begin();it!=g_texturesNames_map.end();++it)
 		glDeleteTextures(1, (GLuint*) &(it->second));
 	g_texturesNames_map.clear();
+	g_atlasRegions_map.clear();
+	g_boundTextureIndex = 0;
+}
+
+void resetGLStats()
+{
+	g_glStats.drawCalls = 0;
+	g_glStats.textureBinds = 0;
+	g_glStats.vertices = 0;
 }
 
 PfPoint glCoordFromSDLPoint(int x, int y, bool coordRelativeToBorders)
@@ -3,6 +3,83 @@
 #include <string>
 #include "errors.h"
 #include "misc.h"
+#include "slaballocator.h"
+#include "glfunc.h"
+
+#ifndef NDEBUG
+unsigned int g_dbGLImageAllocations = 0;
+#endif
+
+// Les allocateurs ne sont jamais détruits : des GLImage globales peuvent être détruites après eux en fin de programme.
+
+// allocateur des GLImage elles-mêmes
+static SlabAllocator& imageAllocator()
+{
+	static SlabAllocator* s_p_allocator = new SlabAllocator(sizeof(GLImage));
+	return *s_p_allocator;
+}
+
+// allocateur des tableaux de données d'images de verticesCount points (au plus MAX_VERTICES_PER_POLYGON), texturées ou non
+static SlabAllocator& dataAllocator(int verticesCount)
+{
+	static SlabAllocator* s_p_allocators_t[MAX_VERTICES_PER_POLYGON] = {0};
+	SlabAllocator*& rp_allocator = s_p_allocators_t[verticesCount-1];
+	if (rp_allocator == 0)
+		rp_allocator = new SlabAllocator(8*verticesCount*sizeof(GLfloat));
+	return *rp_allocator;
+}
+
+// alloue un tableau de données d'image, en le comptabilisant en debug
+static GLfloat* newData(int verticesCount, int dataCount)
+{
+	if (verticesCount <= 0)
+		return 0;
+	#ifndef NDEBUG
+	g_dbGLImageAllocations++;
+	#endif
+	if (verticesCount > MAX_VERTICES_PER_POLYGON) // images regroupées, de taille quelconque
+		return new GLfloat[dataCount];
+	return (GLfloat*) dataAllocator(verticesCount).allocate();
+}
+
+// libère un tableau alloué par newData pour le même nombre de points
+static void deleteData(GLfloat* p_data, int verticesCount)
+{
+	if (p_data == 0)
+		return;
+	if (verticesCount > MAX_VERTICES_PER_POLYGON)
+		delete [] p_data;
+	else
+		dataAllocator(verticesCount).deallocate(p_data);
+}
+
+// reporte sur sa page d'atlas une image texturée dont la texture a été regroupée (fonction addAtlas du fichier "glfunc.h")
+static void remapToAtlas(unsigned int& r_textureIndex, GLfloat* p_data, int verticesCount)
+{
+	unsigned int atlasIndex;
+	PfRectangle region;
+	if (p_data == 0 || !atlasRegion(r_textureIndex, atlasIndex, region))
+		return;
+
+	r_textureIndex = atlasIndex;
+	for (int i=0;i<verticesCount;i++) // une texture regroupée ne peut pas être répétée
+	{
+		p_data[i*8] = region.getX() + MIN(MAX(p_data[i*8], 0.0), 1.0)*region.getW();
+		p_data[i*8+1] = region.getY() + MIN(MAX(p_data[i*8+1], 0.0), 1.0)*region.getH();
+	}
+}
+
+// abscisse OpenGL d'un point, éventuellement relative aux bordures de la vue
+static inline GLfloat glX(float x, bool coordRelativeToBorder)
+{
+	return coordRelativeToBorder?x*(1-2*SYSTEM_BORDER_WIDTH) + SYSTEM_BORDER_WIDTH:x;
+}
+
+// ordonnée OpenGL d'un point
+static inline GLfloat glY(float y)
+{
+	return y * (float) g_windowHeight / g_windowWidth;
+}
 
 GLImage::GLImage() : m_mode(GL_POINTS), m_verticesCount(0), m_textureIndex(0), m_data_t(0), m_valid(false), m_static(false),
     m_angle(0.0), m_centerX(0.0), m_centerY(0.0) {}
@@ -16,7 +93,7 @@ GLImage::GLImage(const GLImage& glImage) :
 	else
 	{
 		int dataCount = (m_textureIndex!=0)?8*m_verticesCount:6*m_verticesCount;
-		m_data_t = new GLfloat[dataCount];
+		m_data_t = newData(m_verticesCount, dataCount);
 		for (int i=0;i<dataCount;i++)
 			m_data_t[i] = glImage.m_data_t[i];
 	}
@@ -33,98 +110,156 @@ GLImage::GLImage(const GLfloat* data_t_c, int verticesCount, unsigned int textur
 	else
 	{
 		int dataCount = (m_textureIndex!=0)?8*m_verticesCount:6*m_verticesCount;
-		m_data_t = new GLfloat[dataCount];
+		m_data_t = newData(m_verticesCount, dataCount);
 		for (int i=0;i<dataCount;i++)
 			m_data_t[i] = data_t_c[i];
+		if (m_textureIndex != 0)
+			remapToAtlas(m_textureIndex, m_data_t, m_verticesCount);
 	}
 }
 
 GLImage::GLImage(const PfPolygon& polygon, const PfColor& color, GLenum mode, bool coordRelativeToBorder, bool stat) :
 	m_mode(mode), m_verticesCount(polygon.count()), m_textureIndex(0), m_valid(polygon.count() > 0), m_static(!coordRelativeToBorder || stat), m_angle(0.0), m_centerX(0.0), m_centerY(0.0)
 {
-	m_data_t = new GLfloat[6*m_verticesCount];
+	m_data_t = newData(m_verticesCount, 6*m_verticesCount);
 
 	try
 	{
-		int n = 0;
-		float minX = MAX_NUMBER, minY = MAX_NUMBER, maxX = -MAX_NUMBER, maxY = -MAX_NUMBER;
-		for (int i=0;i<m_verticesCount;i++)
-		{
-			m_data_t[n++] = color.getR();
-			m_data_t[n++] = color.getG();
-			m_data_t[n++] = color.getB();
-
-			m_data_t[n++] = coordRelativeToBorder?polygon.pointAt(i).getX()*(1-2*SYSTEM_BORDER_WIDTH) + SYSTEM_BORDER_WIDTH:polygon.pointAt(i).getX();
-			if (m_data_t[n-1] > maxX)
-				maxX = m_data_t[n-1];
-			if (m_data_t[n-1] < minX)
-				minX = m_data_t[n-1];
-			m_data_t[n++] = polygon.pointAt(i).getY() * (float) g_windowHeight / g_windowWidth;
-			if (m_data_t[n-1] > maxY)
-				maxY = m_data_t[n-1];
-			if (m_data_t[n-1] < minY)
-				minY = m_data_t[n-1];
-			m_data_t[n++] = 0.0;
-		}
-
-		// Calcul du centre par centre de la bounding box.
-		m_centerX = (minX + maxX) / 2;
-		m_centerY = (minY + maxY) / 2;
+		fillData(polygon, polygon, color, coordRelativeToBorder);
 	}
 	catch (PfException& e)
 	{
+		deleteData(m_data_t, m_verticesCount);
 		throw ConstructorException(__LINE__, __FILE__, "Erreur lors de la lecture des points du polygone lors de la création de la GLImage.", "GLImage", e);
 	}
 }
-
+
 GLImage::GLImage(const PfPolygon& polygon, unsigned int textureIndex, const PfPolygon& coordPolygon, const PfColor& color, bool coordRelativeToBorder, bool stat) :
 	m_mode(GL_TRIANGLE_FAN), m_verticesCount(polygon.count()), m_textureIndex(textureIndex), m_valid(polygon.count() > 0), m_static(!coordRelativeToBorder || stat), m_angle(0.0),
 	m_centerX(0.0), m_centerY(0.0)
 {
-	m_data_t = new GLfloat[(textureIndex == 0)?6*m_verticesCount:8*m_verticesCount];
+	m_data_t = newData(m_verticesCount, (textureIndex == 0)?6*m_verticesCount:8*m_verticesCount);
 
 	try
 	{
-		int n = 0;
-		float minX = MAX_NUMBER, minY = MAX_NUMBER, maxX = -MAX_NUMBER, maxY = -MAX_NUMBER;
-		for (int i=0;i<m_verticesCount;i++)
+		fillData(polygon, coordPolygon, color, coordRelativeToBorder);
+	}
+	catch (PfException& e)
+	{
+		deleteData(m_data_t, m_verticesCount);
+		throw ConstructorException(__LINE__, __FILE__, "Erreur lors de la lecture des points des polygones lors de la création de la GLImage.", "GLImage", e);
+	}
+	if (m_textureIndex != 0)
+		remapToAtlas(m_textureIndex, m_data_t, m_verticesCount);
+}
+
+GLImage::GLImage(const vector<const GLImage*>& q_glImages_v) :
+	m_mode(GL_TRIANGLES), m_verticesCount(0), m_textureIndex(0), m_data_t(0), m_valid(false), m_static(false), m_angle(0.0), m_centerX(0.0), m_centerY(0.0)
+{
+	const GLImage* q_img;
+	for (unsigned int i=0, size=q_glImages_v.size();i<size;i++)
+	{
+		q_img = q_glImages_v[i];
+		if (q_img == 0 || !q_img->isBatchable())
+			throw ConstructorException(__LINE__, __FILE__, string("L'image ") + itostr(i) + " ne peut pas être regroupée.", "GLImage");
+		if (i == 0)
+			m_textureIndex = q_img->m_textureIndex;
+		else if (q_img->m_textureIndex != m_textureIndex)
+			throw ConstructorException(__LINE__, __FILE__, string("L'image ") + itostr(i) + " n'a pas la même texture que les précédentes.", "GLImage");
+		m_verticesCount += (q_img->m_mode == GL_TRIANGLES)?q_img->m_verticesCount:3*(q_img->m_verticesCount-2);
+	}
+
+	if (m_verticesCount == 0)
+		return;
+
+	m_data_t = newData(m_verticesCount, 8*m_verticesCount);
+	m_valid = true;
+
+	int n = 0;
+	float minX = MAX_NUMBER, minY = MAX_NUMBER, maxX = -MAX_NUMBER, maxY = -MAX_NUMBER;
+	for (unsigned int i=0, size=q_glImages_v.size();i<size;i++)
+	{
+		q_img = q_glImages_v[i];
+		for (int j=0, count=q_img->m_verticesCount;j<count;j++)
+		{
+			float x = q_img->m_data_t[j*8+5], y = q_img->m_data_t[j*8+6];
+			minX = MIN(minX, x);
+			maxX = MAX(maxX, x);
+			minY = MIN(minY, y);
+			maxY = MAX(maxY, y);
+		}
+		if (q_img->m_mode == GL_TRIANGLES)
+		{
+			for (int k=0, dataCount=8*q_img->m_verticesCount;k<dataCount;k++)
+				m_data_t[n++] = q_img->m_data_t[k];
+		}
+		else
+		{
+			for (int j=1, count=q_img->m_verticesCount-1;j<count;j++) // découpage en éventail : (0, j, j+1)
+			{
+				for (int k=0;k<8;k++)
+					m_data_t[n++] = q_img->m_data_t[k];
+				for (int k=0;k<16;k++)
+					m_data_t[n++] = q_img->m_data_t[j*8+k];
+			}
+		}
+	}
+
+	// Calcul du centre par centre de la bounding box.
+	m_centerX = (minX + maxX) / 2;
+	m_centerY = (minY + maxY) / 2;
+}
+
+GLImage::GLImage(const vector<PfRectangle>& rects_v, unsigned int textureIndex, const vector<PfRectangle>& coordRects_v, unsigned int rectsCount,
+				 const PfColor& color, bool coordRelativeToBorder, bool stat) :
+	m_mode(GL_TRIANGLES), m_verticesCount(6*rectsCount), m_textureIndex(textureIndex), m_data_t(0), m_valid(rectsCount > 0), m_static(!coordRelativeToBorder || stat),
+	m_angle(0.0), m_centerX(0.0), m_centerY(0.0)
+{
+	if (rects_v.size() < rectsCount || (textureIndex != 0 && coordRects_v.size() < rectsCount))
+		throw ConstructorException(__LINE__, __FILE__, string("Moins de ") + itostr(rectsCount) + " rectangles dans les listes.", "GLImage");
+	if (rectsCount == 0)
+		return;
+
+	m_data_t = newData(m_verticesCount, (textureIndex == 0)?6*m_verticesCount:8*m_verticesCount);
+
+	// triangles (bas gauche, bas droit, haut droit) et (bas gauche, haut droit, haut gauche) de chaque rectangle
+	static const int s_cornersX_t[6] = {0, 1, 1, 0, 1, 0}, s_cornersY_t[6] = {0, 0, 1, 0, 1, 1};
+	int n = 0;
+	float minX = MAX_NUMBER, minY = MAX_NUMBER, maxX = -MAX_NUMBER, maxY = -MAX_NUMBER;
+	for (unsigned int i=0;i<rectsCount;i++)
+	{
+		const PfRectangle& rc_rect = rects_v[i];
+		for (int k=0;k<6;k++)
 		{
-			if (textureIndex != 0)
+			if (m_textureIndex != 0)
 			{
-				m_data_t[n++] = coordPolygon.pointAt(i).getX();
-				m_data_t[n++] = coordPolygon.pointAt(i).getY();
+				m_data_t[n++] = coordRects_v[i].getX() + s_cornersX_t[k]*coordRects_v[i].getW();
+				m_data_t[n++] = coordRects_v[i].getY() + s_cornersY_t[k]*coordRects_v[i].getH();
 			}
 			m_data_t[n++] = color.getR();
 			m_data_t[n++] = color.getG();
 			m_data_t[n++] = color.getB();
-
-			m_data_t[n++] = coordRelativeToBorder?polygon.pointAt(i).getX()*(1-2*SYSTEM_BORDER_WIDTH) + SYSTEM_BORDER_WIDTH:polygon.pointAt(i).getX();
-			if (m_data_t[n-1] > maxX)
-				maxX = m_data_t[n-1];
-			if (m_data_t[n-1] < minX)
-				minX = m_data_t[n-1];
-			m_data_t[n++] = polygon.pointAt(i).getY() * (float) g_windowHeight / g_windowWidth;
-			if (m_data_t[n-1] > maxY)
-				maxY = m_data_t[n-1];
-			if (m_data_t[n-1] < minY)
-				minY = m_data_t[n-1];
+			m_data_t[n++] = glX(rc_rect.getX() + s_cornersX_t[k]*rc_rect.getW(), coordRelativeToBorder);
+			minX = MIN(minX, m_data_t[n-1]);
+			maxX = MAX(maxX, m_data_t[n-1]);
+			m_data_t[n++] = glY(rc_rect.getY() + s_cornersY_t[k]*rc_rect.getH());
+			minY = MIN(minY, m_data_t[n-1]);
+			maxY = MAX(maxY, m_data_t[n-1]);
 			m_data_t[n++] = 0.0;
 		}
-
-		// Calcul du centre par centre de la bounding box.
-		m_centerX = (minX + maxX) / 2;
-		m_centerY = (minY + maxY) / 2;
-	}
-	catch (PfException& e)
-	{
-		throw ConstructorException(__LINE__, __FILE__, "Erreur lors de la lecture des points des polygones lors de la création de la GLImage.", "GLImage", e);
 	}
+
+	// Calcul du centre par centre de la bounding box.
+	m_centerX = (minX + maxX) / 2;
+	m_centerY = (minY + maxY) / 2;
+
+	if (m_textureIndex != 0)
+		remapToAtlas(m_textureIndex, m_data_t, m_verticesCount);
 }
 
 GLImage::~GLImage()
 {
-	if (m_data_t != 0)
-		delete [] m_data_t;
+	deleteData(m_data_t, m_verticesCount);
 }
 
 bool GLImage::isTextured() const
@@ -132,6 +267,14 @@ bool GLImage::isTextured() const
 	return m_textureIndex != 0;
 }
 
+bool GLImage::isBatchable() const
+{
+	if (!m_valid || m_textureIndex == 0 || m_static || m_angle > 1.0 || m_angle < -1.0)
+		return false;
+
+	return (m_mode == GL_TRIANGLES || ((m_mode == GL_TRIANGLE_FAN || m_mode == GL_POLYGON) && m_verticesCount >= 3));
+}
+
 vector<PfPoint> GLImage::points() const
 {
 	vector<PfPoint> x_v;
@@ -147,10 +290,100 @@ vector<PfPoint> GLImage::points() const
 	return x_v;
 }
 
+PfRectangle GLImage::boundingBox() const
+{
+	if (m_verticesCount == 0 || m_data_t == 0)
+		return PfRectangle();
+
+	int stride = (m_textureIndex != 0)?8:6;
+	int offset = stride - 3;
+	float minX = m_data_t[offset], maxX = minX, minY = m_data_t[offset+1], maxY = minY;
+	for (int i=1;i<m_verticesCount;i++)
+	{
+		minX = MIN(minX, m_data_t[i*stride+offset]);
+		maxX = MAX(maxX, m_data_t[i*stride+offset]);
+		minY = MIN(minY, m_data_t[i*stride+offset+1]);
+		maxY = MAX(maxY, m_data_t[i*stride+offset+1]);
+	}
+
+	return PfRectangle(minX, minY, maxX-minX, maxY-minY);
+}
+
+bool GLImage::updateData(const PfPolygon& polygon, unsigned int textureIndex, const PfPolygon& coordPolygon, const PfColor& color, bool coordRelativeToBorder, bool stat)
+{
+	if (m_data_t == 0 || m_mode != GL_TRIANGLE_FAN || m_verticesCount != polygon.count() || (m_textureIndex == 0) != (textureIndex == 0))
+		return false;
+
+	m_textureIndex = textureIndex;
+	m_static = (!coordRelativeToBorder || stat);
+	try
+	{
+		fillData(polygon, coordPolygon, color, coordRelativeToBorder);
+	}
+	catch (PfException& e)
+	{
+		throw PfException(__LINE__, __FILE__, "Impossible de mettre à jour les données de la GLImage.", e);
+	}
+	if (m_textureIndex != 0)
+		remapToAtlas(m_textureIndex, m_data_t, m_verticesCount);
+
+	return true;
+}
+
+void GLImage::fillData(const PfPolygon& polygon, const PfPolygon& coordPolygon, const PfColor& color, bool coordRelativeToBorder)
+{
+	int n = 0;
+	float minX = MAX_NUMBER, minY = MAX_NUMBER, maxX = -MAX_NUMBER, maxY = -MAX_NUMBER;
+	for (int i=0;i<m_verticesCount;i++)
+	{
+		if (m_textureIndex != 0)
+		{
+			m_data_t[n++] = coordPolygon.pointAt(i).getX();
+			m_data_t[n++] = coordPolygon.pointAt(i).getY();
+		}
+		m_data_t[n++] = color.getR();
+		m_data_t[n++] = color.getG();
+		m_data_t[n++] = color.getB();
+
+		m_data_t[n++] = glX(polygon.pointAt(i).getX(), coordRelativeToBorder);
+		if (m_data_t[n-1] > maxX)
+			maxX = m_data_t[n-1];
+		if (m_data_t[n-1] < minX)
+			minX = m_data_t[n-1];
+		m_data_t[n++] = glY(polygon.pointAt(i).getY());
+		if (m_data_t[n-1] > maxY)
+			maxY = m_data_t[n-1];
+		if (m_data_t[n-1] < minY)
+			minY = m_data_t[n-1];
+		m_data_t[n++] = 0.0;
+	}
+
+	// Calcul du centre par centre de la bounding box.
+	m_centerX = (minX + maxX) / 2;
+	m_centerY = (minY + maxY) / 2;
+}
+
+void* GLImage::operator new(size_t size)
+{
+	if (size != sizeof(GLImage))
+		return ::operator new(size);
+	return imageAllocator().allocate();
+}
+
+void GLImage::operator delete(void* p_image, size_t size)
+{
+	if (size != sizeof(GLImage))
+		::operator delete(p_image);
+	else
+		imageAllocator().deallocate(p_image);
+}
+
 GLImage& GLImage::operator=(const GLImage& glImage)
 {
     if (&glImage != this)
     {
+        deleteData(m_data_t, m_verticesCount);
+
         m_mode = glImage.m_mode;
         m_verticesCount = glImage.m_verticesCount;
         m_textureIndex = glImage.m_textureIndex;
@@ -160,14 +393,12 @@ GLImage& GLImage::operator=(const GLImage& glImage)
         m_centerX = glImage.m_centerX;
         m_centerY = glImage.m_centerY;
 
-        if (m_data_t != 0)
-            delete [] m_data_t;
         if (glImage.m_data_t == 0)
             m_data_t = 0;
         else
         {
             int dataCount = (m_textureIndex!=0)?8*m_verticesCount:6*m_verticesCount;
-            m_data_t = new GLfloat[dataCount];
+            m_data_t = newData(m_verticesCount, dataCount);
             for (int i=0;i<dataCount;i++)
                 m_data_t[i] = glImage.m_data_t[i];
         }
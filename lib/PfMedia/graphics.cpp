@@ -3,86 +3,78 @@
 #include <vector>
 #include <math.h>
 #include <cstdlib>
+#include <cstring>
 #include "errors.h"
+#include "noisegenerator.h"
 
-vector<vector<int> > g_noise2D_v2;
+NoiseGenerator g_noise2D;
 
 float** generate2DTexture(unsigned int r, unsigned int c, TextureGenerationMode mode, float v1, float v2, float v3)
 {
-	if (r == 0 || c == 0)
-		throw ArgumentException(__LINE__, __FILE__, "Coordonnée nulle.", "r/c", "generate2DTexture");
-
-	if (mode == GRAPHICS_NOISE)
-		init2DNoise(r/v2+2, c/v2+2, (int) (ABS(v3)+FLOAT_MARGIN), MAX(1, (int) (ABS(v1)+FLOAT_MARGIN)));
+	vector<float> texture_v;
+	fill2DTexture(texture_v, r, c, mode, v1, v2, v3);
 
 	float** rtn_t2 = new float*[r];
 	for (unsigned int i=0;i<r;i++)
 	{
 		rtn_t2[i] = new float[c];
-		for (unsigned int j=0;j<c;j++)
-		{
-			switch (mode)
-			{
-				case GRAPHICS_FLAT:
-					rtn_t2[i][j] = v1;
-					break;
-				case GRAPHICS_LINEAR:
-					rtn_t2[i][j] = v1 - v2*ABS((int) i - (int) r/2);
-					rtn_t2[i][j] += v1 - v2*ABS((int) j - (int) c/2);
-					rtn_t2[i][j] /= 2;
-					break;
-				case GRAPHICS_DOME:
-					rtn_t2[i][j] = v1 - v2 * ((int)i-(int)r/2)*((int)i-(int)r/2);
-					rtn_t2[i][j] += v1 - v2 * ((int)j-(int)c/2)*((int)j-(int)c/2);
-					rtn_t2[i][j] /= 2;
-					break;
-				case GRAPHICS_RANDOM:
-					rtn_t2[i][j] = (float) rand()/RAND_MAX * v1 + 1;
-					break;
-				case GRAPHICS_NOISE:
-					rtn_t2[i][j] = pfNoiseFct(i, j, (unsigned int) (ABS(v2)+FLOAT_MARGIN));
-					break;
-			}
-		}
+		memcpy(rtn_t2[i], &(texture_v[i*c]), c*sizeof(float));
 	}
 
 	return rtn_t2;
 }
 
-float pfNoiseFct(float x, float y, unsigned int step)
+void fill2DTexture(vector<float>& r_texture_v, unsigned int r, unsigned int c, TextureGenerationMode mode, float v1, float v2, float v3)
 {
-	if (step == 0)
-		throw ArgumentException(__LINE__, __FILE__, "Pas nul pour le bruit.", "step", "pfNoise");
-
-	float ax = ABS(x) + FLOAT_MARGIN;
-	float ay = ABS(y) + FLOAT_MARGIN;
-
-	int i = (int) (ax / step);
-	int j = (int) (ay / step);
+	if (r == 0 || c == 0)
+		throw ArgumentException(__LINE__, __FILE__, "Coordonnée nulle.", "r/c", "fill2DTexture");
 
-	float** nVal = new float*[4];
-	for (int k=0;k<4;k++)
-		nVal[k] = new float[4];
+	r_texture_v.resize(r*c);
+	float* p_t = &(r_texture_v[0]);
 
-	int size = g_noise2D_v2.size();
-	for (int k=0;k<4;k++)
+	if (mode == GRAPHICS_NOISE)
 	{
-		for (int l=0;l<4;l++)
-			nVal[k][l] = g_noise2D_v2[MIN(size-1, MAX(0, i+k-1))][MIN(size-1, MAX(0, j+l-1))];
+		unsigned int step = (unsigned int) (ABS(v2)+FLOAT_MARGIN);
+		if (step == 0)
+			throw ArgumentException(__LINE__, __FILE__, "Pas nul pour le bruit.", "v2", "fill2DTexture");
+		NoiseGenerator noise((unsigned int) (ABS(v3)+FLOAT_MARGIN));
+		noise.init(r/step+3, c/step+3, MAX(1, (int) (ABS(v1)+FLOAT_MARGIN)));
+		noise.fillRegion(0, 0, r, c, step, p_t);
+		return;
 	}
 
-	float rtn = cubicInterpolation2D(nVal[0][0], nVal[0][1], nVal[0][2], nVal[0][3],
-									 nVal[1][0], nVal[1][1], nVal[1][2], nVal[1][3],
-									 nVal[2][0], nVal[2][1], nVal[2][2], nVal[2][3],
-									 nVal[3][0], nVal[3][1], nVal[3][2], nVal[3][3],
-									 fmod((ax/step),1), fmod((ay/step),1));
-	//float rtn = linearInterpolation2D(nVal[1][1], nVal[1][2], nVal[2][1], nVal[2][2], fmod((ax/step),1), fmod((ay/step),1));
+	for (unsigned int i=0;i<r;i++, p_t+=c)
+	{
+		switch (mode)
+		{
+			case GRAPHICS_FLAT:
+				for (unsigned int j=0;j<c;j++)
+					p_t[j] = v1;
+				break;
+			case GRAPHICS_LINEAR:
+				for (unsigned int j=0;j<c;j++)
+					p_t[j] = (v1 - v2*ABS((int) i - (int) r/2) + v1 - v2*ABS((int) j - (int) c/2)) / 2;
+				break;
+			case GRAPHICS_DOME:
+				for (unsigned int j=0;j<c;j++)
+					p_t[j] = (v1 - v2 * ((int)i-(int)r/2)*((int)i-(int)r/2) + v1 - v2 * ((int)j-(int)c/2)*((int)j-(int)c/2)) / 2;
+				break;
+			case GRAPHICS_RANDOM:
+				for (unsigned int j=0;j<c;j++)
+					p_t[j] = (float) rand()/RAND_MAX * v1 + 1;
+				break;
+			default:
+				break;
+		}
+	}
+}
 
-	for (int k=0;k<4;k++)
-		delete [] nVal[k];
-	delete [] nVal;
+float pfNoiseFct(float x, float y, unsigned int step)
+{
+	if (step == 0)
+		throw ArgumentException(__LINE__, __FILE__, "Pas nul pour le bruit.", "step", "pfNoise");
 
-	return rtn;
+	return g_noise2D.value(x, y, step);
 }
 
 int pfRand(int seed, int max)
@@ -92,13 +84,8 @@ int pfRand(int seed, int max)
 	if (max <= 0)
 		throw ArgumentException(__LINE__, __FILE__, "Maximum négatif ou nul.", "max", "pfRand");
 
-	//int rtn = seed * 1103515245 + 12345;
-	//rtn = (unsigned int) (rtn / 65536);
-	//return ABS(round((float) rtn/65536 * max));
-
-	srand(seed);
-	rand();
-	return rand() % (max+1);
+	NoiseGenerator generator(seed);
+	return generator.next() % (max+1);
 }
 
 float linearInterpolation(float a, float b, float x)
@@ -144,17 +131,10 @@ void init2DNoise(unsigned int w, unsigned int h, int seed, int max)
 	if (max <= 0)
 		throw ArgumentException(__LINE__, __FILE__, "Maximum négatif ou nul.", "max", "init2DNoise");
 
-	g_noise2D_v2.clear();
-
 	try
 	{
-		srand(seed);
-		for (unsigned int i=0;i<w;i++)
-		{
-			g_noise2D_v2.push_back(vector<int>());
-			for (unsigned int j=0;j<h;j++)
-				g_noise2D_v2[i].push_back(rand()%(max+1));
-		}
+		g_noise2D.reseed(seed);
+		g_noise2D.init(w, h, max);
 	}
 	catch (PfException& e)
 	{
@@ -15,6 +15,13 @@
 #include <map>
 #include <vector>
 #include "geometry.h"
+#include "inputsession.h"
+
+#define INPUT_FLAG_KEYS 0x01 //!< Flag d'un bloc d'enregistrement des entrées contenant des touches.
+#define INPUT_FLAG_MOUSE 0x02 //!< Flag d'un bloc d'enregistrement des entrées contenant l'état des boutons de la souris.
+#define INPUT_FLAG_MOTION 0x04 //!< Flag d'un bloc d'enregistrement des entrées contenant un mouvement de la souris.
+#define INPUT_FLAG_TEXT 0x08 //!< Flag d'un bloc d'enregistrement des entrées contenant du texte entré.
+#define INPUT_FLAG_QUIT 0x10 //!< Flag d'un bloc d'enregistrement des entrées contenant l'événement SDL_QUIT.
 
 /**
 * @brief Classe permettant une gestion groupée de multiples événements SDL.
@@ -38,6 +45,21 @@
 *
 * L'événement SDL_TEXTINPUT n'est pas utilisé par cette classe. A la place, le membre EventHandler::m_inputText_v est mis à jour en fonction
 * des touches entrées et de la méthode EventHandler::handleTextKey.
+*
+* Les entrées peuvent être enregistrées dans un fichier binaire, puis rejouées à l'identique sans source d'événements SDL,
+* au moyen d'une session InputSession (EventHandler::setInputSession).
+* Un enregistrement commence par l'entier PFGAME_VERSION (fichier "misc_gen.h"), suivi d'un bloc par appel à EventHandler::pollEvents.
+* Un bloc commence par un octet de flags indiquant les données qui suivent, dans cet ordre :
+* <ul><li>INPUT_FLAG_KEYS : un <em>unsigned short</em> nombre de touches, puis pour chaque touche son code SDLK (<em>int</em>)
+* et son état EventHandler::EventHandlerCode (<em>unsigned char</em>), seules les touches juste enfoncées ou juste relâchées étant écrites,</li>
+* <li>INPUT_FLAG_MOUSE : les états des boutons gauche et droit de la souris (deux <em>unsigned char</em>),</li>
+* <li>INPUT_FLAG_MOTION : la position du curseur (deux <em>float</em>) et son déplacement (deux <em>int</em>),</li>
+* <li>INPUT_FLAG_TEXT : un <em>unsigned short</em> nombre de caractères, puis les caractères du texte entré,</li>
+* <li>INPUT_FLAG_QUIT : aucune donnée, l'événement SDL_QUIT.</li></ul>
+* Un tour sans entrée n'occupe ainsi qu'un octet.
+*
+* Le contrôleur appelant EventHandler::pollEvents une fois par tour de durée fixe (MVCSystem::tick), un rejeu reproduit
+* exactement une session de jeu, ce qui permet de comparer des mesures de performance d'une version à l'autre.
 */
 class EventHandler
 {
@@ -84,6 +106,12 @@ public:
     *
     * Dans le cas d'une touche du clavier enfoncée (SDL_KEYDOWN), la méthode privée EventHandler::handleTextKey est également appelée pour éventuellement
     * mettre à jour le champ EventHandler::m_inputText_v en ajoutant le retour de cette méthode.
+    *
+    * Si la session EventHandler::mq_session est en mode InputSession::INPUT_RECORD, l'état résultant est ensuite enregistré (EventHandler::writeTick).
+    *
+    * Si elle est en mode InputSession::INPUT_REPLAY, la file d'événements SDL est vidée sans être traitée, hormis l'événement SDL_QUIT,
+    * et l'état est lu depuis l'enregistrement (EventHandler::readTick).
+    * A la fin de l'enregistrement, la session est terminée et EventHandler::m_quitting passe à <code>true</code>, ce qui termine le contrôleur.
     */
     void pollEvents();
     /**
@@ -139,6 +167,7 @@ public:
     int getMouseRelY() const {return m_mouseRelY;} //!< Accesseur.
     bool isQuitting() const {return m_quitting;} //!< Accesseur.
     const vector<unsigned char>& getInputText() const {return m_inputText_v;} //!< Accesseur.
+    void setInputSession(InputSession* q_session) {mq_session = q_session;} //!< Accesseur.
 
 private:
     /**
@@ -148,6 +177,17 @@ private:
     * Les touches sont traitées pour générer un texte ASCII (pour l'instant toujours un seul caractère).
     */
     unsigned char handleTextKey(SDL_Scancode code);
+    /**
+    * @brief Enregistre l'état résultant du dernier appel à EventHandler::pollEvents.
+    * @param rc_previousCoord La position du curseur avant le traitement des événements.
+    * @param wasQuitting La valeur de EventHandler::m_quitting avant le traitement des événements.
+    */
+    void writeTick(const PfPoint& rc_previousCoord, bool wasQuitting);
+    /**
+    * @brief Lit un bloc de l'enregistrement en cours de rejeu et l'applique à l'état de cette instance.
+    * @return <code>false</code> si l'enregistrement est terminé ou tronqué.
+    */
+    bool readTick();
 
     map<SDL_Keycode, EventHandlerCode> m_keys_map; //!< La map des touches SDLK.
     EventHandlerCode m_leftMouse; //!< Indique si le bouton gauche de la souris est enfoncé.
@@ -160,6 +200,7 @@ private:
     bool m_caret; //!< Indique si l'accent circonflexe est en attente.
     bool m_umlaut; //!< Indique si le tréma est en attente.
     bool m_tilde; //!< Indique si le tilde est en attente.
+    InputSession* mq_session; //!< La session d'enregistrement ou de rejeu des entrées, 0 si les entrées ne sont lues que depuis la file d'événements SDL.
 };
 
 #endif // EVENTHANDLER_H_INCLUDED
@@ -19,7 +19,13 @@
 *
 * Pour mieux comprendre le principe de rendu d'une image texturée, se référer à la documentation de la fonction <em>drawGL</em> de ce fichier.
 *
-* @see addTexture, drawGL
+* Des textures peuvent également être regroupées dans les pages d'un TextureAtlas (fichier "textureatlas.h"), ajoutées au contexte par la fonction <em>addAtlas</em>.
+* Chaque page reçoit alors son propre indice de texture, à partir de ATLAS_TEXTURE_INDEX (fichier "media_gen.h"),
+* et une seconde map interne associe à l'indice de chaque texture regroupée l'indice de sa page et la région qu'elle y occupe.
+* Les GLImage sont construites directement sur la page, avec des coordonnées de texture converties (fonction <em>atlasRegion</em>),
+* ce qui reste transparent pour le reste du programme.
+*
+* @see addTexture, addAtlas, drawGL
 */
 
 #ifndef GLFUNC_H_INCLUDED
@@ -33,6 +39,11 @@
 #include <fstream>
 #include "geometry.h"
 
+class PNGToGLLoader;
+class PNGDecodingPool;
+class TextureAtlas;
+class BinaryReader;
+
 class GLImage;
 
 /**
@@ -43,6 +54,32 @@ extern SDL_Window* gp_mainScreen;
 * @brief Pointeur vers le moteur de rendu SDL.
 */
 extern SDL_Renderer* gp_renderer;
+
+/**
+* @brief Compteurs de rendu OpenGL.
+*
+* Ces compteurs sont incrémentés par les fonctions <em>bindTexture</em> et <em>drawGL</em>, et remis à zéro par la fonction <em>resetGLStats</em>.
+*/
+struct GLDrawStats
+{
+    unsigned int drawCalls; //!< Le nombre d'appels de rendu.
+    unsigned int textureBinds; //!< Le nombre de changements de texture.
+    unsigned int vertices; //!< Le nombre de sommets envoyés.
+};
+/**
+* @brief Les compteurs de rendu actuels.
+*/
+extern GLDrawStats g_glStats;
+/**
+* @brief Indique si les fonctions de rendu se contentent d'enregistrer les appels sans les transmettre à OpenGL.
+*
+* Ce mode permet de mesurer le nombre d'appels de rendu (GLDrawStats) sans contexte OpenGL, par exemple hors affichage.
+* Dans ce mode, la fonction <em>bindTexture</em> ne vérifie pas que la texture a été chargée, et la fonction <em>translateCamera</em>
+* n'appelle pas OpenGL.
+*
+* Ce mode est à activer pour utiliser un RecordingRenderBackend (fichier "renderbackend.h") sans contexte OpenGL.
+*/
+extern bool g_glRecordOnly;
 
 /**
 * @brief Initialise le contexte OpenGL.
@@ -126,12 +163,93 @@ void addTexture(const string& fileName, unsigned int textureIndex);
 */
 void addTexture(ifstream& r_ifs, unsigned int textureIndex);
 /**
+* @brief Génère une texture OpenGL à partir d'une image PNG déjà décodée.
+* @param r_image L'image décodée.
+* @param textureIndex L'indice de la texture à ajouter.
+*
+* L'indice de texture est géré comme pour les fonctions <em>addTexture</em> précédentes.
+*
+* @warning
+* Si l'indice de texture passé en paramètre est déjà utilisé, alors rien n'est fait.
+*/
+void addTexture(PNGToGLLoader& r_image, unsigned int textureIndex);
+/**
+* @brief Lit une image PNG dans un flux et l'ajoute à un TextureAtlas.
+* @param r_ifs Une référence vers le fichier à lire.
+* @param textureIndex L'indice de la texture à ajouter.
+* @param r_atlas L'atlas.
+* @throw PfException si le flux ne présente pas suffisamment d'octets à lire ou si l'image ne peut pas être décodée.
+*
+* Le format lu est celui de la fonction <em>addTexture</em> à partir d'un flux.
+*
+* Si l'image est trop grande pour l'atlas, elle est ajoutée directement au contexte OpenGL.
+* Sinon, elle ne sera utilisable qu'après appel à la fonction <em>addAtlas</em>.
+*
+* @warning
+* Si l'indice de texture passé en paramètre est déjà utilisé, alors rien n'est fait.
+* Le flux en lecture est alors déplacé à la fin de la portion "PNG" qui aurait été lue.
+*/
+void addTexture(ifstream& r_ifs, unsigned int textureIndex, TextureAtlas& r_atlas);
+/**
+* @brief Ajoute au contexte OpenGL les pages d'un TextureAtlas.
+* @param r_atlas L'atlas, dont les images sont rangées si ce n'est pas déjà fait.
+* @return Le nombre de pages ajoutées.
+*
+* Chaque page reçoit un nouvel indice de texture, à partir de ATLAS_TEXTURE_INDEX (fichier "media_gen.h").
+* Les régions de l'atlas sont enregistrées pour la fonction <em>atlasRegion</em>, puis les pixels des pages sont libérés.
+*
+* Si <em>g_glRecordOnly</em> est vrai, les pages ne sont pas transmises à OpenGL, mais les régions sont tout de même enregistrées.
+*
+* @warning
+* Les GLImage construites avant l'appel à cette fonction ne sont pas converties.
+*/
+unsigned int addAtlas(TextureAtlas& r_atlas);
+/**
+* @brief Retourne la page et la région d'une texture regroupée dans un atlas par la fonction <em>addAtlas</em>.
+* @param textureIndex L'indice de la texture.
+* @param r_atlasIndex L'indice de texture de la page, à remplir.
+* @param r_rect Le rectangle de la texture dans la page, en coordonnées de texture de la page, à remplir.
+* @return <code>false</code> si la texture n'est regroupée dans aucun atlas.
+*/
+bool atlasRegion(unsigned int textureIndex, unsigned int& r_atlasIndex, PfRectangle& r_rect);
+/**
+* @brief Lit une image PNG dans un flux et la confie à un PNGDecodingPool pour décodage.
+* @param r_reader Le lecteur du fichier à lire (fichier "binaryreader.h" de la bibliothèque PfMisc).
+* @param textureIndex L'indice de la texture à ajouter, utilisé comme clé de l'image dans le PNGDecodingPool.
+* @param r_pool Le PNGDecodingPool.
+* @return <code>false</code> si l'indice de texture est déjà utilisé, auquel cas l'image n'est pas décodée.
+* @throw PfException si le flux ne présente pas suffisamment d'octets à lire.
+*
+* Le format lu est celui de la fonction <em>addTexture</em> à partir d'un flux. Les octets de l'image sont lus en une seule fois.
+*
+* Les images décodées doivent ensuite être ajoutées au contexte OpenGL par la fonction <em>uploadDecodedTextures</em>.
+*/
+bool queueTexture(BinaryReader& r_reader, unsigned int textureIndex, PNGDecodingPool& r_pool);
+/**
+* @brief Ajoute au contexte OpenGL les images décodées par un PNGDecodingPool.
+* @param r_pool Le PNGDecodingPool.
+* @param wait Indique s'il faut attendre au moins une image lorsque des images sont encore en cours de décodage.
+* @param p_atlas L'atlas auquel confier les images, 0 pour les ajouter directement au contexte OpenGL.
+* @return Le nombre de textures ajoutées, 0 si toutes les images du PNGDecodingPool ont déjà été récupérées.
+* @throw PfException si une image n'a pas pu être décodée.
+*
+* Toutes les images décodées disponibles sont ajoutées, chacune sous l'indice de texture qui lui a été associé par la fonction <em>queueTexture</em>.
+*
+* Si un atlas est passé en paramètre, les images lui sont ajoutées (TextureAtlas::addImage) et ne seront utilisables qu'après appel à la fonction <em>addAtlas</em>.
+* Les images trop grandes pour l'atlas sont ajoutées directement au contexte OpenGL.
+*
+* Cette fonction doit être appelée par le thread propriétaire du contexte OpenGL.
+*/
+unsigned int uploadDecodedTextures(PNGDecodingPool& r_pool, bool wait = true, TextureAtlas* p_atlas = 0);
+/**
 * @brief Lie la texture dont l'indice est passé en paramètre au contexte OpenGL.
 * @param textureIndex L'indice de la texture.
 * @throw ArgumentException si l'indice passé en paramètre ne correspond à aucune texture.
 *
 * C'est cette fonction et elle seule qui utilise la map interne au fichier "glfunc.cpp" pour associer une nouvelle texture OpenGL au contexte
 * à partir de son nom OpenGL, associé à l'indice de texture passé en paramètre.
+*
+* Si la texture est déjà liée au contexte, rien n'est fait.
 */
 void bindTexture(unsigned int textureIndex);
 /**
@@ -147,6 +265,9 @@ void bindTexture(unsigned int textureIndex);
 *
 * Si l'image est texturée, alors la fonction <em>bindTexture</em> est appelée pour charger la texture correspondante dans le contexte.
 *
+* L'image est rendue en un seul appel à <em>glDrawArrays</em>, ce qui permet de rendre d'un coup une image regroupant plusieurs polygones
+* (constructeur GLImage 3).
+*
 * @warning
 * Une exception peut être levée par <em>bindTexture</em> si la texture n'a pas été préalablement chargée (si l'indice de l'image n'est pas associé
 * à un nom OpenGL).
@@ -164,10 +285,14 @@ void drawTransition();
 * @brief Libère la mémoire allouée pour les textures.
 *
 * Cette méthode appelle la fonction <em>glDeleteTextures</em> sur les textures de la map gérée en interne du fichier "glfunc.cpp".
-* La map est alors vidée.
+* La map est alors vidée, ainsi que celle des régions d'atlas.
 */
 void freeTextures();
 /**
+* @brief Remet à zéro les compteurs de rendu <em>g_glStats</em>.
+*/
+void resetGLStats();
+/**
 * @brief Retourne un point de coordonnées comprises entre 0.0 et 1.0 (point OpenGL) depuis un point SDL (coordonnées de souris).
 * @param x L'abscisse en pixels SDL du point.
 * @param y L'ordonnée en pixels SDL du point.
@@ -11,10 +11,24 @@
 
 #include "media_gen.h"
 
+#include <cstddef>
 #include <vector>
 #include <GL/gl.h>
 #include "geometry.h"
 
+#ifndef NDEBUG
+/**
+* @brief Nombre de tableaux de données alloués par des GLImage depuis le lancement du programme.
+*
+* Ce compteur permet de vérifier qu'une frame ne fait aucune allocation lorsque les images sont mises à jour sur place (GLImage::updateData).
+* Les tableaux pris dans un SlabAllocator sont comptés, même s'ils ne nécessitent pas d'allocation sur le tas.
+*
+* @remarks
+* Non déclaré si NDEBUG est définie.
+*/
+extern unsigned int g_dbGLImageAllocations;
+#endif
+
 /**
 * @brief Classe regroupant les données nécessaires à l'affichage d'une image OpenGL.
 *
@@ -25,9 +39,28 @@
 *
 * Le booléen GLImage::m_valid indique si l'image construite possède des données lisibles.
 *
+* Une image peut également regrouper les triangles de plusieurs images texturées partageant la même texture (constructeur GLImage 3),
+* afin d'être rendue en un seul appel OpenGL. Une telle image n'est pas soumise à la limite MAX_VERTICES_PER_POLYGON.
+*
+* Les GLImage allouées dynamiquement, ainsi que les tableaux de données d'au plus MAX_VERTICES_PER_POLYGON points,
+* sont pris dans des SlabAllocator (fichier "slaballocator.h" de la bibliothèque PfMisc), un par nombre de points.
+* La génération d'un Viewable de nombreuses images ne coûte ainsi que quelques allocations sur le tas, les blocs libérés étant réutilisés.
+* Les tableaux plus grands (images regroupées) sont alloués normalement.
+*
+* Si la texture d'une image a été regroupée dans un atlas (fonction <em>addAtlas</em> du fichier "glfunc.h"), l'image est construite
+* ou mise à jour directement sur la page de l'atlas : GLImage::m_textureIndex est alors l'indice de la page, et les coordonnées de texture,
+* ramenées entre 0 et 1, sont converties dans la région de la page correspondante.
+* Des images de textures différentes d'un même atlas peuvent ainsi être regroupées et rendues sans changement de texture.
+*
 * @warning
-* Pas plus de MAX_VERTICES_PER_POLYGON points par image pour s'assurer de la compatibilité avec d'autres fonctions, notamment <em>drawGL</em>
-* du fichier "glfunc.h".
+* Pas plus de MAX_VERTICES_PER_POLYGON points par polygone.
+*
+* Les GLImage ne doivent être créées et détruites que par le thread principal, les SlabAllocator n'étant pas protégés
+* (vérifié par une assertion en mode Debug). Les threads de décodage PNG et de lecture des maps ne manipulent que des données brutes.
+*
+* @remarks
+* Les images ne sont pas prises dans une arène vidée à chaque frame : un Viewable, et ses images, vit jusqu'à la modification
+* de son ModelItem (AbstractView::update), donc au-delà de la frame qui l'a généré.
 */
 class GLImage
 {
@@ -120,6 +153,50 @@ public:
     */
     GLImage(const PfPolygon& polygon, unsigned int textureIndex, const PfPolygon& coordPolygon, const PfColor& color = PfColor::WHITE, bool coordRelativeToBorder = true, bool stat = false);
     /**
+    * @brief Constructeur GLImage 3.
+    * @param q_glImages_v La liste des images à regrouper.
+    * @throw ConstructorException si une image de la liste ne peut être regroupée (GLImage::isBatchable) ou si les textures diffèrent.
+    *
+    * Crée une image texturée en mode GL_TRIANGLES contenant, dans l'ordre de la liste, les triangles de toutes les images passées en paramètre.
+    * Les images en mode GL_TRIANGLE_FAN ou GL_POLYGON sont découpées en éventail à partir de leur premier point.
+    *
+    * Si la liste est vide, l'image ne sera pas valide.
+    *
+    * @warning
+    * De la mémoire est allouée lors de la création de la GLImage.
+    * Le destructeur se charge de ces données.
+    *
+    * Le centre de cette image est calculé comme le centre de sa "bounding box".
+    */
+    explicit GLImage(const vector<const GLImage*>& q_glImages_v);
+    /**
+    * @brief Constructeur GLImage 4.
+    * @param rects_v La liste des rectangles à rendre.
+    * @param textureIndex L'indice de texture, 0 pour une image non texturée.
+    * @param coordRects_v La liste des fragments de texture, un par rectangle, ignorée si l'image n'est pas texturée.
+    * @param rectsCount Le nombre de rectangles à rendre, pris en début de liste.
+    * @param color La couleur de l'image.
+    * @param coordRelativeToBorder <code>true</code> si les coordonnées de cette image sont relatives aux bordures de la vue (SYSTEM_BORDER_WIDTH, fichier "media_gen.h").
+    * @param stat <code>true</code> si cette image est statique.
+    * @throw ConstructorException si l'une des listes compte moins de <em>rectsCount</em> éléments.
+    *
+    * Crée une image en mode GL_TRIANGLES contenant deux triangles par rectangle, afin de rendre en un seul appel OpenGL
+    * une série de rectangles partageant la même texture, par exemple les caractères d'un texte (PfText).
+    * Une telle image n'est pas soumise à la limite MAX_VERTICES_PER_POLYGON.
+    *
+    * Si <em>rectsCount</em> est nul, l'image ne sera pas valide.
+    *
+    * @warning
+    * De la mémoire est allouée lors de la création de la GLImage.
+    * Le destructeur se charge de ces données.
+    *
+    * Le centre de cette image est calculé comme le centre de sa "bounding box".
+    *
+    * Si <em>coordRelativeToBorder</em> est faux, alors l'image sera également statique.
+    */
+    GLImage(const vector<PfRectangle>& rects_v, unsigned int textureIndex, const vector<PfRectangle>& coordRects_v, unsigned int rectsCount,
+            const PfColor& color = PfColor::WHITE, bool coordRelativeToBorder = true, bool stat = false);
+    /**
     * @brief Destructeur GLImage.
     *
     * Détruit le tableau de données.
@@ -135,10 +212,38 @@ public:
     */
     bool isTextured() const;
     /**
+    * @brief Indique si cette image peut être regroupée avec d'autres images de même texture.
+    * @return <code>true</code> si l'image est valide, texturée, non statique, sans rotation, et rendue en triangles.
+    */
+    bool isBatchable() const;
+    /**
     * @brief Retoure une liste de points correspondant au polygone de cette image.
     * @return La liste de points.
     */
     vector<PfPoint> points() const;
+    /**
+    * @brief Retourne le rectangle englobant de cette image.
+    * @return Le rectangle droit englobant tous les points de cette image, de dimensions nulles si l'image n'a pas de point.
+    */
+    PfRectangle boundingBox() const;
+    /**
+    * @brief Remplace les données de cette image sans réallouer son tableau.
+    * @param polygon Le nouveau polygone de l'image.
+    * @param textureIndex Le nouvel indice de texture, 0 pour une image non texturée.
+    * @param coordPolygon Le nouveau polygone du fragment de texture.
+    * @param color La nouvelle couleur de cette image.
+    * @param coordRelativeToBorder <code>true</code> si les coordonnées de cette image sont relatives aux bordures de la vue.
+    * @param stat <code>true</code> pour une image ne dépendant pas de la caméra.
+    * @return <code>false</code> si le tableau de données ne peut être réutilisé, auquel cas l'image n'est pas modifiée.
+    * @throw PfException si une erreur survient lors de la lecture des points des polygones.
+    *
+    * Le résultat est identique à celui du constructeur GLImage 2 avec les mêmes paramètres, l'angle de l'image étant conservé.
+    *
+    * Le tableau est réutilisé si l'image est en mode GL_TRIANGLE_FAN, possède autant de points que le polygone,
+    * et reste texturée ou non texturée.
+    */
+    bool updateData(const PfPolygon& polygon, unsigned int textureIndex, const PfPolygon& coordPolygon, const PfColor& color = PfColor::WHITE,
+                    bool coordRelativeToBorder = true, bool stat = false);
     /*
     * Accesseurs
     * ----------
@@ -170,8 +275,32 @@ public:
     * au nombre de points multiplié par 8 ou 6 selon que l'image est texturée ou non.
     */
     GLImage& operator=(const GLImage& glImage);
+    /**
+    * @brief Opérateur d'allocation, prenant la mémoire dans un SlabAllocator.
+    * @param size La taille à allouer.
+    * @return La mémoire allouée.
+    */
+    static void* operator new(size_t size);
+    /**
+    * @brief Opérateur de libération, rendant la mémoire au SlabAllocator.
+    * @param p_image La mémoire à libérer.
+    * @param size La taille allouée.
+    */
+    static void operator delete(void* p_image, size_t size);
 
 private:
+    /**
+    * @brief Remplit le tableau de données d'après un polygone, au format défini par GLImage::m_textureIndex.
+    * @param polygon Le polygone de l'image.
+    * @param coordPolygon Le polygone du fragment de texture, ignoré si l'image n'est pas texturée.
+    * @param color La couleur de l'image.
+    * @param coordRelativeToBorder <code>true</code> si les coordonnées de cette image sont relatives aux bordures de la vue.
+    * @throw PfException si une erreur survient lors de la lecture des points des polygones.
+    *
+    * Le tableau doit être alloué pour GLImage::m_verticesCount points. Le centre de l'image est recalculé.
+    */
+    void fillData(const PfPolygon& polygon, const PfPolygon& coordPolygon, const PfColor& color, bool coordRelativeToBorder);
+
     GLenum m_mode; //!< Le mode d'affichage de l'image avec OpenGL (GL_TRIANGLES, GL_LINE_LOOP etc...).
     int m_verticesCount; //!< Le nombre de points de cette image.
     unsigned int m_textureIndex; //!< L'indice de texture, 0 pour une image non texturée.
@@ -13,6 +13,8 @@
 
 #include "media_gen.h"
 
+#include <vector>
+
 /**
 * @brief Enumération des modes de génération de tableaux 2D de textures.
 */
@@ -38,16 +40,38 @@ enum TextureGenerationMode {GRAPHICS_FLAT, //!< Texture unie.
 * <li>GRAPHICS_LINEAR : t[i][j] = (v1 - v2*|i-r/2| + v1 - v2*|j-c/2|)/2</li>
 * <li>GRAPHICS_DOME : t[i][j] = (v1 - v2*(i-r/2)² + v1 - v2*(j-c/2)²)/2</li>
 * <li>GRAPHICS_RANDOM : t[i][j] = rand()/RAND_MAX*v1</li>
-* <li>GRAPHICS_NOISE : t[i][j] = pfNoiseFct(i,j,v2)</li></ul>
+* <li>GRAPHICS_NOISE : t[i][j] = bruit cohérent de pas v2, de graine v3, compris entre 0 et v1</li></ul>
 *
-* Dans le cas de GRAPHICS_NOISE, la foncton <em>init2DNoise</em> est auparavant
-* appelée, avec pour arguments (w=r, h=c, seed=v3, max=v1).
+* Le tableau est calculé par la fonction <em>fill2DTexture</em>, puis recopié ligne par ligne.
 *
 * @warning
 * De la mémoire est allouée pour le tableau retourné.
 */
 float** generate2DTexture(unsigned int r, unsigned int c, TextureGenerationMode mode, float v1 = 0, float v2 = 0, float v3 = 0);
 
+/**
+* @brief Remplit un tableau contigu avec une texture 2D, ligne après ligne.
+* @param r_texture_v Le tableau à remplir, redimensionné à <em>r</em> * <em>c</em> valeurs.
+* @param r Le nombre de lignes de la texture.
+* @param c Le nombre de colonnes de la texture.
+* @param mode Le mode de génération de texture.
+* @param v1 Une valeur d'initialisation.
+* @param v2 Une valeur d'initialisation.
+* @param v3 Une valeur d'initialisation.
+* @throw ArgumentException si l'une des coordonnées est nulle, ou si le pas du bruit est nul en mode GRAPHICS_NOISE.
+*
+* La valeur t[i][j] de la fonction <em>generate2DTexture</em> est placée à l'indice i*c+j.
+*
+* Dans le cas de GRAPHICS_NOISE, un NoiseGenerator local, de graine v3, génère une grille de valeurs comprises entre 0 et v1,
+* puis calcule toute la texture d'un seul appel à NoiseGenerator::fillRegion, avec un pas v2.
+* Cette fonction ne modifie alors aucune variable globale : elle peut être appelée depuis plusieurs threads
+* et retourne toujours la même texture pour des paramètres donnés.
+*
+* La capacité du tableau est conservée d'un appel à l'autre, aucune allocation n'est donc faite si le tableau est réutilisé
+* pour une texture de même taille.
+*/
+void fill2DTexture(vector<float>& r_texture_v, unsigned int r, unsigned int c, TextureGenerationMode mode, float v1 = 0, float v2 = 0, float v3 = 0);
+
 /**
 * @brief Retourne une valeur de bruit cohérent 2D.
 * @param x L'abscisse.
@@ -57,6 +81,11 @@ float** generate2DTexture(unsigned int r, unsigned int c, TextureGenerationMode
 * @throw ArgumentException si le pas est nul.
 *
 * Si x ou y est négatif, sa valeur absolue est prise.
+*
+* Le bruit utilisé est celui généré par le dernier appel à la fonction <em>init2DNoise</em> (NoiseGenerator::value).
+*
+* @warning
+* Ce bruit est global : préférer un NoiseGenerator propre à l'appelant pour un usage dans plusieurs threads.
 */
 float pfNoiseFct(float x, float y, unsigned int step);
 
@@ -68,6 +97,7 @@ float pfNoiseFct(float x, float y, unsigned int step);
 * @throw ArgumentException si la graine est strictement négative ou si le maximum est négatif ou nul.
 *
 * La même valeur est retournée pour une valeur <em>seed</em> donnée.
+* Le générateur pseudo-aléatoire de la fonction <em>rand</em> n'est pas réinitialisé, un NoiseGenerator local étant utilisé.
 *
 * @warning
 * Méthode abandonnée.
@@ -148,7 +178,7 @@ float cubicInterpolation2D(float y00, float y01, float y02, float y03, float y10
 * @throw ArgumentException si l'une des dimensions est nulle.
 * @throw ArgumentException si la graine est strictement négative ou si le maximum est négatif ou nul.
 *
-* Modifie la variable globale <em>g_noise2D_v2</em>.
+* Modifie le NoiseGenerator global <em>g_noise2D</em>, utilisé par la fonction <em>pfNoiseFct</em>.
 */
 void init2DNoise(unsigned int w, unsigned int h, int seed, int max);
 
@@ -0,0 +1,104 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe InputSession.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef INPUTSESSION_H_INCLUDED
+#define INPUTSESSION_H_INCLUDED
+
+#include "media_gen.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include "noncopyable.h"
+
+/**
+* @brief Fichier d'enregistrement ou de rejeu des entrées utilisateur.
+*
+* Une session est ouverte une seule fois, en enregistrement (InputSession::startRecording) ou en rejeu (InputSession::startReplay),
+* puis partagée par les instances de EventHandler successives (EventHandler::setInputSession), afin qu'un enregistrement couvre une partie entière
+* et non la seule dernière carte chargée.
+*
+* Le contenu du fichier est décrit par la classe EventHandler, cette classe n'en connaissant que l'en-tête (l'entier PFGAME_VERSION du fichier "misc_gen.h").
+*/
+class InputSession : private NonCopyable
+{
+public:
+    /**
+    * @brief Enumération des modes d'une session.
+    */
+    enum InputMode
+    {
+        INPUT_LIVE, //!< Aucun fichier ouvert, les entrées sont lues depuis la file d'événements SDL.
+        INPUT_RECORD, //!< Entrées lues depuis la file d'événements SDL et enregistrées dans un fichier.
+        INPUT_REPLAY //!< Entrées lues depuis un fichier enregistré, la file d'événements SDL étant ignorée.
+    };
+
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur InputSession par défaut.
+    *
+    * Le mode est INPUT_LIVE.
+    */
+    InputSession();
+
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Commence l'enregistrement des entrées dans un fichier.
+    * @param fileName Le nom du fichier, écrasé s'il existe.
+    * @throw FileException si le fichier ne peut pas être ouvert.
+    *
+    * Un enregistrement ou un rejeu en cours est d'abord terminé (InputSession::stop).
+    */
+    void startRecording(const string& fileName);
+    /**
+    * @brief Commence le rejeu des entrées enregistrées dans un fichier.
+    * @param fileName Le nom du fichier.
+    * @throw FileException si le fichier ne peut pas être ouvert ou si sa version n'est pas PFGAME_VERSION.
+    *
+    * Un enregistrement ou un rejeu en cours est d'abord terminé (InputSession::stop).
+    * Le fichier est lu entièrement en mémoire, afin qu'aucune lecture disque n'ait lieu pendant le rejeu.
+    */
+    void startReplay(const string& fileName);
+    /**
+    * @brief Termine l'enregistrement ou le rejeu en cours, le mode passant à INPUT_LIVE.
+    */
+    void stop();
+    /**
+    * @brief Ecrit des données dans l'enregistrement en cours.
+    * @param p_src Les données.
+    * @param size Le nombre d'octets à écrire.
+    */
+    void write(const void* p_src, unsigned int size);
+    /**
+    * @brief Copie des données de l'enregistrement en cours de rejeu.
+    * @param p_dest La destination.
+    * @param size Le nombre d'octets à copier.
+    * @return <code>false</code> s'il reste moins de <em>size</em> octets à lire.
+    */
+    bool read(void* p_dest, unsigned int size);
+
+    /*
+    * Accesseurs
+    * ----------
+    */
+    InputMode getMode() const {return m_mode;} //!< Accesseur.
+
+private:
+    InputMode m_mode; //!< Le mode de la session.
+    ofstream m_recordFile; //!< Le fichier de l'enregistrement en cours.
+    vector<char> m_replay_v; //!< Le contenu du fichier en cours de rejeu.
+    unsigned int m_replayPos; //!< La position de lecture dans InputSession::m_replay_v.
+};
+
+#endif // INPUTSESSION_H_INCLUDED
@@ -26,9 +26,10 @@
 * <ul><li>Le fichier "mediahandler.h" initialise tous les contextes nécessaires à une application OpenGL/SDL/FMOD standard,</li>
 * <li>Le fichier "glfunc.h" regroupe les fonctions permettant l'utilisation de SDL et OpengGL,</li>
 * <li>Le fichier "pngtoglloader.h" offre un outil pour l'exploitation d'images PNG,</li>
+* <li>Le fichier "textureatlas.h" regroupe des images dans quelques grandes textures,</li>
 * <li>Le fichier "fmodfunc.h" permet la gestion de l'audio via FMOD,</li>
 * <li>Le fichier "geometry.h" gère les opérations sur des formes via différentes classes : PfPoint, PfPolygon, PfRectangle, PfOrientation et PfColor,</li>
-* <li>Le fichier "graphics.h" permet la génération de textures procédurales.</li></ul>
+* <li>Le fichier "graphics.h" permet la génération de textures procédurales, le fichier "noisegenerator.h" y ajoutant un générateur de bruit cohérent.</li></ul>
 *
 * La classe GLImage définit une image telle qu'elle est affichée à l'écran par les fonctions de cette bibliothèque.
 *
@@ -46,7 +47,7 @@
 * Avant d'utiliser les fonctions SDL dans un programme, inclure la macro SDL_MAIN_HANDLED, autrement : erreur ld undefined reference to WinMain@16.
 *
 * @see
-* media_gen.h, mediahandler.h, glfunc.h, pngtoglloader.h, fmodfunc.h, geometry.h, graphics.h
+* media_gen.h, mediahandler.h, glfunc.h, pngtoglloader.h, textureatlas.h, fmodfunc.h, geometry.h, graphics.h, noisegenerator.h
 */
 
 #ifndef MEDIA_GEN_H_INCLUDED
@@ -71,6 +72,12 @@
 #define MAX_VERTICES_PER_POLYGON 10 //!< Le nombre maximal de sommets dans un polygone.
 #define TRANSITION_FRAMES_COUNT 8 //!< Le nombre de frames d'une transition.
 
+#define ATLAS_SIZE 2048 //!< La largeur et la hauteur maximale d'une page d'atlas de textures, en pixels.
+#define ATLAS_PADDING 2 //!< La marge autour de chaque image d'un atlas de textures, en pixels.
+#define ATLAS_TEXTURE_INDEX 100000000 //!< L'indice de texture de la première page d'atlas ajoutée au contexte OpenGL, les suivantes prenant les indices suivants.
+
+#define NOISE_RAND_MAX 0xFFFFFF //!< La valeur maximale retournée par le générateur pseudo-aléatoire d'un NoiseGenerator.
+
 #define Y_PIXEL_SIZE 1./g_windowHeight //!< La taille verticale d'un pixel.
 #define Y_X_RATIO ((float) g_windowHeight/g_windowWidth) //!< Rapport entre la hauteur et la largeur de l'écran, utile pour dessiner des carrés sur un écran rectangulaire en utilisant un seul pourcentage.
 
@@ -0,0 +1,121 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe NoiseGenerator.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef NOISEGENERATOR_H_INCLUDED
+#define NOISEGENERATOR_H_INCLUDED
+
+#include "media_gen.h"
+
+#include <vector>
+
+/**
+* @brief Générateur de bruit cohérent 2D, disposant de son propre générateur pseudo-aléatoire.
+*
+* Le bruit est défini par une grille de valeurs aléatoires entières, comprises entre 0 et un maximum,
+* générée par la méthode NoiseGenerator::init.
+* Entre les noeuds de cette grille, espacés d'un pas donné, les valeurs sont obtenues par interpolation cubique,
+* d'abord selon les lignes puis selon les colonnes.
+*
+* Le générateur pseudo-aléatoire est un générateur congruentiel linéaire propre à chaque instance, réinitialisé avec la graine
+* à chaque appel de NoiseGenerator::init : pour une graine donnée, les valeurs générées sont toujours les mêmes,
+* et la fonction <em>srand</em> n'est jamais appelée.
+* Plusieurs instances peuvent ainsi être utilisées simultanément dans des threads différents.
+* Les méthodes constantes d'une même instance peuvent également être appelées depuis plusieurs threads.
+*
+* La grille et les régions calculées par NoiseGenerator::fillRegion sont stockées dans des tableaux contigus, ligne après ligne.
+* Le calcul d'une région se fait ligne par ligne, sans allocation par point,
+* en boucles simples que le compilateur peut vectoriser.
+*/
+class NoiseGenerator
+{
+public:
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur NoiseGenerator.
+    * @param seed La graine de hasard.
+    *
+    * La grille est vide tant que la méthode NoiseGenerator::init n'a pas été appelée.
+    */
+    explicit NoiseGenerator(unsigned int seed = 0);
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Génère la grille de ce bruit.
+    * @param rows Le nombre de lignes de la grille.
+    * @param columns Le nombre de colonnes de la grille.
+    * @param max La valeur maximale d'un noeud de la grille.
+    * @throw ArgumentException si l'une des dimensions est nulle ou si le maximum est négatif ou nul.
+    *
+    * Le générateur pseudo-aléatoire est auparavant réinitialisé avec la graine de ce bruit.
+    */
+    void init(unsigned int rows, unsigned int columns, int max);
+    /**
+    * @brief Retourne la valeur de ce bruit en un point.
+    * @param x L'abscisse, selon les lignes de la grille.
+    * @param y L'ordonnée, selon les colonnes de la grille.
+    * @param step Le pas du bruit.
+    * @return La valeur calculée.
+    * @throw ArgumentException si le pas est nul.
+    * @throw PfException si la grille est vide.
+    *
+    * Si x ou y est négatif, sa valeur absolue est prise.
+    * Les noeuds hors de la grille prennent la valeur du noeud le plus proche.
+    */
+    float value(float x, float y, unsigned int step) const;
+    /**
+    * @brief Calcule les valeurs de ce bruit sur une région rectangulaire de points entiers.
+    * @param row La ligne du premier point de la région.
+    * @param column La colonne du premier point de la région.
+    * @param rows Le nombre de lignes de la région.
+    * @param columns Le nombre de colonnes de la région.
+    * @param step Le pas du bruit.
+    * @param p_out Le tableau à remplir, d'au moins <em>rows</em> * <em>columns</em> valeurs, ligne après ligne.
+    * @throw ArgumentException si le pas est nul.
+    * @throw PfException si la grille est vide.
+    *
+    * Le point (i;j) de la région prend la valeur NoiseGenerator::value(row+i, column+j, step).
+    *
+    * Pour chaque ligne de la région, les quatre lignes de la grille qui l'encadrent sont d'abord interpolées
+    * sur l'ensemble des colonnes de grille utiles, puis chaque point de la ligne est interpolé entre les quatre colonnes qui l'encadrent.
+    * Les coefficients d'interpolation ne dépendent que de la position d'un point entre deux noeuds, ils sont calculés une fois par appel.
+    */
+    void fillRegion(unsigned int row, unsigned int column, unsigned int rows, unsigned int columns, unsigned int step, float* p_out) const;
+    /**
+    * @brief Retourne un nombre pseudo-aléatoire, compris entre 0 et NOISE_RAND_MAX.
+    * @return La valeur suivante du générateur.
+    */
+    unsigned int next();
+    /**
+    * @brief Réinitialise le générateur pseudo-aléatoire.
+    * @param seed La nouvelle graine de hasard.
+    *
+    * La grille n'est pas modifiée.
+    */
+    void reseed(unsigned int seed);
+    /*
+    * Accesseurs
+    * ----------
+    */
+    unsigned int getSeed() const {return m_seed;} //!< Accesseur.
+    unsigned int getRowsCount() const {return m_rows;} //!< Accesseur.
+    unsigned int getColumnsCount() const {return m_columns;} //!< Accesseur.
+
+private:
+    unsigned int m_seed; //!< La graine de hasard.
+    unsigned int m_state; //!< L'état du générateur pseudo-aléatoire.
+    unsigned int m_rows; //!< Le nombre de lignes de la grille.
+    unsigned int m_columns; //!< Le nombre de colonnes de la grille.
+    vector<float> m_lattice_v; //!< Les noeuds de la grille, ligne après ligne.
+};
+
+#endif // NOISEGENERATOR_H_INCLUDED
@@ -0,0 +1,117 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe PNGDecodingPool.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef PNGDECODINGPOOL_H_INCLUDED
+#define PNGDECODINGPOOL_H_INCLUDED
+
+#include "media_gen.h"
+
+#include <string>
+#include <vector>
+#include <SDL.h>
+#include "noncopyable.h"
+
+class PNGToGLLoader;
+
+/**
+* @brief Ensemble de threads décodant des images PNG en parallèle.
+*
+* Les images sont ajoutées sous forme de tableaux d'octets (PNGDecodingPool::addImage), puis décodées par des threads de travail
+* au moyen de PNGToGLLoader. Les images décodées sont récupérées dans leur ordre de fin de décodage (PNGDecodingPool::nextImage).
+*
+* Le décodage n'utilise pas OpenGL : seul l'ajout des textures décodées au contexte (fonction <em>addTexture</em> du fichier "glfunc.h")
+* doit être fait par le thread propriétaire du contexte OpenGL. Cette classe peut donc être utilisée sans contexte OpenGL.
+*
+* Les threads sont créés par le constructeur et arrêtés par le destructeur, qui détruit les images non récupérées.
+*/
+class PNGDecodingPool : private NonCopyable
+{
+public:
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur PNGDecodingPool.
+    * @param threadsCount Le nombre de threads de décodage, 0 pour un thread par coeur de processeur.
+    * @throw ConstructorException si les threads ne peuvent pas être créés.
+    */
+    explicit PNGDecodingPool(unsigned int threadsCount = 0);
+    /**
+    * @brief Destructeur PNGDecodingPool.
+    *
+    * Attend la fin des décodages en cours, abandonne les autres et détruit les images non récupérées.
+    */
+    ~PNGDecodingPool();
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Ajoute une image à décoder.
+    * @param key La clé identifiant l'image, retournée avec l'image décodée.
+    * @param dt_t Le tableau d'octets de l'image PNG, alloué par <em>new[]</em> et détruit par ce PNGDecodingPool.
+    * @param length La longueur du tableau d'octets.
+    */
+    void addImage(unsigned int key, char dt_t[], long length);
+    /**
+    * @brief Récupère une image décodée.
+    * @param r_key La clé de l'image, à remplir.
+    * @param rpn_image L'image décodée, à remplir, à détruire par l'appelant.
+    * @param wait Indique s'il faut attendre la fin d'un décodage lorsqu'aucune image décodée n'est disponible.
+    * @return <code>false</code> si aucune image n'est disponible, ou si toutes les images ajoutées ont déjà été récupérées.
+    * @throw PfException si l'image n'a pas pu être décodée.
+    */
+    bool nextImage(unsigned int& r_key, PNGToGLLoader*& rpn_image, bool wait = true);
+    /**
+    * @brief Retourne le nombre d'images ajoutées.
+    * @return Le nombre d'images.
+    */
+    unsigned int addedCount() const;
+    /**
+    * @brief Retourne le nombre d'images dont le décodage est terminé, avec succès ou non.
+    * @return Le nombre d'images.
+    */
+    unsigned int decodedCount() const;
+
+private:
+    /**
+    * @brief Image à décoder ou décodée.
+    */
+    struct Job
+    {
+        unsigned int key; //!< La clé de l'image.
+        char* dt_t; //!< Les octets de l'image, 0 une fois le décodage commencé.
+        long length; //!< Le nombre d'octets de l'image.
+        PNGToGLLoader* p_image; //!< L'image décodée, 0 tant qu'elle ne l'est pas ou en cas d'erreur.
+        string error; //!< Le message d'erreur de décodage, vide si aucune.
+    };
+
+    /**
+    * @brief Fonction exécutée par les threads de décodage.
+    * @param p_pool Le PNGDecodingPool.
+    * @return 0.
+    */
+    static int decodingThread(void* p_pool);
+    /**
+    * @brief Décode les images ajoutées jusqu'à l'arrêt de ce PNGDecodingPool.
+    */
+    void decodeImages();
+
+    vector<Job> m_jobs_v; //!< Les images, dans l'ordre d'ajout.
+    unsigned int m_nextJob; //!< L'indice de la prochaine image à décoder.
+    vector<unsigned int> m_decoded_v; //!< Les indices des images décodées, dans l'ordre de fin de décodage.
+    unsigned int m_nextDecoded; //!< L'indice dans PNGDecodingPool::m_decoded_v de la prochaine image à récupérer.
+    bool m_stop; //!< Indique aux threads qu'ils doivent s'arrêter.
+    vector<SDL_Thread*> mp_threads_v; //!< Les threads de décodage.
+    SDL_mutex* mp_mutex; //!< Le mutex protégeant les membres ci-dessus.
+    SDL_cond* mp_jobCond; //!< Signalé à l'ajout d'une image ou à l'arrêt.
+    SDL_cond* mp_decodedCond; //!< Signalé à la fin d'un décodage.
+};
+
+#endif // PNGDECODINGPOOL_H_INCLUDED
@@ -189,6 +189,10 @@ public:
     * ----------
     */
     int getName() const {return m_name;} //!< Accesseur.
+    GLuint getWidth() const {return m_width;} //!< Accesseur.
+    GLuint getHeight() const {return m_height;} //!< Accesseur.
+    GLuint getInternalFormat() const {return m_internalFormat;} //!< Accesseur, également le nombre d'octets par texel.
+    const GLubyte* getTexels() const {return m_texels_t;} //!< Accesseur, les lignes étant rangées de bas en haut.
 
 private:
     /**
@@ -0,0 +1,232 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe RenderBackend et ses dérivées : GLRenderBackend et RecordingRenderBackend.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef RENDERBACKEND_H_INCLUDED
+#define RENDERBACKEND_H_INCLUDED
+
+#include "media_gen.h"
+
+#include <ostream>
+#include <vector>
+#include "noncopyable.h"
+
+class GLImage;
+
+/**
+* @brief Interface de rendu des images d'une frame.
+*
+* Une frame commence par RenderBackend::beginFrame, se poursuit par le rendu de chaque image (RenderBackend::draw),
+* et se termine par RenderBackend::endFrame.
+*
+* Il s'agit d'une classe abstraite. Les classes filles transmettent ces appels à OpenGL (GLRenderBackend)
+* ou les enregistrent pour les analyser (RecordingRenderBackend).
+*/
+class RenderBackend : private NonCopyable
+{
+public:
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Destructeur RenderBackend.
+    */
+    virtual ~RenderBackend() {}
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Commence une frame.
+    */
+    virtual void beginFrame() = 0;
+    /**
+    * @brief Rend une image.
+    * @param rc_glImage L'image à rendre.
+    * @throw PfException si l'image ne peut être rendue.
+    *
+    * Les images non valides ne sont pas rendues.
+    */
+    virtual void draw(const GLImage& rc_glImage) = 0;
+    /**
+    * @brief Termine une frame.
+    *
+    * L'effet de transition en cours (<em>g_transitionFrame</em>, fichier "media_gen.h") est rendu et avance d'une frame.
+    */
+    virtual void endFrame() = 0;
+};
+
+/**
+* @brief Rendu OpenGL.
+*
+* Les appels sont transmis aux fonctions du fichier "glfunc.h" :
+* <ul><li>RenderBackend::beginFrame appelle <em>clearGL</em>,</li>
+* <li>RenderBackend::draw appelle <em>drawGL</em>,</li>
+* <li>RenderBackend::endFrame appelle <em>drawTransition</em>, <em>flushGL</em> et <em>swapSDLBuffers</em>.</li></ul>
+*/
+class GLRenderBackend : public RenderBackend
+{
+public:
+    /*
+    * Redéfinitions
+    * -------------
+    */
+    /**
+    * @brief Efface les tampons OpenGL.
+    */
+    virtual void beginFrame();
+    /**
+    * @brief Rend une image avec OpenGL.
+    * @param rc_glImage L'image à rendre.
+    * @throw PfException si l'image ne peut être rendue.
+    */
+    virtual void draw(const GLImage& rc_glImage);
+    /**
+    * @brief Rend la transition, puis affiche la frame.
+    */
+    virtual void endFrame();
+};
+
+/**
+* @brief Rendu enregistré en mémoire, sans OpenGL.
+*
+* Les commandes que transmettrait la fonction <em>drawGL</em> (fichier "glfunc.h") sont enregistrées pour la frame en cours
+* (RecordingRenderBackend::m_commands_v) : changements de texture, rendus, empilements de matrice pour les images statiques et tournées.
+* Les statistiques de chaque frame (RecordingRenderBackend::FrameStats) sont conservées, et écrites dans un flux si celui-ci est précisé.
+*
+* Ce rendu permet de mesurer le coût d'affichage d'une vue sans fenêtre ni pilote graphique, par exemple pour des mesures de performance
+* ou des tests de non-régression.
+*
+* @warning
+* Sans contexte OpenGL, la variable <em>g_glRecordOnly</em> (fichier "glfunc.h") doit être vraie,
+* afin que les autres fonctions de ce fichier (caméra, textures) n'appellent pas OpenGL.
+*/
+class RecordingRenderBackend : public RenderBackend
+{
+public:
+    /**
+    * @brief Type de commande enregistrée.
+    */
+    enum CommandType
+    {
+        CLEAR, //!< Effacement des tampons.
+        BIND, //!< Changement de texture.
+        DRAW, //!< Rendu d'une image.
+        PUSH_MATRIX, //!< Empilement de matrice.
+        POP_MATRIX, //!< Dépilement de matrice.
+        PRESENT //!< Affichage de la frame.
+    };
+
+    /**
+    * @brief Commande enregistrée.
+    */
+    struct Command
+    {
+        CommandType type; //!< Le type de commande.
+        unsigned int textureIndex; //!< L'indice de texture, pour les commandes BIND et DRAW (0 si l'image n'est pas texturée).
+        int verticesCount; //!< Le nombre de sommets, pour les commandes DRAW.
+    };
+
+    /**
+    * @brief Statistiques d'une frame.
+    */
+    struct FrameStats
+    {
+        unsigned int drawCalls; //!< Le nombre de rendus.
+        unsigned int textureBinds; //!< Le nombre de changements de texture.
+        unsigned int vertices; //!< Le nombre de sommets rendus.
+        unsigned int matrixPushes; //!< Le nombre d'empilements de matrice.
+        unsigned int staticImages; //!< Le nombre d'images statiques rendues.
+        unsigned int rotatedImages; //!< Le nombre d'images tournées rendues.
+        float coveredArea; //!< La somme des aires des rectangles englobants des images rendues, en surface d'écran (1 x Y_X_RATIO), estimant le recouvrement.
+    };
+
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur RecordingRenderBackend.
+    * @param q_os Le flux dans lequel écrire les statistiques de chaque frame, 0 pour ne rien écrire.
+    */
+    explicit RecordingRenderBackend(ostream* q_os = 0);
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Ecrit les statistiques d'une frame dans un flux, sur une ligne.
+    * @param r_os Le flux.
+    * @param index L'indice de la frame.
+    * @throw ArgumentException si l'indice n'est pas valide.
+    */
+    void writeStats(ostream& r_os, unsigned int index) const;
+    /**
+    * @brief Retourne les statistiques d'une frame.
+    * @param index L'indice de la frame, 0 pour la première frame terminée.
+    * @return Les statistiques.
+    * @throw ArgumentException si l'indice n'est pas valide.
+    */
+    const FrameStats& frameStats(unsigned int index) const;
+    /**
+    * @brief Retourne le nombre de frames terminées.
+    * @return Le nombre de frames.
+    */
+    unsigned int framesCount() const;
+    /**
+    * @brief Oublie les frames enregistrées.
+    */
+    void clear();
+    /*
+    * Redéfinitions
+    * -------------
+    */
+    /**
+    * @brief Commence l'enregistrement d'une frame.
+    *
+    * Les commandes de la frame précédente sont oubliées, et une commande CLEAR est enregistrée.
+    */
+    virtual void beginFrame();
+    /**
+    * @brief Enregistre le rendu d'une image.
+    * @param rc_glImage L'image à rendre.
+    *
+    * Les commandes sont celles que transmettrait la fonction <em>drawGL</em> : empilement de matrice pour une image statique ou tournée,
+    * changement de texture si la texture de l'image n'est pas la dernière liée, rendu, puis dépilements.
+    */
+    virtual void draw(const GLImage& rc_glImage);
+    /**
+    * @brief Termine l'enregistrement d'une frame.
+    *
+    * La transition en cours est enregistrée comme une image statique non texturée recouvrant l'écran, puis une commande PRESENT.
+    * Les statistiques de la frame sont ajoutées à la liste RecordingRenderBackend::m_frames_v et écrites dans le flux s'il y en a un.
+    */
+    virtual void endFrame();
+    /*
+    * Accesseurs
+    * ----------
+    */
+    const vector<Command>& getCommands() const {return m_commands_v;} //!< Accesseur.
+
+private:
+    /**
+    * @brief Enregistre une commande.
+    * @param type Le type de commande.
+    * @param textureIndex L'indice de texture.
+    * @param verticesCount Le nombre de sommets.
+    */
+    void record(CommandType type, unsigned int textureIndex = 0, int verticesCount = 0);
+
+    ostream* mq_os; //!< Le flux dans lequel écrire les statistiques, 0 si aucun, non détruit par cette instance.
+    vector<Command> m_commands_v; //!< Les commandes de la frame en cours ou de la dernière frame terminée.
+    FrameStats m_current; //!< Les statistiques de la frame en cours.
+    vector<FrameStats> m_frames_v; //!< Les statistiques des frames terminées.
+    unsigned int m_boundTextureIndex; //!< L'indice de la dernière texture liée, 0 si aucune.
+};
+
+#endif // RENDERBACKEND_H_INCLUDED
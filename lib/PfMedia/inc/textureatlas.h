@@ -0,0 +1,141 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe TextureAtlas.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef TEXTUREATLAS_H_INCLUDED
+#define TEXTUREATLAS_H_INCLUDED
+
+#include "media_gen.h"
+
+#include <GL/gl.h>
+#include <map>
+#include <vector>
+#include "noncopyable.h"
+#include "geometry.h"
+
+class PNGToGLLoader;
+
+/**
+* @brief Regroupement d'images décodées dans quelques grandes textures, les pages de l'atlas.
+*
+* Les images sont ajoutées une à une (TextureAtlas::addImage), chacune sous son indice de texture, puis rangées dans les pages
+* lors de l'appel à TextureAtlas::pack.
+* Les pages sont des images RGBA de largeur TextureAtlas::m_size, dont la hauteur est la plus petite puissance de 2 suffisante.
+*
+* Les images sont rangées par étagères, de la plus haute à la plus basse.
+* Chacune est entourée d'une marge de TextureAtlas::m_padding pixels recopiant ses bords, afin que le filtrage linéaire d'OpenGL
+* n'y mélange pas les pixels d'une image voisine.
+*
+* Pour chaque indice de texture, la région retournée par TextureAtlas::region indique la page et le rectangle qu'y occupe l'image,
+* en coordonnées de texture de la page.
+* Une coordonnée de texture (u, v) de l'image d'origine correspond ainsi à la coordonnée
+* (x + u*w, y + v*h) de la page, pour la région de rectangle (x, y, w, h).
+*
+* Cette classe n'utilise pas OpenGL : c'est la fonction <em>addAtlas</em> du fichier "glfunc.h" qui ajoute les pages au contexte.
+*
+* @warning
+* Une image rangée dans un atlas ne peut pas être répétée : ses coordonnées de texture doivent être comprises entre 0 et 1.
+*/
+class TextureAtlas : private NonCopyable
+{
+public:
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur TextureAtlas.
+    * @param size La largeur et la hauteur maximale d'une page, en pixels.
+    * @param padding La marge autour de chaque image, en pixels.
+    */
+    explicit TextureAtlas(unsigned int size = ATLAS_SIZE, unsigned int padding = ATLAS_PADDING);
+    /**
+    * @brief Destructeur TextureAtlas.
+    *
+    * Détruit les images non encore rangées.
+    */
+    ~TextureAtlas();
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Ajoute une image à ranger dans cet atlas.
+    * @param textureIndex L'indice de texture de l'image.
+    * @param pn_image L'image décodée, détruite par cet atlas.
+    * @return <code>false</code> si l'image, marge comprise, est trop grande pour une page ou si elle est vide, auquel cas elle n'est pas détruite.
+    *
+    * Si l'indice de texture est déjà présent dans cet atlas, l'image est détruite sans être ajoutée.
+    */
+    bool addImage(unsigned int textureIndex, PNGToGLLoader* pn_image);
+    /**
+    * @brief Range les images ajoutées dans les pages de cet atlas.
+    *
+    * Les images sont détruites une fois recopiées.
+    * Les images ajoutées après un appel à cette méthode sont rangées dans de nouvelles pages à l'appel suivant.
+    */
+    void pack();
+    /**
+    * @brief Retourne la région occupée par une image rangée dans cet atlas.
+    * @param textureIndex L'indice de texture de l'image.
+    * @param r_page L'indice de la page, à remplir.
+    * @param r_rect Le rectangle de l'image dans la page, en coordonnées de texture de la page, à remplir.
+    * @return <code>false</code> si l'image n'est pas rangée dans cet atlas.
+    */
+    bool region(unsigned int textureIndex, unsigned int& r_page, PfRectangle& r_rect) const;
+    /**
+    * @brief Retourne le nombre de pages de cet atlas.
+    * @return Le nombre de pages.
+    */
+    unsigned int pagesCount() const;
+    /**
+    * @brief Retourne la hauteur d'une page.
+    * @param page L'indice de la page.
+    * @return La hauteur en pixels.
+    * @throw ArgumentException si l'indice n'est pas valide.
+    */
+    unsigned int pageHeight(unsigned int page) const;
+    /**
+    * @brief Retourne les pixels RGBA d'une page, la ligne du bas en premier.
+    * @param page L'indice de la page.
+    * @return Le tableau de pixels.
+    * @throw ArgumentException si l'indice n'est pas valide.
+    */
+    const GLubyte* pageTexels(unsigned int page) const;
+    /**
+    * @brief Libère les pixels des pages, une fois celles-ci ajoutées au contexte OpenGL.
+    *
+    * Les régions sont conservées.
+    */
+    void releaseTexels();
+    /*
+    * Accesseurs
+    * ----------
+    */
+    unsigned int getSize() const {return m_size;} //!< Accesseur.
+    const map<unsigned int, pair<unsigned int, PfRectangle> >& getRegions() const {return m_regions_map;} //!< Accesseur.
+
+private:
+    /**
+    * @brief Recopie une image dans une page, marge comprise, au format RGBA.
+    * @param rc_image L'image.
+    * @param r_texels_v Les pixels de la page.
+    * @param height La hauteur de la page.
+    * @param x L'abscisse du coin inférieur gauche de l'image, marge comprise, en pixels.
+    * @param y L'ordonnée du coin inférieur gauche de l'image, marge comprise, en pixels.
+    */
+    void copyImage(const PNGToGLLoader& rc_image, vector<GLubyte>& r_texels_v, unsigned int height, unsigned int x, unsigned int y) const;
+
+    unsigned int m_size; //!< La largeur et la hauteur maximale d'une page.
+    unsigned int m_padding; //!< La marge autour de chaque image.
+    map<unsigned int, PNGToGLLoader*> mpn_images_map; //!< Les images à ranger, par indice de texture.
+    vector<vector<GLubyte> > m_pages_v; //!< Les pixels RGBA de chaque page.
+    vector<unsigned int> m_heights_v; //!< La hauteur de chaque page.
+    map<unsigned int, pair<unsigned int, PfRectangle> > m_regions_map; //!< Les régions des images rangées : page et rectangle, par indice de texture.
+};
+
+#endif // TEXTUREATLAS_H_INCLUDED
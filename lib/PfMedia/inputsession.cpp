@@ -0,0 +1,67 @@
+#include "inputsession.h"
+
+#include <cstring>
+#include <iterator>
+#include "errors.h"
+#include "misc.h"
+
+InputSession::InputSession() : m_mode(INPUT_LIVE), m_replayPos(0) {}
+
+void InputSession::startRecording(const string& fileName)
+{
+	stop();
+
+	m_recordFile.open(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+	if (!m_recordFile.is_open())
+		throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
+
+	int version = PFGAME_VERSION;
+	write(&version, sizeof(int));
+	m_mode = INPUT_RECORD;
+}
+
+void InputSession::startReplay(const string& fileName)
+{
+	stop();
+
+	ifstream ifs(fileName.c_str(), ios::in | ios::binary);
+	if (!ifs.is_open())
+		throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
+	m_replay_v.assign(istreambuf_iterator<char>(ifs), istreambuf_iterator<char>());
+	ifs.close();
+
+	int version = -1; // valeur conservée si le fichier est trop court
+	if (!read(&version, sizeof(int)) || version != PFGAME_VERSION)
+	{
+		m_replay_v.clear();
+		m_replayPos = 0;
+		throw FileException(__LINE__, __FILE__, string("L'enregistrement n'est pas de la version la plus récente.\n\tVersion actuelle : ")
+                      + itostr(PFGAME_VERSION) + "\n\tVersion du fichier : " + itostr(version), fileName);
+	}
+	m_mode = INPUT_REPLAY;
+}
+
+void InputSession::stop()
+{
+	if (m_recordFile.is_open())
+		m_recordFile.close();
+	m_replay_v.clear();
+	m_replayPos = 0;
+	m_mode = INPUT_LIVE;
+}
+
+void InputSession::write(const void* p_src, unsigned int size)
+{
+	m_recordFile.write((const char*) p_src, size);
+}
+
+bool InputSession::read(void* p_dest, unsigned int size)
+{
+	if (m_replay_v.size() - m_replayPos < size)
+		return false;
+
+	memcpy(p_dest, &(m_replay_v[m_replayPos]), size);
+	m_replayPos += size;
+
+	return true;
+}
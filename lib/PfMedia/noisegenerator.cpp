@@ -0,0 +1,144 @@
+#include "noisegenerator.h"
+
+#include <math.h>
+#include "errors.h"
+
+// ramène un indice de noeud dans la grille
+static inline int clampIndex(int index, unsigned int size)
+{
+	return MIN((int) size - 1, MAX(0, index));
+}
+
+// coefficients de l'interpolation cubique des quatre noeuds encadrant le point x (0 <= x < 1)
+static inline void cubicWeights(float x, float& r_w0, float& r_w1, float& r_w2, float& r_w3)
+{
+	float x2 = x*x, x3 = x2*x;
+	r_w0 = -x3 + 2*x2 - x;
+	r_w1 = x3 - 2*x2 + 1;
+	r_w2 = -x3 + x2 + x;
+	r_w3 = x3 - x2;
+}
+
+NoiseGenerator::NoiseGenerator(unsigned int seed) : m_seed(seed), m_state(0), m_rows(0), m_columns(0)
+{
+	reseed(seed);
+}
+
+void NoiseGenerator::init(unsigned int rows, unsigned int columns, int max)
+{
+	if (rows == 0 || columns == 0)
+		throw ArgumentException(__LINE__, __FILE__, "Dimension nulle.", "rows/columns", "NoiseGenerator::init");
+	if (max <= 0)
+		throw ArgumentException(__LINE__, __FILE__, "Maximum négatif ou nul.", "max", "NoiseGenerator::init");
+
+	reseed(m_seed);
+	m_rows = rows;
+	m_columns = columns;
+	m_lattice_v.resize(rows*columns);
+	for (unsigned int i=0, size=m_lattice_v.size();i<size;i++)
+		m_lattice_v[i] = (float) (next() % (max+1));
+}
+
+float NoiseGenerator::value(float x, float y, unsigned int step) const
+{
+	if (step == 0)
+		throw ArgumentException(__LINE__, __FILE__, "Pas nul pour le bruit.", "step", "NoiseGenerator::value");
+	if (m_lattice_v.empty())
+		throw PfException(__LINE__, __FILE__, "Grille de bruit non initialisée.");
+
+	float ax = ABS(x), ay = ABS(y);
+	int i = (int) ((ax + FLOAT_MARGIN) / step);
+	int j = (int) ((ay + FLOAT_MARGIN) / step);
+
+	float wx[4], wy[4], v[4];
+	cubicWeights(MAX(0, (ax - i*step) / step), wx[0], wx[1], wx[2], wx[3]);
+	cubicWeights(MAX(0, (ay - j*step) / step), wy[0], wy[1], wy[2], wy[3]);
+
+	// interpolation selon les lignes, sur les quatre colonnes encadrant le point, puis selon les colonnes
+	const float* q_row;
+	for (int l=0;l<4;l++)
+		v[l] = 0;
+	for (int k=0;k<4;k++)
+	{
+		q_row = &(m_lattice_v[clampIndex(i+k-1, m_rows)*m_columns]);
+		for (int l=0;l<4;l++)
+			v[l] += wx[k] * q_row[clampIndex(j+l-1, m_columns)];
+	}
+
+	return wy[0]*v[0] + wy[1]*v[1] + wy[2]*v[2] + wy[3]*v[3];
+}
+
+void NoiseGenerator::fillRegion(unsigned int row, unsigned int column, unsigned int rows, unsigned int columns, unsigned int step, float* p_out) const
+{
+	if (step == 0)
+		throw ArgumentException(__LINE__, __FILE__, "Pas nul pour le bruit.", "step", "NoiseGenerator::fillRegion");
+	if (m_lattice_v.empty())
+		throw PfException(__LINE__, __FILE__, "Grille de bruit non initialisée.");
+	if (rows == 0 || columns == 0)
+		return;
+
+	// coefficients par position entre deux noeuds, rangés par coefficient pour que les boucles internes soient contiguës
+	vector<float> w0_v(step), w1_v(step), w2_v(step), w3_v(step);
+	for (unsigned int s=0;s<step;s++)
+		cubicWeights((float) s / step, w0_v[s], w1_v[s], w2_v[s], w3_v[s]);
+
+	// colonnes de grille utiles, ramenées dans la grille
+	int firstCol = clampIndex((int) (column/step) - 1, m_columns);
+	int lastCol = clampIndex((int) ((column+columns-1)/step) + 2, m_columns);
+	unsigned int count = lastCol - firstCol + 1;
+	vector<float> line_v(count);
+	float* p_line = &(line_v[0]);
+
+	const float *q_r0, *q_r1, *q_r2, *q_r3, *q_w0 = &(w0_v[0]), *q_w1 = &(w1_v[0]), *q_w2 = &(w2_v[0]), *q_w3 = &(w3_v[0]);
+	float wx0, wx1, wx2, wx3, a, b, c, d;
+	float* p_dst;
+	unsigned int p, q, s, n;
+	int ii, jj;
+	for (unsigned int i=0;i<rows;i++)
+	{
+		p = row + i;
+		ii = p / step;
+		s = p % step;
+		wx0 = q_w0[s];
+		wx1 = q_w1[s];
+		wx2 = q_w2[s];
+		wx3 = q_w3[s];
+		q_r0 = &(m_lattice_v[clampIndex(ii-1, m_rows)*m_columns + firstCol]);
+		q_r1 = &(m_lattice_v[clampIndex(ii, m_rows)*m_columns + firstCol]);
+		q_r2 = &(m_lattice_v[clampIndex(ii+1, m_rows)*m_columns + firstCol]);
+		q_r3 = &(m_lattice_v[clampIndex(ii+2, m_rows)*m_columns + firstCol]);
+
+		// interpolation selon les lignes
+		for (unsigned int k=0;k<count;k++)
+			p_line[k] = wx0*q_r0[k] + wx1*q_r1[k] + wx2*q_r2[k] + wx3*q_r3[k];
+
+		// interpolation selon les colonnes, par intervalles entre deux noeuds
+		p_dst = p_out + i*columns;
+		for (unsigned int j=0;j<columns;j+=n)
+		{
+			q = column + j;
+			jj = q / step;
+			s = q % step;
+			n = MIN(step - s, columns - j);
+			a = p_line[clampIndex(jj-1, m_columns) - firstCol];
+			b = p_line[clampIndex(jj, m_columns) - firstCol];
+			c = p_line[clampIndex(jj+1, m_columns) - firstCol];
+			d = p_line[clampIndex(jj+2, m_columns) - firstCol];
+			for (unsigned int t=0;t<n;t++)
+				p_dst[j+t] = a*q_w0[s+t] + b*q_w1[s+t] + c*q_w2[s+t] + d*q_w3[s+t];
+		}
+	}
+}
+
+unsigned int NoiseGenerator::next()
+{
+	m_state = m_state * 1664525u + 1013904223u;
+	return m_state >> 8;
+}
+
+void NoiseGenerator::reseed(unsigned int seed)
+{
+	m_seed = seed;
+	m_state = seed;
+	next();
+}
@@ -0,0 +1,181 @@
+#include "pngdecodingpool.h"
+
+#include <stdexcept>
+#include "errors.h"
+#include "misc.h"
+#include "pngtoglloader.h"
+#include "profiler.h"
+
+PNGDecodingPool::PNGDecodingPool(unsigned int threadsCount) : m_nextJob(0), m_nextDecoded(0), m_stop(false), mp_mutex(0), mp_jobCond(0), mp_decodedCond(0)
+{
+	if (threadsCount == 0)
+		threadsCount = MAX(1, SDL_GetCPUCount());
+
+	mp_mutex = SDL_CreateMutex();
+	mp_jobCond = SDL_CreateCond();
+	mp_decodedCond = SDL_CreateCond();
+	if (mp_mutex == 0 || mp_jobCond == 0 || mp_decodedCond == 0)
+	{
+		if (mp_mutex != 0)
+			SDL_DestroyMutex(mp_mutex);
+		if (mp_jobCond != 0)
+			SDL_DestroyCond(mp_jobCond);
+		if (mp_decodedCond != 0)
+			SDL_DestroyCond(mp_decodedCond);
+		throw ConstructorException(__LINE__, __FILE__, string("Impossible de créer les objets de synchronisation : ") + SDL_GetError(), "PNGDecodingPool");
+	}
+
+	SDL_Thread* p_thread;
+	for (unsigned int i=0;i<threadsCount;i++)
+	{
+		p_thread = SDL_CreateThread(decodingThread, "PNGDecoding", this);
+		if (p_thread != 0)
+			mp_threads_v.push_back(p_thread);
+	}
+	if (mp_threads_v.size() == 0)
+	{
+		SDL_DestroyMutex(mp_mutex);
+		SDL_DestroyCond(mp_jobCond);
+		SDL_DestroyCond(mp_decodedCond);
+		throw ConstructorException(__LINE__, __FILE__, string("Impossible de créer les threads de décodage : ") + SDL_GetError(), "PNGDecodingPool");
+	}
+}
+
+PNGDecodingPool::~PNGDecodingPool()
+{
+	SDL_LockMutex(mp_mutex);
+	m_stop = true;
+	SDL_CondBroadcast(mp_jobCond);
+	SDL_UnlockMutex(mp_mutex);
+
+	for (unsigned int i=0, size=mp_threads_v.size();i<size;i++)
+		SDL_WaitThread(mp_threads_v[i], 0);
+
+	for (unsigned int i=0, size=m_jobs_v.size();i<size;i++)
+	{
+		if (m_jobs_v[i].dt_t != 0)
+			delete [] m_jobs_v[i].dt_t;
+		if (m_jobs_v[i].p_image != 0)
+			delete m_jobs_v[i].p_image;
+	}
+
+	SDL_DestroyMutex(mp_mutex);
+	SDL_DestroyCond(mp_jobCond);
+	SDL_DestroyCond(mp_decodedCond);
+}
+
+void PNGDecodingPool::addImage(unsigned int key, char dt_t[], long length)
+{
+	Job job;
+	job.key = key;
+	job.dt_t = dt_t;
+	job.length = length;
+	job.p_image = 0;
+
+	SDL_LockMutex(mp_mutex);
+	m_jobs_v.push_back(job);
+	SDL_CondSignal(mp_jobCond);
+	SDL_UnlockMutex(mp_mutex);
+}
+
+bool PNGDecodingPool::nextImage(unsigned int& r_key, PNGToGLLoader*& rpn_image, bool wait)
+{
+	SDL_LockMutex(mp_mutex);
+	while (m_nextDecoded == m_decoded_v.size())
+	{
+		if (!wait || m_nextDecoded == m_jobs_v.size()) // rien à attendre
+		{
+			SDL_UnlockMutex(mp_mutex);
+			return false;
+		}
+		SDL_CondWait(mp_decodedCond, mp_mutex);
+	}
+
+	Job& r_job = m_jobs_v[m_decoded_v[m_nextDecoded]];
+	m_nextDecoded++;
+	r_key = r_job.key;
+	rpn_image = r_job.p_image;
+	r_job.p_image = 0;
+	string error = r_job.error;
+	SDL_UnlockMutex(mp_mutex);
+
+	if (rpn_image == 0)
+		throw PfException(__LINE__, __FILE__, string("Impossible de décoder l'image ") + itostr(r_key) + " : " + error);
+
+	return true;
+}
+
+unsigned int PNGDecodingPool::addedCount() const
+{
+	SDL_LockMutex(mp_mutex);
+	unsigned int count = m_jobs_v.size();
+	SDL_UnlockMutex(mp_mutex);
+
+	return count;
+}
+
+unsigned int PNGDecodingPool::decodedCount() const
+{
+	SDL_LockMutex(mp_mutex);
+	unsigned int count = m_decoded_v.size();
+	SDL_UnlockMutex(mp_mutex);
+
+	return count;
+}
+
+int PNGDecodingPool::decodingThread(void* p_pool)
+{
+	((PNGDecodingPool*) p_pool)->decodeImages();
+
+	return 0;
+}
+
+void PNGDecodingPool::decodeImages()
+{
+	unsigned int index;
+	char* dt_t;
+	long length;
+	PNGToGLLoader* p_image;
+	string error;
+
+	#ifdef PROFILING
+	Profiler::nameThread("PNGDecoding");
+	#endif
+
+	SDL_LockMutex(mp_mutex);
+	while (true)
+	{
+		while (!m_stop && m_nextJob == m_jobs_v.size())
+			SDL_CondWait(mp_jobCond, mp_mutex);
+		if (m_stop)
+			break;
+
+		index = m_nextJob;
+		m_nextJob++;
+		dt_t = m_jobs_v[index].dt_t;
+		length = m_jobs_v[index].length;
+		m_jobs_v[index].dt_t = 0;
+		SDL_UnlockMutex(mp_mutex);
+
+		// décodage hors du mutex, aucune exception ne doit quitter le thread
+		p_image = 0;
+		error.clear();
+		try
+		{
+			PROFILE_SCOPE("decodePNG");
+			PNGDataBuffer dataBuffer(dt_t, length); // détruit les octets
+			p_image = new PNGToGLLoader(dataBuffer);
+		}
+		catch (exception& e)
+		{
+			error = e.what();
+		}
+
+		SDL_LockMutex(mp_mutex);
+		m_jobs_v[index].p_image = p_image;
+		m_jobs_v[index].error = error;
+		m_decoded_v.push_back(index);
+		SDL_CondBroadcast(mp_decodedCond);
+	}
+	SDL_UnlockMutex(mp_mutex);
+}
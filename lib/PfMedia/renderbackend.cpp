@@ -0,0 +1,139 @@
+#include "renderbackend.h"
+
+#include "errors.h"
+#include "misc.h"
+#include "glfunc.h"
+#include "glimage.h"
+
+// GLRenderBackend
+
+void GLRenderBackend::beginFrame()
+{
+	clearGL();
+}
+
+void GLRenderBackend::draw(const GLImage& rc_glImage)
+{
+	drawGL(rc_glImage);
+}
+
+void GLRenderBackend::endFrame()
+{
+	drawTransition();
+	flushGL();
+	swapSDLBuffers();
+}
+
+// RecordingRenderBackend
+
+RecordingRenderBackend::RecordingRenderBackend(ostream* q_os) : mq_os(q_os), m_boundTextureIndex(0)
+{
+	FrameStats stats = {0, 0, 0, 0, 0, 0, 0.0};
+	m_current = stats;
+}
+
+void RecordingRenderBackend::writeStats(ostream& r_os, unsigned int index) const
+{
+	const FrameStats& rc_stats = frameStats(index);
+	r_os << "frame " << index << " : " << rc_stats.drawCalls << " draws, " << rc_stats.textureBinds << " binds, " << rc_stats.vertices << " vertices, "
+		<< rc_stats.matrixPushes << " push, " << rc_stats.staticImages << " static, " << rc_stats.rotatedImages << " rotated, overdraw "
+		<< rc_stats.coveredArea / Y_X_RATIO << "\n";
+}
+
+const RecordingRenderBackend::FrameStats& RecordingRenderBackend::frameStats(unsigned int index) const
+{
+	if (index >= m_frames_v.size())
+		throw ArgumentException(__LINE__, __FILE__, string("Indice non valide, l'indice doit être compris entre 0 et ") + itostr(m_frames_v.size()) + ".", "index",
+							"RecordingRenderBackend::frameStats");
+	return m_frames_v[index];
+}
+
+unsigned int RecordingRenderBackend::framesCount() const
+{
+	return m_frames_v.size();
+}
+
+void RecordingRenderBackend::clear()
+{
+	m_commands_v.clear();
+	m_frames_v.clear();
+	m_boundTextureIndex = 0;
+}
+
+void RecordingRenderBackend::beginFrame()
+{
+	FrameStats stats = {0, 0, 0, 0, 0, 0, 0.0};
+	m_current = stats;
+	m_commands_v.clear();
+	record(CLEAR);
+}
+
+void RecordingRenderBackend::draw(const GLImage& rc_glImage)
+{
+	if (!rc_glImage.isValid())
+		return;
+
+	bool rotated = (rc_glImage.getAngle() > 1.0 || rc_glImage.getAngle() < -1.0);
+	if (rc_glImage.isStatic())
+	{
+		record(PUSH_MATRIX);
+		m_current.staticImages++;
+	}
+	if (rotated)
+	{
+		record(PUSH_MATRIX);
+		m_current.rotatedImages++;
+	}
+	if (rc_glImage.isTextured() && rc_glImage.getTextureIndex() != m_boundTextureIndex)
+	{
+		m_boundTextureIndex = rc_glImage.getTextureIndex();
+		record(BIND, m_boundTextureIndex);
+	}
+	record(DRAW, rc_glImage.getTextureIndex(), rc_glImage.getVerticesCount());
+	PfRectangle rect = rc_glImage.boundingBox();
+	m_current.coveredArea += rect.getW() * rect.getH();
+	if (rc_glImage.isStatic())
+		record(POP_MATRIX);
+	if (rotated)
+		record(POP_MATRIX);
+}
+
+void RecordingRenderBackend::endFrame()
+{
+	if (g_transitionFrame > 0) // même rendu que la fonction drawTransition
+	{
+		record(PUSH_MATRIX);
+		record(DRAW, 0, 4);
+		record(POP_MATRIX);
+		m_current.staticImages++;
+		m_current.coveredArea += Y_X_RATIO;
+		g_transitionFrame = (g_transitionFrame == TRANSITION_FRAMES_COUNT)?0:g_transitionFrame+1;
+	}
+	record(PRESENT);
+
+	m_frames_v.push_back(m_current);
+	if (mq_os != 0)
+		writeStats(*mq_os, m_frames_v.size()-1);
+}
+
+void RecordingRenderBackend::record(CommandType type, unsigned int textureIndex, int verticesCount)
+{
+	Command command = {type, textureIndex, verticesCount};
+	m_commands_v.push_back(command);
+
+	switch (type)
+	{
+		case BIND:
+			m_current.textureBinds++;
+			break;
+		case DRAW:
+			m_current.drawCalls++;
+			m_current.vertices += verticesCount;
+			break;
+		case PUSH_MATRIX:
+			m_current.matrixPushes++;
+			break;
+		default:
+			break;
+	}
+}
@@ -0,0 +1,198 @@
+#include "textureatlas.h"
+
+#include <algorithm>
+#include "errors.h"
+#include "misc.h"
+#include "pngtoglloader.h"
+
+// image à ranger, avec sa position dans les pages une fois placée (coin inférieur gauche, marge comprise)
+struct AtlasPlacement
+{
+	unsigned int textureIndex;
+	PNGToGLLoader* q_image;
+	unsigned int page;
+	unsigned int x;
+	unsigned int y;
+};
+
+// ordre de rangement : de la plus haute à la plus basse, puis de la plus large à la plus étroite, puis par indice de texture
+static bool placementOrder(const AtlasPlacement& rc_a, const AtlasPlacement& rc_b)
+{
+	if (rc_a.q_image->getHeight() != rc_b.q_image->getHeight())
+		return rc_a.q_image->getHeight() > rc_b.q_image->getHeight();
+	if (rc_a.q_image->getWidth() != rc_b.q_image->getWidth())
+		return rc_a.q_image->getWidth() > rc_b.q_image->getWidth();
+	return rc_a.textureIndex < rc_b.textureIndex;
+}
+
+TextureAtlas::TextureAtlas(unsigned int size, unsigned int padding) : m_size(size), m_padding(padding) {}
+
+TextureAtlas::~TextureAtlas()
+{
+	for (map<unsigned int, PNGToGLLoader*>::iterator it=mpn_images_map.begin();it!=mpn_images_map.end();++it)
+		delete it->second;
+}
+
+bool TextureAtlas::addImage(unsigned int textureIndex, PNGToGLLoader* pn_image)
+{
+	if (pn_image->getWidth() == 0 || pn_image->getHeight() == 0
+		|| pn_image->getWidth() + 2*m_padding > m_size || pn_image->getHeight() + 2*m_padding > m_size)
+		return false;
+
+	if (m_regions_map.find(textureIndex) != m_regions_map.end() || mpn_images_map.find(textureIndex) != mpn_images_map.end())
+		delete pn_image;
+	else
+		mpn_images_map.insert(pair<unsigned int, PNGToGLLoader*>(textureIndex, pn_image));
+
+	return true;
+}
+
+void TextureAtlas::pack()
+{
+	if (mpn_images_map.empty())
+		return;
+
+	vector<AtlasPlacement> placements_v;
+	AtlasPlacement placement;
+	for (map<unsigned int, PNGToGLLoader*>::iterator it=mpn_images_map.begin();it!=mpn_images_map.end();++it)
+	{
+		placement.textureIndex = it->first;
+		placement.q_image = it->second;
+		placements_v.push_back(placement);
+	}
+	sort(placements_v.begin(), placements_v.end(), placementOrder);
+
+	// rangement par étagères, une nouvelle page étant commencée lorsque l'étagère suivante dépasse la page
+	vector<unsigned int> usedHeights_v(1, 0);
+	unsigned int page = m_pages_v.size(), shelfX = 0, shelfY = 0, shelfH = 0, w, h;
+	for (unsigned int i=0, size=placements_v.size();i<size;i++)
+	{
+		w = placements_v[i].q_image->getWidth() + 2*m_padding;
+		h = placements_v[i].q_image->getHeight() + 2*m_padding;
+		if (shelfX + w > m_size)
+		{
+			shelfY += shelfH;
+			shelfX = 0;
+			shelfH = 0;
+		}
+		if (shelfY + h > m_size)
+		{
+			page++;
+			usedHeights_v.push_back(0);
+			shelfX = 0;
+			shelfY = 0;
+			shelfH = 0;
+		}
+		placements_v[i].page = page;
+		placements_v[i].x = shelfX;
+		placements_v[i].y = shelfY;
+		shelfX += w;
+		shelfH = MAX(shelfH, h);
+		usedHeights_v.back() = shelfY + shelfH;
+	}
+
+	for (unsigned int i=0, size=usedHeights_v.size();i<size;i++)
+	{
+		unsigned int height = 1;
+		while (height < usedHeights_v[i])
+			height *= 2;
+		m_heights_v.push_back(height);
+		m_pages_v.push_back(vector<GLubyte>(4*m_size*height, 0));
+	}
+
+	for (unsigned int i=0, size=placements_v.size();i<size;i++)
+	{
+		const AtlasPlacement& rc_pl = placements_v[i];
+		unsigned int height = m_heights_v[rc_pl.page];
+		copyImage(*(rc_pl.q_image), m_pages_v[rc_pl.page], height, rc_pl.x, rc_pl.y);
+		m_regions_map[rc_pl.textureIndex] = pair<unsigned int, PfRectangle>(rc_pl.page,
+																			   PfRectangle((float) (rc_pl.x + m_padding)/m_size,
+																						   (float) (rc_pl.y + m_padding)/height,
+																						   (float) rc_pl.q_image->getWidth()/m_size,
+																						   (float) rc_pl.q_image->getHeight()/height));
+		delete rc_pl.q_image;
+	}
+	mpn_images_map.clear();
+}
+
+bool TextureAtlas::region(unsigned int textureIndex, unsigned int& r_page, PfRectangle& r_rect) const
+{
+	map<unsigned int, pair<unsigned int, PfRectangle> >::const_iterator it = m_regions_map.find(textureIndex);
+	if (it == m_regions_map.end())
+		return false;
+
+	r_page = it->second.first;
+	r_rect = it->second.second;
+
+	return true;
+}
+
+unsigned int TextureAtlas::pagesCount() const
+{
+	return m_heights_v.size();
+}
+
+unsigned int TextureAtlas::pageHeight(unsigned int page) const
+{
+	if (page >= m_heights_v.size())
+		throw ArgumentException(__LINE__, __FILE__, string("Indice de page non valide : ") + itostr(page) + ".", "page", "TextureAtlas::pageHeight");
+
+	return m_heights_v[page];
+}
+
+const GLubyte* TextureAtlas::pageTexels(unsigned int page) const
+{
+	if (page >= m_pages_v.size() || m_pages_v[page].empty())
+		throw ArgumentException(__LINE__, __FILE__, string("Indice de page non valide ou page libérée : ") + itostr(page) + ".", "page", "TextureAtlas::pageTexels");
+
+	return &(m_pages_v[page][0]);
+}
+
+void TextureAtlas::releaseTexels()
+{
+	for (unsigned int i=0, size=m_pages_v.size();i<size;i++)
+		vector<GLubyte>().swap(m_pages_v[i]);
+}
+
+void TextureAtlas::copyImage(const PNGToGLLoader& rc_image, vector<GLubyte>& r_texels_v, unsigned int height, unsigned int x, unsigned int y) const
+{
+	unsigned int w = rc_image.getWidth(), h = rc_image.getHeight(), bpp = rc_image.getInternalFormat();
+	const GLubyte* q_texels = rc_image.getTexels();
+	const GLubyte* q_src;
+	GLubyte* p_dst;
+	int sx, sy;
+
+	for (unsigned int dy=0;dy<h+2*m_padding && y+dy<height;dy++)
+	{
+		sy = MIN(MAX((int) dy - (int) m_padding, 0), (int) h - 1); // les marges recopient les bords de l'image
+		for (unsigned int dx=0;dx<w+2*m_padding;dx++)
+		{
+			sx = MIN(MAX((int) dx - (int) m_padding, 0), (int) w - 1);
+			q_src = q_texels + (sy*w + sx)*bpp;
+			p_dst = &(r_texels_v[((y+dy)*m_size + x+dx)*4]);
+			switch (bpp)
+			{
+				case 1:
+					p_dst[0] = p_dst[1] = p_dst[2] = q_src[0];
+					p_dst[3] = 255;
+					break;
+				case 2:
+					p_dst[0] = p_dst[1] = p_dst[2] = q_src[0];
+					p_dst[3] = q_src[1];
+					break;
+				case 3:
+					p_dst[0] = q_src[0];
+					p_dst[1] = q_src[1];
+					p_dst[2] = q_src[2];
+					p_dst[3] = 255;
+					break;
+				default:
+					p_dst[0] = q_src[0];
+					p_dst[1] = q_src[1];
+					p_dst[2] = q_src[2];
+					p_dst[3] = q_src[3];
+					break;
+			}
+		}
+	}
+}
@@ -0,0 +1,95 @@
+#include "binaryreader.h"
+
+#include <cstring>
+
+BinaryReader::BinaryReader(istream& r_is, unsigned int bufferSize) :
+    mr_is(r_is), m_buffer_v(MAX(bufferSize, 1)), m_begin(0), m_end(0), m_fail(false), m_eof(false) {}
+
+void BinaryReader::read(char* p_dest, unsigned int size)
+{
+    unsigned int count;
+    while (size > 0)
+    {
+        if (m_begin == m_end && size >= m_buffer_v.size()) // grande lecture faite directement vers la destination
+        {
+            mr_is.read(p_dest, size);
+            if ((unsigned int) mr_is.gcount() < size)
+            {
+                m_fail = true;
+                m_eof = true;
+            }
+            return;
+        }
+        if (!fill())
+        {
+            m_fail = true;
+            m_eof = true;
+            return;
+        }
+        count = MIN(size, m_end - m_begin);
+        memcpy(p_dest, &(m_buffer_v[m_begin]), count);
+        m_begin += count;
+        p_dest += count;
+        size -= count;
+    }
+}
+
+string BinaryReader::readString(char delim)
+{
+    string rtn_str;
+    const char* q_begin;
+    const char* q_end;
+    while (fill())
+    {
+        q_begin = &(m_buffer_v[m_begin]);
+        q_end = (const char*) memchr(q_begin, '\0', m_end - m_begin);
+        if (delim != '\0')
+        {
+            const char* q_delim = (const char*) memchr(q_begin, delim, ((q_end == 0)?(&(m_buffer_v[0]) + m_end):q_end) - q_begin);
+            if (q_delim != 0)
+                q_end = q_delim;
+        }
+        if (q_end != 0)
+        {
+            rtn_str.append(q_begin, q_end - q_begin);
+            m_begin += (q_end - q_begin) + 1;
+            return rtn_str;
+        }
+        rtn_str.append(q_begin, m_end - m_begin);
+        m_begin = m_end;
+    }
+    m_fail = true;
+    m_eof = true;
+
+    return rtn_str;
+}
+
+void BinaryReader::skip(unsigned int size)
+{
+    unsigned int count = MIN(size, m_end - m_begin);
+    m_begin += count;
+    size -= count;
+    if (size > 0)
+    {
+        mr_is.seekg(size, ios::cur);
+        if (mr_is.fail())
+        {
+            m_fail = true;
+            m_eof = true;
+        }
+    }
+}
+
+bool BinaryReader::fill()
+{
+    if (m_begin < m_end)
+        return true;
+    if (!mr_is.good()) // le bloc précédent a atteint la fin du flux
+        return false;
+
+    mr_is.read(&(m_buffer_v[0]), m_buffer_v.size());
+    m_begin = 0;
+    m_end = (unsigned int) mr_is.gcount();
+
+    return (m_end > 0);
+}
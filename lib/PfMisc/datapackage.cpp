@@ -2,28 +2,33 @@
 
 #include "misc.h"
 #include "errors.h"
+#include "mappedfile.h"
 
-DataPackage::DataPackage() : m_intIndex(0), m_uintIndex(0), m_charIndex(0), m_ucharIndex(0), m_floatIndex(0), m_doubleIndex(0), m_stringIndex(0), m_enumIndex(0), m_over(false) {}
+DataPackage::DataPackage() : m_intIndex(0), m_uintIndex(0), m_charIndex(0), m_ucharIndex(0), m_floatIndex(0), m_doubleIndex(0), m_stringIndex(0), m_enumIndex(0), m_over(false),
+    mq_data(0), m_dataSize(0), m_intOffset(0), m_uintOffset(0), m_charOffset(0), m_ucharOffset(0), m_floatOffset(0), m_doubleOffset(0), m_stringOffset(0), m_enumOffset(0) {}
 
 DataPackage::DataPackage(ifstream& r_ifs, unsigned int dataCount) :
-    m_intIndex(0), m_uintIndex(0), m_charIndex(0), m_ucharIndex(0), m_floatIndex(0), m_doubleIndex(0), m_stringIndex(0), m_enumIndex(0), m_over(false)
+    m_intIndex(0), m_uintIndex(0), m_charIndex(0), m_ucharIndex(0), m_floatIndex(0), m_doubleIndex(0), m_stringIndex(0), m_enumIndex(0), m_over(false),
+    mq_data(0), m_dataSize(0), m_intOffset(0), m_uintOffset(0), m_charOffset(0), m_ucharOffset(0), m_floatOffset(0), m_doubleOffset(0), m_stringOffset(0), m_enumOffset(0)
 {
     try
     {
         DataType type;
         int intV, enumV;
         unsigned int uintV;
-        char charV, tmp;
+        char charV;
         unsigned char ucharV;
         float floatV;
         double doubleV;
-        string strV;
         unsigned int i = 0;
         int ignoreCount = 0;
         do
         {
-            for (;ignoreCount>0;ignoreCount--)
-                r_ifs.read(&tmp, sizeof(char));
+            if (ignoreCount > 0)
+            {
+                r_ifs.seekg(ignoreCount, ios::cur);
+                ignoreCount = 0;
+            }
 
             r_ifs.read((char*) &type, sizeof(DataType));
             switch (type)
@@ -55,15 +60,7 @@ DataPackage::DataPackage(ifstream& r_ifs, unsigned int dataCount) :
                     m_double_v.push_back(doubleV);
                     break;
                 case DT_STRING:
-                    strV.clear();
-                    do
-                    {
-                        r_ifs.read(&tmp, sizeof(char));
-                        if (tmp != '\0')
-                            strV += tmp;
-                    }
-                    while (r_ifs.good() && tmp != '\0');
-                    m_string_v.push_back(strV);
+                    m_string_v.push_back(readString(r_ifs));
                     break;
                 case DT_ENUM:
                     r_ifs.read((char*) &enumV, sizeof(int));
@@ -92,19 +89,75 @@ DataPackage::DataPackage(ifstream& r_ifs, unsigned int dataCount) :
     }
 }
 
-int DataPackage::nextInt()
+DataPackage::DataPackage(MappedFile& r_file, unsigned int dataCount) :
+    m_intIndex(0), m_uintIndex(0), m_charIndex(0), m_ucharIndex(0), m_floatIndex(0), m_doubleIndex(0), m_stringIndex(0), m_enumIndex(0), m_over(false),
+    mq_data(0), m_dataSize(0), m_intOffset(0), m_uintOffset(0), m_charOffset(0), m_ucharOffset(0), m_floatOffset(0), m_doubleOffset(0), m_stringOffset(0), m_enumOffset(0)
 {
-    int x = 0;
+    try
+    {
+        // les données sont seulement parcourues pour trouver leur fin et vérifier leur validité, les valeurs seront lues en place
+        const char* q_begin = r_file.current();
+        unsigned int size = r_file.remaining(), offset = 0, valSize;
+        DataType type = DT_END;
+        unsigned int i = 0;
+        do
+        {
+            if (size - offset < sizeof(DataType))
+                break;
+            memcpy(&type, q_begin + offset, sizeof(DataType));
+            offset += sizeof(DataType);
+            switch (type)
+            {
+                case DT_END:
+                case DT_INT:
+                case DT_UINT:
+                case DT_CHAR:
+                case DT_UCHAR:
+                case DT_FLOAT:
+                case DT_DOUBLE:
+                case DT_ENUM:
+                    valSize = valueSize(type, q_begin + offset);
+                    break;
+                case DT_STRING:
+                    if (memchr(q_begin + offset, '\0', size - offset) == 0)
+                        throw PfException(__LINE__, __FILE__, "Erreur de lecture, chaîne de caractères non terminée.");
+                    valSize = valueSize(type, q_begin + offset);
+                    break;
+                case DT_IGNORE:
+                    if (size - offset < sizeof(int))
+                        throw PfException(__LINE__, __FILE__, "Erreur de lecture, valeur DT_IGNORE incomplète.");
+                    valSize = valueSize(type, q_begin + offset);
+                    break;
+                default:
+                    throw PfException(__LINE__, __FILE__, "Type de données non valide.");
+            }
+            if (valSize > size - offset)
+                break;
+            offset += valSize;
+            i++;
+        } while (i < dataCount || (dataCount == 0 && type != DT_END));
 
-    if (m_intIndex < m_int_v.size())
+        if (i < dataCount || (dataCount == 0 && type != DT_END) || i == 0)
+        {
+            if (dataCount > 0)
+                throw PfException(__LINE__, __FILE__, string("Erreur de lecture, seulement ") + itostr(i) + " valeurs trouvées sur " + itostr(dataCount) + ".");
+            else
+                throw PfException(__LINE__, __FILE__, string("Erreur de lecture, valeur DT_END non trouvée."));
+        }
+
+        mq_data = q_begin;
+        m_dataSize = offset;
+        r_file.skip(offset);
+    }
+    catch (PfException& e)
     {
-        x = m_int_v[m_intIndex];
-        m_intIndex++;
+        throw ConstructorException(__LINE__, __FILE__, "Données non valides.", "DataPackage", e);
     }
-    else
-        m_over = true;
+}
 
-    return x;
+int DataPackage::nextInt()
+{
+    return nextValue<int>(DT_INT, m_intOffset, m_int_v, m_intIndex);
 }
 
 void DataPackage::addInt(int val)
@@ -114,17 +167,7 @@ void DataPackage::addInt(int val)
 
 unsigned int DataPackage::nextUInt()
 {
-    unsigned int x = 0;
-
-    if (m_uintIndex < m_uint_v.size())
-    {
-        x =  m_uint_v[m_uintIndex];
-        m_uintIndex++;
-    }
-    else
-        m_over = true;
-
-    return x;
+    return nextValue<unsigned int>(DT_UINT, m_uintOffset, m_uint_v, m_uintIndex);
 }
 
 void DataPackage::addUInt(unsigned int val)
@@ -134,17 +177,7 @@ void DataPackage::addUInt(unsigned int val)
 
 char DataPackage::nextChar()
 {
-    char x = 0;
-
-    if (m_charIndex < m_char_v.size())
-    {
-        x = m_char_v[m_charIndex];
-        m_charIndex++;
-    }
-    else
-        m_over = true;
-
-    return x;
+    return nextValue<char>(DT_CHAR, m_charOffset, m_char_v, m_charIndex);
 }
 
 void DataPackage::addChar(char val)
@@ -154,17 +187,7 @@ void DataPackage::addChar(char val)
 
 unsigned char DataPackage::nextUChar()
 {
-    unsigned char x = 0;
-
-    if (m_ucharIndex < m_uchar_v.size())
-    {
-        x = m_uchar_v[m_ucharIndex];
-        m_ucharIndex++;
-    }
-    else
-        m_over = true;
-
-    return x;
+    return nextValue<unsigned char>(DT_UCHAR, m_ucharOffset, m_uchar_v, m_ucharIndex);
 }
 
 void DataPackage::addUChar(unsigned char val)
@@ -174,17 +197,7 @@ void DataPackage::addUChar(unsigned char val)
 
 float DataPackage::nextFloat()
 {
-    float x = 0.0;
-
-    if (m_floatIndex < m_float_v.size())
-    {
-        x = m_float_v[m_floatIndex];
-        m_floatIndex++;
-    }
-    else
-        m_over = true;
-
-    return x;
+    return nextValue<float>(DT_FLOAT, m_floatOffset, m_float_v, m_floatIndex);
 }
 
 void DataPackage::addFloat(float val)
@@ -194,17 +207,7 @@ void DataPackage::addFloat(float val)
 
 double DataPackage::nextDouble()
 {
-    double x = 0.0;
-
-    if (m_doubleIndex < m_double_v.size())
-    {
-        x = m_double_v[m_doubleIndex];
-        m_doubleIndex++;
-    }
-    else
-        m_over = true;
-
-    return x;
+    return nextValue<double>(DT_DOUBLE, m_doubleOffset, m_double_v, m_doubleIndex);
 }
 
 void DataPackage::addDouble(double val)
@@ -215,8 +218,11 @@ void DataPackage::addDouble(double val)
 string DataPackage::nextString()
 {
     string x_str;
+    const char* q_value;
 
-    if (m_stringIndex < m_string_v.size())
+    if (mq_data != 0 && nextMapped(DT_STRING, m_stringOffset, q_value))
+        x_str = q_value;
+    else if (m_stringIndex < m_string_v.size())
     {
         x_str = m_string_v[m_stringIndex];
         m_stringIndex++;
@@ -227,24 +233,31 @@ string DataPackage::nextString()
     return x_str;
 }
 
-void DataPackage::addString(const string& val)
-{
-    m_string_v.push_back(val);
-}
-
-int DataPackage::nextEnum()
+const char* DataPackage::nextCString()
 {
-    int x = 0;
+    const char* q_value = "";
 
-    if (m_enumIndex < m_enum_v.size())
+    if (mq_data != 0 && nextMapped(DT_STRING, m_stringOffset, q_value))
+        return q_value;
+    if (m_stringIndex < m_string_v.size())
     {
-        x = m_enum_v[m_enumIndex];
-        m_enumIndex++;
+        q_value = m_string_v[m_stringIndex].c_str();
+        m_stringIndex++;
     }
     else
         m_over = true;
 
-    return x;
+    return q_value;
+}
+
+void DataPackage::addString(const string& val)
+{
+    m_string_v.push_back(val);
+}
+
+int DataPackage::nextEnum()
+{
+    return nextValue<int>(DT_ENUM, m_enumOffset, m_enum_v, m_enumIndex);
 }
 
 void DataPackage::addEnum(int val)
@@ -262,4 +275,55 @@ void DataPackage::clear()
     m_double_v.clear();
     m_string_v.clear();
     m_enum_v.clear();
+    mq_data = 0;
+    m_dataSize = 0;
+}
+
+unsigned int DataPackage::valueSize(DataType type, const char* q_value)
+{
+    int ignoreCount;
+
+    switch (type)
+    {
+        case DT_INT:
+        case DT_ENUM:
+            return sizeof(int);
+        case DT_UINT:
+            return sizeof(unsigned int);
+        case DT_CHAR:
+            return sizeof(char);
+        case DT_UCHAR:
+            return sizeof(unsigned char);
+        case DT_FLOAT:
+            return sizeof(float);
+        case DT_DOUBLE:
+            return sizeof(double);
+        case DT_STRING:
+            return strlen(q_value) + 1;
+        case DT_IGNORE:
+            memcpy(&ignoreCount, q_value, sizeof(int));
+            return sizeof(int) + MAX(0, ignoreCount);
+        default:
+            return 0;
+    }
+}
+
+bool DataPackage::nextMapped(DataType type, unsigned int& r_offset, const char*& rq_value) const
+{
+    DataType entryType;
+    const char* q_value;
+
+    while (r_offset < m_dataSize)
+    {
+        memcpy(&entryType, mq_data + r_offset, sizeof(DataType));
+        q_value = mq_data + r_offset + sizeof(DataType);
+        r_offset += sizeof(DataType) + valueSize(entryType, q_value);
+        if (entryType == type)
+        {
+            rq_value = q_value;
+            return true;
+        }
+    }
+
+    return false;
 }
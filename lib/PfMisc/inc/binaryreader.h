@@ -0,0 +1,107 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe BinaryReader.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef BINARYREADER_H_INCLUDED
+#define BINARYREADER_H_INCLUDED
+
+#include "misc_gen.h"
+
+#include <istream>
+#include <string>
+#include <vector>
+#include "noncopyable.h"
+
+/**
+* @brief Lecture bufferisée d'un flux binaire.
+*
+* Les octets du flux sont lus par blocs de taille BinaryReader::m_buffer_v, puis distribués depuis ce tampon.
+* Une valeur de quelques octets est ainsi copiée depuis la mémoire sans appel au flux,
+* et une chaîne de caractères est recherchée dans le tampon au moyen de <em>memchr</em> plutôt que lue caractère par caractère.
+* Une lecture plus grande que le tampon est faite directement depuis le flux vers la destination.
+*
+* L'interface reprend celle d'un flux en lecture (BinaryReader::read, BinaryReader::good, BinaryReader::fail),
+* de sorte qu'un code lisant un <em>ifstream</em> puisse lire un BinaryReader sans autre modification.
+* Comme pour un flux, une lecture dépassant la fin du fichier marque ce lecteur en échec et en fin de fichier.
+*
+* @warning
+* Le flux lu est avancé par blocs : sa position ne correspond pas à celle de ce lecteur,
+* et il ne doit pas être lu directement tant que ce lecteur est utilisé.
+*/
+class BinaryReader : private NonCopyable
+{
+public:
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur BinaryReader.
+    * @param r_is Le flux à lire, prépositionné.
+    * @param bufferSize La taille du tampon, en octets.
+    */
+    explicit BinaryReader(istream& r_is, unsigned int bufferSize = BINARY_BUFFER_SIZE);
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Copie des octets du flux, puis avance la position de lecture.
+    * @param p_dest La destination.
+    * @param size Le nombre d'octets à copier.
+    *
+    * Si le flux ne présente pas suffisamment d'octets, les octets disponibles sont copiés et ce lecteur est marqué en échec.
+    */
+    void read(char* p_dest, unsigned int size);
+    /**
+    * @brief Lit une chaîne de caractères jusqu'à trouver le premier '\0' ou un délimiteur, puis avance la position de lecture après celui-ci.
+    * @param delim Un caractère de fin de chaîne servant de délimitation, en plus de '\0'.
+    * @return La chaîne lue, délimiteur non inclus.
+    *
+    * Equivalent de la fonction <em>readString</em> (fichier "misc.h") pour un BinaryReader.
+    * Si la fin du flux est atteinte avant un délimiteur, la chaîne lue jusque là est retournée et ce lecteur est marqué en échec.
+    */
+    string readString(char delim = '\0');
+    /**
+    * @brief Avance la position de lecture.
+    * @param size Le nombre d'octets à passer.
+    *
+    * Si le flux ne présente pas suffisamment d'octets, ce lecteur est marqué en échec.
+    */
+    void skip(unsigned int size);
+    /**
+    * @brief Indique si ce lecteur n'est ni en échec ni en fin de fichier.
+    * @return <code>true</code> si la lecture peut se poursuivre.
+    */
+    bool good() const {return !m_fail && !m_eof;}
+    /**
+    * @brief Indique si une lecture a échoué.
+    * @return <code>true</code> si une lecture a échoué.
+    */
+    bool fail() const {return m_fail;}
+    /**
+    * @brief Indique si la fin du flux a été atteinte.
+    * @return <code>true</code> si la fin du flux a été atteinte.
+    */
+    bool eof() const {return m_eof;}
+
+private:
+    /**
+    * @brief Remplit le tampon à partir du flux, lorsqu'il a été entièrement lu.
+    * @return <code>false</code> si le flux ne présente plus aucun octet.
+    */
+    bool fill();
+
+    istream& mr_is; //!< Le flux lu.
+    vector<char> m_buffer_v; //!< Le tampon.
+    unsigned int m_begin; //!< L'indice du prochain octet à lire dans le tampon.
+    unsigned int m_end; //!< L'indice suivant le dernier octet valide du tampon.
+    bool m_fail; //!< Indique si une lecture a échoué.
+    bool m_eof; //!< Indique si la fin du flux a été atteinte.
+};
+
+#endif // BINARYREADER_H_INCLUDED
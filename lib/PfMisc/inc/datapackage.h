@@ -13,6 +13,7 @@
 
 #include <vector>
 #include <fstream>
+#include <cstring>
 
 #define WRITE_INT(a, b) DataPackage::writeValue<int>(a, b, DataPackage::DT_INT) //!< Macro simplifiant l'appel à DataPackage::writeValue.
 #define WRITE_UINT(a, b) DataPackage::writeValue<unsigned int>(a, b, DataPackage::DT_UINT) //!< Macro simplifiant l'appel à DataPackage::writeValue.
@@ -24,6 +25,8 @@
 #define WRITE_ENUM(a, b) DataPackage::writeValue<int>(a, b, DataPackage::DT_ENUM) //!< Macro simplifiant l'appel à DataPackage::writeValue.
 #define WRITE_END(a) DataPackage::writeEnd(a) //!< Lien vers DataPackage::writeEnd pour cohérence.
 
+class MappedFile;
+
 /**
 * @brief Groupe de données.
 *
@@ -48,6 +51,14 @@
 * Cela ne se fait que si une demande de lecture conduit au retour d'une valeur par défaut suite à épuisement de la liste.
 *
 * La valeur DT_END de DataPackage::DataType permet d'indiquer à une méthode lisant un DataPackage que la lecture est finie.
+*
+* <b>Lecture en place</b>
+*
+* Un DataPackage construit à partir d'un MappedFile ne copie pas les valeurs dans ses listes : il parcourt directement les données projetées en mémoire.
+* Un indice de lecture en octets est conservé par type (DataPackage::m_intOffset par exemple), chaque méthode de lecture cherchant la valeur suivante
+* de son type à partir de cet indice. Les chaînes de caractères peuvent être lues sans copie grâce à DataPackage::nextCString.
+*
+* Une fois les données projetées épuisées pour un type, la lecture se poursuit dans la liste correspondante, alimentée par les méthodes d'ajout.
 */
 class DataPackage
 {
@@ -136,6 +147,21 @@ public:
     * Le flux doit être ouvert en binaire.
     */
     DataPackage(ifstream& r_ifs, unsigned int dataCount = 0);
+    /**
+    * @brief Constructeur DataPackage 2.
+    * @param r_file Le fichier projeté contenant les données, lues à partir de son indice de lecture.
+    * @param dataCount Le nombre de valeurs à lire, 0 indique une lecture complète jusqu'à DT_END.
+    * @throw ConstructorException si un nombre insuffisant de valeurs est lu ou si des données sont invalides.
+    *
+    * Les données ont le même format que pour le constructeur DataPackage 1.
+    * Elles sont seulement vérifiées, sans être copiées : les valeurs sont lues en place lors des appels aux méthodes de lecture.
+    *
+    * L'indice de lecture du fichier est placé après les données lues, comme le flux du constructeur DataPackage 1.
+    *
+    * @warning
+    * Le fichier doit exister tant que ce DataPackage (ou une de ses copies) est lu.
+    */
+    DataPackage(MappedFile& r_file, unsigned int dataCount = 0);
     /*
     * Méthodes
     * --------
@@ -206,6 +232,14 @@ public:
     */
     string nextString();
     /**
+    * @brief Retourne la première chaîne de caractères non lue, sans copie.
+    * @return La chaîne, terminée par '\0', chaîne vide si toutes les chaînes ont été lues.
+    *
+    * Pour un DataPackage lu en place, le pointeur retourné désigne directement les données du fichier projeté.
+    * Sinon, il désigne une chaîne de la liste DataPackage::m_string_v, et n'est plus valide après un ajout ou un appel à DataPackage::clear.
+    */
+    const char* nextCString();
+    /**
     * @brief Ajoute une valeur de ce type à cette structure.
     * @param val La valeur à ajouter.
     */
@@ -223,6 +257,8 @@ public:
     /**
     * @brief Efface toutes les valeurs de ce DataPackage.
     *
+    * Un DataPackage lu en place ne fait plus référence à son fichier.
+    *
     * @warning
     * La valeur du booléen DataPackage::m_over est inchangée.
     */
@@ -234,6 +270,48 @@ public:
     bool isOver() const {return m_over;} //!< Accesseur.
 
 private:
+    /**
+    * @brief Retourne la taille d'une valeur de données lue en place.
+    * @param type Le type de la valeur.
+    * @param q_value Le début de la valeur, après son type.
+    * @return La taille en octets, y compris le '\0' final d'une chaîne et les octets à sauter d'une valeur DT_IGNORE.
+    */
+    static unsigned int valueSize(DataType type, const char* q_value);
+    /**
+    * @brief Cherche la prochaine valeur d'un type dans les données lues en place.
+    * @param type Le type recherché.
+    * @param r_offset L'indice de lecture de ce type, placé après la valeur trouvée.
+    * @param rq_value Le début de la valeur trouvée, à remplir.
+    * @return <code>false</code> si aucune valeur de ce type ne reste à lire.
+    */
+    bool nextMapped(DataType type, unsigned int& r_offset, const char*& rq_value) const;
+    /**
+    * @brief Retourne la première valeur non lue d'un type, lue en place puis dans la liste correspondante.
+    * @param type Le type de la valeur.
+    * @param r_offset L'indice de lecture en place de ce type.
+    * @param rc_values_v La liste de ce type.
+    * @param r_index L'indice de lecture de la liste.
+    * @return La valeur, 0 si toutes les valeurs ont été lues.
+    */
+    template<class T>
+    T nextValue(DataType type, unsigned int& r_offset, const vector<T>& rc_values_v, unsigned int& r_index)
+    {
+        T x = 0;
+        const char* q_value;
+
+        if (mq_data != 0 && nextMapped(type, r_offset, q_value))
+            memcpy(&x, q_value, sizeof(T));
+        else if (r_index < rc_values_v.size())
+        {
+            x = rc_values_v[r_index];
+            r_index++;
+        }
+        else
+            m_over = true;
+
+        return x;
+    }
+
     vector<int> m_int_v; //!< La liste d'int.
     unsigned int m_intIndex; //!< L'indice de lecture des int.
     vector<unsigned int> m_uint_v; //!< La liste d'unsigned int.
@@ -251,6 +329,16 @@ private:
     vector<int> m_enum_v; //!< La liste d'enum.
     unsigned int m_enumIndex; //!< L'indice de lecture des enum.
     bool m_over; //!< Indique si une liste a été épuisée.
+    const char* mq_data; //!< Les données lues en place, dans un MappedFile, 0 si aucune.
+    unsigned int m_dataSize; //!< La taille en octets des données lues en place.
+    unsigned int m_intOffset; //!< L'indice de lecture en place des int.
+    unsigned int m_uintOffset; //!< L'indice de lecture en place des unsigned int.
+    unsigned int m_charOffset; //!< L'indice de lecture en place des char.
+    unsigned int m_ucharOffset; //!< L'indice de lecture en place des unsigned char.
+    unsigned int m_floatOffset; //!< L'indice de lecture en place des float.
+    unsigned int m_doubleOffset; //!< L'indice de lecture en place des double.
+    unsigned int m_stringOffset; //!< L'indice de lecture en place des string.
+    unsigned int m_enumOffset; //!< L'indice de lecture en place des enum.
 };
 
 #endif // DATAPACKAGE_H_INCLUDED
@@ -8,6 +8,10 @@
 * Chacune de ces énumérations est accompagnée d'une fonction associant une chaîne de caractères (string) à ses valeurs.
 * Cette fonction, pour chaque énumération, est appelée <em>textFrom</em>.
 *
+* Les textes de chaque énumération sont déclarés une seule fois, dans une spécialisation de la structure EnumTexts.
+* La classe EnumText en tire les chaînes retournées par <em>textFrom</em>, construites une seule fois,
+* ainsi que la recherche inverse d'une valeur à partir de son texte (fonction <em>enumFrom</em>).
+*
 * Chacune de ces énumérations est accompagnée d'une macro ENUM_[NOM_D_ENUMERATION]_COUNT contenant le nombre d'éléments dans l'énumération.
 */
 
@@ -16,7 +20,104 @@
 
 #include "misc_gen.h"
 
+#include <map>
 #include <string>
+#include <vector>
+
+/**
+* @brief Table des textes d'une énumération, à spécialiser pour chaque énumération.
+*
+* Une spécialisation définit :
+* <ul><li>COUNT : le nombre de valeurs de l'énumération,</li>
+* <li>FLAGS : 1 si les valeurs sont des flags (0, puis 0x1, 0x2, 0x4...), 0 si elles se suivent à partir de 0,</li>
+* <li>la fonction statique <em>at</em>, retournant le texte de la valeur d'indice donné.</li></ul>
+*
+* L'indice d'une valeur est la valeur elle-même, ou pour des flags, 0 pour la valeur nulle puis 1 + la position du bit.
+*/
+template<class E>
+struct EnumTexts;
+
+/**
+* @brief Conversion entre les valeurs d'une énumération et leurs textes, d'après la table EnumTexts de l'énumération.
+*
+* Les chaînes sont construites au premier appel et conservées : la conversion d'une valeur en texte ne fait aucune allocation.
+* La recherche inverse utilise une map construite de même.
+*/
+template<class E>
+class EnumText
+{
+public:
+    /**
+    * @brief Retourne l'indice d'une valeur dans la table des textes.
+    * @param value La valeur.
+    * @return L'indice, EnumTexts::COUNT si la valeur n'est pas valide.
+    */
+    static unsigned int index(E value)
+    {
+        unsigned int v = (unsigned int) value;
+        if (!EnumTexts<E>::FLAGS)
+            return MIN(v, (unsigned int) EnumTexts<E>::COUNT);
+        if (v == 0)
+            return 0;
+        unsigned int i = 1;
+        while (v != 1 && (v & 1) == 0)
+        {
+            v >>= 1;
+            i++;
+        }
+        return (v == 1)?MIN(i, (unsigned int) EnumTexts<E>::COUNT):EnumTexts<E>::COUNT;
+    }
+    /**
+    * @brief Retourne le texte d'une valeur.
+    * @param value La valeur.
+    * @return Le texte, vide si la valeur n'est pas valide.
+    */
+    static const string& text(E value)
+    {
+        static vector<string> s_texts_v;
+        if (s_texts_v.empty())
+        {
+            for (unsigned int i=0;i<EnumTexts<E>::COUNT;i++)
+                s_texts_v.push_back(EnumTexts<E>::at(i));
+            s_texts_v.push_back(""); // valeur non valide
+        }
+        return s_texts_v[index(value)];
+    }
+    /**
+    * @brief Recherche la valeur associée à un texte.
+    * @param text Le texte.
+    * @param r_value La valeur, à remplir.
+    * @return <code>false</code> si aucune valeur n'est associée à ce texte.
+    *
+    * Si plusieurs valeurs partagent le même texte, la première est retenue.
+    */
+    static bool value(const string& text, E& r_value)
+    {
+        static map<string, E> s_values_map;
+        if (s_values_map.empty())
+        {
+            for (unsigned int i=0;i<EnumTexts<E>::COUNT;i++)
+                s_values_map.insert(pair<string, E>(EnumTexts<E>::at(i), (E) ((EnumTexts<E>::FLAGS && i > 0)?(1 << (i-1)):i)));
+        }
+        typename map<string, E>::const_iterator it = s_values_map.find(text);
+        if (it == s_values_map.end())
+            return false;
+        r_value = it->second;
+        return true;
+    }
+};
+
+/**
+* @brief Recherche la valeur d'une énumération associée à un texte, réciproque de <em>textFrom</em>.
+* @param text Le texte.
+* @param r_value La valeur, à remplir.
+* @return <code>false</code> si aucune valeur n'est associée à ce texte, auquel cas <em>r_value</em> est inchangée.
+*/
+template<class E>
+inline bool enumFrom(const string& text, E& r_value)
+{
+    return EnumText<E>::value(text, r_value);
+}
 
 /**
 * @brief Enumération des différents codes de retour de fonctions ou méthodes.
@@ -46,6 +147,20 @@ enum PfReturnCode
 };
 #define ENUM_PF_RETURN_CODE_COUNT 13 //!< Le nombre de valeurs pour l'énumération PfReturnCode.
 
+/**
+* @brief Table des textes de l'énumération PfReturnCode, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfReturnCode>
+{
+    enum {COUNT = ENUM_PF_RETURN_CODE_COUNT, FLAGS = 1};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"NULL", "NULL", "NULL", "NULL", "NULL", "NULL", "NULL", "NULL", "NULL", "OK", "FAIL", "NOTHING", "EMPTY"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant un code de retour.
 * @param code Le code de retour.
@@ -55,38 +170,9 @@ enum PfReturnCode
 *
 * Pour les 8 premières valeurs suivant RETURN_NULL, 'NULL' est également retourné.
 */
-inline string textFrom(PfReturnCode code)
+inline const string& textFrom(PfReturnCode code)
 {
-    string x_str;
-
-    switch (code)
-    {
-        case RETURN_NULL:
-        case RETURN_VALUE1:
-        case RETURN_VALUE2:
-        case RETURN_VALUE3:
-        case RETURN_VALUE4:
-        case RETURN_VALUE5:
-        case RETURN_VALUE6:
-        case RETURN_VALUE7:
-        case RETURN_VALUE8:
-            x_str = "NULL";
-            break;
-        case RETURN_OK:
-            x_str = "OK";
-            break;
-        case RETURN_FAIL:
-            x_str = "FAIL";
-            break;
-        case RETURN_NOTHING:
-            x_str = "NOTHING";
-            break;
-        case RETURN_EMPTY:
-            x_str = "EMPTY";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfReturnCode>::text(code);
 }
 
 /**
@@ -113,6 +199,20 @@ enum PfAnimationStatus
 };
 #define ENUM_PF_ANIMATION_STATUS_COUNT 16 //!< Le nombre de valeurs pour l'énumération PfAnimationStatus.
 
+/**
+* @brief Table des textes de l'énumération PfAnimationStatus, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfAnimationStatus>
+{
+    enum {COUNT = ENUM_PF_ANIMATION_STATUS_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"NONE", "IDLE", "HIGHLIGHTED", "SELECTED", "ACTIVATED", "DEACTIVATED", "DISABLED", "WALKING", "JUMPING", "FALLING1", "FALLING2", "GETUP1", "GETUP2", "DROWNING", "MISC1", "MISC2"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une animation.
 * @param status Le statut d'animation.
@@ -120,63 +220,9 @@ enum PfAnimationStatus
 *
 * Le texte retourné correspond au nom de l'élément de l'énumération, sans le préfixe 'ANIM'.
 */
-inline string textFrom(PfAnimationStatus status)
+inline const string& textFrom(PfAnimationStatus status)
 {
-    string x_str;
-
-    switch (status)
-    {
-        case ANIM_NONE:
-            x_str = "NONE";
-            break;
-        case ANIM_IDLE:
-            x_str = "IDLE";
-            break;
-        case ANIM_HIGHLIGHTED:
-            x_str = "HIGHLIGHTED";
-            break;
-        case ANIM_SELECTED:
-            x_str = "SELECTED";
-            break;
-        case ANIM_ACTIVATED:
-            x_str = "ACTIVATED";
-            break;
-        case ANIM_DEACTIVATED:
-            x_str = "DEACTIVATED";
-            break;
-        case ANIM_DISABLED:
-            x_str = "DISABLED";
-            break;
-        case ANIM_WALKING:
-            x_str = "WALKING";
-            break;
-        case ANIM_JUMPING:
-            x_str = "JUMPING";
-            break;
-        case ANIM_FALLING1:
-            x_str = "FALLING1";
-            break;
-        case ANIM_FALLING2:
-            x_str = "FALLING2";
-            break;
-        case ANIM_GETUP1:
-            x_str = "GETUP1";
-            break;
-        case ANIM_GETUP2:
-            x_str = "GETUP2";
-            break;
-        case ANIM_DROWNING:
-            x_str = "DROWNING";
-            break;
-        case ANIM_MISC1:
-            x_str = "MISC1";
-            break;
-        case ANIM_MISC2:
-            x_str = "MISC2";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfAnimationStatus>::text(status);
 }
 
 /**
@@ -221,6 +267,20 @@ enum PfWadSlot
 #define ENUM_PF_WAD_SLOT_WIDGETS_BEG WAD_GUI_BUTTON1 //!< Le slot marquant le début de la section des objets d'interface utilisateur.
 #define ENUM_PF_WAD_SLOT_WIDGETS_END WAD_GUI_PROGRESSBAR //!< Le slot marquant la fin de la section des objets d'interface utilisateur.
 
+/**
+* @brief Table des textes de l'énumération PfWadSlot, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfWadSlot>
+{
+    enum {COUNT = ENUM_PF_WAD_SLOT_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"NULL_OBJECT", "MOB", "JUNGLE1", "JUNGLE2", "GRASS", "FENCE1", "FENCE2", "SIGN1", "SIGN2", "STATIC1", "STATIC2", "ANIMATED1", "ANIMATED2", "PORTAL1", "BACKGROUND", "GUI_BORDER", "GUI_BUTTON1", "GUI_BUTTON2", "GUI_SELECTIONGRID", "GUI_SCROLLBAR", "GUI_LIST1", "GUI_LIST2", "GUI_LABEL1", "GUI_LABEL2", "GUI_TEXTBOX", "GUI_SPINBOX", "GUI_SLIDINGCURSOR", "GUI_PROGRESSBAR"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant un slot de wad.
 * @param slot Le slot de wad.
@@ -228,99 +288,9 @@ enum PfWadSlot
 *
 * Le texte retourné correspond au nom de l'élément de l'énumération, sans le préfixe 'WAD'.
 */
-inline string textFrom(PfWadSlot slot)
+inline const string& textFrom(PfWadSlot slot)
 {
-    string x_str;
-
-    switch (slot)
-    {
-        case WAD_NULL_OBJECT:
-            x_str = "NULL_OBJECT";
-            break;
-        case WAD_MOB:
-            x_str = "MOB";
-            break;
-        case WAD_JUNGLE1:
-            x_str = "JUNGLE1";
-            break;
-        case WAD_JUNGLE2:
-            x_str = "JUNGLE2";
-            break;
-        case WAD_GRASS:
-            x_str = "GRASS";
-            break;
-        case WAD_FENCE1:
-            x_str = "FENCE1";
-            break;
-        case WAD_FENCE2:
-            x_str = "FENCE2";
-            break;
-        case WAD_SIGN1:
-            x_str = "SIGN1";
-            break;
-        case WAD_SIGN2:
-            x_str = "SIGN2";
-            break;
-        case WAD_STATIC1:
-            x_str = "STATIC1";
-            break;
-        case WAD_STATIC2:
-            x_str = "STATIC2";
-            break;
-        case WAD_ANIMATED1:
-            x_str = "ANIMATED1";
-            break;
-        case WAD_ANIMATED2:
-            x_str = "ANIMATED2";
-            break;
-        case WAD_PORTAL1:
-            x_str = "PORTAL1";
-            break;
-        case WAD_BACKGROUND:
-            x_str = "BACKGROUND";
-            break;
-        case WAD_GUI_BORDER:
-            x_str = "GUI_BORDER";
-            break;
-        case WAD_GUI_BUTTON1:
-            x_str = "GUI_BUTTON1";
-            break;
-        case WAD_GUI_BUTTON2:
-            x_str = "GUI_BUTTON2";
-            break;
-        case WAD_GUI_SELECTIONGRID:
-            x_str = "GUI_SELECTIONGRID";
-            break;
-        case WAD_GUI_SCROLLBAR:
-            x_str = "GUI_SCROLLBAR";
-            break;
-        case WAD_GUI_LIST1:
-            x_str = "GUI_LIST1";
-            break;
-        case WAD_GUI_LIST2:
-            x_str = "GUI_LIST2";
-            break;
-        case WAD_GUI_LABEL1:
-            x_str = "GUI_LABEL1";
-            break;
-        case WAD_GUI_LABEL2:
-            x_str = "GUI_LABEL2";
-            break;
-        case WAD_GUI_TEXTBOX:
-            x_str = "GUI_TEXTBOX";
-            break;
-        case WAD_GUI_SPINBOX:
-            x_str = "GUI_SPINBOX";
-            break;
-        case WAD_GUI_SLIDINGCURSOR:
-            x_str = "GUI_SLIDINGCURSOR";
-            break;
-        case WAD_GUI_PROGRESSBAR:
-            x_str = "GUI_PROGRESSBAR";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfWadSlot>::text(slot);
 }
 
 /**
@@ -341,6 +311,20 @@ enum PfWadScriptOption
 };
 #define ENUM_PF_WAD_SCRIPT_OPTION_COUNT 7 //!< Le nombre de valeurs pour l'énumération PfWadScriptOption.
 
+/**
+* @brief Table des textes de l'énumération PfWadScriptOption, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfWadScriptOption>
+{
+    enum {COUNT = ENUM_PF_WAD_SCRIPT_OPTION_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"img", "snd", "vid", "msc", "frm", "slw", "box"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une option de script de wad.
 * @param option L'option de script de wad.
@@ -348,36 +332,9 @@ enum PfWadScriptOption
 *
 * Le texte retourné correspond à l'écriture de l'option dans le script, indiquée dans la documentation de l'énumération elle-même (option xxx).
 */
-inline string textFrom(PfWadScriptOption option)
+inline const string& textFrom(PfWadScriptOption option)
 {
-    string x_str;
-
-    switch (option)
-    {
-        case WADTXT_IMG:
-            x_str = "img";
-            break;
-        case WADTXT_SND:
-            x_str = "snd";
-            break;
-        case WADTXT_VID:
-            x_str = "vid";
-            break;
-        case WADTXT_MSC:
-            x_str = "msc";
-            break;
-        case WADTXT_FRM:
-            x_str = "frm";
-            break;
-        case WADTXT_SLW:
-            x_str = "slw";
-            break;
-        case WADTXT_BOX:
-            x_str = "box";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfWadScriptOption>::text(option);
 }
 
 /**
@@ -393,6 +350,20 @@ enum PfMscValue
 };
 #define ENUM_PF_MSC_VALUE_COUNT 3 //!< Le nombre de valeurs pour l'énumération PfMscValue.
 
+/**
+* @brief Table des textes de l'énumération PfMscValue, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfMscValue>
+{
+    enum {COUNT = ENUM_PF_MSC_VALUE_COUNT, FLAGS = 1};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"none", "loop", "turnable"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une valeur de l'option "msc".
 * @param value La valeur de l'option "msc".
@@ -400,24 +371,9 @@ enum PfMscValue
 *
 * Le texte retourné correspond à l'écriture de la valeur dans le script, indiquée dans la documentation de l'énumération elle-même (valeur xxx).
 */
-inline string textFrom(PfMscValue value)
+inline const string& textFrom(PfMscValue value)
 {
-    string x_str;
-
-    switch (value)
-    {
-        case WADMSC_NONE:
-            x_str = "none";
-            break;
-        case WADMSC_LOOP:
-            x_str = "loop";
-            break;
-        case WADMSC_TURNABLE:
-            x_str = "turnable";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfMscValue>::text(value);
 }
 
 /**
@@ -431,6 +387,20 @@ enum PfWadObjProperty
 };
 #define ENUM_PF_WAD_OBJ_PROPERTY_COUNT 3 //!< Le nombre de valeurs pour l'énumération PfWadObjProperty.
 
+/**
+* @brief Table des textes de l'énumération PfWadObjProperty, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfWadObjProperty>
+{
+    enum {COUNT = ENUM_PF_WAD_OBJ_PROPERTY_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"colHeight", "box", "center"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une propriété d'objet.
 * @param value La propriété concernée.
@@ -438,24 +408,9 @@ enum PfWadObjProperty
 *
 * Le texte retourné correspond à l'écriture de la propriété dans le script, indiquée dans la documentation de l'énumération elle-même (valeur xxx).
 */
-inline string textFrom(PfWadObjProperty value)
+inline const string& textFrom(PfWadObjProperty value)
 {
-    string x_str;
-
-    switch (value)
-    {
-        case WADOBJ_COLHEIGHT:
-            x_str = "colHeight";
-            break;
-        case WADOBJ_BOX:
-            x_str = "box";
-            break;
-        case WADOBJ_CENTER:
-            x_str = "center";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfWadObjProperty>::text(value);
 }
 
 /**
@@ -473,6 +428,20 @@ enum PfMenuScriptSection
 };
 #define ENUM_PF_MENU_SCRIPT_SECTION_COUNT 4 //!< Le nombre de valeurs pour l'énumération PfMenuScriptSection.
 
+/**
+* @brief Table des textes de l'énumération PfMenuScriptSection, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfMenuScriptSection>
+{
+    enum {COUNT = ENUM_PF_MENU_SCRIPT_SECTION_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"PUT", "SEL", "MUS", "MSC"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une section de script de menu.
 * @param section La section de script de menu.
@@ -480,27 +449,9 @@ enum PfMenuScriptSection
 *
 * Le texte retourné correspond à l'écriture de la section dans le script, indiquée dans la documentation de l'énumération elle-même (section XXX).
 */
-inline string textFrom(PfMenuScriptSection section)
+inline const string& textFrom(PfMenuScriptSection section)
 {
-    string x_str;
-
-    switch (section)
-    {
-        case MENSCT_PUT:
-            x_str = "PUT";
-            break;
-        case MENSCT_SEL:
-            x_str = "SEL";
-            break;
-        case MENSCT_MUS:
-            x_str = "MUS";
-            break;
-        case MENSCT_MSC:
-            x_str = "MSC";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfMenuScriptSection>::text(section);
 }
 
 /**
@@ -521,6 +472,20 @@ enum PfMenuScriptOption
 };
 #define ENUM_PF_MENU_SCRIPT_OPTION_COUNT 7 //!< Le nombre de valeurs pour l'énumération PfMenuScriptOption.
 
+/**
+* @brief Table des textes de l'énumération PfMenuScriptOption, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfMenuScriptOption>
+{
+    enum {COUNT = ENUM_PF_MENU_SCRIPT_OPTION_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"obj", "crd", "txt", "lyt", "eft", "val", "dyn"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une option de script de menu.
 * @param option L'option de script de menu.
@@ -528,36 +493,9 @@ enum PfMenuScriptOption
 *
 * Le texte retourné correspond à l'écriture de l'option dans le script, indiquée dans la documentation de l'énumération elle-même (option xxx).
 */
-inline string textFrom(PfMenuScriptOption option)
+inline const string& textFrom(PfMenuScriptOption option)
 {
-    string x_str;
-
-    switch (option)
-    {
-        case MENOPT_OBJ:
-            x_str = "obj";
-            break;
-        case MENOPT_CRD:
-            x_str = "crd";
-            break;
-        case MENOPT_TXT:
-            x_str = "txt";
-            break;
-        case MENOPT_LYT:
-            x_str = "lyt";
-            break;
-        case MENOPT_EFT:
-            x_str = "eft";
-            break;
-        case MENOPT_VAL:
-            x_str = "val";
-            break;
-        case MENOPT_DYN:
-            x_str = "dyn";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfMenuScriptOption>::text(option);
 }
 
 /**
@@ -576,6 +514,20 @@ enum PfTextureScriptSection
 };
 #define ENUM_PF_TEXTURE_SCRIPT_SECTION_COUNT 5 //!< Le nombre de valeurs pour l'énumération PfTextureScriptSection.
 
+/**
+* @brief Table des textes de l'énumération PfTextureScriptSection, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfTextureScriptSection>
+{
+    enum {COUNT = ENUM_PF_TEXTURE_SCRIPT_SECTION_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"SPR", "BRD", "CLF", "CLB", "FLC"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une section de script de textures.
 * @param section La section de script de textures.
@@ -583,30 +535,9 @@ enum PfTextureScriptSection
 *
 * Le texte retourné correspond à l'écriture de la section dans le script, indiquée dans la documentation de l'énumération elle-même (section XXX).
 */
-inline string textFrom(PfTextureScriptSection section)
+inline const string& textFrom(PfTextureScriptSection section)
 {
-    string x_str;
-
-    switch (section)
-    {
-        case TEXSCT_SPR:
-            x_str = "SPR";
-            break;
-        case TEXSCT_BRD:
-            x_str = "BRD";
-            break;
-        case TEXSCT_CLF:
-            x_str = "CLF";
-            break;
-        case TEXSCT_CLB:
-            x_str = "CLB";
-            break;
-        case TEXSCT_FLC:
-            x_str = "FLC";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfTextureScriptSection>::text(section);
 }
 
 /**
@@ -644,6 +575,20 @@ enum PfEffect
 };
 #define ENUM_PF_EFFECT_COUNT 18 //!< Le nombre de valeurs pour l'énumération PfEffect.
 
+/**
+* @brief Table des textes de l'énumération PfEffect, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfEffect>
+{
+    enum {COUNT = ENUM_PF_EFFECT_COUNT, FLAGS = 1};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"none", "empty", "empty", "empty", "empty", "empty", "empty", "empty", "empty", "new", "next", "quit", "prev", "switch", "select", "sleep", "delete", "print"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant un effet.
 * @param effect L'effet.
@@ -653,55 +598,9 @@ enum PfEffect
 *
 * Le texte 'empty' est retourné pour les valeurs comprises entre 0x1 et 0x80.
 */
-inline string textFrom(PfEffect effect)
+inline const string& textFrom(PfEffect effect)
 {
-    string x_str;
-
-    switch (effect)
-    {
-        case EFFECT_NONE:
-            x_str = "none";
-            break;
-        case EFFECT_EMPTY1:
-        case EFFECT_EMPTY2:
-        case EFFECT_EMPTY3:
-        case EFFECT_EMPTY4:
-        case EFFECT_EMPTY5:
-        case EFFECT_EMPTY6:
-        case EFFECT_EMPTY7:
-        case EFFECT_EMPTY8:
-            x_str = "empty";
-            break;
-        case EFFECT_NEW:
-            x_str = "new";
-            break;
-        case EFFECT_NEXT:
-            x_str = "next";
-            break;
-        case EFFECT_QUIT:
-            x_str = "quit";
-            break;
-        case EFFECT_PREV:
-            x_str = "prev";
-            break;
-        case EFFECT_SWITCH:
-            x_str = "switch";
-            break;
-        case EFFECT_SELECT:
-            x_str = "select";
-            break;
-        case EFFECT_SLEEP:
-            x_str = "sleep";
-            break;
-        case EFFECT_DELETE:
-            x_str = "delete";
-            break;
-        case EFFECT_PRINT:
-            x_str = "print";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfEffect>::text(effect);
 }
 
 /**
@@ -726,6 +625,20 @@ enum PfInstruction
 };
 #define ENUM_PF_INSTRUCTION_COUNT 14 //!< Le nombre de valeurs pour l'énumération PfInstruction.
 
+/**
+* @brief Table des textes de l'énumération PfInstruction, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfInstruction>
+{
+    enum {COUNT = ENUM_PF_INSTRUCTION_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"none", "left", "up", "right", "down", "activate", "switch", "select", "delete", "modify", "validate", "stop", "jump", "check"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une instruction.
 * @param instruction L'instruction.
@@ -733,57 +646,9 @@ enum PfInstruction
 *
 * Le texte retourné correspond au nom de la valeur énumérée sans 'INSTRUCTION', et en minuscules (par exemple, 'up').
 */
-inline string textFrom(PfInstruction instruction)
+inline const string& textFrom(PfInstruction instruction)
 {
-    string x_str;
-
-    switch (instruction)
-    {
-        case INSTRUCTION_NONE:
-            x_str = "none";
-            break;
-        case INSTRUCTION_LEFT:
-            x_str = "left";
-            break;
-        case INSTRUCTION_UP:
-            x_str = "up";
-            break;
-        case INSTRUCTION_RIGHT:
-            x_str = "right";
-            break;
-        case INSTRUCTION_DOWN:
-            x_str = "down";
-            break;
-        case INSTRUCTION_ACTIVATE:
-            x_str = "activate";
-            break;
-        case INSTRUCTION_SWITCH:
-            x_str = "switch";
-            break;
-        case INSTRUCTION_SELECT:
-            x_str = "select";
-            break;
-        case INSTRUCTION_DELETE:
-            x_str = "delete";
-            break;
-        case INSTRUCTION_MODIFY:
-            x_str = "modify";
-            break;
-        case INSTRUCTION_VALIDATE:
-            x_str = "validate";
-            break;
-        case INSTRUCTION_STOP:
-            x_str = "stop";
-            break;
-        case INSTRUCTION_JUMP:
-            x_str = "jump";
-            break;
-        case INSTRUCTION_CHECK:
-            x_str = "check";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfInstruction>::text(instruction);
 }
 
 /**
@@ -797,6 +662,20 @@ enum PfGameMode
 };
 #define ENUM_PF_GAME_MODE_COUNT 3 //!< Le nombre de valeurs pour l'énumération PfGameMode.
 
+/**
+* @brief Table des textes de l'énumération PfGameMode, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfGameMode>
+{
+    enum {COUNT = ENUM_PF_GAME_MODE_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"none", "menu", "map"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retoure un texte représentant un mode de jeu.
 * @param mode Le mode de jeu.
@@ -804,24 +683,9 @@ enum PfGameMode
 *
 * Le texte retourné correspond au nom de la valeur énumérée sans 'GAME', et en minuscules (par exemple, 'map').
 */
-inline string textFrom(PfGameMode mode)
+inline const string& textFrom(PfGameMode mode)
 {
-    string x_str;
-
-    switch (mode)
-    {
-        case GAME_NONE:
-            x_str = "none";
-            break;
-        case GAME_MENU:
-            x_str = "menu";
-            break;
-        case GAME_MAP:
-            x_str = "map";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfGameMode>::text(mode);
 }
 
 /**
@@ -837,6 +701,20 @@ enum PfBoxType
 };
 #define ENUM_PF_BOX_TYPE_COUNT 5 //!< Le nombre de valeurs pour l'énumération PfBoxType.
 
+/**
+* @brief Table des textes de l'énumération PfBoxType, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfBoxType>
+{
+    enum {COUNT = ENUM_PF_BOX_TYPE_COUNT, FLAGS = 0};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"MAIN", "COLLISION", "TRIGGER", "DOOR", "ACTION"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant une zone.
 * @param box La zone.
@@ -844,30 +722,9 @@ enum PfBoxType
 *
 * Le texte retourné correspond au nom de la valeur énumérée sans 'BOX_TYPE'.
 */
-inline string textFrom(PfBoxType box)
+inline const string& textFrom(PfBoxType box)
 {
-    string x_str;
-
-    switch (box)
-    {
-        case BOX_TYPE_MAIN:
-            x_str = "MAIN";
-            break;
-        case BOX_TYPE_COLLISION:
-            x_str = "COLLISION";
-            break;
-        case BOX_TYPE_TRIGGER:
-            x_str = "TRIGGER";
-            break;
-        case BOX_TYPE_DOOR:
-            x_str = "DOOR";
-            break;
-        case BOX_TYPE_ACTION:
-            x_str = "ACTION";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfBoxType>::text(box);
 }
 
 /**
@@ -890,6 +747,20 @@ enum PfObjectStatus
 };
 #define ENUM_PF_OBJECT_STATUS_COUNT 10 //!< Le nombre de valeurs pour l'énumération PfObjectStatus.
 
+/**
+* @brief Table des textes de l'énumération PfObjectStatus, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfObjectStatus>
+{
+    enum {COUNT = ENUM_PF_OBJECT_STATUS_COUNT, FLAGS = 1};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"NONE", "JUMPING", "LANDING", "ONTHEFLOOR", "FALLING", "STANDBY", "STOPPED", "ONWATER", "DEAD", "ACTIVATED"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant un état d'objet.
 * @param objStat L'état d'objet.
@@ -897,45 +768,9 @@ enum PfObjectStatus
 *
 * Le texte retourné correspond au nom de la valeur énumérée sans 'OBJSTAT'.
 */
-inline string textFrom(PfObjectStatus objStat)
+inline const string& textFrom(PfObjectStatus objStat)
 {
-    string x_str;
-
-    switch (objStat)
-    {
-        case OBJSTAT_NONE:
-            x_str = "NONE";
-            break;
-        case OBJSTAT_JUMPING:
-            x_str = "JUMPING";
-            break;
-        case OBJSTAT_LANDING:
-            x_str = "LANDING";
-            break;
-        case OBJSTAT_ONTHEFLOOR:
-            x_str = "ONTHEFLOOR";
-            break;
-        case OBJSTAT_FALLING:
-            x_str = "FALLING";
-            break;
-        case OBJSTAT_STANDBY:
-            x_str = "STANDBY";
-            break;
-        case OBJSTAT_STOPPED:
-            x_str = "STOPPED";
-            break;
-        case OBJSTAT_ONWATER:
-            x_str = "ONWATER";
-            break;
-        case OBJSTAT_DEAD:
-            x_str = "DEAD";
-            break;
-        case OBJSTAT_ACTIVATED:
-            x_str = "ACTIVATED";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfObjectStatus>::text(objStat);
 }
 
 /**
@@ -955,6 +790,20 @@ enum PfActivationCode
 };
 #define ENUM_PF_ACTIVATION_CODE_COUNT 7 //!< Le nombre de valeurs pour l'énumération PfActivationCode.
 
+/**
+* @brief Table des textes de l'énumération PfActivationCode, dans l'ordre de ses valeurs.
+*/
+template<>
+struct EnumTexts<PfActivationCode>
+{
+    enum {COUNT = ENUM_PF_ACTIVATION_CODE_COUNT, FLAGS = 1};
+    static const char* at(unsigned int index)
+    {
+        static const char* const s_texts_t[COUNT] = {"NONE", "ANY", "USER", "SOUTH", "WEST", "NORTH", "EAST"};
+        return s_texts_t[index];
+    }
+};
+
 /**
 * @brief Retourne un texte représentant un code d'activation.
 * @param code Le code d'activation.
@@ -962,36 +811,9 @@ enum PfActivationCode
 *
 * Le texte retourné correspond au nom de la valeur énumérée sans 'ACTIVCODE'.
 */
-inline string textFrom(PfActivationCode code)
+inline const string& textFrom(PfActivationCode code)
 {
-    string x_str;
-
-    switch (code)
-    {
-        case ACTIVCODE_NONE:
-            x_str = "NONE";
-            break;
-        case ACTIVCODE_ANY:
-            x_str = "ANY";
-            break;
-        case ACTIVCODE_USER:
-            x_str = "USER";
-            break;
-        case ACTIVCODE_SOUTH:
-            x_str = "SOUTH";
-            break;
-        case ACTIVCODE_WEST:
-            x_str = "WEST";
-            break;
-        case ACTIVCODE_NORTH:
-            x_str = "NORTH";
-            break;
-        case ACTIVCODE_EAST:
-            x_str = "EAST";
-            break;
-    }
-
-    return x_str;
+    return EnumText<PfActivationCode>::text(code);
 }
 
 #endif // ENUM_H_INCLUDED
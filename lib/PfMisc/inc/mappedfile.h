@@ -0,0 +1,100 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe MappedFile.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef MAPPEDFILE_H_INCLUDED
+#define MAPPEDFILE_H_INCLUDED
+
+#include "misc_gen.h"
+
+#include <string>
+#include "noncopyable.h"
+
+/**
+* @brief Fichier projeté en mémoire, en lecture seule.
+*
+* Le contenu du fichier est accessible directement en mémoire (MappedFile::getData) sans copie ni lecture par petits blocs.
+* Un indice de lecture (MappedFile::m_offset) permet de parcourir le fichier à la manière d'un flux binaire en lecture.
+*
+* Ce fichier sert notamment à construire des DataPackage lisant leurs valeurs en place (voir DataPackage::DataPackage(MappedFile&, unsigned int)).
+*
+* La projection utilise <em>mmap</em>, ou <em>MapViewOfFile</em> sous Windows.
+*
+* @warning
+* Les pointeurs retournés par cette classe, et les DataPackage construits à partir d'elle, ne sont valides que tant que l'objet existe.
+*/
+class MappedFile : private NonCopyable
+{
+public:
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur MappedFile.
+    * @param fileName Le chemin du fichier.
+    * @throw ConstructorException si le fichier ne peut pas être ouvert ou projeté.
+    */
+    explicit MappedFile(const string& fileName);
+    /**
+    * @brief Destructeur MappedFile.
+    *
+    * Libère la projection et ferme le fichier.
+    */
+    ~MappedFile();
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Copie des octets du fichier à partir de l'indice de lecture, puis avance celui-ci.
+    * @param p_dest La destination.
+    * @param size Le nombre d'octets à copier.
+    * @throw PfException si la fin du fichier est dépassée.
+    */
+    void read(void* p_dest, unsigned int size);
+    /**
+    * @brief Lit une chaîne de caractères à partir de l'indice de lecture, jusqu'au premier '\0', puis avance celui-ci après le '\0'.
+    * @return La chaîne lue.
+    *
+    * Equivalent de la fonction <em>readString</em> (fichier "misc.h") pour un flux en lecture.
+    * Une chaîne vide est retournée si la fin du fichier est atteinte.
+    */
+    string readString();
+    /**
+    * @brief Avance l'indice de lecture.
+    * @param size Le nombre d'octets à passer.
+    * @throw PfException si la fin du fichier est dépassée.
+    */
+    void skip(unsigned int size);
+    /**
+    * @brief Retourne un pointeur vers les données situées à l'indice de lecture.
+    * @return Le pointeur, à ne pas lire au-delà de MappedFile::remaining octets.
+    */
+    const char* current() const {return mq_data + m_offset;}
+    /**
+    * @brief Retourne le nombre d'octets restant à lire.
+    * @return Le nombre d'octets.
+    */
+    unsigned int remaining() const {return m_size - m_offset;}
+    /*
+    * Accesseurs
+    * ----------
+    */
+    const char* getData() const {return mq_data;} //!< Accesseur.
+    unsigned int getSize() const {return m_size;} //!< Accesseur.
+    unsigned int getOffset() const {return m_offset;} //!< Accesseur.
+
+private:
+    const char* mq_data; //!< Le début du fichier projeté, 0 si le fichier est vide.
+    unsigned int m_size; //!< La taille du fichier.
+    unsigned int m_offset; //!< L'indice de lecture.
+    void* mp_handle; //!< Le descripteur du fichier (HANDLE sous Windows).
+    void* mp_mapping; //!< L'objet de projection sous Windows, inutilisé sinon.
+};
+
+#endif // MAPPEDFILE_H_INCLUDED
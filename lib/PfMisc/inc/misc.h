@@ -30,11 +30,15 @@
 * Le langage utilisé pour la lecture des scripts est un groupe de deux lettres, pour l'instant "en" ou "fr".
 *
 * Les membres de cette structure sont statiques, et initialisés dans le fichier "misc.cpp" aux valeurs suivantes :
-* <ul><li>s_language = DEFAULT_LANGUAGE (fichier "misc_gen.h")</li></ul>
+* <ul><li>s_language = DEFAULT_LANGUAGE (fichier "misc_gen.h")</li>
+* <li>s_inputRecord = ""</li>
+* <li>s_inputReplay = ""</li></ul>
 */
 struct ConfigSettings
 {
-    static string s_language; //!< Le langage utilisé pour la lecture des scripts.
+    static string s_language; //!< Le langage utilisé pour la lecture des scripts. Un changement de valeur vide les scripts conservés en mémoire.
+    static string s_inputRecord; //!< Le fichier d'enregistrement des entrées utilisateur, aucun enregistrement si vide.
+    static string s_inputReplay; //!< Le fichier d'entrées utilisateur à rejouer, prioritaire sur l'enregistrement, aucun rejeu si vide.
 };
 
 // Fonctions de gestion des scripts et fichiers
@@ -45,7 +49,9 @@ struct ConfigSettings
 * @throw ScriptException si une ligne du fichier de configuration n'est pas valide.
 *
 * Le fichier CONFIG_FILE est composé de lignes de la forme [PARAMETRE]=[VALEUR]. Les paramètres valides sont :
-* <ul><li>LANGUAGE=(en, fr...)</li></ul>
+* <ul><li>LANGUAGE=(en, fr...)</li>
+* <li>INPUT_RECORD=(nom de fichier)</li>
+* <li>INPUT_REPLAY=(nom de fichier)</li></ul>
 */
 void readConfig();
 
@@ -70,6 +76,9 @@ void readConfig();
 *
 * Si le mode de lecture n'est pas valide, tout le fichier est lu.
 *
+* Le fichier n'est lu qu'une fois : son contenu et les indices de ses sections sont conservés en mémoire jusqu'au prochain changement
+* de ConfigSettings::s_language.
+*
 * @warning
 * De manière générale, éviter deux lignes de sections successives dans les scripts (section vide enchaînant directement sur une autre section)
 * sous peine d'omission de section dans certains cas.
@@ -87,6 +96,8 @@ vector<string> readScript(const string& scriptName, const string& language = Con
 *
 * Cette fonction ouvre le fichier nommé [<em>scriptName</em>].[SCRIPT_EXT] ou [<em>scriptName</em>]_[<em>language</em>].[SCRIPT_EXT] si un langage est spécifié,
 * SCRIPT_EXT étant défini dans le fichier "misc_gen.h".
+*
+* Le fichier est conservé en mémoire comme pour la fonction <em>readScript</em>.
 */
 string readLineAtSection(const string& scriptName, const string& sectionName, const string& language = ConfigSettings::s_language);
 
@@ -102,6 +113,8 @@ string readLineAtSection(const string& scriptName, const string& sectionName, co
 *
 * La chaîne <em>s</em> est cherchée dans le fichier de traduction, à gauche des signes '='. Dès qu'elle est trouvée, le mot à droite du signe
 * '=' est retourné. Si la chaîne n'est pas trouvée, elle n'est pas traduite et est retournée telle quelle.
+*
+* Le fichier de traduction n'est lu qu'une fois, dans une table conservée jusqu'au prochain changement de ConfigSettings::s_language.
 */
 string translate(const string& s, const string& language = ConfigSettings::s_language);
 
@@ -213,6 +226,10 @@ void writeString(ofstream& r_ofs, const string& str);
 *
 * Dès que '\0' ou <em>delim</em> est rencontré, la chaîne de caractère est retournée.
 *
+* Le délimiteur est recherché par blocs dans le tampon du flux (<em>getline</em>) plutôt que caractère par caractère.
+* Si <em>delim</em> n'est pas '\0', un '\0' rencontré avant lui tronque la chaîne retournée, mais le flux est tout de même avancé jusqu'à <em>delim</em>.
+* Si la fin du flux est atteinte, le flux retourne <em>true</em> au test <em>fail</em>.
+*
 * @remarks
 * Le flux n'est pas rembobiné en fin de fonction.
 */
@@ -244,9 +261,22 @@ string readString(ifstream& r_ifs, const string& delim);
 * et le curseur écriture après la copie.
 *
 * Un groupe de quatre octets (unsigned int) est écrit afin d'indiquer la taille du fichier en nombre d'octets.
-* Le fichier est ensuite recopié de manière binaire.
+* Le fichier est ensuite recopié de manière binaire, par blocs de BINARY_BUFFER_SIZE octets (fichier "misc_gen.h").
 */
 void writeBinaryFile(ofstream& r_ofs, ifstream& r_ifs);
+/**
+* @brief Ouvre un fichier binaire en écriture avec un tampon de BINARY_BUFFER_SIZE octets (fichier "misc_gen.h").
+* @param r_ofs Le flux à ouvrir, qui ne doit pas être déjà ouvert.
+* @param r_buffer_v Le tampon, redimensionné par cette fonction.
+* @param fileName Le nom du fichier, écrasé s'il existe.
+* @return <code>true</code> si le fichier est ouvert.
+*
+* Les nombreuses petites valeurs des fichiers binaires (wad, maps, menus, textures...) sont ainsi écrites sur le disque par blocs.
+*
+* @warning
+* Le tampon doit exister jusqu'à la fermeture du flux : il doit donc être déclaré avant lui.
+*/
+bool openBufferedBinaryFile(ofstream& r_ofs, vector<char>& r_buffer_v, const string& fileName);
 
 // Fonctions d'organisation
 
@@ -49,6 +49,9 @@
 *
 * Vient ensuite la gestion des informations de debug, qui est inhibée lorsque la macro NDEBUG est définie.
 *
+* Enfin, la macro PROFILING active le profileur (fichier "profiler.h"). Elle est définie en mode Debug,
+* et en mode Release uniquement si la macro PROFILE_RELEASE est définie.
+*
 * @section ConfigFile Le fichier de configuration
 *
 * Le fichier de configuration, défini par la macro CONFIG_FILE, sert à définir un état de fonctionnement du jeu.
@@ -57,6 +60,9 @@
 * utilisés en extension des fichiers de traduction, sous la forme TRANSLATION_SCRIPT_NAME_[en, fr...]. Par exemple : 'translation_fr'.
 * Ainsi, en fonction du langage choisi, le programme sait quel fichier de traduction ouvrir.
 *
+* Il permet également d'enregistrer les entrées utilisateur d'une map ou de l'éditeur dans un fichier (INPUT_RECORD),
+* ou de les rejouer (INPUT_REPLAY) pour reproduire une session à l'identique, par exemple pour comparer des mesures de performance.
+*
 * Le fichier de configuration sera probablement amené à s'enrichir par la suite.
 * La fonction <em>readConfig</em> (fichier "misc.h") gère la lecture de ce fichier.
 *
@@ -112,6 +118,7 @@
 * <li>une interface pour la gestion de phases de jeu (MultiPhases),</li>
 * <li>une interface pour les objets pouvant répondre à des instructions (InstructionReader),</li>
 * <li>une interface interdisant la copie d'une instance de classe (NonCopyable),</li>
+* <li>un profileur mesurant la durée de blocs de code et exportant des traces (Profiler, fichier "profiler.h"),</li>
 * <li>une interface pour les objets pouvant être sérialisés (Serializable).</li></ul>
 *
 * @see misc_gen.h, misc.h, enum.h
@@ -220,6 +227,7 @@
 #define MISC_GEN_H_INCLUDED
 
 //#define NDEBUG
+//#define PROFILE_RELEASE
 
 #define SYSTEM_WINDOWS //!< Indique que le système d'exploitation est Windows.
 //#define SYSTEM_LINUX //!< Indique que le système d'exploitation est Linux.
@@ -253,6 +261,7 @@
 #define END_OF_LIST_INT -999999999 //!< Fin de liste de groupes de quatre octets.
 #define END_OF_SECTION -999999998 //!< Fin de section.
 #define SAVE_END_VALUE 1000 //!< La valeur du champ SAVE_END des énumérations de sauvegarde.
+#define BINARY_BUFFER_SIZE 65536 //!< La taille des blocs lus ou écrits en une fois dans un fichier binaire (voir BinaryReader).
 
 // Macros mathématiques
 
@@ -340,4 +349,8 @@ extern ofstream g_log;
 
 #endif // ifndef NDEBUG
 
+#if !defined(NDEBUG) || defined(PROFILE_RELEASE)
+#define PROFILING //!< Indique que le profileur (fichier "profiler.h") est compilé.
+#endif
+
 #endif // MISC_GEN_H_INCLUDED
@@ -0,0 +1,152 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant le profileur : les classes Profiler et ProfileScope, et la macro PROFILE_SCOPE.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*
+* Le profileur n'est compilé que si la macro PROFILING est définie (fichier "misc_gen.h"), c'est-à-dire en mode Debug,
+* ou en mode Release si la macro PROFILE_RELEASE est définie.
+* Sinon, la macro PROFILE_SCOPE ne fait rien, et les appels directs aux méthodes de la classe Profiler doivent être placés
+* dans un bloc <code>#ifdef PROFILING</code>.
+*/
+
+#ifndef PROFILER_H_INCLUDED
+#define PROFILER_H_INCLUDED
+
+#include "misc_gen.h"
+
+#include <string>
+#include <vector>
+#include <utility>
+#include "noncopyable.h"
+
+#define PROFILER_RING_SIZE 4096 //!< Le nombre de mesures conservées pour chaque thread, les plus anciennes étant écrasées.
+#define PROFILER_TRACE_FILE "trace.json" //!< Le nom par défaut du fichier de trace écrit par Profiler::exportTrace.
+
+#define PROFILE_CONCAT_(a, b) a##b //!< Macro de concaténation utilisée par PROFILE_SCOPE.
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b) //!< Macro de concaténation utilisée par PROFILE_SCOPE, développant ses paramètres.
+
+#ifdef PROFILING
+/**
+* @brief Macro mesurant la durée du bloc dans lequel elle est placée.
+*
+* Cette macro s'utilise de la manière suivante :
+*
+* <code>PROFILE_SCOPE("nom");</code>
+*
+* Le nom doit être une chaîne littérale, seul son pointeur étant conservé.
+*
+* Si PROFILING n'est pas définie, alors cette macro ne fait rien.
+*/
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name)
+#endif
+
+/**
+* @brief Profileur mesurant la durée de blocs de code, thread par thread.
+*
+* Chaque thread dispose de sa propre liste circulaire de PROFILER_RING_SIZE mesures, créée à sa première mesure.
+* Une mesure retient le nom du bloc, ses dates de début et de fin en microsecondes et sa profondeur d'imbrication dans le thread.
+* Les mesures sont ajoutées par la classe ProfileScope, au moyen de la macro PROFILE_SCOPE.
+*
+* La méthode Profiler::endFrame, appelée par le thread principal après chaque affichage, cumule les mesures de l'image écoulée par nom de bloc.
+* Ce bilan est récupéré par la méthode Profiler::frameBreakdown, pour être affiché à l'écran.
+*
+* La méthode Profiler::exportTrace écrit les mesures de tous les threads au format JSON de l'outil de trace de Chrome (chrome://tracing).
+*
+* Cette classe ne dépend pas de la SDL : les horloges et les verrous sont ceux du système.
+*
+* @warning
+* Les listes des threads terminés sont conservées jusqu'à la fin du programme, afin de figurer dans les traces.
+*/
+class Profiler
+{
+    friend class ProfileScope;
+
+public:
+    /**
+    * @brief Retourne la date actuelle.
+    * @return La date en microsecondes depuis le lancement du programme.
+    */
+    static double now();
+    /**
+    * @brief Nomme le thread appelant dans les traces.
+    * @param name Le nom du thread.
+    *
+    * Par défaut, un thread est nommé d'après son numéro d'ordre de première mesure.
+    */
+    static void nameThread(const string& name);
+    /**
+    * @brief Termine une image pour le thread appelant.
+    *
+    * Les mesures de ce thread terminées depuis l'appel précédent sont cumulées par nom de bloc, dans l'ordre de leurs débuts.
+    */
+    static void endFrame();
+    /**
+    * @brief Retourne le bilan de la dernière image terminée par le thread appelant (Profiler::endFrame).
+    * @param r_breakdown_v La liste à remplir de paires nom - durée en millisecondes.
+    *
+    * La liste est vidée, puis reçoit en premier la durée totale de l'image sous le nom "frame",
+    * puis la durée cumulée de chaque bloc, son nom étant décalé de deux espaces par niveau d'imbrication.
+    */
+    static void frameBreakdown(vector<pair<string, float> >& r_breakdown_v);
+    /**
+    * @brief Ecrit les mesures conservées de tous les threads dans un fichier de trace.
+    * @param fileName Le nom du fichier.
+    * @throw FileException si le fichier ne peut pas être ouvert.
+    *
+    * Le fichier suit le format JSON de l'outil de trace de Chrome : un événement complet (phase "X") par mesure,
+    * et un événement de métadonnées par thread pour son nom.
+    */
+    static void exportTrace(const string& fileName = PROFILER_TRACE_FILE);
+
+private:
+    /**
+    * @brief Constructeur Profiler, non défini : cette classe n'a que des méthodes statiques.
+    */
+    Profiler();
+    /**
+    * @brief Commence une mesure pour le thread appelant.
+    * @return La date de début.
+    */
+    static double beginScope();
+    /**
+    * @brief Termine une mesure pour le thread appelant et l'ajoute à sa liste.
+    * @param q_name Le nom du bloc.
+    * @param start La date de début retournée par Profiler::beginScope.
+    */
+    static void endScope(const char* q_name, double start);
+};
+
+/**
+* @brief Mesure de la durée de vie d'une instance, du constructeur au destructeur.
+*
+* Cette classe s'utilise au moyen de la macro PROFILE_SCOPE.
+*/
+class ProfileScope : private NonCopyable
+{
+public:
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur ProfileScope.
+    * @param q_name Le nom du bloc mesuré, qui doit exister jusqu'à la fin du programme.
+    */
+    explicit ProfileScope(const char* q_name) : mq_name(q_name), m_start(Profiler::beginScope()) {}
+    /**
+    * @brief Destructeur ProfileScope.
+    *
+    * Ajoute la mesure à la liste du thread.
+    */
+    ~ProfileScope() {Profiler::endScope(mq_name, m_start);}
+
+private:
+    const char* mq_name; //!< Le nom du bloc mesuré.
+    double m_start; //!< La date de début de la mesure.
+};
+
+#endif // PROFILER_H_INCLUDED
@@ -0,0 +1,98 @@
+/**
+* @file
+* @author Anaïs Vernet
+* @brief Fichier contenant la classe SlabAllocator.
+* @date xx/xx/xxxx
+* @version 0.0.0
+*/
+
+#ifndef SLABALLOCATOR_H_INCLUDED
+#define SLABALLOCATOR_H_INCLUDED
+
+#include "misc_gen.h"
+
+#include <cstddef>
+#include <vector>
+#include "noncopyable.h"
+
+#define SLAB_BLOCKS_COUNT 256 //!< Le nombre de blocs par défaut d'une plaque de SlabAllocator.
+
+/**
+* @brief Allocateur de blocs de taille fixe, regroupés en plaques.
+*
+* La mémoire est réservée par plaques de plusieurs blocs (SlabAllocator::m_blocksPerSlab).
+* Les blocs libres sont chaînés entre eux : une allocation ou une libération ne coûte que quelques affectations,
+* et une plaque n'est réservée que lorsque tous les blocs existants sont utilisés.
+*
+* Les plaques ne sont rendues au système qu'à la destruction de l'allocateur.
+*
+* Cette classe sert à éviter une allocation sur le tas pour chacun des nombreux petits objets de même taille
+* créés lors de la génération des images (voir la classe GLImage de la bibliothèque PfMedia).
+*
+* @warning
+* Cette classe n'est pas protégée contre les accès concurrents : un allocateur ne doit être utilisé que par le thread qui l'a construit.
+* En mode Debug, une assertion le vérifie à chaque allocation ou libération.
+*/
+class SlabAllocator : private NonCopyable
+{
+public:
+    /*
+    * Constructeurs et destructeur
+    * ----------------------------
+    */
+    /**
+    * @brief Constructeur SlabAllocator.
+    * @param blockSize La taille d'un bloc, en octets.
+    * @param blocksPerSlab Le nombre de blocs d'une plaque.
+    * @throw ConstructorException si l'un des paramètres est nul.
+    *
+    * La taille des blocs est arrondie au multiple supérieur de la taille d'un <code>double</code>, afin de conserver l'alignement.
+    * Aucune plaque n'est réservée à la construction.
+    */
+    explicit SlabAllocator(size_t blockSize, unsigned int blocksPerSlab = SLAB_BLOCKS_COUNT);
+    /**
+    * @brief Destructeur SlabAllocator.
+    *
+    * Libère toutes les plaques, que leurs blocs soient utilisés ou non.
+    */
+    ~SlabAllocator();
+    /*
+    * Méthodes
+    * --------
+    */
+    /**
+    * @brief Retourne un bloc libre.
+    * @return Le bloc, de taille SlabAllocator::m_blockSize.
+    *
+    * Une nouvelle plaque est réservée si aucun bloc n'est libre.
+    */
+    void* allocate();
+    /**
+    * @brief Rend un bloc à cet allocateur.
+    * @param p_block Le bloc, retourné auparavant par SlabAllocator::allocate.
+    *
+    * Un pointeur nul est ignoré.
+    */
+    void deallocate(void* p_block);
+    /**
+    * @brief Retourne le nombre de plaques réservées.
+    * @return Le nombre de plaques.
+    */
+    unsigned int slabsCount() const;
+    /*
+    * Accesseurs
+    * ----------
+    */
+    size_t getBlockSize() const {return m_blockSize;} //!< Accesseur.
+
+private:
+    size_t m_blockSize; //!< La taille d'un bloc, en octets.
+    unsigned int m_blocksPerSlab; //!< Le nombre de blocs d'une plaque.
+    vector<char*> mpn_slabs_v; //!< Les plaques réservées.
+    void* mp_freeBlock; //!< Le premier bloc libre, chaque bloc libre contenant l'adresse du suivant.
+#ifndef NDEBUG
+    const void* mq_ownerThread; //!< L'identifiant du thread ayant construit cet allocateur (non déclaré si NDEBUG est définie).
+#endif
+};
+
+#endif // SLABALLOCATOR_H_INCLUDED
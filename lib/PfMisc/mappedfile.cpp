@@ -0,0 +1,109 @@
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include <cstring>
+#include "errors.h"
+
+MappedFile::MappedFile(const string& fileName) : mq_data(0), m_size(0), m_offset(0), mp_handle(0), mp_mapping(0)
+{
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE)
+        throw ConstructorException(__LINE__, __FILE__, string("Impossible d'ouvrir le fichier ") + fileName + ".", "MappedFile");
+    mp_handle = file;
+    m_size = (unsigned int) GetFileSize(file, 0);
+    if (m_size > 0)
+    {
+        HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+        if (mapping != 0)
+        {
+            mp_mapping = mapping;
+            mq_data = (const char*) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        }
+        if (mq_data == 0)
+        {
+            if (mapping != 0)
+                CloseHandle(mapping);
+            CloseHandle(file);
+            throw ConstructorException(__LINE__, __FILE__, string("Impossible de projeter le fichier ") + fileName + " en mémoire.", "MappedFile");
+        }
+    }
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw ConstructorException(__LINE__, __FILE__, string("Impossible d'ouvrir le fichier ") + fileName + ".", "MappedFile");
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        throw ConstructorException(__LINE__, __FILE__, string("Impossible de lire la taille du fichier ") + fileName + ".", "MappedFile");
+    }
+    m_size = (unsigned int) st.st_size;
+    if (m_size > 0)
+    {
+        void* p_data = mmap(0, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p_data == MAP_FAILED)
+        {
+            close(fd);
+            throw ConstructorException(__LINE__, __FILE__, string("Impossible de projeter le fichier ") + fileName + " en mémoire.", "MappedFile");
+        }
+        mq_data = (const char*) p_data;
+    }
+    close(fd); // la projection reste valide après fermeture du descripteur
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef _WIN32
+    if (mq_data != 0)
+        UnmapViewOfFile(mq_data);
+    if (mp_mapping != 0)
+        CloseHandle((HANDLE) mp_mapping);
+    if (mp_handle != 0)
+        CloseHandle((HANDLE) mp_handle);
+#else
+    if (mq_data != 0)
+        munmap((void*) mq_data, m_size);
+#endif
+}
+
+void MappedFile::read(void* p_dest, unsigned int size)
+{
+    if (size > remaining())
+        throw PfException(__LINE__, __FILE__, "Fin de fichier dépassée.");
+
+    memcpy(p_dest, current(), size);
+    m_offset += size;
+}
+
+string MappedFile::readString()
+{
+    if (remaining() == 0) // fichier vide ou entièrement lu, MappedFile::mq_data pouvant être nul
+        return "";
+
+    const char* q_begin = current();
+    const char* q_end = (const char*) memchr(q_begin, '\0', remaining());
+    if (q_end == 0) // comme pour un flux, la chaîne s'arrête à la fin du fichier
+        q_end = mq_data + m_size;
+
+    string rtn_str(q_begin, q_end - q_begin);
+    m_offset = MIN(m_size, (unsigned int) (q_end - mq_data) + 1);
+
+    return rtn_str;
+}
+
+void MappedFile::skip(unsigned int size)
+{
+    if (size > remaining())
+        throw PfException(__LINE__, __FILE__, "Fin de fichier dépassée.");
+
+    m_offset += size;
+}
@@ -4,6 +4,8 @@
 #include <dirent.h>
 
 string ConfigSettings::s_language = DEFAULT_LANGUAGE;
+string ConfigSettings::s_inputRecord = "";
+string ConfigSettings::s_inputReplay = "";
 
 void readConfig()
 {
@@ -23,6 +25,10 @@ void readConfig()
         str2 = str.substr(pos+1);
         if (str1 == "LANGUAGE")
             ConfigSettings::s_language = str2;
+        else if (str1 == "INPUT_RECORD")
+            ConfigSettings::s_inputRecord = str2;
+        else if (str1 == "INPUT_REPLAY")
+            ConfigSettings::s_inputReplay = str2;
         else
             throw ScriptException(__LINE__, __FILE__, string("Ligne non valide, le paramètre ") + str1 + " n'est pas pris en charge.", CONFIG_FILE, str);
     }
@@ -30,78 +36,144 @@ void readConfig()
     configFile.close();
 }
 
-vector<string> readScript(const string& scriptName, const string& language, const string& readingMode)
+// Les fichiers script et de traduction sont lus une seule fois, puis conservés en mémoire jusqu'au prochain changement de ConfigSettings::s_language.
+// Les lignes d'un script sont celles que retournerait une lecture par getline tant que le flux est valide, la dernière ayant épuisé le flux.
+
+struct CachedScript
 {
-    vector<string> x_lines_v;
-    string fileName = scriptName + (language.empty()?"":"_" + language) + "." + SCRIPT_EXT;
+    vector<string> lines_v; // les lignes du fichier
+    map<string, vector<unsigned int> > sections_v_map; // les indices des lignes de titre de chaque section, par titre sans crochets
+};
+
+static string s_cachedLanguage = DEFAULT_LANGUAGE; // le langage pour lequel les caches sont valides
+static map<string, CachedScript> s_scripts_map; // par nom de fichier
+static map<string, map<string, string> > s_translations_map; // par nom de fichier
+
+static void checkScriptsCache()
+{
+    if (s_cachedLanguage == ConfigSettings::s_language)
+        return;
+
+    s_scripts_map.clear();
+    s_translations_map.clear();
+    s_cachedLanguage = ConfigSettings::s_language;
+}
+
+static const CachedScript& cachedScript(const string& fileName)
+{
+    checkScriptsCache();
+
+    map<string, CachedScript>::iterator it = s_scripts_map.find(fileName);
+    if (it != s_scripts_map.end())
+        return it->second;
+
     ifstream scriptFile(fileName.c_str());
+    if (!scriptFile.is_open())
+        throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
 
+    CachedScript script;
+    string str;
+    while (scriptFile.good())
+    {
+        getline(scriptFile, str);
+        if (!str.empty() && str.at(0) == '[') // titre de section ?
+            script.sections_v_map[str.substr(1, str.find_first_of(']')-1)].push_back(script.lines_v.size());
+        script.lines_v.push_back(str);
+    }
+    scriptFile.close();
+
+    return s_scripts_map.insert(pair<string, CachedScript>(fileName, script)).first->second;
+}
+
+static const map<string, string>& translationTable(const string& language)
+{
+    checkScriptsCache();
+
+    string fileName = string(TRANSLATION_SCRIPT_NAME) + "_" + language + "." + SCRIPT_EXT;
+    map<string, map<string, string> >::iterator it = s_translations_map.find(fileName);
+    if (it != s_translations_map.end())
+        return it->second;
+
+    ifstream scriptFile(fileName.c_str());
     if (!scriptFile.is_open())
         throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
 
+    map<string, string>& r_table_map = s_translations_map[fileName];
     string str;
+    while (scriptFile.good())
+    {
+        getline(scriptFile, str);
+        size_t pos = str.find_first_of('=');
+        if (pos == string::npos || pos == str.length()-1)
+            continue;
+        r_table_map.insert(pair<string, string>(str.substr(0, pos), str.substr(pos+1))); // seule la première traduction d'une chaîne est retenue
+    }
+    scriptFile.close();
+
+    return r_table_map;
+}
+
+static string translateWith(const map<string, string>& rc_table_map, const string& s)
+{
+    if (s.size() == 0)
+        return s;
+
+    // ce mic-mac n'est plus trop nécessaire me semble-t-il, mais je me souviens du bug qui avait été résolu comme cela, alors je laisse :
+    // retire '\0' pour pouvoir comparer avec les chaînes de la table, donc sans '\0'
+    map<string, string>::const_iterator it = rc_table_map.find((s.at(s.size()-1) == '\0')?s.substr(0, s.size()-1):s);
+
+    return (it != rc_table_map.end())?it->second:s;
+}
+
+vector<string> readScript(const string& scriptName, const string& language, const string& readingMode)
+{
+    vector<string> x_lines_v;
+    string fileName = scriptName + (language.empty()?"":"_" + language) + "." + SCRIPT_EXT;
+    const CachedScript& rc_script = cachedScript(fileName);
+    const vector<string>& rc_lines_v = rc_script.lines_v;
+    unsigned int count = rc_lines_v.size();
+
     size_t pos = readingMode.find_first_of(' ');
 
     if (readingMode.substr(0, pos) == "titles") // retourne les titres de toutes les sections
     {
         // si un argument suit "titles", seules les sections dont la première ligne contient le texte suivant "titles" retournent leurs titres.
         string firstLine = (pos == string::npos || pos == readingMode.length()-1)?"":readingMode.substr(pos+1); // première ligne de la section à tester
-        string firstLineTest; // stockera le contenu de la première ligne des sections
-        while (scriptFile.good())
+        for (unsigned int i=0;i<count;i++)
         {
-            getline(scriptFile, str);
-            if (!str.empty() && str.at(0) == '[') // titre de section ?
+            const string& rc_str = rc_lines_v[i];
+            if (!rc_str.empty() && rc_str.at(0) == '[') // titre de section ?
             {
-                getline(scriptFile, firstLineTest); // lecture de la première ligne de la section
-                if (firstLine == "" || firstLine == firstLineTest) // aucun test requis ou condition remplie ?
-                {
-                    str = str.substr(1, str.find_first_of(']')-1); // recopie du titre sans crochets
-                    x_lines_v.push_back(str);
-                }
+                i++; // la première ligne de la section est lue et ne peut donc pas être un titre
+                if (firstLine == "" || firstLine == ((i < count)?rc_lines_v[i]:"")) // aucun test requis ou condition remplie ?
+                    x_lines_v.push_back(rc_str.substr(1, rc_str.find_first_of(']')-1)); // recopie du titre sans crochets
             }
         }
     }
     else if (readingMode.substr(0, pos) == "section") // retourne le contenu d'une section
     {
-        bool found = false;
         if (pos == string::npos || pos == readingMode.length()-1) // aucune section spécifiée en argument après "section" ?
-        {
-            scriptFile.close();
             throw ArgumentException(__LINE__, __FILE__, "Mode de lecture \"section\" et aucune section spécifiée.", "readingMode", "readScript");
-        }
-        while (scriptFile.good())
+        map<string, vector<unsigned int> >::const_iterator it = rc_script.sections_v_map.find(readingMode.substr(pos+1));
+        if (it == rc_script.sections_v_map.end())
+            throw FileException(__LINE__, __FILE__, "Aucune section nommée " + readingMode.substr(pos+1) + " dans ce script.", fileName);
+        unsigned int next = 0; // première ligne non encore lue
+        for (unsigned int i=0, size=it->second.size();i<size;i++)
         {
-            getline(scriptFile, str);
-            if (!str.empty() && str.at(0) == '[') // titre de section ?
+            if (it->second[i] < next) // titre lu comme fin de la section précédente
+                continue;
+            unsigned int j = it->second[i] + 1;
+            // lecture jusqu'à la prochaine section, la dernière ligne du fichier n'étant pas retenue
+            while (j+1 < count && (rc_lines_v[j].empty() || rc_lines_v[j].at(0) != '['))
             {
-                if (str.substr(1, str.find_first_of(']')-1) == readingMode.substr(pos+1)) // est-ce la bonne section ?
-                {
-                    getline(scriptFile, str);
-                    while (scriptFile.good() && (str.empty() || str.at(0) != '[')) // lecture jusqu'à la prochaine section
-                    {
-                        x_lines_v.push_back(str);
-                        getline(scriptFile, str);
-                    }
-                    found = true;
-                }
+                x_lines_v.push_back(rc_lines_v[j]);
+                j++;
             }
-        }
-        if (!found)
-        {
-            scriptFile.close();
-            throw FileException(__LINE__, __FILE__, "Aucune section nommée " + readingMode.substr(pos+1) + " dans ce script.", fileName);
+            next = j + 1;
         }
     }
     else // par défaut, lit tout le fichier
-    {
-        while (scriptFile.good())
-        {
-            getline(scriptFile, str);
-            x_lines_v.push_back(str);
-        }
-    }
-
-    scriptFile.close();
+        x_lines_v = rc_lines_v;
 
     return x_lines_v;
 }
@@ -109,33 +181,15 @@ vector<string> readScript(const string& scriptName, const string& language, cons
 string readLineAtSection(const string& scriptName, const string& sectionName, const string& language)
 {
     string fileName = scriptName + (language.empty()?"":"_" + language) + "." + SCRIPT_EXT;
-    ifstream scriptFile(fileName.c_str());
+    const CachedScript& rc_script = cachedScript(fileName);
 
-    if (!scriptFile.is_open())
-        throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
-
-    string x_str;
-    bool found = false;
-    while (scriptFile.good())
-    {
-        getline(scriptFile, x_str);
-        if (!x_str.empty() && x_str.at(0) == '[') // titre de section ?
-        {
-            if (x_str.substr(1, x_str.find_first_of(']')-1) == sectionName) // est-ce la bonne section ?
-            {
-                getline(scriptFile, x_str);
-                found = true;
-                break;
-            }
-        }
-    }
-
-    scriptFile.close();
-
-    if (!found)
+    map<string, vector<unsigned int> >::const_iterator it = rc_script.sections_v_map.find(sectionName);
+    if (it == rc_script.sections_v_map.end())
         throw FileException(__LINE__, __FILE__, "Aucune section nommée " + sectionName + " dans ce script.", fileName);
 
-    return x_str;
+    unsigned int line = it->second[0] + 1;
+
+    return (line < rc_script.lines_v.size())?rc_script.lines_v[line]:"";
 }
 
 string translate(const string& s, const string& language)
@@ -145,35 +199,7 @@ string translate(const string& s, const string& language)
     if (s.size() == 0)
         return s;
 
-    string x_str, str2;
-    string fileName = string(TRANSLATION_SCRIPT_NAME) + "_" + language + "." + SCRIPT_EXT;
-    ifstream scriptFile(fileName.c_str());
-
-    if (!scriptFile.is_open())
-        throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
-
-    bool found = false;
-    while (scriptFile.good())
-    {
-        getline(scriptFile, x_str);
-        size_t pos = x_str.find_first_of('=');
-        if (pos == string::npos || pos == x_str.length()-1)
-            continue;
-        // ce mic-mac n'est plus trop nécessaire me semble-t-il, mais je me souviens du bug qui avait été résolu comme cela, alors je laisse :
-        str2 = (s.at(s.size()-1) == '\0')?s.substr(0, s.size()-1):s; // retire '\0' pour pouvoir comparer avec la chaîne extraite ci-dessous, donc sans '\0'
-        if (x_str.substr(0, pos) == str2)
-        {
-            x_str = x_str.substr(pos+1);
-            found = true;
-            break;
-        }
-    }
-    if (!found)
-        x_str = s;
-
-    scriptFile.close();
-
-    return x_str;
+    return translateWith(translationTable(language), s);
 }
 
 vector<string> translate(const vector<string>& stringList, const string& language)
@@ -182,42 +208,11 @@ vector<string> translate(const vector<string>& stringList, const string& languag
         return stringList;
 
     vector<string> x_list;
-    string fileName = string(TRANSLATION_SCRIPT_NAME) + "_" + language + "." + SCRIPT_EXT;
-    ifstream scriptFile(fileName.c_str());
+    const map<string, string>& rc_table_map = translationTable(language);
 
-    if (!scriptFile.is_open())
-        throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
-
-    string str, str2;
+    x_list.reserve(stringList.size());
     for (unsigned int i=0; i<stringList.size(); i++)
-    {
-        bool found = false;
-        if (stringList[i].size() > 0)
-        {
-            while (scriptFile.good())
-            {
-                getline(scriptFile, str);
-                size_t pos = str.find_first_of('=');
-                if (pos == string::npos || pos == str.length()-1)
-                    continue;
-                // ce mic-mac n'est plus trop nécessaire me semble-t-il, mais je me souviens du bug qui avait été résolu comme cela, alors je laisse :
-                // retire '\0' pour pouvoir comparer avec la chaîne extraite ci-dessous, donc sans '\0'
-                str2 = (stringList[i].at(stringList[i].size()-1) == '\0')?stringList[i].substr(0, stringList[i].size()-1):stringList[i];
-                if (str.substr(0, pos) == str2)
-                {
-                    x_list.push_back(str.substr(pos+1));
-                    found = true;
-                    break;
-                }
-            }
-        }
-        if (!found)
-            x_list.push_back(stringList[i]);
-        scriptFile.clear();
-        scriptFile.seekg(0, ios_base::beg);
-    }
-
-    scriptFile.close();
+        x_list.push_back(translateWith(rc_table_map, stringList[i]));
 
     return x_list;
 }
@@ -404,27 +399,22 @@ vector<unsigned char> unicodeToAscii(const string& rc_text)
 
 void writeString(ofstream& r_ofs, const string& str)
 {
-    char c;
-    for (unsigned int i=0, size=str.size(); i<size; i++)
-    {
-        c = str.at(i);
-        r_ofs.write(&c, sizeof(char));
-    }
-    c = '\0';
-    r_ofs.write(&c, sizeof(char));
+    r_ofs.write(str.c_str(), str.size() + 1); // '\0' compris
 }
 
 string readString(ifstream& r_ifs, char delim)
 {
-    char c;
     string x_str;
-    do
+    // getline parcourt directement le tampon du flux à la recherche du délimiteur
+    getline(r_ifs, x_str, delim);
+    if (delim != '\0')
     {
-        r_ifs.read(&c, sizeof(char));
-        if (c != '\0' && c != delim)
-            x_str.append(1, c);
+        string::size_type pos = x_str.find('\0');
+        if (pos != string::npos)
+            x_str.erase(pos);
     }
-    while (r_ifs.good() && c != '\0' && c != delim);
+    if (r_ifs.eof())
+        r_ifs.setstate(ios::failbit);
 
     return x_str;
 }
@@ -462,18 +452,27 @@ string readString(ifstream& r_ifs, const string& delim)
 void writeBinaryFile(ofstream& r_ofs, ifstream& r_ifs)
 {
     unsigned int size;
-    char c;
+    vector<char> buffer_v(BINARY_BUFFER_SIZE);
 
     r_ifs.seekg(0, ios::end);
     size = r_ifs.tellg();
     r_ofs.write((char*) &size, sizeof(unsigned int));
     r_ifs.seekg(0, ios::beg);
-    r_ifs.read(&c, sizeof(char));
 
-    while (r_ifs.good())
+    // copie par blocs
+    do
     {
-        r_ofs.write(&c, sizeof(char));
-        r_ifs.read(&c, sizeof(char));
-    }
+        r_ifs.read(&(buffer_v[0]), buffer_v.size());
+        r_ofs.write(&(buffer_v[0]), r_ifs.gcount());
+    } while (r_ifs.good());
+}
+
+bool openBufferedBinaryFile(ofstream& r_ofs, vector<char>& r_buffer_v, const string& fileName)
+{
+    r_buffer_v.resize(BINARY_BUFFER_SIZE);
+    r_ofs.rdbuf()->pubsetbuf(&(r_buffer_v[0]), r_buffer_v.size()); // avant l'ouverture, sans quoi le tampon peut être ignoré
+    r_ofs.open(fileName.c_str(), ios::out | ios::binary | ios::trunc);
+
+    return r_ofs.is_open();
 }
 
@@ -0,0 +1,258 @@
+#include "profiler.h"
+
+#ifdef PROFILING
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#endif
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "errors.h"
+#include "misc.h"
+
+// verrou du système, le profileur ne dépendant pas de la SDL
+class ProfilerLock : private NonCopyable
+{
+public:
+#ifdef _WIN32
+    ProfilerLock() {InitializeCriticalSection(&m_section);}
+    ~ProfilerLock() {DeleteCriticalSection(&m_section);}
+    void lock() {EnterCriticalSection(&m_section);}
+    void unlock() {LeaveCriticalSection(&m_section);}
+#else
+    ProfilerLock() {pthread_mutex_init(&m_mutex, 0);}
+    ~ProfilerLock() {pthread_mutex_destroy(&m_mutex);}
+    void lock() {pthread_mutex_lock(&m_mutex);}
+    void unlock() {pthread_mutex_unlock(&m_mutex);}
+#endif
+
+private:
+#ifdef _WIN32
+    CRITICAL_SECTION m_section;
+#else
+    pthread_mutex_t m_mutex;
+#endif
+};
+
+// mesure d'un bloc, le nom étant une chaîne littérale
+struct ProfileSample
+{
+    const char* q_name;
+    double start;
+    double end;
+    unsigned int depth;
+};
+
+// liste circulaire des mesures d'un thread, seul ce thread y ajoutant des mesures
+struct ProfileBuffer
+{
+    unsigned int threadId;
+    string threadName;
+    vector<ProfileSample> samples_v;
+    unsigned int count; // nombre total de mesures ajoutées, la mesure i étant à l'indice i%PROFILER_RING_SIZE
+    unsigned int depth;
+    unsigned int frameStart; // valeur de count lors du dernier appel à Profiler::endFrame
+    double frameDate;
+    vector<pair<string, float> > lastFrame_v;
+    ProfilerLock lock; // protège les mesures et le bilan contre la lecture par un autre thread
+};
+
+// ensemble des listes de tous les threads, détruites en fin de programme
+struct ProfilerRegistry
+{
+    ~ProfilerRegistry()
+    {
+        for (unsigned int i=0, size=pn_buffers_v.size();i<size;i++)
+            delete pn_buffers_v[i];
+    }
+
+    ProfilerLock lock;
+    vector<ProfileBuffer*> pn_buffers_v;
+};
+
+static ProfilerRegistry s_registry;
+static __thread ProfileBuffer* sq_threadBuffer = 0;
+static double s_origin = Profiler::now();
+
+// bloc cumulé sur une image
+struct FrameEntry
+{
+    const char* q_name;
+    unsigned int depth;
+    double start;
+    double total;
+};
+
+static bool frameEntryOrder(const FrameEntry& rc_a, const FrameEntry& rc_b)
+{
+    return rc_a.start < rc_b.start;
+}
+
+// liste du thread appelant, créée à la première mesure
+static ProfileBuffer& threadBuffer()
+{
+    if (sq_threadBuffer == 0)
+    {
+        ProfileBuffer* p_buffer = new ProfileBuffer;
+        p_buffer->samples_v.resize(PROFILER_RING_SIZE);
+        p_buffer->count = 0;
+        p_buffer->depth = 0;
+        p_buffer->frameStart = 0;
+        p_buffer->frameDate = Profiler::now();
+
+        s_registry.lock.lock();
+        p_buffer->threadId = s_registry.pn_buffers_v.size() + 1;
+        p_buffer->threadName = string("thread ") + itostr(p_buffer->threadId);
+        s_registry.pn_buffers_v.push_back(p_buffer);
+        s_registry.lock.unlock();
+
+        sq_threadBuffer = p_buffer;
+    }
+
+    return *sq_threadBuffer;
+}
+
+// échappement des caractères réservés d'une chaîne JSON
+static string jsonString(const string& str)
+{
+    string rtn("\"");
+    for (unsigned int i=0, size=str.size();i<size;i++)
+    {
+        if (str[i] == '"' || str[i] == '\\')
+            rtn += '\\';
+        if ((unsigned char) str[i] >= 0x20)
+            rtn += str[i];
+    }
+
+    return rtn + "\"";
+}
+
+double Profiler::now()
+{
+#ifdef _WIN32
+    static LARGE_INTEGER s_frequency = {{0, 0}};
+    if (s_frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&s_frequency);
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return (double) counter.QuadPart * 1000000.0 / (double) s_frequency.QuadPart - s_origin;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0 - s_origin;
+#endif
+}
+
+void Profiler::nameThread(const string& name)
+{
+    ProfileBuffer& r_buffer = threadBuffer();
+    r_buffer.lock.lock();
+    r_buffer.threadName = name;
+    r_buffer.lock.unlock();
+}
+
+void Profiler::endFrame()
+{
+    ProfileBuffer& r_buffer = threadBuffer();
+    double date = now();
+
+    r_buffer.lock.lock();
+
+    // les mesures sont ajoutées à leur fin, un bloc imbriqué précédant son parent : les blocs sont ensuite triés par date de début
+    vector<FrameEntry> entries_v;
+    unsigned int first = MAX(r_buffer.frameStart, (r_buffer.count > PROFILER_RING_SIZE)?r_buffer.count-PROFILER_RING_SIZE:0);
+    for (unsigned int i=first;i<r_buffer.count;i++)
+    {
+        const ProfileSample& rc_sample = r_buffer.samples_v[i%PROFILER_RING_SIZE];
+        unsigned int j = 0, size = entries_v.size();
+        while (j < size && strcmp(entries_v[j].q_name, rc_sample.q_name) != 0)
+            j++;
+        if (j == size)
+        {
+            FrameEntry entry = {rc_sample.q_name, rc_sample.depth, rc_sample.start, 0.0};
+            entries_v.push_back(entry);
+        }
+        entries_v[j].start = MIN(entries_v[j].start, rc_sample.start);
+        entries_v[j].total += rc_sample.end - rc_sample.start;
+    }
+    stable_sort(entries_v.begin(), entries_v.end(), frameEntryOrder);
+
+    r_buffer.lastFrame_v.clear();
+    r_buffer.lastFrame_v.push_back(pair<string, float>("frame", (date - r_buffer.frameDate) / 1000.0));
+    for (unsigned int i=0, size=entries_v.size();i<size;i++)
+        r_buffer.lastFrame_v.push_back(pair<string, float>(string(2*entries_v[i].depth, ' ') + entries_v[i].q_name, entries_v[i].total / 1000.0));
+    r_buffer.frameStart = r_buffer.count;
+    r_buffer.frameDate = date;
+
+    r_buffer.lock.unlock();
+}
+
+void Profiler::frameBreakdown(vector<pair<string, float> >& r_breakdown_v)
+{
+    ProfileBuffer& r_buffer = threadBuffer();
+    r_buffer.lock.lock();
+    r_breakdown_v = r_buffer.lastFrame_v;
+    r_buffer.lock.unlock();
+}
+
+void Profiler::exportTrace(const string& fileName)
+{
+    ofstream ofs(fileName.c_str(), ios::out | ios::trunc);
+    if (!ofs.is_open())
+        throw FileException(__LINE__, __FILE__, "Impossible d'ouvrir le fichier.", fileName);
+
+    ofs.setf(ios::fixed);
+    ofs.precision(3);
+    ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    s_registry.lock.lock();
+    for (unsigned int b=0, size=s_registry.pn_buffers_v.size();b<size;b++)
+    {
+        ProfileBuffer& r_buffer = *(s_registry.pn_buffers_v[b]);
+        r_buffer.lock.lock();
+
+        ofs << (first?"":",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << r_buffer.threadId
+            << ",\"args\":{\"name\":" << jsonString(r_buffer.threadName) << "}}";
+        first = false;
+
+        for (unsigned int i=(r_buffer.count > PROFILER_RING_SIZE)?r_buffer.count-PROFILER_RING_SIZE:0;i<r_buffer.count;i++)
+        {
+            const ProfileSample& rc_sample = r_buffer.samples_v[i%PROFILER_RING_SIZE];
+            ofs << ",\n{\"name\":" << jsonString(rc_sample.q_name) << ",\"cat\":\"pf\",\"ph\":\"X\",\"ts\":" << rc_sample.start
+                << ",\"dur\":" << rc_sample.end - rc_sample.start << ",\"pid\":1,\"tid\":" << r_buffer.threadId << "}";
+        }
+
+        r_buffer.lock.unlock();
+    }
+    s_registry.lock.unlock();
+
+    ofs << "\n]}\n";
+}
+
+double Profiler::beginScope()
+{
+    threadBuffer().depth++;
+
+    return now();
+}
+
+void Profiler::endScope(const char* q_name, double start)
+{
+    double end = now();
+    ProfileBuffer& r_buffer = *sq_threadBuffer; // créée par Profiler::beginScope
+
+    r_buffer.depth--;
+    ProfileSample sample = {q_name, start, end, r_buffer.depth};
+
+    r_buffer.lock.lock();
+    r_buffer.samples_v[r_buffer.count%PROFILER_RING_SIZE] = sample;
+    r_buffer.count++;
+    r_buffer.lock.unlock();
+}
+
+#endif // PROFILING
@@ -0,0 +1,64 @@
+#include "slaballocator.h"
+
+#include <cassert>
+#include "errors.h"
+
+#ifndef NDEBUG
+// variable propre à chaque thread, dont l'adresse identifie le thread appelant
+static __thread char s_threadTag;
+#endif
+
+SlabAllocator::SlabAllocator(size_t blockSize, unsigned int blocksPerSlab) : m_blockSize(blockSize), m_blocksPerSlab(blocksPerSlab), mp_freeBlock(0)
+#ifndef NDEBUG
+    , mq_ownerThread(&s_threadTag)
+#endif
+{
+    if (blockSize == 0 || blocksPerSlab == 0)
+        throw ConstructorException(__LINE__, __FILE__, "La taille des blocs et le nombre de blocs par plaque ne peuvent être nuls.", "SlabAllocator");
+
+    // un bloc libre doit pouvoir contenir l'adresse du suivant, et tous les blocs doivent rester alignés
+    size_t align = MAX(sizeof(double), sizeof(void*));
+    m_blockSize = (MAX(m_blockSize, sizeof(void*)) + align - 1) / align * align;
+}
+
+SlabAllocator::~SlabAllocator()
+{
+    for (unsigned int i=0, size=mpn_slabs_v.size();i<size;i++)
+        delete [] mpn_slabs_v[i];
+}
+
+void* SlabAllocator::allocate()
+{
+    assert(mq_ownerThread == &s_threadTag);
+
+    if (mp_freeBlock == 0)
+    {
+        char* p_slab = new char[m_blockSize*m_blocksPerSlab];
+        mpn_slabs_v.push_back(p_slab);
+        // chaînage des blocs de la nouvelle plaque, dans l'ordre des adresses
+        for (unsigned int i=0;i<m_blocksPerSlab-1;i++)
+            *((void**) (p_slab + i*m_blockSize)) = p_slab + (i+1)*m_blockSize;
+        *((void**) (p_slab + (m_blocksPerSlab-1)*m_blockSize)) = 0;
+        mp_freeBlock = p_slab;
+    }
+
+    void* p_block = mp_freeBlock;
+    mp_freeBlock = *((void**) p_block);
+
+    return p_block;
+}
+
+void SlabAllocator::deallocate(void* p_block)
+{
+    if (p_block == 0)
+        return;
+    assert(mq_ownerThread == &s_threadTag);
+
+    *((void**) p_block) = mp_freeBlock;
+    mp_freeBlock = p_block;
+}
+
+unsigned int SlabAllocator::slabsCount() const
+{
+    return mpn_slabs_v.size();
+}